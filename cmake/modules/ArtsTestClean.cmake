@@ -0,0 +1,4 @@
+# Removes the files and directories in PATHS, separated by colons.
+# Used by ARTS_TEST_CTLFILE_CLEAN.
+string(REPLACE ":" ";" PATHS "${PATHS}")
+file(REMOVE_RECURSE ${PATHS})
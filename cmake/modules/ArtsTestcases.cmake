@@ -27,3 +27,22 @@ macro (ARTS_TEST_CTLFILE_DEPENDS TESTNAME DEPENDNAME)
     )
 endmacro (ARTS_TEST_CTLFILE_DEPENDS)
 
+
+macro (ARTS_TEST_CTLFILE_CLEAN TESTNAME)
+  # Removes the files and directories given after TESTNAME, relative to the
+  # test directory, before the test is run.
+  string(REPLACE ";" ":" CLEAN_PATHS "${ARGN}")
+  add_test(
+    NAME arts.ctlfile.${TESTNAME}.clean
+    COMMAND ${CMAKE_COMMAND} -DPATHS=${CLEAN_PATHS}
+            -P ${CMAKE_SOURCE_DIR}/cmake/modules/ArtsTestClean.cmake
+    )
+  set_tests_properties(
+    arts.ctlfile.${TESTNAME}.clean
+    PROPERTIES FIXTURES_SETUP arts.ctlfile.${TESTNAME}.clean
+    )
+  set_tests_properties(
+    arts.ctlfile.${TESTNAME}
+    PROPERTIES FIXTURES_REQUIRED arts.ctlfile.${TESTNAME}.clean
+    )
+endmacro (ARTS_TEST_CTLFILE_CLEAN)
@@ -2219,3 +2219,235 @@ void xsec_species2(Matrix& xsec,
     }
   }
 }
+
+//! Upper bound of the cross-section of a line inside a frequency range.
+/*!
+  The line shape is bounded by its peak value and, outside of the range,
+  by its value at the distance d to the closest end of the range. For
+  the Voigt profile, the convolution of a Lorentz profile L and a Gauss
+  profile G, the value at distance d is bounded by L(d/2) plus the peak
+  of L times the part of G beyond d/2.
+
+  Lines with line mixing or a non-LTE population are not bounded, the
+  function returns -1 for them.
+
+  \param line                 The line.
+  \param T                    Temperature.
+  \param P                    Pressure.
+  \param vmrs                 VMRs of all species at this level.
+  \param abs_species          The species tags.
+  \param fmin                 Lower end of the frequency range.
+  \param fmax                 Upper end of the frequency range.
+  \param isotopologue_ratios  Isotopologue ratios.
+  \param partition_functions  Partition functions.
+  \return                     The bound, or -1.
+
+  \author ARTS developers
+  \date   2020-06-02
+*/
+static Numeric line_xsec_bound(const LineRecord& line,
+                               const Numeric& T,
+                               const Numeric& P,
+                               ConstVectorView vmrs,
+                               const ArrayOfArrayOfSpeciesTag& abs_species,
+                               const Numeric& fmin,
+                               const Numeric& fmax,
+                               const SpeciesAuxData& isotopologue_ratios,
+                               const SpeciesAuxData& partition_functions) {
+  using Constant::inv_pi;
+  using Constant::inv_sqrt_pi;
+
+  if (line.GetLinePopulationType() != LinePopulationType::ByLTE) return -1;
+
+  const LineShape::Output X = line.GetShapeParams(T, P, vmrs, abs_species);
+  if (X.Y != 0 || X.G != 0) return -1;
+
+  // Line strength
+  Numeric qt0 = 1, qt = 1;
+  partition_function(
+      qt0,
+      qt,
+      line.Ti0(),
+      T,
+      partition_functions.getParamType(line.Species(), line.Isotopologue()),
+      partition_functions.getParam(line.Species(), line.Isotopologue()));
+  const Numeric S =
+      fabs(Linefunctions::lte_linestrength(
+          line.I0(), line.Elow(), line.F(), qt0, line.Ti0(), qt, T)) *
+      isotopologue_ratios.getParam(line.Species(), line.Isotopologue())[0]
+          .data[0];
+
+  // Widths. The speed dependence narrows the line, this is approximated
+  // by reducing the Lorentz width
+  const Numeric F0 = line.F() + X.D0 + X.DV;
+  const Numeric GD =
+      fabs(line.F()) *
+      Linefunctions::DopplerConstant(T, line.IsotopologueData().Mass());
+  Numeric GL = fabs(X.G0);
+  if (line.GetLineShapeType() == LineShape::Type::SDVP ||
+      line.GetLineShapeType() == LineShape::Type::HTP)
+    GL = max(GL - 1.5 * fabs(X.G2), 0.0);
+
+  const Numeric cutoff = line.CutOff();
+  const bool lorentz_mirror =
+      line.GetMirroringType() == MirroringType::Lorentz;
+
+  // Bound of the line shape at distance d from the centre
+  auto shape_bound = [&](const Numeric d, const bool lorentz) -> Numeric {
+    if (cutoff > 0 && d > cutoff) return 0;
+    if (lorentz || line.GetLineShapeType() == LineShape::Type::LP)
+      return GL > 0 ? inv_pi * GL / (d * d + GL * GL) : 0;
+    if (line.GetLineShapeType() == LineShape::Type::DP || GL == 0)
+      return inv_sqrt_pi / GD * exp(-(d / GD) * (d / GD));
+    const Numeric lpeak = inv_pi / GL;
+    const Numeric wing =
+        inv_pi * GL / (0.25 * d * d + GL * GL) + 0.5 * lpeak * erfc(d / GD / 2);
+    return min(min(lpeak, inv_sqrt_pi / GD), wing);
+  };
+
+  // Distance to the frequency range
+  const Numeric d = F0 < fmin ? fmin - F0 : F0 > fmax ? F0 - fmax : 0;
+  Numeric bound = shape_bound(d, false);
+
+  // Mirrored line, centred at -F0
+  if (line.GetMirroringType() == MirroringType::Lorentz ||
+      line.GetMirroringType() == MirroringType::SameAsLineShape)
+    bound += shape_bound(fmin + F0, lorentz_mirror);
+
+  // Normalisation factors are below (f/F0)^2
+  const Numeric Fabs = fabs(line.F());
+  if (line.GetLineNormalizationType() != LineNormalizationType::None &&
+      fmax > Fabs)
+    bound *= (fmax / Fabs) * (fmax / Fabs);
+
+  return S * bound;
+}
+
+//! Remove weak lines, keeping a bound of the resulting error.
+/*!
+  For each line and pressure level, an upper bound of the cross-section
+  inside the frequency range of f_grid is determined. The bounds are
+  divided by the largest bound of all lines at the same level, and the
+  largest of these ratios over the levels, r, is taken as the relative
+  importance of the line. Lines are removed in order of increasing r, as
+  long as the sum of r over the removed lines does not exceed tolerance.
+
+  The removed lines can then at no frequency and level change the cross-
+  section of the species by more than tolerance times the largest peak
+  cross-section of any line of the species at that level. The bounds are
+  conservative, the actual error is normally much smaller.
+
+  Lines with line mixing or a non-LTE population are always kept.
+
+  \param abs_lines            In/out: The lines of one species.
+  \param tolerance            Relative tolerance, see above.
+  \param f_grid               Frequency grid.
+  \param abs_p                Pressure grid.
+  \param abs_t                Temperatures associated with abs_p.
+  \param all_vmrs             Gas volume mixing ratios [nspecies, np].
+  \param abs_species          Species tags for all species.
+  \param isotopologue_ratios  Isotopologue ratios.
+  \param partition_functions  Partition functions.
+  \return                     The error bound of the removed lines, in the
+                              same relative measure as tolerance.
+
+  \author ARTS developers
+  \date   2020-06-02
+*/
+Numeric prune_weak_lines(ArrayOfLineRecord& abs_lines,
+                         const Numeric& tolerance,
+                         const Vector& f_grid,
+                         const Vector& abs_p,
+                         const Vector& abs_t,
+                         const Matrix& all_vmrs,
+                         const ArrayOfArrayOfSpeciesTag& abs_species,
+                         const SpeciesAuxData& isotopologue_ratios,
+                         const SpeciesAuxData& partition_functions) {
+  const Index nl = abs_lines.nelem();
+  const Index np = abs_p.nelem();
+
+  if (nl < 2 || np == 0 || f_grid.nelem() == 0 || tolerance <= 0) return 0;
+
+  const Numeric fmin = min(f_grid);
+  const Numeric fmax = max(f_grid);
+
+  // Bounds of all lines and levels
+  Matrix bounds(nl, np);
+  String fail_msg;
+  bool failed = false;
+#pragma omp parallel for if (!arts_omp_in_parallel() && nl > 1)
+  for (Index il = 0; il < nl; il++) {
+    if (failed) continue;
+    try {
+      for (Index ip = 0; ip < np; ip++)
+        bounds(il, ip) = line_xsec_bound(abs_lines[il],
+                                         abs_t[ip],
+                                         abs_p[ip],
+                                         all_vmrs(joker, ip),
+                                         abs_species,
+                                         fmin,
+                                         fmax,
+                                         isotopologue_ratios,
+                                         partition_functions);
+    } catch (const std::exception& e) {
+#pragma omp critical(prune_weak_lines_fail)
+      {
+        fail_msg = e.what();
+        failed = true;
+      }
+    }
+  }
+  if (failed) throw runtime_error(fail_msg);
+
+  // Normalise with the largest bound of each level
+  Vector ratio(nl, 0);
+  ArrayOfIndex candidates;
+  for (Index ip = 0; ip < np; ip++) {
+    const Numeric bmax = max(bounds(joker, ip));
+    for (Index il = 0; il < nl; il++) {
+      if (bounds(il, ip) < 0)
+        ratio[il] = -1;
+      else if (ratio[il] >= 0 && bmax > 0)
+        ratio[il] = max(ratio[il], bounds(il, ip) / bmax);
+    }
+  }
+  for (Index il = 0; il < nl; il++)
+    if (ratio[il] >= 0) candidates.push_back(il);
+
+  std::sort(candidates.begin(), candidates.end(), [&](Index a, Index b) {
+    return ratio[a] < ratio[b];
+  });
+
+  // Remove the weakest lines while the sum of ratios stays below tolerance
+  std::vector<bool> remove(size_t(nl), false);
+  Numeric sum = 0;
+  Index nremove = 0;
+  for (Index i = 0; i < candidates.nelem(); i++) {
+    const Index il = candidates[i];
+    if (sum + ratio[il] > tolerance) break;
+    sum += ratio[il];
+    remove[size_t(il)] = true;
+    nremove++;
+  }
+
+  if (nremove == 0) return 0;
+
+  // The actual bound is the largest sum of the removed lines at any level
+  Numeric error_bound = 0;
+  for (Index ip = 0; ip < np; ip++) {
+    const Numeric bmax = max(bounds(joker, ip));
+    if (bmax <= 0) continue;
+    Numeric level_sum = 0;
+    for (Index il = 0; il < nl; il++)
+      if (remove[size_t(il)]) level_sum += bounds(il, ip);
+    error_bound = max(error_bound, level_sum / bmax);
+  }
+
+  ArrayOfLineRecord kept;
+  kept.reserve(size_t(nl - nremove));
+  for (Index il = 0; il < nl; il++)
+    if (!remove[size_t(il)]) kept.push_back(abs_lines[il]);
+  abs_lines = std::move(kept);
+
+  return error_bound;
+}
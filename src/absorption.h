@@ -829,4 +829,14 @@ void xsec_species2(Matrix& xsec,
                    const SpeciesAuxData& isotopologue_ratios,
                    const SpeciesAuxData& partition_functions);
 
+Numeric prune_weak_lines(ArrayOfLineRecord& abs_lines,
+                         const Numeric& tolerance,
+                         const Vector& f_grid,
+                         const Vector& abs_p,
+                         const Vector& abs_t,
+                         const Matrix& all_vmrs,
+                         const ArrayOfArrayOfSpeciesTag& abs_species,
+                         const SpeciesAuxData& isotopologue_ratios,
+                         const SpeciesAuxData& partition_functions);
+
 #endif  // absorption_h
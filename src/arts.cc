@@ -44,6 +44,10 @@ void arts_exit(int status) {
   extern String out_basename;  // Basis for file name
   ostringstream report_file_ext;
 
+  // Pending asynchronous output must reach the report file before it is
+  // closed
+  async_log_stop();
+
   report_file_ext << ".rep";
   cleanup_output_file(report_file,
                       add_basedir(out_basename + report_file_ext.str()));
@@ -64,6 +68,10 @@ void arts_exit(int status) {
 void arts_exit_with_error_message(const String &m, ArtsOut &out) {
   ostringstream os;
 
+  // Error messages are written directly, so make sure that earlier output
+  // appears first
+  async_log_stop();
+
   os << m << "\n";
 
   if (out.get_verbosity().get_screen_verbosity() <
@@ -505,6 +505,9 @@ const char *set_variable_value(InteractiveWorkspace *workspace,
                                long id,
                                long group_id,
                                VariableValueStruct value) {
+  // Never copy into memory owned by the caller.
+  workspace->release_variable_view(id);
+
   // If ptr is null empty variable
   if (value.ptr == nullptr) {
     workspace->initialize_variable(id);
@@ -621,6 +624,26 @@ const char *set_variable_value(InteractiveWorkspace *workspace,
   return nullptr;
 }
 
+const char *set_variable_view(InteractiveWorkspace *workspace,
+                              long id,
+                              long group_id,
+                              VariableValueStruct value) {
+  try {
+    workspace->set_variable_view(id,
+                                 group_id,
+                                 value.dimensions,
+                                 reinterpret_cast<const Numeric *>(value.ptr));
+  } catch (const std::exception &e) {
+    string_buffer = e.what();
+    return string_buffer.c_str();
+  }
+  return nullptr;
+}
+
+void release_variable_view(InteractiveWorkspace *workspace, long id) {
+  workspace->release_variable_view(id);
+}
+
 long add_variable(InteractiveWorkspace *workspace,
                   long group_id,
                   const char *name) {
@@ -508,6 +508,11 @@ VariableStruct get_variable(Index i);
 
 //! Get value WSV in given workspace.
 /**
+     * No data is copied: For numeric data the data pointer of the returned
+     * VariableValueStruct points directly to the memory of the variable in
+     * the workspace. It must be treated as read-only and is only valid
+     * until the variable is modified, released or erased.
+     *
      * \param workspace Pointer to a InteractiveWorkspace object.
      * \param id Index of the workspace variable.
      * \param group_id Index of the group the variable belongs to.
@@ -565,6 +570,45 @@ const char *set_variable_value(InteractiveWorkspace *workspace,
                                long id,
                                long group_id,
                                VariableValueStruct value);
+//! Bind WSV in given workspace to external memory.
+/**
+     * Sets the WSV to a view of the memory given by the data pointer of the
+     * VariableValueStruct, without copying it. The data is assumed to be a
+     * contiguous array of double with c-style memory layout and size given
+     * by the dimension field of VariableValueStruct. Supported data types
+     * are Vector, Matrix and Tensor3 to Tensor7.
+     *
+     * The memory remains owned by the caller and must stay valid until the
+     * view is released using release_variable_view, the variable is set
+     * using set_variable_value or the workspace is destroyed. Views can only
+     * be used as input: Methods and agendas that have the variable among
+     * their outputs will fail.
+     *
+     * \param workspace Pointer to a InteractiveWorkspace object.
+     * \param id Index of the workspace variable.
+     * \param group_id Index of the group the variable belongs to.
+     * \param value VariableValueStruct describing the external memory.
+     * \return Pointer to null-terminated string containing the error message
+     * if the variable can not be bound to the memory, NULL otherwise.
+     */
+DLL_PUBLIC
+const char *set_variable_view(InteractiveWorkspace *workspace,
+                              long id,
+                              long group_id,
+                              VariableValueStruct value);
+
+//! Release view of external memory.
+/**
+     * Removes the view set by set_variable_view. The variable is reset to
+     * the value it had before the view was set. The external memory is not
+     * touched and can be freed by the caller afterwards.
+     *
+     * \param workspace Pointer to a InteractiveWorkspace object.
+     * \param id Index of the workspace variable.
+     */
+DLL_PUBLIC
+void release_variable_view(InteractiveWorkspace *workspace, long id);
+
 //! Add variable of given type to workspace.
 /**
      * This adds and initializes a variable in the current workspace and also
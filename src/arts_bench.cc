@@ -0,0 +1,710 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   arts_bench.cc
+
+  \brief  Micro-benchmarks of the core ARTS kernels.
+
+  Each benchmark calls a kernel repeatedly on fixed, synthetic input (or
+  on the test data in controlfiles/testdata) until a minimum run time is
+  reached, and reports the minimum, median and mean time per call.
+
+  Usage:
+
+    arts_bench [-f filter] [-m min_time] [-o results.json]
+               [-c baseline.json] [-t tolerance]
+
+  -f  Only run benchmarks whose name contains the given string.
+  -m  Minimum run time per benchmark in seconds (default 0.5).
+  -o  Write the results as JSON to the given file.
+  -c  Compare the median times to a baseline written by -o. The exit
+      status is 1 if any benchmark is slower than the baseline by more
+      than the tolerance.
+  -t  Relative tolerance of the comparison (default 0.1).
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include "agenda_record.h"
+#include "arts.h"
+#include "arts_omp.h"
+#include "auto_md.h"
+#include "auto_version.h"
+#include "file.h"
+#include "global_data.h"
+#include "linefunctions.h"
+#include "math_funcs.h"
+#include "matpackII.h"
+#include "methods.h"
+#include "parameters.h"
+#include "parser.h"
+#include "propagationmatrix.h"
+#include "sensor.h"
+#include "transmissionmatrix.h"
+#include "workspace_ng.h"
+#include "xml_io.h"
+
+extern Parameters parameters;
+extern Verbosity verbosity_at_launch;
+extern const Numeric DEG2RAD;
+
+//! Timing statistics of one benchmark, in seconds per call.
+struct BenchResult {
+  String name;
+  Index iterations;
+  Numeric min;
+  Numeric median;
+  Numeric mean;
+};
+
+//! Runs the benchmarks and collects their timings.
+class BenchRunner {
+ public:
+  BenchRunner(const String& filter, Numeric min_time)
+      : mfilter(filter), mmin_time(min_time) {}
+
+  //! Check if a benchmark shall be run.
+  bool selected(const String& name) const {
+    return mfilter.empty() || name.find(mfilter) != std::string::npos;
+  }
+
+  //! Check if any of the benchmarks shall be run.
+  bool any_selected(const ArrayOfString& names) const {
+    for (const auto& name : names)
+      if (selected(name)) return true;
+    return false;
+  }
+
+  //! Time a kernel.
+  /*!
+    The kernel is called once without timing, and then until the total
+    time exceeds the minimum run time, but at least 5 times.
+  */
+  void run(const String& name, const std::function<void()>& kernel) {
+    if (!selected(name)) return;
+
+    typedef std::chrono::steady_clock clock;
+
+    kernel();
+
+    std::vector<Numeric> times;
+    Numeric total = 0;
+    while (times.size() < 5 || (total < mmin_time && times.size() < 1000000)) {
+      const clock::time_point start = clock::now();
+      kernel();
+      const Numeric t =
+          std::chrono::duration<Numeric>(clock::now() - start).count();
+      times.push_back(t);
+      total += t;
+    }
+
+    std::sort(times.begin(), times.end());
+    const size_t n = times.size();
+
+    BenchResult r;
+    r.name = name;
+    r.iterations = (Index)n;
+    r.min = times[0];
+    r.median = n % 2 ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+    r.mean = total / (Numeric)n;
+    mresults.push_back(r);
+
+    cout << std::left << std::setw(32) << r.name << std::right
+         << std::setw(10) << r.iterations << std::scientific
+         << std::setprecision(3) << std::setw(12) << r.median << " s\n"
+         << std::defaultfloat;
+  }
+
+  const Array<BenchResult>& results() const { return mresults; }
+
+ private:
+  String mfilter;
+  Numeric mmin_time;
+  Array<BenchResult> mresults;
+};
+
+//! A workspace on which controlfile snippets can be executed.
+class BenchWorkspace {
+ public:
+  BenchWorkspace(const String& tmpdir, const Verbosity& rverbosity)
+      : mtmpdir(tmpdir), verbosity(rverbosity) {
+    mws.initialize();
+  }
+
+  //! Parse the body of an Arts2 block.
+  Agenda parse(const String& body) {
+    const String cfname = mtmpdir + "/bench.arts";
+    {
+      std::ofstream os(cfname.c_str());
+      os << "Arts2 {\n" << body << "\n}\n";
+      if (!os) throw runtime_error("Cannot write file " + cfname);
+    }
+
+    Agenda tasklist;
+    ArtsParser arts_parser(tasklist, cfname, verbosity);
+    arts_parser.parse_tasklist();
+    tasklist.set_name("Arts");
+    tasklist.set_main_agenda();
+    unlink(cfname.c_str());
+
+    // The parser may have created new variables.
+    mws.initialize();
+
+    return tasklist;
+  }
+
+  //! Execute a parsed snippet.
+  void execute(const Agenda& tasklist) { Arts2(mws, tasklist, verbosity); }
+
+  //! Parse and execute the body of an Arts2 block.
+  void execute(const String& body) { execute(parse(body)); }
+
+  //! Access a workspace variable by name.
+  template <typename T>
+  T& get(const String& name) {
+    auto it = Workspace::WsvMap.find(name);
+    if (it == Workspace::WsvMap.end())
+      throw runtime_error("Unknown workspace variable: " + name);
+    return *static_cast<T*>(mws[it->second]);
+  }
+
+  Workspace& ws() { return mws; }
+
+ private:
+  Workspace mws;
+  String mtmpdir;
+  Verbosity verbosity;
+};
+
+//! Line shape functions on a wide frequency grid around a single line.
+void bench_lineshapes(BenchRunner& runner) {
+  const Index nf = 20001;
+  const Numeric F0 = 110.8364e9;
+  const Eigen::VectorXd f_grid =
+      Eigen::VectorXd::LinSpaced(nf, F0 - 500e6, F0 + 500e6);
+  const Numeric GD_div_F0 = 1e-6;
+
+  Eigen::VectorXcd F(nf);
+  Eigen::MatrixXcd dF(nf, 0);
+  Eigen::Matrix<Complex, Eigen::Dynamic, Linefunctions::ExpectedDataSize()>
+      data(nf, Linefunctions::ExpectedDataSize());
+
+  const LineShape::Output X_voigt = {1e6, 1e4, 0, 0, 0, 0, 0, 0, 0};
+  runner.run("lineshape_voigt", [&]() {
+    Linefunctions::set_voigt(F, dF, data, f_grid, 0, 0, F0, GD_div_F0, X_voigt);
+  });
+
+  const LineShape::Output X_htp = {1e6, 1e4, 1e5, 1e3, 1e4, 0.1, 0, 0, 0};
+  runner.run("lineshape_htp", [&]() {
+    Linefunctions::set_htp(F, dF, f_grid, 0, 0, F0, GD_div_F0, X_htp);
+  });
+}
+
+//! Layer transmission matrices for 1 and 4 Stokes components.
+void bench_transmission(BenchRunner& runner) {
+  const Index nf = 10000;
+
+  for (Index stokes_dim = 1; stokes_dim <= 4; stokes_dim += 3) {
+    PropagationMatrix K1(nf, stokes_dim), K2(nf, stokes_dim);
+    for (Index iv = 0; iv < nf; iv++) {
+      const Numeric x = (Numeric)iv / (Numeric)nf;
+      K1.Kjj()[iv] = 1e-4 * (1 + x);
+      K2.Kjj()[iv] = 1e-4 * (2 - x);
+      if (stokes_dim == 4) {
+        K1.K12()[iv] = K2.K12()[iv] = 1e-6 * x;
+        K1.K13()[iv] = K2.K13()[iv] = 2e-6 * x;
+        K1.K14()[iv] = K2.K14()[iv] = 3e-6 * x;
+        K1.K23()[iv] = K2.K23()[iv] = 1e-5 * x;
+        K1.K24()[iv] = K2.K24()[iv] = 2e-5 * x;
+        K1.K34()[iv] = K2.K34()[iv] = 3e-5 * x;
+      }
+    }
+
+    TransmissionMatrix T(nf, stokes_dim);
+    ArrayOfTransmissionMatrix dT1, dT2;
+    const ArrayOfPropagationMatrix dK;
+
+    ostringstream name;
+    name << "transmission_stokes" << stokes_dim;
+    runner.run(name.str(), [&]() {
+      stepwise_transmission(T, dT1, dT2, K1, K2, dK, dK, 1000, 0, 0, -1);
+    });
+  }
+}
+
+//! Application of a banded sensor response matrix on iyb and diyb_dx.
+void bench_sensor(BenchRunner& runner) {
+  const Index n1y = 1000;
+  const Index niyb = 20000;
+  const Index nx = 50;
+  const Index width = 100;
+
+  Sparse H(n1y, niyb);
+  Vector row(niyb, 0);
+  for (Index r = 0; r < n1y; r++) {
+    const Index c0 = r * (niyb - width) / (n1y - 1);
+    row = 0;
+    for (Index c = 0; c < width; c++)
+      row[c0 + c] = exp(-pow((Numeric)(c - width / 2) / (width / 4), 2));
+    row /= row.sum();
+    H.insert_row(r, row);
+  }
+
+  Vector iyb(niyb), y(n1y);
+  for (Index i = 0; i < niyb; i++) iyb[i] = 100 + sin((Numeric)i);
+  runner.run("sensor_mult_iyb", [&]() { mult(y, H, iyb); });
+
+  Matrix diyb_dx(niyb, nx), jacobian(n1y, nx);
+  for (Index i = 0; i < niyb; i++)
+    for (Index j = 0; j < nx; j++) diyb_dx(i, j) = cos((Numeric)(i + j));
+  runner.run("sensor_mult_jacobian", [&]() { mult(jacobian, H, diyb_dx); });
+
+  // Construction of a spectrometer response, 1000 channels on a
+  // frequency grid with 20000 points
+  Vector sensor_f, ch_f;
+  linspace(sensor_f, 100e9, 120e9 - 0.5e6, 1e6);
+  linspace(ch_f, 100.01e9, 119.99e9, 20e6);
+  ArrayOfGriddedField1 ch_response(1);
+  ch_response[0].set_name("Backend channel response function");
+  ch_response[0].resize(2);
+  ch_response[0].set_grid_name(0, "Frequency");
+  Vector ch_grid(2);
+  ch_grid[0] = -5e6;
+  ch_grid[1] = 5e6;
+  ch_response[0].set_grid(0, ch_grid);
+  ch_response[0].data = 1;
+  Sparse Hspec;
+  runner.run("sensor_spectrometer_matrix", [&]() {
+    spectrometer_matrix(Hspec, ch_f, ch_response, sensor_f, 1, 1, 1);
+  });
+}
+
+//! Writing and reading of a Tensor4 in ascii and binary XML format.
+void bench_xml(BenchRunner& runner, const String& tmpdir) {
+  Tensor4 t(10, 10, 50, 100);
+  for (Index b = 0; b < t.nbooks(); b++)
+    for (Index p = 0; p < t.npages(); p++)
+      for (Index r = 0; r < t.nrows(); r++)
+        for (Index c = 0; c < t.ncols(); c++)
+          t(b, p, r, c) = sin((Numeric)(b + p + r + c));
+
+  const Verbosity verbosity(0, 0, 0);
+  const String fname = tmpdir + "/bench_tensor4.xml";
+  Tensor4 t_read;
+
+  runner.run("xml_write_ascii", [&]() {
+    xml_write_to_file(fname, t, FILE_TYPE_ASCII, 0, verbosity);
+  });
+  runner.run("xml_read_ascii", [&]() {
+    if (!file_exists(fname))
+      xml_write_to_file(fname, t, FILE_TYPE_ASCII, 0, verbosity);
+    xml_read_from_file(fname, t_read, verbosity);
+  });
+
+  runner.run("xml_write_binary", [&]() {
+    xml_write_to_file(fname, t, FILE_TYPE_BINARY, 0, verbosity);
+  });
+  runner.run("xml_read_binary", [&]() {
+    if (!file_exists(fname + ".bin"))
+      xml_write_to_file(fname, t, FILE_TYPE_BINARY, 0, verbosity);
+    xml_read_from_file(fname, t_read, verbosity);
+  });
+
+  unlink(fname.c_str());
+  unlink((fname + ".bin").c_str());
+}
+
+//! Common setup of a 1D clear-sky atmosphere with an O3 line.
+static const char* const setup_1d =
+    "INCLUDE \"general/general.arts\"\n"
+    "INCLUDE \"general/continua.arts\"\n"
+    "INCLUDE \"general/agendas.arts\"\n"
+    "INCLUDE \"general/agendasDOIT.arts\"\n"
+    "INCLUDE \"general/planet_earth.arts\"\n"
+    "Copy( abs_xsec_agenda, abs_xsec_agenda__noCIA )\n"
+    "Copy( ppath_agenda, ppath_agenda__FollowSensorLosPath )\n"
+    "Copy( refr_index_air_agenda, refr_index_air_agenda__GasMicrowavesEarth )\n"
+    "IndexSet( stokes_dim, 1 )\n"
+    "VectorNLinSpace( f_grid, 1000, 110.3e9, 111.3e9 )\n"
+    "abs_speciesSet( species=[ \"O3\", \"H2O\" ] )\n"
+    "AtmosphereSet1D\n"
+    "VectorNLogSpace( p_grid, 100, 1.013e5, 1 )\n"
+    "AtmRawRead( basename = \"testdata/tropical\" )\n"
+    "AtmFieldsCalc\n"
+    "MatrixSetConstant( z_surface, 1, 1, 0 )\n"
+    "ReadXML( abs_lines, \"testdata/ozone_line.xml\" )\n"
+    "abs_lines_per_speciesCreateFromLines\n"
+    "abs_cont_descriptionInit\n"
+    "AbsInputFromAtmFields\n"
+    "Touch( abs_nlte )\n"
+    "IndexSet( nlte_do, 0 )\n"
+    "ArrayOfIndexSet( abs_species_active, [0, 1] )\n"
+    "abs_speciesSet( abs_species=abs_nls, species=[] )\n"
+    "VectorSet( abs_nls_pert, [] )\n"
+    "VectorLinSpace( abs_t_pert, -60, 60, 20 )\n"
+    "abs_xsec_agenda_checkedCalc\n"
+    "jacobianOff\n"
+    "abs_lookupCalc\n"
+    "cloudboxOff\n"
+    "atmfields_checkedCalc\n"
+    "atmgeom_checkedCalc\n"
+    "cloudbox_checkedCalc\n";
+
+//! The 1D atmosphere expanded to 3D.
+static const char* const setup_3d =
+    "AtmosphereSet3D\n"
+    "VectorLinSpace( lat_grid, -40, 40, 2 )\n"
+    "VectorLinSpace( lon_grid, -40, 40, 2 )\n"
+    "AtmFieldsCalcExpand1D\n"
+    "nelemGet( nelem, lat_grid )\n"
+    "IndexCreate( nlon )\n"
+    "nelemGet( nlon, lon_grid )\n"
+    "MatrixSetConstant( z_surface, nelem, nlon, 0 )\n"
+    "atmfields_checkedCalc\n"
+    "atmgeom_checkedCalc\n"
+    "cloudbox_checkedCalc\n";
+
+//! Line-by-line cross sections, look-up table extraction and paths.
+void bench_workspace(BenchRunner& runner,
+                     const String& tmpdir,
+                     const Verbosity& verbosity) {
+  const ArrayOfString names_1d{"xsec_species",
+                               "abs_lookup_extract",
+                               "ppath_1d_geometric",
+                               "ppath_1d_refraction",
+                               "doit_scat_integral"};
+  const ArrayOfString names_3d{"ppath_3d_geometric",
+                               "ppath_3d_geometric_analytic",
+                               "ppath_3d_refraction"};
+
+  if (!runner.any_selected(names_1d) && !runner.any_selected(names_3d))
+    return;
+
+  BenchWorkspace bws(tmpdir, verbosity);
+  bws.execute(setup_1d);
+
+  // Cross sections of 1000 synthetic lines, copies of the O3 line
+  // distributed over the frequency grid
+  if (runner.selected("xsec_species")) {
+    ArrayOfArrayOfLineRecord& lines =
+        bws.get<ArrayOfArrayOfLineRecord>("abs_lines_per_species");
+    const LineRecord line = lines[0][0];
+    const Vector& f_grid = bws.get<Vector>("f_grid");
+    const Index nl = 1000;
+    lines[0].resize(nl);
+    for (Index il = 0; il < nl; il++) {
+      lines[0][il] = line;
+      lines[0][il].setF(f_grid[0] + (f_grid[f_grid.nelem() - 1] - f_grid[0]) *
+                                        (Numeric)il / (Numeric)(nl - 1));
+    }
+
+    const Agenda xsec = bws.parse(
+        "abs_xsec_per_speciesInit\n"
+        "abs_xsec_per_speciesAddLines\n");
+    runner.run("xsec_species", [&]() { bws.execute(xsec); });
+  }
+
+  // Extraction of the absorption at all pressure levels
+  if (runner.selected("abs_lookup_extract")) {
+    const GasAbsLookup& abs_lookup = bws.get<GasAbsLookup>("abs_lookup");
+    const Vector& abs_p = bws.get<Vector>("abs_p");
+    const Vector& abs_t = bws.get<Vector>("abs_t");
+    const Matrix& abs_vmrs = bws.get<Matrix>("abs_vmrs");
+    const Vector& f_grid = bws.get<Vector>("f_grid");
+    Matrix sga;
+    runner.run("abs_lookup_extract", [&]() {
+      for (Index ip = 0; ip < abs_p.nelem(); ip++)
+        abs_lookup.Extract(sga,
+                           5,
+                           5,
+                           5,
+                           0,
+                           abs_p[ip],
+                           abs_t[ip] + 10,
+                           abs_vmrs(joker, ip),
+                           f_grid,
+                           0.5);
+    });
+  }
+
+  // Limb paths with a tangent altitude of about 20 km
+  const Agenda ppath = bws.parse("ppathCalc\n");
+  const String limb_1d =
+      "VectorSet( rte_pos, [600e3] )\n"
+      "VectorSet( rte_los, [113.2] )\n"
+      "VectorSet( rte_pos2, [] )\n";
+  const String geometric =
+      "Copy( ppath_step_agenda, ppath_step_agenda__GeometricPath )\n";
+  const String refraction =
+      "Copy( ppath_step_agenda, ppath_step_agenda__RefractedPath )\n";
+
+  if (runner.selected("ppath_1d_geometric")) {
+    bws.execute(limb_1d + geometric);
+    runner.run("ppath_1d_geometric", [&]() { bws.execute(ppath); });
+  }
+  if (runner.selected("ppath_1d_refraction")) {
+    bws.execute(limb_1d + refraction);
+    runner.run("ppath_1d_refraction", [&]() { bws.execute(ppath); });
+  }
+
+  // Scattering integral of DOIT in a 1D cloudbox of 20 levels
+  if (runner.selected("doit_scat_integral")) {
+    const Index np = 20, nza = 19, naa = 19, stokes_dim = 4;
+    Vector za_grid, aa_grid;
+    nlinspace(za_grid, 0, 180, nza);
+    nlinspace(aa_grid, 0, 360, naa);
+    const ArrayOfIndex cloudbox_limits{0, np - 1};
+
+    Tensor7 pha_mat_doit(np, nza, 1, nza, naa, stokes_dim, stokes_dim);
+    Tensor6 doit_i_field_mono(np, 1, 1, nza, 1, stokes_dim);
+    Tensor6 doit_scat_field(np, 1, 1, nza, 1, stokes_dim, 0);
+    for (Index ip = 0; ip < np; ip++)
+      for (Index iza = 0; iza < nza; iza++) {
+        for (Index i = 0; i < stokes_dim; i++)
+          doit_i_field_mono(ip, 0, 0, iza, 0, i) =
+              100 * cos(DEG2RAD * za_grid[iza]) / (Numeric)(i + 1);
+        for (Index jza = 0; jza < nza; jza++)
+          for (Index jaa = 0; jaa < naa; jaa++)
+            for (Index i = 0; i < stokes_dim; i++)
+              for (Index j = 0; j < stokes_dim; j++)
+                pha_mat_doit(ip, iza, 0, jza, jaa, i, j) =
+                    (i == j ? 1e-3 : 1e-5) *
+                    (1 + cos(DEG2RAD * (za_grid[iza] - za_grid[jza])));
+      }
+
+    const Agenda& pha_mat_spt_agenda = bws.get<Agenda>("pha_mat_spt_agenda");
+    const Tensor4 pnd_field(1, np, 1, 1, 1);
+    const Tensor3& t_field = bws.get<Tensor3>("t_field");
+    runner.run("doit_scat_integral", [&]() {
+      doit_scat_fieldCalc(bws.ws(),
+                          doit_scat_field,
+                          pha_mat_spt_agenda,
+                          doit_i_field_mono,
+                          pnd_field,
+                          t_field,
+                          1,
+                          cloudbox_limits,
+                          za_grid,
+                          aa_grid,
+                          nza,
+                          pha_mat_doit,
+                          verbosity);
+    });
+  }
+
+  if (!runner.any_selected(names_3d)) return;
+
+  bws.execute(setup_3d);
+
+  const String limb_3d =
+      "VectorSet( rte_pos, [600e3, 0, 0] )\n"
+      "VectorSet( rte_los, [113.2, 45] )\n"
+      "VectorSet( rte_pos2, [] )\n";
+
+  if (runner.selected("ppath_3d_geometric")) {
+    bws.execute(limb_3d + geometric);
+    runner.run("ppath_3d_geometric", [&]() { bws.execute(ppath); });
+  }
+  if (runner.selected("ppath_3d_geometric_analytic")) {
+    bws.execute(limb_3d +
+                "AgendaSet( ppath_step_agenda ){\n"
+                "  Ignore( t_field )\n"
+                "  Ignore( vmr_field )\n"
+                "  Ignore( f_grid )\n"
+                "  Ignore( ppath_lraytrace )\n"
+                "  ppath_stepGeometric( analytic=1 )\n"
+                "}\n");
+    runner.run("ppath_3d_geometric_analytic",
+               [&]() { bws.execute(ppath); });
+  }
+  if (runner.selected("ppath_3d_refraction")) {
+    bws.execute(limb_3d + refraction);
+    runner.run("ppath_3d_refraction", [&]() { bws.execute(ppath); });
+  }
+}
+
+//! Write the results as JSON.
+void write_json(const String& filename,
+                const Array<BenchResult>& results,
+                Numeric min_time) {
+  std::ofstream os(filename.c_str());
+  os << "{\n"
+     << "  \"version\": \"" << ARTS_FULL_VERSION << "\",\n"
+     << "  \"threads\": " << arts_omp_get_max_threads() << ",\n"
+     << "  \"min_time\": " << min_time << ",\n"
+     << "  \"benchmarks\": [\n"
+     << std::scientific << std::setprecision(6);
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult& r = results[i];
+    os << "    {\"name\": \"" << r.name << "\", \"iterations\": "
+       << r.iterations << ", \"min\": " << r.min
+       << ", \"median\": " << r.median << ", \"mean\": " << r.mean << "}"
+       << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  os << "  ]\n}\n";
+  if (!os) throw runtime_error("Cannot write file " + filename);
+}
+
+//! Read the median times of a JSON file written by write_json.
+std::map<String, Numeric> read_json_medians(const String& filename) {
+  std::ifstream is(filename.c_str());
+  if (!is) throw runtime_error("Cannot read file " + filename);
+  std::ostringstream ss;
+  ss << is.rdbuf();
+  const String s = ss.str();
+
+  std::map<String, Numeric> medians;
+  const String name_key = "\"name\": \"";
+  const String median_key = "\"median\": ";
+  for (size_t pos = s.find(name_key); pos != std::string::npos;
+       pos = s.find(name_key, pos)) {
+    pos += name_key.size();
+    const size_t end = s.find('"', pos);
+    const size_t mpos = s.find(median_key, end);
+    if (end == std::string::npos || mpos == std::string::npos)
+      throw runtime_error("Malformed benchmark file " + filename);
+    medians[s.substr(pos, end - pos)] =
+        strtod(s.c_str() + mpos + median_key.size(), NULL);
+    pos = mpos;
+  }
+  return medians;
+}
+
+//! Compare the results to a baseline, returns the number of regressions.
+Index compare(const Array<BenchResult>& results,
+              const String& baseline,
+              Numeric tolerance) {
+  const std::map<String, Numeric> medians = read_json_medians(baseline);
+
+  cout << "\nComparison to " << baseline << " (tolerance " << tolerance
+       << "):\n";
+  Index nregress = 0;
+  for (const auto& r : results) {
+    auto it = medians.find(r.name);
+    cout << std::left << std::setw(32) << r.name << std::right;
+    if (it == medians.end() || it->second <= 0) {
+      cout << "  no baseline\n";
+      continue;
+    }
+    const Numeric ratio = r.median / it->second;
+    cout << std::fixed << std::setprecision(3) << std::setw(10) << ratio
+         << std::defaultfloat;
+    if (ratio > 1 + tolerance) {
+      cout << "  REGRESSION";
+      nregress++;
+    } else if (ratio < 1 - tolerance) {
+      cout << "  improved";
+    }
+    cout << "\n";
+  }
+  return nregress;
+}
+
+void usage(const char* name) {
+  cerr << "Usage: " << name
+       << " [-f filter] [-m min_time] [-o results.json]\n"
+       << "       [-c baseline.json] [-t tolerance]\n";
+}
+
+int main(int argc, char** argv) {
+  String filter, output, baseline;
+  Numeric min_time = 0.5;
+  Numeric tolerance = 0.1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "f:m:o:c:t:h")) != -1) {
+    switch (opt) {
+      case 'f':
+        filter = optarg;
+        break;
+      case 'm':
+        min_time = strtod(optarg, NULL);
+        break;
+      case 'o':
+        output = optarg;
+        break;
+      case 'c':
+        baseline = optarg;
+        break;
+      case 't':
+        tolerance = strtod(optarg, NULL);
+        break;
+      default:
+        usage(argv[0]);
+        return opt == 'h' ? EXIT_SUCCESS : 2;
+    }
+  }
+
+  define_wsv_group_names();
+  Workspace::define_wsv_data();
+  Workspace::define_wsv_map();
+  define_md_data_raw();
+  expand_md_data_raw_to_md_data();
+  define_md_map();
+  define_md_raw_map();
+  define_agenda_data();
+  define_agenda_map();
+  define_species_data();
+  define_species_map();
+  define_lineshape_data();
+  define_lineshape_norm_data();
+
+#ifdef ARTS_DEFAULT_INCLUDE_DIR
+  parameters.includepath.push_back(ARTS_DEFAULT_INCLUDE_DIR);
+#endif
+
+  // Silent, also after verbosityInit in the included controlfiles
+  Verbosity verbosity(0, 0, 0);
+  verbosity_at_launch = verbosity;
+  verbosity.set_main_agenda(true);
+
+  String tmpdir = "/tmp/arts_bench_XXXXXX";
+  if (!mkdtemp(&tmpdir[0])) {
+    cerr << "Cannot create temporary directory " << tmpdir << "\n";
+    return 2;
+  }
+
+  BenchRunner runner(filter, min_time);
+  int status = EXIT_SUCCESS;
+  try {
+    bench_lineshapes(runner);
+    bench_transmission(runner);
+    bench_sensor(runner);
+    bench_xml(runner, tmpdir);
+    bench_workspace(runner, tmpdir, verbosity);
+
+    if (output.nelem()) write_json(output, runner.results(), min_time);
+    if (baseline.nelem() && compare(runner.results(), baseline, tolerance))
+      status = 1;
+  } catch (const std::exception& x) {
+    cerr << x.what() << "\n";
+    status = 2;
+  }
+
+  rmdir(tmpdir.c_str());
+  return status;
+}
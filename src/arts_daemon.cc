@@ -0,0 +1,351 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   arts_daemon.cc
+
+  \brief  Implementation of the arts execution daemon.
+*/
+
+#include "arts_daemon.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include "auto_md.h"
+#include "parser.h"
+#include "wsv_aux.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+//! Read exactly n bytes from the socket.
+static void read_bytes(int fd, char* buf, size_t n) {
+  while (n) {
+    ssize_t r = recv(fd, buf, n, 0);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) throw runtime_error("Connection closed by client.");
+    buf += r;
+    n -= static_cast<size_t>(r);
+  }
+}
+
+//! Write exactly n bytes to the socket.
+static void write_bytes(int fd, const char* buf, size_t n) {
+  while (n) {
+    ssize_t r = send(fd, buf, n, MSG_NOSIGNAL);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) throw runtime_error("Connection closed by client.");
+    buf += r;
+    n -= static_cast<size_t>(r);
+  }
+}
+
+//! Collect the outputs of all methods of an agenda, and of the agendas they call.
+static void collect_outputs(Workspace& ws,
+                            const Agenda& agenda,
+                            std::set<Index>& outputs,
+                            std::set<const Agenda*>& visited) {
+  if (!visited.insert(&agenda).second) return;
+
+  for (const auto& method : agenda.Methods()) {
+    outputs.insert(method.Out().begin(), method.Out().end());
+
+    // Agenda definitions, e.g. by AgendaSet
+    collect_outputs(ws, method.Tasks(), outputs, visited);
+
+    // Agendas executed by the method
+    for (const auto& i : method.In()) {
+      const Index group = Workspace::wsv_data[i].Group();
+      if (!is_agenda_group_id(group) || !ws.is_initialized(i)) continue;
+      if (group == get_wsv_group_id("Agenda")) {
+        collect_outputs(
+            ws, *static_cast<Agenda*>(ws[i]), outputs, visited);
+      } else {
+        for (const auto& a : *static_cast<ArrayOfAgenda*>(ws[i]))
+          collect_outputs(ws, a, outputs, visited);
+      }
+    }
+  }
+}
+
+static uint64_t read_integer(int fd) {
+  uint64_t i;
+  read_bytes(fd, reinterpret_cast<char*>(&i), sizeof(i));
+  return i;
+}
+
+static void write_integer(int fd, uint64_t i) {
+  write_bytes(fd, reinterpret_cast<const char*>(&i), sizeof(i));
+}
+
+//! Longest string accepted in a request.
+static const uint64_t max_string_length = uint64_t(1) << 30;
+
+//! Largest number of input or output variables accepted in a request.
+static const uint64_t max_variables = uint64_t(1) << 16;
+
+static String read_string(int fd) {
+  const uint64_t n = read_integer(fd);
+  if (n > max_string_length) {
+    ostringstream os;
+    os << "Request contains a string of " << n << " bytes, the maximum is "
+       << max_string_length << ".";
+    throw runtime_error(os.str());
+  }
+  String s(n, '\0');
+  if (s.size()) read_bytes(fd, &s[0], s.size());
+  return s;
+}
+
+static uint64_t read_count(int fd) {
+  const uint64_t n = read_integer(fd);
+  if (n > max_variables) {
+    ostringstream os;
+    os << "Request contains " << n << " variables, the maximum is "
+       << max_variables << ".";
+    throw runtime_error(os.str());
+  }
+  return n;
+}
+
+static void write_string(int fd, const String& s) {
+  write_integer(fd, s.size());
+  write_bytes(fd, s.data(), s.size());
+}
+
+static String read_file(const String& name) {
+  std::ifstream is(name.c_str(), std::ios::binary);
+  std::ostringstream os;
+  os << is.rdbuf();
+  return os.str();
+}
+
+static void write_file(const String& name, const String& content) {
+  std::ofstream os(name.c_str(), std::ios::binary);
+  os.write(content.data(), static_cast<std::streamsize>(content.size()));
+  if (!os) throw runtime_error("Cannot write file " + name);
+}
+
+//! Check that the names refer to existing workspace variables.
+static void check_variable_names(const ArrayOfString& names) {
+  for (const auto& name : names) {
+    if (Workspace::WsvMap.find(name) == Workspace::WsvMap.end()) {
+      throw runtime_error("Unknown workspace variable: " + name);
+    }
+  }
+}
+
+ArtsDaemon::ArtsDaemon(Workspace& ws,
+                       const String& socket_path,
+                       const Verbosity& rverbosity)
+    : mws(ws), msocket(socket_path), verbosity(rverbosity), mfd(-1) {
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (msocket.size() >= sizeof(addr.sun_path)) {
+    throw runtime_error("Socket path is too long: " + msocket);
+  }
+  strncpy(addr.sun_path, msocket.c_str(), sizeof(addr.sun_path) - 1);
+
+  const char* tmp = getenv("TMPDIR");
+  String tmpdir = String(tmp ? tmp : "/tmp") + "/arts_daemon_XXXXXX";
+  if (!mkdtemp(&tmpdir[0])) {
+    throw runtime_error("Cannot create temporary directory " + tmpdir);
+  }
+  mtmpdir = tmpdir;
+
+  // Only the user running the daemon may connect to the socket.
+  // A stale socket from an earlier daemon is replaced, anything else at
+  // the socket path is left alone.
+  struct stat st;
+  if (lstat(msocket.c_str(), &st) == 0) {
+    if (!S_ISSOCK(st.st_mode)) {
+      rmdir(mtmpdir.c_str());
+      throw runtime_error("Socket path exists and is not a socket: " +
+                          msocket);
+    }
+    unlink(msocket.c_str());
+  }
+
+  mfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  const mode_t old_umask = umask(0177);
+  const int bound = mfd < 0 ? -1 : bind(mfd, (sockaddr*)&addr, sizeof(addr));
+  umask(old_umask);
+  if (bound < 0 || chmod(msocket.c_str(), S_IRUSR | S_IWUSR) < 0 ||
+      listen(mfd, 16) < 0) {
+    ostringstream os;
+    os << "Cannot listen on socket " << msocket << ": " << strerror(errno);
+    if (mfd >= 0) close(mfd);
+    rmdir(mtmpdir.c_str());
+    throw runtime_error(os.str());
+  }
+}
+
+ArtsDaemon::~ArtsDaemon() {
+  close(mfd);
+  unlink(msocket.c_str());
+  rmdir(mtmpdir.c_str());
+}
+
+String ArtsDaemon::file_name(const String& prefix, Index i) const {
+  ostringstream os;
+  os << mtmpdir << "/" << prefix << "_" << i << ".xml";
+  return os.str();
+}
+
+void ArtsDaemon::serve() {
+  CREATE_OUT1;
+
+  out1 << "Waiting for requests on " << msocket << "\n";
+
+  bool running = true;
+  while (running) {
+    int fd = accept(mfd, NULL, NULL);
+    if (fd < 0) {
+      if (errno == EINTR) continue;
+      ostringstream os;
+      os << "Error accepting connection: " << strerror(errno);
+      throw runtime_error(os.str());
+    }
+
+    try {
+      running = handle_request(fd);
+    } catch (const std::runtime_error& x) {
+      // A broken connection only affects the current request.
+      out1 << x.what() << "\n";
+    }
+    close(fd);
+  }
+
+  out1 << "Daemon shut down.\n";
+}
+
+bool ArtsDaemon::handle_request(int fd) {
+  const String body = read_string(fd);
+  if (body.empty()) return false;
+
+  ArrayOfString in_names(read_count(fd));
+  for (size_t i = 0; i < in_names.size(); i++) {
+    in_names[i] = read_string(fd);
+    String xml = read_string(fd);
+    String bin = read_string(fd);
+    write_file(file_name("in", i), xml);
+    if (bin.size()) write_file(file_name("in", i) + ".bin", bin);
+  }
+
+  ArrayOfString out_names(read_count(fd));
+  for (auto& name : out_names) name = read_string(fd);
+
+  String error;
+  try {
+    execute(body, in_names, out_names);
+  } catch (const std::exception& x) {
+    error = x.what();
+  }
+
+  ArrayOfString files;
+  for (size_t i = 0; i < in_names.size(); i++) {
+    files.push_back(file_name("in", i));
+    files.push_back(file_name("in", i) + ".bin");
+  }
+  for (size_t i = 0; i < out_names.size(); i++) {
+    files.push_back(file_name("out", i));
+    files.push_back(file_name("out", i) + ".bin");
+  }
+
+  if (error.empty()) {
+    write_integer(fd, 0);
+    for (size_t i = 0; i < out_names.size(); i++) {
+      write_string(fd, read_file(file_name("out", i)));
+      write_string(fd, read_file(file_name("out", i) + ".bin"));
+    }
+  } else {
+    write_integer(fd, 1);
+    write_string(fd, error);
+  }
+
+  for (const auto& f : files) unlink(f.c_str());
+  unlink((mtmpdir + "/request.arts").c_str());
+
+  return true;
+}
+
+void ArtsDaemon::execute(const String& body,
+                         const ArrayOfString& in_names,
+                         const ArrayOfString& out_names) {
+  CREATE_OUT2;
+
+  check_variable_names(in_names);
+  check_variable_names(out_names);
+
+  // Wrap the request into a controlfile that reads the inputs and writes
+  // the outputs, so the parser takes care of the variable groups.
+  ostringstream cf;
+  cf << "Arts2 {\n";
+  for (size_t i = 0; i < in_names.size(); i++) {
+    cf << "ReadXML(" << in_names[i] << ", \"" << file_name("in", i)
+       << "\")\n";
+  }
+  cf << body << "\n";
+  for (size_t i = 0; i < out_names.size(); i++) {
+    cf << "WriteXML(\"binary\", " << out_names[i] << ", \""
+       << file_name("out", i) << "\")\n";
+  }
+  cf << "}\n";
+
+  const String cfname = mtmpdir + "/request.arts";
+  write_file(cfname, cf.str());
+
+  Agenda tasklist;
+  ArtsParser arts_parser(tasklist, cfname, verbosity);
+  arts_parser.parse_tasklist();
+  tasklist.set_name("Arts");
+  tasklist.set_main_agenda();
+
+  // The parser may have created new variables.
+  mws.initialize();
+
+  // Work on copies of everything the request modifies, including the
+  // variables set inside the agendas it executes.
+  std::set<Index> outputs;
+  std::set<const Agenda*> visited;
+  collect_outputs(mws, tasklist, outputs, visited);
+  for (const auto& i : outputs) mws.duplicate(i);
+
+  String error;
+  try {
+    Arts2(mws, tasklist, verbosity);
+  } catch (const std::exception& x) {
+    error = x.what();
+  }
+
+  for (const auto& i : outputs) mws.pop_free(i);
+
+  if (error.size()) throw runtime_error(error);
+
+  out2 << "Request executed.\n";
+}
@@ -0,0 +1,90 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   arts_daemon.h
+
+  \brief  Declarations for the arts execution daemon.
+
+  The daemon keeps the workspace of an already executed setup controlfile
+  in memory and executes small requests against it, which are received on
+  a Unix domain socket.
+
+  All integers are unsigned 64 bit in native byte order, strings are sent
+  as their length followed by the characters. A request consists of:
+
+  - String: The body of an Arts2 block, i.e. the methods to execute. An
+    empty body shuts the daemon down.
+  - Integer n_in followed by n_in times
+    - String: The name of the input variable.
+    - String: The content of its XML file.
+    - String: The content of its binary data file, empty for ascii XML.
+  - Integer n_out followed by n_out times
+    - String: The name of the output variable.
+
+  Strings longer than 1 GiB and more than 65536 input or output variables
+  are rejected, and the connection is then closed. The socket is only
+  accessible by the user running the daemon.
+
+  The input variables are read before the body is executed, the output
+  variables are written in binary format afterwards. The response
+  consists of an integer status. If it is 0, the XML file and the binary
+  data file of each output variable follow as two strings. Otherwise the
+  error message follows as a single string.
+
+  All variables that are modified by a request, also inside the agendas it
+  executes, are duplicated before and restored after the execution, so
+  every request sees the workspace as it was left by the setup
+  controlfile.
+
+  A socket left at the socket path by an earlier daemon is replaced. If
+  the path exists and is not a socket, the daemon refuses to start.
+*/
+
+#ifndef arts_daemon_h
+#define arts_daemon_h
+
+#include "agenda_class.h"
+#include "messages.h"
+#include "workspace_ng.h"
+
+class ArtsDaemon {
+ public:
+  ArtsDaemon(Workspace& ws, const String& socket, const Verbosity& verbosity);
+
+  ~ArtsDaemon();
+
+  //! Accept and execute requests until a shutdown request is received.
+  void serve();
+
+ private:
+  bool handle_request(int fd);
+
+  void execute(const String& body,
+               const ArrayOfString& in_names,
+               const ArrayOfString& out_names);
+
+  String file_name(const String& prefix, Index i) const;
+
+  Workspace& mws;
+  String msocket;
+  String mtmpdir;
+  Verbosity verbosity;
+  int mfd;
+};
+
+#endif /* arts_daemon_h */
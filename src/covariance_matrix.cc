@@ -29,9 +29,107 @@
 #include <utility>
 #include <vector>
 
+#include "Eigen/SparseCholesky"
 #include "covariance_matrix.h"
 #include "lapack.h"
 
+//------------------------------------------------------------------------------
+// Factorization of correlated blocks
+//------------------------------------------------------------------------------
+/*! Cholesky factorization of a group of correlated blocks.
+ *
+ * The diagonal blocks of the group are mapped onto a continuous square matrix,
+ * in order of increasing block index. The factorization is sparse if all
+ * blocks of the group are sparse, dense otherwise.
+ */
+class CovarianceMatrixFactor {
+ public:
+  /*! Block indices of the diagonal blocks covered by the factorization. */
+  std::vector<Index> block_indices;
+  /*! Element ranges of the diagonal blocks in the covariance matrix. */
+  std::vector<Range> ranges;
+  /*! Element ranges of the diagonal blocks in the continuous matrix. */
+  std::vector<Range> ranges_cont;
+  /*! Size of the continuous matrix. */
+  Index n = 0;
+
+  bool is_sparse = false;
+  /*! Dense factor, as given by dpotrf. */
+  Matrix dense_factor;
+  /*! Sparse factor. */
+  Eigen::SimplicialLLT<Eigen::SparseMatrix<Numeric>, Eigen::Upper> sparse_factor;
+
+  /*! Solve S X = B for a number of right-hand sides.
+   *
+   * @param[in,out] bt On input the right-hand sides B stored as rows, on output
+   *        the solutions stored in the same way. Must have n columns.
+   */
+  void solve(Matrix &bt) const {
+    assert(bt.ncols() == n);
+    if (bt.nrows() == 0) return;
+
+    // A row-major matrix of right-hand sides is a column-major matrix with
+    // one right-hand side per column.
+    if (is_sparse) {
+      Eigen::Map<Eigen::Matrix<Numeric, Eigen::Dynamic, Eigen::Dynamic>> b(
+          bt.get_raw_data(), n, bt.nrows());
+      b = sparse_factor.solve(b);
+    } else {
+      char uplo = 'L';
+      int ni = static_cast<int>(n);
+      int nrhs = static_cast<int>(bt.nrows());
+      int info = 0;
+      lapack::dpotrs_(&uplo,
+                      &ni,
+                      &nrhs,
+                      const_cast<Numeric *>(dense_factor.get_c_array()),
+                      &ni,
+                      bt.get_raw_data(),
+                      &ni,
+                      &info);
+      assert(info == 0);
+    }
+  }
+
+  /*! Gather the rows of the blocks of the group from a vector. */
+  void gather(MatrixView bt, Index row, ConstVectorView v) const {
+    for (size_t k = 0; k < ranges.size(); ++k) {
+      bt(row, ranges_cont[k]) = v[ranges[k]];
+    }
+  }
+
+  /*! Scatter a solution back to the element positions of the group. */
+  void scatter(VectorView v, ConstMatrixView bt, Index row) const {
+    for (size_t k = 0; k < ranges.size(); ++k) {
+      v[ranges[k]] = bt(row, ranges_cont[k]);
+    }
+  }
+
+  /*! Compute columns [c0, c0 + nc) of the inverse, stored as rows of bt. */
+  void inverse_columns(Matrix &bt, Index c0, Index nc) const {
+    bt.resize(nc, n);
+    bt = 0.0;
+    for (Index i = 0; i < nc; ++i) bt(i, c0 + i) = 1.0;
+    solve(bt);
+  }
+
+  /*! Element index in the covariance matrix of an index in the continuous
+   *  matrix. */
+  Index element_index(Index i) const {
+    for (size_t k = 0; k < ranges.size(); ++k) {
+      const Index offset = i - ranges_cont[k].get_start();
+      if (offset >= 0 && offset < ranges_cont[k].get_extent())
+        return ranges[k].get_start() + offset;
+    }
+    assert(false);
+    return -1;
+  }
+};
+
+/*! Number of inverse columns computed at once when the inverse is needed
+ *  element-wise. Limits the memory used to this many rows of the group. */
+static const Index inverse_chunk_size = 64;
+
 //------------------------------------------------------------------------------
 // Correlations
 //------------------------------------------------------------------------------
@@ -173,26 +271,7 @@ Matrix CovarianceMatrix::get_inverse() const {
   Index n = nrows();
   Matrix A(n, n);
   A = 0.0;
-
-  for (const Block &c : inverses_) {
-    MatrixView Aview = A(c.get_row_range(), c.get_column_range());
-    if (c.get_matrix_type() == Block::MatrixType::dense) {
-      Aview = c.get_dense();
-    } else {
-      Aview = c.get_sparse();
-    }
-
-    Index ci, cj;
-    std::tie(ci, cj) = c.get_indices();
-    if (ci != cj) {
-      MatrixView ATview = A(c.get_column_range(), c.get_row_range());
-      if (c.get_matrix_type() == Block::MatrixType::dense) {
-        ATview = transpose(c.get_dense());
-      } else {
-        ATview = transpose(static_cast<Matrix>(c.get_sparse()));
-      }
-    }
-  }
+  add_inv(A, *this);
   return A;
 }
 
@@ -388,16 +467,56 @@ void CovarianceMatrix::generate_blocks(
   }
 }
 
+bool CovarianceMatrix::has_factor(Index i) const {
+  for (const auto &f : factors_) {
+    for (Index bi : f->block_indices) {
+      if (bi == i) return true;
+    }
+  }
+  return false;
+}
+
 void CovarianceMatrix::compute_inverse() const {
   std::vector<std::vector<const Block *>> correlation_blocks{};
   generate_blocks(correlation_blocks);
   for (std::vector<const Block *> &cb : correlation_blocks) {
-    invert_correlation_block(inverses_, cb);
+    factorize_correlation_block(cb);
+  }
+}
+
+void CovarianceMatrix::store_inverse() const {
+  Matrix bt;
+  for (const auto &f : factors_) {
+    Matrix A(f->n, f->n);
+    for (Index c0 = 0; c0 < f->n; c0 += inverse_chunk_size) {
+      const Index nc = std::min(inverse_chunk_size, f->n - c0);
+      f->inverse_columns(bt, c0, nc);
+      A(Range(c0, nc), joker) = bt;
+    }
+
+    // Note that blocks that are implicitly zero in the covariance matrix
+    // are in general non-zero in its inverse.
+    const Index nb = static_cast<Index>(f->block_indices.size());
+    for (Index k = 0; k < nb; ++k) {
+      for (Index l = 0; l < nb; ++l) {
+        const Index bi = f->block_indices[k];
+        const Index bj = f->block_indices[l];
+        if (bi <= bj) {
+          inverses_.push_back(
+              Block(f->ranges[k],
+                    f->ranges[l],
+                    std::make_pair(bi, bj),
+                    std::make_shared<Matrix>(
+                        A(f->ranges_cont[k], f->ranges_cont[l]))));
+        }
+      }
+    }
   }
+  factors_.clear();
 }
 
-void CovarianceMatrix::invert_correlation_block(
-    std::vector<Block> &inverses, std::vector<const Block *> &blocks) const {
+void CovarianceMatrix::factorize_correlation_block(
+    std::vector<const Block *> &blocks) const {
   // Can't compute inverse of empty block.
   assert(blocks.size() > 0);
 
@@ -415,22 +534,19 @@ void CovarianceMatrix::invert_correlation_block(
     return has_inverse(a->get_indices());
   };
   if (std::all_of(blocks.begin(), blocks.end(), block_has_inverse)) return;
+  if (has_factor(blocks.front()->get_indices().first)) return;
 
-  // Otherwise go on to precompute the inverse of a block consisting
-  // of correlations between multiple retrieval quantities.
+  // Otherwise go on to factorize the block consisting of correlations
+  // between multiple retrieval quantities.
 
   // The single blocks corresponding to a set of correlated retrieval quantities
   // can be distributed freely over the covariance matrix, so we need to establish
-  // a mapping to a continuous square matrix to compute the inverse. This is done by
-  // mapping the coordinates of each block to a start row and extent in the continuous
-  // matrix A. We also record which retrieval quantity indices belong to this
-  // set of retrieval quantities.
-  Index n = 0;
-  std::map<Index, Index> block_start{};
-  std::map<Index, Index> block_extent{};
-  std::map<Index, Index> block_start_cont{};
-  std::map<Index, Index> block_extent_cont{};
-  std::vector<Index> block_indices{};
+  // a mapping to a continuous square matrix. This is done by mapping the
+  // coordinates of each block to a start row and extent in the continuous
+  // matrix.
+  auto factor = std::make_shared<CovarianceMatrixFactor>();
+  std::map<Index, Range> range_cont{};
+  bool all_sparse = true;
 
   for (size_t i = 0; i < blocks.size(); ++i) {
     Index ci, cj;
@@ -438,76 +554,85 @@ void CovarianceMatrix::invert_correlation_block(
 
     if (ci == cj) {
       Index extent = blocks[i]->get_row_range().get_extent();
-      block_start.insert(
-          std::make_pair(ci, blocks[i]->get_row_range().get_start()));
-      block_extent.insert(
-          std::make_pair(ci, blocks[i]->get_row_range().get_extent()));
-      block_start_cont.insert(std::make_pair(ci, n));
-      block_extent_cont.insert(std::make_pair(ci, extent));
-      block_indices.push_back(ci);
-      n += extent;
+      factor->block_indices.push_back(ci);
+      factor->ranges.push_back(blocks[i]->get_row_range());
+      factor->ranges_cont.push_back(Range(factor->n, extent));
+      range_cont.insert(std::make_pair(ci, Range(factor->n, extent)));
+      factor->n += extent;
     }
+    all_sparse &=
+        blocks[i]->get_matrix_type() == Block::MatrixType::sparse;
   }
 
-  // Copy blocks into a single dense matrix.
-  Matrix A(n, n);
-  A = 0.0;
+  const Index n = factor->n;
+  factor->is_sparse = all_sparse;
 
-  for (size_t i = 0; i < blocks.size(); ++i) {
-    Index ci, cj;
-    std::tie(ci, cj) = blocks[i]->get_indices();
-    Range row_range(block_start_cont[ci], block_extent_cont[ci]);
-    Range column_range(block_start_cont[cj], block_extent_cont[cj]);
-    MatrixView A_view = A(row_range, column_range);
-
-    if (blocks[i]->get_matrix_type() == Block::MatrixType::dense) {
-      A_view = blocks[i]->get_dense();
-    } else {
-      A_view = blocks[i]->get_sparse();
-    }
-  }
-
-  for (Index i = 0; i < n; ++i) {
-    for (Index j = i + 1; j < n; ++j) {
-      A(j, i) = A(i, j);
-    }
-  }
-  inv(A, A);
-
-  // // Invert matrix using LAPACK.
-  // char uplo = 'L';
-  // int  ni, info1(0), info2(0);
-  // ni = static_cast<int>(n);
-  // lapack::dpotrf_(&uplo, &ni, A.get_raw_data(), &ni, &info1);
-  // lapack::dpotri_(&uplo, &ni, A.get_raw_data(), &ni, &info2);
-  // if ((info1 != 0) || info2 !=0) {
-  //     throw std::runtime_error("Error inverting block of covariance matrix."
-  //                              "Make sure that it is symmetric, positive definite"
-  //                              "or provide the inverse manually.");
-  // }
-
-  // Now we need to disassemble the matrix inverse bach to the separate block in the
-  // covariance matrix. Note, however, that blocks that previously were implicitly
-  // zero are now non-zero, i.e. the inverse may contain more blocks than the covariance
-  // matrix itself.
-  for (Index bi : block_indices) {
-    for (Index bj : block_indices) {
-      if (bi <= bj) {
-        Range row_range_A(block_start_cont[bi], block_extent_cont[bi]);
-        Range column_range_A(block_start_cont[bj], block_extent_cont[bj]);
-        Range row_range(block_start[bi], block_extent[bi]);
-        Range column_range(block_start[bj], block_extent[bj]);
-        MatrixView A_view = A(row_range_A, column_range_A);
-        inverses.push_back(Block(row_range,
-                                 column_range,
-                                 std::make_pair(bi, bj),
-                                 std::make_shared<Matrix>(A_view)));
+  // Only the upper triangle of the continuous matrix is needed. It is
+  // given by the blocks with ci < cj and the upper triangle of the diagonal
+  // blocks.
+  bool success = true;
+  if (all_sparse) {
+    std::vector<Eigen::Triplet<Numeric>> triplets;
+    for (const Block *b : blocks) {
+      Index ci, cj;
+      std::tie(ci, cj) = b->get_indices();
+      const Index r0 = range_cont.at(ci).get_start();
+      const Index c0 = range_cont.at(cj).get_start();
+
+      Vector values;
+      ArrayOfIndex row_indices, column_indices;
+      b->get_sparse().list_elements(values, row_indices, column_indices);
+      for (Index k = 0; k < values.nelem(); ++k) {
+        const Index r = r0 + row_indices[k];
+        const Index c = c0 + column_indices[k];
+        if (r <= c) {
+          triplets.emplace_back(static_cast<int>(r), static_cast<int>(c),
+                                values[k]);
+        }
       }
     }
+    Eigen::SparseMatrix<Numeric> A(n, n);
+    A.setFromTriplets(triplets.begin(), triplets.end());
+    factor->sparse_factor.compute(A);
+    success = factor->sparse_factor.info() == Eigen::Success;
+  } else {
+    Matrix &A = factor->dense_factor;
+    A.resize(n, n);
+    A = 0.0;
+    for (const Block *b : blocks) {
+      Index ci, cj;
+      std::tie(ci, cj) = b->get_indices();
+      MatrixView A_view = A(range_cont.at(ci), range_cont.at(cj));
+      if (b->get_matrix_type() == Block::MatrixType::dense) {
+        A_view = b->get_dense();
+      } else {
+        A_view = b->get_sparse();
+      }
+    }
+
+    // The upper triangle of a row-major matrix is the lower triangle in
+    // the column-major layout used by LAPACK.
+    char uplo = 'L';
+    int ni = static_cast<int>(n);
+    int info = 0;
+    lapack::dpotrf_(&uplo, &ni, A.get_raw_data(), &ni, &info);
+    success = info == 0;
   }
+
+  if (!success) {
+    throw std::runtime_error(
+        "Error factorizing block of covariance matrix. "
+        "Make sure that it is symmetric, positive definite "
+        "or provide the inverse manually.");
+  }
+
+  factors_.push_back(factor);
 }
 
-void CovarianceMatrix::add_correlation(Block c) { correlations_.push_back(c); }
+void CovarianceMatrix::add_correlation(Block c) {
+  correlations_.push_back(c);
+  factors_.clear();
+}
 
 void CovarianceMatrix::add_correlation_inverse(Block c) {
   inverses_.push_back(c);
@@ -538,6 +663,18 @@ Vector CovarianceMatrix::inverse_diagonal() const {
       diag[b.get_row_range()] = b.diagonal();
     }
   }
+
+  // Diagonal of factorized blocks, computed a chunk of columns at a time.
+  Matrix bt;
+  for (const auto &f : factors_) {
+    for (Index c0 = 0; c0 < f->n; c0 += inverse_chunk_size) {
+      const Index nc = std::min(inverse_chunk_size, f->n - c0);
+      f->inverse_columns(bt, c0, nc);
+      for (Index k = 0; k < nc; ++k) {
+        diag[f->element_index(c0 + k)] = bt(k, c0 + k);
+      }
+    }
+  }
   return diag;
 }
 
@@ -579,6 +716,20 @@ void mult_inv(MatrixView C, ConstMatrixView A, const CovarianceMatrix &B) {
     mult(T, A, c);
     C += T;
   }
+
+  // A * S^{-1} = (S^{-1} * A^T)^T, so the rows of A are the right-hand sides.
+  const Index m = A.nrows();
+  Matrix bt;
+  for (const auto &f : B.factors_) {
+    bt.resize(m, f->n);
+    for (size_t k = 0; k < f->ranges.size(); ++k) {
+      bt(joker, f->ranges_cont[k]) = A(joker, f->ranges[k]);
+    }
+    f->solve(bt);
+    for (size_t k = 0; k < f->ranges.size(); ++k) {
+      C(joker, f->ranges[k]) += bt(joker, f->ranges_cont[k]);
+    }
+  }
 }
 
 void mult_inv(MatrixView C, const CovarianceMatrix &A, ConstMatrixView B) {
@@ -589,6 +740,20 @@ void mult_inv(MatrixView C, const CovarianceMatrix &A, ConstMatrixView B) {
     mult(T, c, B);
     C += T;
   }
+
+  // The columns of B are the right-hand sides.
+  const Index m = B.ncols();
+  Matrix bt;
+  for (const auto &f : A.factors_) {
+    bt.resize(m, f->n);
+    for (size_t k = 0; k < f->ranges.size(); ++k) {
+      bt(joker, f->ranges_cont[k]) = transpose(B(f->ranges[k], joker));
+    }
+    f->solve(bt);
+    for (size_t k = 0; k < f->ranges.size(); ++k) {
+      C(f->ranges[k], joker) += transpose(bt(joker, f->ranges_cont[k]));
+    }
+  }
 }
 
 void solve(VectorView w, const CovarianceMatrix &A, ConstVectorView v) {
@@ -599,6 +764,14 @@ void solve(VectorView w, const CovarianceMatrix &A, ConstVectorView v) {
     mult(t, c, v);
     w += t;
   }
+
+  Matrix bt;
+  for (const auto &f : A.factors_) {
+    bt.resize(1, f->n);
+    f->gather(bt, 0, v);
+    f->solve(bt);
+    f->scatter(w, bt, 0);
+  }
 }
 
 MatrixView &operator+=(MatrixView &A, const CovarianceMatrix &B) {
@@ -612,6 +785,23 @@ void add_inv(MatrixView A, const CovarianceMatrix &B) {
   for (const Block &c : B.inverses_) {
     A += c;
   }
+
+  // Add the inverse of factorized blocks a chunk of columns at a time, so
+  // that it never has to be stored as a whole.
+  Matrix bt;
+  for (const auto &f : B.factors_) {
+    for (Index c0 = 0; c0 < f->n; c0 += inverse_chunk_size) {
+      const Index nc = std::min(inverse_chunk_size, f->n - c0);
+      f->inverse_columns(bt, c0, nc);
+      for (Index i = 0; i < nc; ++i) {
+        // Column c0 + i of the inverse, which by symmetry equals the row.
+        const Index col = f->element_index(c0 + i);
+        for (size_t k = 0; k < f->ranges.size(); ++k) {
+          A(f->ranges[k], col) += bt(i, f->ranges_cont[k]);
+        }
+      }
+    }
+  }
 }
 
 std::ostream &operator<<(std::ostream &os, const CovarianceMatrix &covmat) {
@@ -40,6 +40,7 @@
 #include "matpackII.h"
 
 class CovarianceMatrix;
+class CovarianceMatrixFactor;
 
 //------------------------------------------------------------------------------
 // Type Aliases
@@ -211,8 +212,12 @@ void add_inv(MatrixView A, const Block &);
  *
  * Computing inverses of covariance matrices is handled indirectly by providing
  * mult_inv methods that multiply the inverse of the covariance matrix by a given
- * vector or matrix. This, however, requires previously having computed the inverse
- * of the matrix using the compute_inverse method.
+ * vector or matrix. This, however, requires previously having called the
+ * compute_inverse method. Unless the inverse blocks have been provided by the
+ * user, this computes a Cholesky factorization of each group of correlated
+ * blocks, and the inverse is applied by solving with this factorization. The
+ * inverse itself is never formed explicitly, except if requested through
+ * get_inverse.
  */
 class CovarianceMatrix {
  public:
@@ -267,11 +272,17 @@ class CovarianceMatrix {
   std::vector<Block> &get_blocks() { return correlations_; };
 
   /** Blocks of the inverse covariance matrix.
+     *
+     * Inverses computed by compute_inverse are only held as factorizations
+     * and are here first stored as blocks, see store_inverse.
      *
      * @return Reference to the std::vector holding the blocks
      * objects of the inverse of the covariance matrix.
      */
-  std::vector<Block> &get_inverse_blocks() { return inverses_; };
+  std::vector<Block> &get_inverse_blocks() {
+    store_inverse();
+    return inverses_;
+  };
 
   /**
      * Checks that the covariance matrix contains one diagonal block per retrieval
@@ -316,9 +327,25 @@ class CovarianceMatrix {
      * Compute the inverse of this correlation matrix. This function must be executed
      * after all block have been added to the covariance matrix and before any of the
      * mult_inv or add_inv methods is used.
+     *
+     * Groups of correlated blocks without user-provided inverse are Cholesky
+     * factorized, using a sparse factorization if all blocks of the group are
+     * sparse and a dense one otherwise. An error is thrown if a group is not
+     * positive definite.
      */
   void compute_inverse() const;
 
+  /**
+     * Store the inverses computed by compute_inverse as blocks.
+     *
+     * The factorized groups of correlated blocks are inverted and the
+     * blocks of the inverses added to the inverse blocks, which are then
+     * used in place of the factorizations. This is needed to access or
+     * write out the inverse blocks, and is done by get_inverse_blocks and
+     * the XML output.
+     */
+  void store_inverse() const;
+
   /** Add block to covariance matrix.
      *
      * This function add a given block to the covariance matrix.
@@ -383,12 +410,13 @@ class CovarianceMatrix {
 
  private:
   void generate_blocks(std::vector<std::vector<const Block *>> &) const;
-  void invert_correlation_block(std::vector<Block> &inverses,
-                                std::vector<const Block *> &blocks) const;
+  void factorize_correlation_block(std::vector<const Block *> &blocks) const;
   bool has_inverse(IndexPair indices) const;
+  bool has_factor(Index i) const;
 
   std::vector<Block> correlations_;
   mutable std::vector<Block> inverses_;
+  mutable std::vector<std::shared_ptr<const CovarianceMatrixFactor>> factors_;
 };
 
 void mult(MatrixView, ConstMatrixView, const CovarianceMatrix &);
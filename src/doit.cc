@@ -37,6 +37,7 @@
 #include <stdexcept>
 #include "agenda_class.h"
 #include "array.h"
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "cloudbox.h"
@@ -847,327 +848,511 @@ void cloud_ppath_update1D_noseq(Workspace& ws,
   }  //end if inside cloudbox
 }
 
+//! Pressure levels of a sequential 3D update.
+/*!
+  Gives the pressure levels for which the radiation field is updated by
+  a 3D sweep for one zenith angle, in the order of the update. Uplooking
+  directions are updated from the top of the cloudbox downwards and
+  downlooking directions from the bottom upwards. The radiation field at
+  the level where the sweep starts is not updated. Limb directions, where
+  the path step can end at the level of the starting point, are updated
+  for all levels.
+
+  \param p_indices Pressure indices (not relative to the cloudbox).
+  \param za Zenith angle.
+  \param cloudbox_limits The cloudbox limits.
+  \param z_field The field of geometrical altitudes.
+  \param refellipsoid The reference ellipsoid.
+
+  \author Claudia Emde
+  \date 2003-06-04
+*/
+void cloud_sweep3D_levels(ArrayOfIndex& p_indices,
+                          const Numeric& za,
+                          const ArrayOfIndex& cloudbox_limits,
+                          ConstTensor3View z_field,
+                          ConstVectorView refellipsoid) {
+  const Index p_low = cloudbox_limits[0];
+  const Index p_up = cloudbox_limits[1];
+
+  const Numeric theta_lim =
+      180. - asin((refellipsoid[0] + z_field(p_low, 0, 0)) /
+                  (refellipsoid[0] + z_field(p_up, 0, 0))) *
+                 RAD2DEG;
+
+  p_indices.resize(0);
+
+  // Uplooking, start at the upper boundary
+  if (za <= 90.) {
+    for (Index p_index = p_up - 1; p_index >= p_low; p_index--)
+      p_indices.push_back(p_index);
+  }
+  // Downlooking, start at the lower boundary
+  else if (za > theta_lim) {
+    for (Index p_index = p_low + 1; p_index <= p_up; p_index++)
+      p_indices.push_back(p_index);
+  }
+  // Limb looking. We may miss the endpoints when the intersection point is
+  // at the same level as the actual point, so all levels are included.
+  // Paths that leave the cloudbox are skipped by cloud_geometry3D_calc.
+  else if (za < theta_lim) {
+    for (Index p_index = p_low; p_index <= p_up; p_index++) {
+      // For this case the cloudbox goes down to the surface and we
+      // look downwards. These cases are outside the cloudbox and
+      // not needed. Switch is included here, as ppath_step_agenda
+      // gives an error for such cases.
+      if (p_index != 0) p_indices.push_back(p_index);
+    }
+  }
+}
+
+//! Propagation path steps of a sequential 3D update.
+/*!
+  Calculates the propagation path step to the next intersection with the
+  cloudbox grids, for all grid points of the cloudbox and all propagation
+  directions of the sweep, see *cloud_sweep3D_levels*. The grid positions
+  of the path points and the atmospheric quantities along the path are
+  stored in geometry, see DoitGeometry3D. Steps leaving the cloudbox get
+  no points.
+
+  The directions are handled in parallel, unless called from within a
+  parallel region.
+
+  \param[in,out] ws Current workspace
+  \param geometry The path steps.
+  \param scat_za_grid Zenith angle grid.
+  \param scat_aa_grid Azimuth angle grid.
+  \param cloudbox_limits The cloudbox limits.
+  \param ppath_step_agenda Calculation of propagation path steps.
+  \param ppath_lmax Maximum length between path points.
+  \param ppath_lraytrace Maximum length of ray tracing steps.
+  \param p_grid Pressure grid.
+  \param lat_grid Latitude grid.
+  \param lon_grid Longitude grid.
+  \param z_field Field of geometrical altitudes.
+  \param refellipsoid The reference ellipsoid.
+  \param t_field Temperature field.
+  \param vmr_field VMR field.
+  \param f_grid Frequency grid.
+  \param f_index Frequency index, only used for the path calculation.
+
+  \author ARTS developers
+*/
+void cloud_geometry3D_calc(Workspace& ws,
+                           DoitGeometry3D& geometry,
+                           ConstVectorView scat_za_grid,
+                           ConstVectorView scat_aa_grid,
+                           const ArrayOfIndex& cloudbox_limits,
+                           const Agenda& ppath_step_agenda,
+                           const Numeric& ppath_lmax,
+                           const Numeric& ppath_lraytrace,
+                           ConstVectorView p_grid,
+                           ConstVectorView lat_grid,
+                           ConstVectorView lon_grid,
+                           ConstTensor3View z_field,
+                           ConstVectorView refellipsoid,
+                           ConstTensor3View t_field,
+                           ConstTensor4View vmr_field,
+                           ConstVectorView f_grid,
+                           const Index& f_index,
+                           const Verbosity&) {
+  const Index N_scat_za = scat_za_grid.nelem();
+  const Index N_scat_aa = scat_aa_grid.nelem();
+  const Index N_species = vmr_field.nbooks();
+  const Index n1 = cloudbox_limits[1] - cloudbox_limits[0];
+  const Index n2 = cloudbox_limits[3] - cloudbox_limits[2];
+  const Index n3 = cloudbox_limits[5] - cloudbox_limits[4];
+  const Index n_cells = (n1 + 1) * (n2 + 1) * (n3 + 1);
+  const Index n_dirs = N_scat_za * N_scat_aa;
+
+  // The steps of each direction are calculated separately, in the order
+  // of the sweep, and are then joined in the order of the directions and
+  // the cells. During the calculation, start holds the number of points
+  // of each cell.
+  Array<DoitGeometry3D> fragments(n_dirs);
+  ArrayOfArrayOfIndex cell_orders(n_dirs);
+
+  Workspace l_ws(ws);
+  Agenda l_ppath_step_agenda(ppath_step_agenda);
+
+  String fail_msg;
+  bool failed = false;
+
+#pragma omp parallel for if (!arts_omp_in_parallel() && n_dirs > 1) \
+    firstprivate(l_ws, l_ppath_step_agenda)
+  for (Index i_dir = 0; i_dir < n_dirs; i_dir++) {
+    if (failed) continue;
+
+    const Index scat_za_index = i_dir / N_scat_aa;
+    const Index scat_aa_index = i_dir % N_scat_aa;
+    DoitGeometry3D& fragment = fragments[i_dir];
+    ArrayOfIndex& cell_order = cell_orders[i_dir];
+    fragment.start.assign(size_t(n_cells) + 1, 0);
+
+    // First and last point in azimuth angle grid are equal, the update
+    // starts with the second element.
+    if (scat_aa_index == 0) continue;
+
+    try {
+      ArrayOfIndex p_indices;
+      cloud_sweep3D_levels(p_indices,
+                           scat_za_grid[scat_za_index],
+                           cloudbox_limits,
+                           z_field,
+                           refellipsoid);
+
+      Ppath ppath_step;
+
+      for (Index i_p = 0; i_p < p_indices.nelem(); i_p++) {
+        const Index p_index = p_indices[i_p];
+        for (Index lat_index = cloudbox_limits[2];
+             lat_index <= cloudbox_limits[3];
+             lat_index++) {
+          for (Index lon_index = cloudbox_limits[4];
+               lon_index <= cloudbox_limits[5];
+               lon_index++) {
+            const size_t i_cell =
+                size_t(((p_index - cloudbox_limits[0]) * (n2 + 1) +
+                        lat_index - cloudbox_limits[2]) *
+                           (n3 + 1) +
+                       lon_index - cloudbox_limits[4]);
+
+            //Initialize ppath for 3D.
+            ppath_init_structure(ppath_step, 3, 1);
+
+            ppath_step.pos(0, 2) = lon_grid[lon_index];
+            ppath_step.pos(0, 1) = lat_grid[lat_index];
+            ppath_step.pos(0, 0) = z_field(p_index, lat_index, lon_index);
+            // As always on top of the lat. grid positions, OK to call
+            // refell2r:
+            ppath_step.r[0] = refell2r(refellipsoid, ppath_step.pos(0, 1)) +
+                              ppath_step.pos(0, 0);
+
+            // Define the direction:
+            ppath_step.los(0, 0) = scat_za_grid[scat_za_index];
+            ppath_step.los(0, 1) = scat_aa_grid[scat_aa_index] - 180.;
+
+            // Define the grid positions:
+            ppath_step.gp_p[0].idx = p_index;
+            ppath_step.gp_p[0].fd[0] = 0.;
+            ppath_step.gp_p[0].fd[1] = 1.;
+
+            ppath_step.gp_lat[0].idx = lat_index;
+            ppath_step.gp_lat[0].fd[0] = 0.;
+            ppath_step.gp_lat[0].fd[1] = 1.;
+
+            ppath_step.gp_lon[0].idx = lon_index;
+            ppath_step.gp_lon[0].fd[0] = 0.;
+            ppath_step.gp_lon[0].fd[1] = 1.;
+
+            ppath_step_agendaExecute(l_ws,
+                                     ppath_step,
+                                     ppath_lmax,
+                                     ppath_lraytrace,
+                                     t_field,
+                                     z_field,
+                                     vmr_field,
+                                     Vector(1, f_grid[f_index]),
+                                     l_ppath_step_agenda);
+
+            // Only if the next point lies inside the cloudbox a radiative
+            // transfer step calculation has to be performed.
+            if (!is_inside_cloudbox(ppath_step, cloudbox_limits, true))
+              continue;
+
+            const Index np = ppath_step.np;
+
+            // Gridpositions inside the cloudbox, the optical properties
+            // are stored only inside the cloudbox.
+            ArrayOfGridPos cloud_gp_p = ppath_step.gp_p;
+            ArrayOfGridPos cloud_gp_lat = ppath_step.gp_lat;
+            ArrayOfGridPos cloud_gp_lon = ppath_step.gp_lon;
+
+            for (Index i = 0; i < np; i++) {
+              cloud_gp_p[i].idx -= cloudbox_limits[0];
+              cloud_gp_lat[i].idx -= cloudbox_limits[2];
+              cloud_gp_lon[i].idx -= cloudbox_limits[4];
+            }
+            gridpos_upperend_check(cloud_gp_p[0], n1);
+            gridpos_upperend_check(cloud_gp_p[np - 1], n1);
+            gridpos_upperend_check(cloud_gp_lat[0], n2);
+            gridpos_upperend_check(cloud_gp_lat[np - 1], n2);
+            gridpos_upperend_check(cloud_gp_lon[0], n3);
+            gridpos_upperend_check(cloud_gp_lon[np - 1], n3);
+            gridpos_lowerend_check(cloud_gp_p[0]);
+            gridpos_lowerend_check(cloud_gp_p[np - 1]);
+            gridpos_lowerend_check(cloud_gp_lat[0]);
+            gridpos_lowerend_check(cloud_gp_lat[np - 1]);
+            gridpos_lowerend_check(cloud_gp_lon[0]);
+            gridpos_lowerend_check(cloud_gp_lon[np - 1]);
+
+            // The zenith angles and azimuth of the propagation path are
+            // needed to interpolate the radiation fields on the right
+            // angles.
+            Vector los_grid_aa = ppath_step.los(joker, 1);
+            for (Index i = 0; i < np; i++) los_grid_aa[i] += 180.;
+
+            ArrayOfGridPos gp_za(np);
+            gridpos(gp_za, scat_za_grid, ppath_step.los(joker, 0));
+
+            ArrayOfGridPos gp_aa(np);
+            gridpos(gp_aa, scat_aa_grid, los_grid_aa);
+
+            // Temperature, VMRs and pressure along the path
+            Matrix itw(np, 8);
+            interpweights(itw,
+                          ppath_step.gp_p,
+                          ppath_step.gp_lat,
+                          ppath_step.gp_lon);
+
+            Vector t_int(np);
+            interp(t_int,
+                   itw,
+                   t_field,
+                   ppath_step.gp_p,
+                   ppath_step.gp_lat,
+                   ppath_step.gp_lon);
+
+            Matrix vmr_list_int(N_species, np);
+            for (Index i = 0; i < N_species; i++)
+              interp(vmr_list_int(i, joker),
+                     itw,
+                     vmr_field(i, joker, joker, joker),
+                     ppath_step.gp_p,
+                     ppath_step.gp_lat,
+                     ppath_step.gp_lon);
+
+            Matrix itw_p(np, 2);
+            interpweights(itw_p, ppath_step.gp_p);
+            Vector p_int(np);
+            itw2p(p_int, p_grid, ppath_step.gp_p, itw_p);
+
+            for (Index i = 0; i < np; i++) {
+              const GridPos* gps[5] = {&cloud_gp_p[i],
+                                       &cloud_gp_lat[i],
+                                       &cloud_gp_lon[i],
+                                       &gp_za[i],
+                                       &gp_aa[i]};
+              for (Index j = 0; j < 5; j++) {
+                fragment.idx.push_back(int(gps[j]->idx));
+                fragment.fd.push_back(gps[j]->fd[0]);
+              }
+              fragment.lstep.push_back(i < np - 1 ? ppath_step.lstep[i] : 0);
+              fragment.p.push_back(p_int[i]);
+              fragment.t.push_back(t_int[i]);
+              for (Index j = 0; j < N_species; j++)
+                fragment.vmr.push_back(vmr_list_int(j, i));
+            }
+            fragment.start[i_cell + 1] = np;
+            cell_order.push_back(Index(i_cell));
+          }
+        }
+      }
+    } catch (const std::exception& e) {
+      ostringstream os;
+      os << "Error for scat_za_index = " << scat_za_index
+         << " and scat_aa_index = " << scat_aa_index << ":\n"
+         << e.what();
+#pragma omp critical(cloud_geometry3D_calc_fail)
+      {
+        failed = true;
+        fail_msg = os.str();
+      }
+      continue;
+    }
+  }
+
+  if (failed) throw runtime_error(fail_msg);
+
+  // Join the steps of all directions
+  geometry = DoitGeometry3D();
+  geometry.n_species = N_species;
+  geometry.start.reserve(size_t(n_dirs * n_cells) + 1);
+  geometry.start.push_back(0);
+  for (Index i_dir = 0; i_dir < n_dirs; i_dir++) {
+    const DoitGeometry3D& fragment = fragments[i_dir];
+
+    // Position of the first point of each cell in the fragment
+    std::vector<Index> first(size_t(n_cells), 0);
+    Index n_points = 0;
+    for (const Index i_cell : cell_orders[i_dir]) {
+      first[size_t(i_cell)] = n_points;
+      n_points += fragment.start[size_t(i_cell) + 1];
+    }
+
+    for (size_t i_cell = 0; i_cell < size_t(n_cells); i_cell++) {
+      const Index np = fragment.start[i_cell + 1];
+      const Index i0 = first[i_cell];
+      geometry.start.push_back(geometry.start.back() + np);
+      geometry.idx.insert(geometry.idx.end(),
+                          fragment.idx.begin() + 5 * i0,
+                          fragment.idx.begin() + 5 * (i0 + np));
+      geometry.fd.insert(geometry.fd.end(),
+                         fragment.fd.begin() + 5 * i0,
+                         fragment.fd.begin() + 5 * (i0 + np));
+      geometry.lstep.insert(geometry.lstep.end(),
+                            fragment.lstep.begin() + i0,
+                            fragment.lstep.begin() + i0 + np);
+      geometry.p.insert(geometry.p.end(),
+                        fragment.p.begin() + i0,
+                        fragment.p.begin() + i0 + np);
+      geometry.t.insert(geometry.t.end(),
+                        fragment.t.begin() + i0,
+                        fragment.t.begin() + i0 + np);
+      geometry.vmr.insert(geometry.vmr.end(),
+                          fragment.vmr.begin() + N_species * i0,
+                          fragment.vmr.begin() + N_species * (i0 + np));
+    }
+    fragments[i_dir] = DoitGeometry3D();
+  }
+}
+
 //! Radiative transfer calculation along a path inside the cloudbox (3D).
-/*! 
-  This function calculates the radiation field along a propagation path 
-  step for a specified zenith direction. This function is used for the 
-  sequential update if the radiation field and called inside a loop over
-  the pressure grid. 
-  In the function the intersection point of the propagation path with the 
-  next layer is calculated and all atmospheric properties are 
-  interpolated an the intersection point. Then a radiative transfer step is 
-  performed using the stokes vector as output and input. The inermediate
-  Stokes vectors are stored in the WSV doit_i_field_mono.
+/*!
+  This function calculates the radiation field along a propagation path
+  step for a specified grid point and direction, using a path step
+  calculated by *cloud_geometry3D_calc*. The particle properties and the
+  radiation fields are interpolated to the points of the step, and a
+  radiative transfer step is performed from the end of the step to the
+  grid point.
+
+  The step must have at least one point, see DoitGeometry3D::npoints.
 
   \param[in,out] ws Current workspace
- WS Output:
-  \param doit_i_field_mono Updated radiation field inside the cloudbox.
-  WS Input:
-  \param p_index // Pressure index
-  \param lat_index
-  \param lon_index
-  \param scat_za_index // Index for proagation direction
-  \param scat_aa_index
-  \param scat_za_grid
-  \param scat_aa_grid
-  \param cloudbox_limits 
+  \param stokes_vec Output: Stokes vector at the grid point.
+  \param geometry The path steps.
+  \param i_step Index of the step, see DoitGeometry3D.
+  \param doit_i_field_mono Radiation field inside the cloudbox.
   \param doit_scat_field Scattered field.
-  Calculate scalar gas absorption:
-  \param propmat_clearsky_agenda
-  \param vmr_field
-  Propagation path calculation:
-  \param ppath_step_agenda
-  \param p_grid
-  \param lat_grid
-  \param lon_grid
-  \param z_field
-  \param refellipsoid
-  \param z_surface
-  Calculate thermal emission:
-  \param t_field
-  \param f_grid
-  \param f_index
-  \param ext_mat_field
-  \param abs_vec_field
+  \param propmat_clearsky_agenda Calculation of gas absorption.
+  \param f_grid Frequency grid.
+  \param f_index Frequency index.
+  \param ext_mat_field Extinction matrix of particles inside the cloudbox.
+  \param abs_vec_field Absorption vector of particles inside the cloudbox.
 
   \author Claudia Emde
   \date 2003-06-04
 */
 void cloud_ppath_update3D(Workspace& ws,
-                          Tensor6View doit_i_field_mono,
-                          // ppath_step_agenda:
-                          const Index& p_index,
-                          const Index& lat_index,
-                          const Index& lon_index,
-                          const Index& scat_za_index,
-                          const Index& scat_aa_index,
-                          ConstVectorView scat_za_grid,
-                          ConstVectorView scat_aa_grid,
-                          const ArrayOfIndex& cloudbox_limits,
+                          VectorView stokes_vec,
+                          const DoitGeometry3D& geometry,
+                          const Index& i_step,
+                          ConstTensor6View doit_i_field_mono,
                           ConstTensor6View doit_scat_field,
                           // Calculate scalar gas absorption:
                           const Agenda& propmat_clearsky_agenda,
-                          ConstTensor4View vmr_field,
-                          // Propagation path calculation:
-                          const Agenda& ppath_step_agenda,
-                          const Numeric& ppath_lmax,
-                          const Numeric& ppath_lraytrace,
-                          ConstVectorView p_grid,
-                          ConstVectorView lat_grid,
-                          ConstVectorView lon_grid,
-                          ConstTensor3View z_field,
-                          ConstVectorView refellipsoid,
-                          // Calculate thermal emission:
-                          ConstTensor3View t_field,
                           ConstVectorView f_grid,
                           const Index& f_index,
                           //particle optical properties
                           ConstTensor5View ext_mat_field,
                           ConstTensor4View abs_vec_field,
-                          const Index&,  //scat_za_interp
                           const Verbosity& verbosity) {
   CREATE_OUT3;
 
-  Ppath ppath_step;
   const Index stokes_dim = doit_i_field_mono.ncols();
-
-  Vector sca_vec_av(stokes_dim, 0);
-  Vector aa_grid(scat_aa_grid.nelem());
-
-  for (Index i = 0; i < scat_aa_grid.nelem(); i++)
-    aa_grid[i] = scat_aa_grid[i] - 180.;
-
-  //Initialize ppath for 3D.
-  ppath_init_structure(ppath_step, 3, 1);
-  // See documentation of ppath_init_structure for
-  // understanding the parameters.
-
-  // The first dimension of pos are the points in
-  // the propagation path.
-  // Here we initialize the first point.
-  // The second is: radius, latitude, longitude
-
-  ppath_step.pos(0, 2) = lon_grid[lon_index];
-  ppath_step.pos(0, 1) = lat_grid[lat_index];
-  ppath_step.pos(0, 0) = z_field(p_index, lat_index, lon_index);
-  // As always on top of the lat. grid positions, OK to call refell2r:
-  ppath_step.r[0] =
-      refell2r(refellipsoid, ppath_step.pos(0, 1)) + ppath_step.pos(0, 0);
-
-  // Define the direction:
-  ppath_step.los(0, 0) = scat_za_grid[scat_za_index];
-  ppath_step.los(0, 1) = aa_grid[scat_aa_index];
-
-  // Define the grid positions:
-  ppath_step.gp_p[0].idx = p_index;
-  ppath_step.gp_p[0].fd[0] = 0.;
-  ppath_step.gp_p[0].fd[1] = 1.;
-
-  ppath_step.gp_lat[0].idx = lat_index;
-  ppath_step.gp_lat[0].fd[0] = 0.;
-  ppath_step.gp_lat[0].fd[1] = 1.;
-
-  ppath_step.gp_lon[0].idx = lon_index;
-  ppath_step.gp_lon[0].fd[0] = 0.;
-  ppath_step.gp_lon[0].fd[1] = 1.;
-
-  // Call ppath_step_agenda:
-  ppath_step_agendaExecute(ws,
-                           ppath_step,
-                           ppath_lmax,
-                           ppath_lraytrace,
-                           t_field,
-                           z_field,
-                           vmr_field,
-                           Vector(1, f_grid[f_index]),
-                           ppath_step_agenda);
-
-  // Check whether the next point is inside or outside the
-  // cloudbox. Only if the next point lies inside the
-  // cloudbox a radiative transfer step caclulation has to
-  // be performed.
-  if (is_inside_cloudbox(ppath_step, cloudbox_limits, true)) {
-    // Gridpositions inside the cloudbox.
-    // The optical properties are stored only inside the
-    // cloudbox. For interpolation we use grids
-    // inside the cloudbox.
-
-    ArrayOfGridPos cloud_gp_p = ppath_step.gp_p;
-    ArrayOfGridPos cloud_gp_lat = ppath_step.gp_lat;
-    ArrayOfGridPos cloud_gp_lon = ppath_step.gp_lon;
-
-    for (Index i = 0; i < ppath_step.np; i++) {
-      cloud_gp_p[i].idx -= cloudbox_limits[0];
-      cloud_gp_lat[i].idx -= cloudbox_limits[2];
-      cloud_gp_lon[i].idx -= cloudbox_limits[4];
+  const Index N_species = geometry.n_species;
+  const Index np = geometry.npoints(i_step);
+  const Index first = geometry.start[size_t(i_step)];
+  assert(np > 0);
+
+  // Grid positions of the path points
+  ArrayOfGridPos cloud_gp_p(np), cloud_gp_lat(np), cloud_gp_lon(np);
+  ArrayOfGridPos gp_za(np), gp_aa(np);
+  for (Index i = 0; i < np; i++) {
+    GridPos* gps[5] = {
+        &cloud_gp_p[i], &cloud_gp_lat[i], &cloud_gp_lon[i], &gp_za[i], &gp_aa[i]};
+    for (Index j = 0; j < 5; j++) {
+      const size_t k = size_t(5 * (first + i) + j);
+      gps[j]->idx = geometry.idx[k];
+      gps[j]->fd[0] = geometry.fd[k];
+      gps[j]->fd[1] = 1 - geometry.fd[k];
     }
-    const Index n1 = cloudbox_limits[1] - cloudbox_limits[0];
-    const Index n2 = cloudbox_limits[3] - cloudbox_limits[2];
-    const Index n3 = cloudbox_limits[5] - cloudbox_limits[4];
-    gridpos_upperend_check(cloud_gp_p[0], n1);
-    gridpos_upperend_check(cloud_gp_p[ppath_step.np - 1], n1);
-    gridpos_upperend_check(cloud_gp_lat[0], n2);
-    gridpos_upperend_check(cloud_gp_lat[ppath_step.np - 1], n2);
-    gridpos_upperend_check(cloud_gp_lon[0], n3);
-    gridpos_upperend_check(cloud_gp_lon[ppath_step.np - 1], n3);
-
-    Matrix itw(ppath_step.np, 8);
-    interpweights(itw, cloud_gp_p, cloud_gp_lat, cloud_gp_lon);
-
-    Matrix itw_p(ppath_step.np, 2);
-    interpweights(itw_p, cloud_gp_p);
-
-    // The zenith angles and azimuth of the propagation path are
-    // needed as we have to
-    // interpolate the intensity field and the scattered field on the
-    // right angles.
-    VectorView los_grid_za = ppath_step.los(joker, 0);
-    VectorView los_grid_aa = ppath_step.los(joker, 1);
-
-    for (Index i = 0; i < los_grid_aa.nelem(); i++)
-      los_grid_aa[i] = los_grid_aa[i] + 180.;
-
-    ArrayOfGridPos gp_za(los_grid_za.nelem());
-    gridpos(gp_za, scat_za_grid, los_grid_za);
-
-    ArrayOfGridPos gp_aa(los_grid_aa.nelem());
-    gridpos(gp_aa, scat_aa_grid, los_grid_aa);
-
-    Matrix itw_p_za(ppath_step.np, 32);
-    interpweights(
-        itw_p_za, cloud_gp_p, cloud_gp_lat, cloud_gp_lon, gp_za, gp_aa);
+  }
 
-    // Ppath_step normally has 2 points, the starting
-    // point and the intersection point.
-    // But there can be points in between, when a maximum
-    // lstep is given. We have to interpolate on all the
-    // points in the ppath_step.
+  Matrix itw(np, 8);
+  interpweights(itw, cloud_gp_p, cloud_gp_lat, cloud_gp_lon);
 
-    Tensor3 ext_mat_int(stokes_dim, stokes_dim, ppath_step.np);
-    Matrix abs_vec_int(stokes_dim, ppath_step.np);
-    Matrix sca_vec_int(stokes_dim, ppath_step.np, 0.);
-    Matrix doit_i_field_mono_int(stokes_dim, ppath_step.np, 0.);
-    Vector t_int(ppath_step.np);
-    Vector vmr_int(ppath_step.np);
-    Vector p_int(ppath_step.np);
-    Vector stokes_vec(stokes_dim);
-    //Tensor3 ext_mat_gas(stokes_dim, stokes_dim, ppath_step.np);
-    //Matrix abs_vec_gas(stokes_dim, ppath_step.np);
+  Matrix itw_p_za(np, 32);
+  interpweights(itw_p_za, cloud_gp_p, cloud_gp_lat, cloud_gp_lon, gp_za, gp_aa);
 
-    // Calculate the average of the coefficients for the layers
-    // to be considered in the
-    // radiative transfer calculation.
+  // Ppath_step normally has 2 points, the starting
+  // point and the intersection point.
+  // But there can be points in between, when a maximum
+  // lstep is given. We have to interpolate on all the
+  // points in the ppath_step.
 
-    for (Index i = 0; i < stokes_dim; i++) {
-      // Extinction matrix requires a second loop
-      // over stokes_dim
-      out3 << "Interpolate ext_mat:\n";
-      for (Index j = 0; j < stokes_dim; j++) {
-        //
-        // Interpolation of ext_mat
-        //
-        interp(ext_mat_int(i, j, joker),
-               itw,
-               ext_mat_field(joker, joker, joker, i, j),
-               cloud_gp_p,
-               cloud_gp_lat,
-               cloud_gp_lon);
-      }
-      // Absorption vector:
-      //
-      // Interpolation of abs_vec
-      //
-      interp(abs_vec_int(i, joker),
+  Tensor3 ext_mat_int(stokes_dim, stokes_dim, np);
+  Matrix abs_vec_int(stokes_dim, np);
+  Matrix sca_vec_int(stokes_dim, np, 0.);
+  Matrix doit_i_field_mono_int(stokes_dim, np, 0.);
+
+  for (Index i = 0; i < stokes_dim; i++) {
+    // Extinction matrix requires a second loop
+    // over stokes_dim
+    out3 << "Interpolate ext_mat:\n";
+    for (Index j = 0; j < stokes_dim; j++) {
+      interp(ext_mat_int(i, j, joker),
              itw,
-             abs_vec_field(joker, joker, joker, i),
+             ext_mat_field(joker, joker, joker, i, j),
              cloud_gp_p,
              cloud_gp_lat,
              cloud_gp_lon);
-      //
-      // Scattered field:
-      //
-      // Interpolation of sca_vec:
-      //
-      out3 << "Interpolate doit_scat_field:\n";
-      interp(sca_vec_int(i, joker),
-             itw_p_za,
-             doit_scat_field(joker, joker, joker, joker, joker, i),
-             cloud_gp_p,
-             cloud_gp_lat,
-             cloud_gp_lon,
-             gp_za,
-             gp_aa);
-      out3 << "Interpolate doit_i_field_mono:\n";
-      interp(doit_i_field_mono_int(i, joker),
-             itw_p_za,
-             doit_i_field_mono(joker, joker, joker, joker, joker, i),
-             cloud_gp_p,
-             cloud_gp_lat,
-             cloud_gp_lon,
-             gp_za,
-             gp_aa);
     }
-    //
-    // Planck function
-    //
-    // Interpolate temperature field
-    //
-    out3 << "Interpolate temperature field\n";
-    interp(t_int,
+    // Absorption vector:
+    interp(abs_vec_int(i, joker),
            itw,
-           t_field(joker, joker, joker),
-           ppath_step.gp_p,
-           ppath_step.gp_lat,
-           ppath_step.gp_lon);
-
-    //
-    // The vmr_field is needed for the gaseous absorption
-    // calculation.
-    //
-    const Index N_species = vmr_field.nbooks();
-    //
-    // Interpolated vmr_list, holds a vmr_list for each point in
-    // ppath_step.
-    //
-    Matrix vmr_list_int(N_species, ppath_step.np);
-
-    for (Index i = 0; i < N_species; i++) {
-      out3 << "Interpolate vmr field\n";
-      interp(vmr_int,
-             itw,
-             vmr_field(i, joker, joker, joker),
-             ppath_step.gp_p,
-             ppath_step.gp_lat,
-             ppath_step.gp_lon);
-
-      vmr_list_int(i, joker) = vmr_int;
-    }
+           abs_vec_field(joker, joker, joker, i),
+           cloud_gp_p,
+           cloud_gp_lat,
+           cloud_gp_lon);
+    // Scattered field:
+    out3 << "Interpolate doit_scat_field:\n";
+    interp(sca_vec_int(i, joker),
+           itw_p_za,
+           doit_scat_field(joker, joker, joker, joker, joker, i),
+           cloud_gp_p,
+           cloud_gp_lat,
+           cloud_gp_lon,
+           gp_za,
+           gp_aa);
+    out3 << "Interpolate doit_i_field_mono:\n";
+    interp(doit_i_field_mono_int(i, joker),
+           itw_p_za,
+           doit_i_field_mono(joker, joker, joker, joker, joker, i),
+           cloud_gp_p,
+           cloud_gp_lat,
+           cloud_gp_lon,
+           gp_za,
+           gp_aa);
+  }
 
-    // Presssure (needed for the calculation of gas absorption)
-    itw2p(p_int, p_grid, ppath_step.gp_p, itw_p);
+  // Temperature, VMRs, pressure and step lengths are taken as stored
+  Vector t_int(np), p_int(np), lstep(np - 1);
+  Matrix vmr_list_int(N_species, np);
+  for (Index i = 0; i < np; i++) {
+    const size_t k = size_t(first + i);
+    t_int[i] = geometry.t[k];
+    p_int[i] = geometry.p[k];
+    if (i < np - 1) lstep[i] = geometry.lstep[k];
+    for (Index j = 0; j < N_species; j++)
+      vmr_list_int(j, i) = geometry.vmr[k * size_t(N_species) + size_t(j)];
+  }
 
-    out3 << "Calculate radiative transfer inside cloudbox.\n";
-    cloud_RT_no_background(ws,
-                           doit_i_field_mono,
-                           propmat_clearsky_agenda,
-                           ppath_step,
-                           t_int,
-                           vmr_list_int,
-                           ext_mat_int,
-                           abs_vec_int,
-                           sca_vec_int,
-                           doit_i_field_mono_int,
-                           p_int,
-                           cloudbox_limits,
-                           f_grid,
-                           f_index,
-                           p_index,
-                           lat_index,
-                           lon_index,
-                           scat_za_index,
-                           scat_aa_index,
-                           verbosity);
-  }  //end if inside cloudbox
+  out3 << "Calculate radiative transfer inside cloudbox.\n";
+  cloud_RT_step(ws,
+                stokes_vec,
+                propmat_clearsky_agenda,
+                lstep,
+                t_int,
+                vmr_list_int,
+                ext_mat_int,
+                abs_vec_int,
+                sca_vec_int,
+                doit_i_field_mono_int,
+                p_int,
+                f_grid,
+                f_index,
+                verbosity);
 }
 
 //! cloud_RT_no_background
@@ -1222,14 +1407,88 @@ void cloud_RT_no_background(Workspace& ws,
                             const Index& scat_za_index,
                             const Index& scat_aa_index,
                             const Verbosity& verbosity) {
+  const Index stokes_dim = doit_i_field_mono.ncols();
+  const Index atmosphere_dim = cloudbox_limits.nelem() / 2;
+
+  Vector stokes_vec(stokes_dim, 0.);
+
+  cloud_RT_step(ws,
+                stokes_vec,
+                propmat_clearsky_agenda,
+                ppath_step.lstep,
+                t_int,
+                vmr_list_int,
+                ext_mat_int,
+                abs_vec_int,
+                sca_vec_int,
+                doit_i_field_mono_int,
+                p_int,
+                f_grid,
+                f_index,
+                verbosity);
+
+  // Assign calculated Stokes Vector to doit_i_field_mono.
+  if (atmosphere_dim == 1)
+    doit_i_field_mono(
+        p_index - cloudbox_limits[0], 0, 0, scat_za_index, 0, joker) =
+        stokes_vec;
+  else if (atmosphere_dim == 3)
+    doit_i_field_mono(p_index - cloudbox_limits[0],
+                      lat_index - cloudbox_limits[2],
+                      lon_index - cloudbox_limits[4],
+                      scat_za_index,
+                      scat_aa_index,
+                      joker) = stokes_vec;
+}
+
+//! cloud_RT_step
+/*
+  Radiative transfer along a propagation path step inside the cloudbox,
+  from the last point of the step to the first one. This is the part of
+  *cloud_RT_no_background* that does not depend on how the step was
+  obtained.
+
+  Output:
+  \param stokes_vec Stokes vector at the first point of the step.
+  Input:
+  \param propmat_clearsky_agenda Calculate gas absorption.
+  \param lstep Length of the path between the points of the step.
+  \param t_int Temperature values at the points of the step.
+  \param vmr_list_int Volume mixing ratios at the points of the step.
+  \param ext_mat_int Interpolated total particle extinction matrix.
+  \param abs_vec_int Interpolated total particle absorption vector.
+  \param sca_vec_int Interpolated total particle scattering vector.
+  \param doit_i_field_mono_int Interpolated radiances.
+  \param p_int Pressure values at the points of the step.
+  \param f_grid Frequency grid.
+  \param f_index Frequency index of (monochromatic) scattering calculation.
+
+  \author Claudia Emde
+  \date 2005-05-13
+*/
+void cloud_RT_step(Workspace& ws,
+                   //Output
+                   VectorView stokes_vec,
+                   // Input
+                   const Agenda& propmat_clearsky_agenda,
+                   ConstVectorView lstep,
+                   ConstVectorView t_int,
+                   ConstMatrixView vmr_list_int,
+                   ConstTensor3View ext_mat_int,
+                   ConstMatrixView abs_vec_int,
+                   ConstMatrixView sca_vec_int,
+                   ConstMatrixView doit_i_field_mono_int,
+                   ConstVectorView p_int,
+                   ConstVectorView f_grid,
+                   const Index& f_index,
+                   const Verbosity& verbosity) {
   CREATE_OUT3;
 
   const Index N_species = vmr_list_int.nrows();
-  const Index stokes_dim = doit_i_field_mono.ncols();
-  const Index atmosphere_dim = cloudbox_limits.nelem() / 2;
+  const Index stokes_dim = stokes_vec.nelem();
+  const Index np = t_int.nelem();
 
   Vector sca_vec_av(stokes_dim, 0);
-  Vector stokes_vec(stokes_dim, 0.);
   Vector rtp_temperature_nlte_dummy(0);
   Vector rtp_vmr_local(N_species, 0.);
 
@@ -1243,9 +1502,9 @@ void cloud_RT_no_background(Workspace& ws,
   Vector vector_tmp(stokes_dim);
 
   // Incoming stokes vector
-  stokes_vec = doit_i_field_mono_int(joker, ppath_step.np - 1);
+  stokes_vec = doit_i_field_mono_int(joker, np - 1);
 
-  for (Index k = ppath_step.np - 1; k >= 0; k--) {
+  for (Index k = np - 1; k >= 0; k--) {
     // Save propmat_clearsky from previous level by
     // swapping it with current level
     std::swap(cur_propmat_clearsky, prev_propmat_clearsky);
@@ -1279,7 +1538,7 @@ void cloud_RT_no_background(Workspace& ws,
 
     // Skip any further calculations for the first point.
     // We need values at two ppath points before we can average.
-    if (k == ppath_step.np - 1) continue;
+    if (k == np - 1) continue;
 
     // Average prev_propmat_clearsky with cur_propmat_clearsky
     for (Index i = 0; i < prev_propmat_clearsky.nelem(); i++) {
@@ -1317,7 +1576,7 @@ void cloud_RT_no_background(Workspace& ws,
     Numeric rte_planck_value = planck(f, 0.5 * (t_int[k] + t_int[k + 1]));
 
     // Length of the path between the two layers.
-    Numeric lstep = ppath_step.lstep[k];
+    const Numeric lstep_k = lstep[k];
 
     // Some messages:
     if (out3.sufficient_priority()) {
@@ -1329,7 +1588,7 @@ void cloud_RT_no_background(Workspace& ws,
            << " the cloudbox:"
            << "\n";
       out3 << "Stokes vector at intersection point: \n" << stokes_vec << "\n";
-      out3 << "lstep: ..." << lstep << "\n";
+      out3 << "lstep: ..." << lstep_k << "\n";
       out3 << "------------------------------------------\n";
       out3 << "Averaged coefficients: \n";
       out3 << "Planck function: " << rte_planck_value << "\n";
@@ -1347,22 +1606,10 @@ void cloud_RT_no_background(Workspace& ws,
                               ext_mat_local,
                               abs_vec_local,
                               sca_vec_av,
-                              lstep,
+                              lstep_k,
                               rte_planck_value);
 
   }  // End of loop over ppath_step.
-  // Assign calculated Stokes Vector to doit_i_field_mono.
-  if (atmosphere_dim == 1)
-    doit_i_field_mono(
-        p_index - cloudbox_limits[0], 0, 0, scat_za_index, 0, joker) =
-        stokes_vec;
-  else if (atmosphere_dim == 3)
-    doit_i_field_mono(p_index - cloudbox_limits[0],
-                      lat_index - cloudbox_limits[2],
-                      lon_index - cloudbox_limits[4],
-                      scat_za_index,
-                      scat_aa_index,
-                      joker) = stokes_vec;
 }
 
 //! cloud_RT_surface
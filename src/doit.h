@@ -34,6 +34,7 @@
 #define doit_h
 
 #include "agenda_class.h"
+#include "doit_geometry_cache.h"
 #include "matpackVI.h"
 #include "ppath.h"
 #include "propagationmatrix.h"
@@ -161,39 +162,44 @@ void cloud_ppath_update1D_planeparallel(Workspace& ws,
                                         // const Agenda& surface_agenda,
                                         const Verbosity& verbosity);
 
-void cloud_ppath_update3D(Workspace& ws,
-                          Tensor6View doit_i_field_mono,
-                          // ppath_step_agenda:
-                          const Index& p_index,
-                          const Index& lat_index,
-                          const Index& lon_index,
-                          const Index& scat_za_index,
-                          const Index& scat_aa_index,
-                          ConstVectorView scat_za_grid,
-                          ConstVectorView scat_aa_grid,
+void cloud_sweep3D_levels(ArrayOfIndex& p_indices,
+                          const Numeric& za,
                           const ArrayOfIndex& cloudbox_limits,
+                          ConstTensor3View z_field,
+                          ConstVectorView refellipsoid);
+
+void cloud_geometry3D_calc(Workspace& ws,
+                           DoitGeometry3D& geometry,
+                           ConstVectorView scat_za_grid,
+                           ConstVectorView scat_aa_grid,
+                           const ArrayOfIndex& cloudbox_limits,
+                           const Agenda& ppath_step_agenda,
+                           const Numeric& ppath_lmax,
+                           const Numeric& ppath_lraytrace,
+                           ConstVectorView p_grid,
+                           ConstVectorView lat_grid,
+                           ConstVectorView lon_grid,
+                           ConstTensor3View z_field,
+                           ConstVectorView refellipsoid,
+                           ConstTensor3View t_field,
+                           ConstTensor4View vmr_field,
+                           ConstVectorView f_grid,
+                           const Index& f_index,
+                           const Verbosity& verbosity);
+
+void cloud_ppath_update3D(Workspace& ws,
+                          VectorView stokes_vec,
+                          const DoitGeometry3D& geometry,
+                          const Index& i_step,
+                          ConstTensor6View doit_i_field_mono,
                           ConstTensor6View doit_scat_field,
                           // Calculate scalar gas absorption:
                           const Agenda& propmat_clearsky_agenda,
-                          ConstTensor4View vmr_field,
-                          // Gas absorption:
-                          // Propagation path calculation:
-                          const Agenda& ppath_step_agenda,
-                          const Numeric& ppath_lmax,
-                          const Numeric& ppath_lraytrace,
-                          ConstVectorView p_grid,
-                          ConstVectorView lat_grid,
-                          ConstVectorView lon_grid,
-                          ConstTensor3View z_field,
-                          ConstVectorView refellipsoid,
-                          // Calculate thermal emission:
-                          ConstTensor3View t_field,
                           ConstVectorView f_grid,
                           const Index& f_index,
                           //particle optical properties
                           ConstTensor5View ext_mat_field,
                           ConstTensor4View abs_vec_field,
-                          const Index&,  //scat_za_interp
                           const Verbosity& verbosity);
 
 void cloud_RT_no_background(Workspace& ws,
@@ -219,6 +225,23 @@ void cloud_RT_no_background(Workspace& ws,
                             const Index& scat_aa_index,
                             const Verbosity& verbosity);
 
+void cloud_RT_step(Workspace& ws,
+                   //Output
+                   VectorView stokes_vec,
+                   // Input
+                   const Agenda& propmat_clearsky_agenda,
+                   ConstVectorView lstep,
+                   ConstVectorView t_int,
+                   ConstMatrixView vmr_list_int,
+                   ConstTensor3View ext_mat_int,
+                   ConstMatrixView abs_vec_int,
+                   ConstMatrixView sca_vec_int,
+                   ConstMatrixView doit_i_field_mono_int,
+                   ConstVectorView p_int,
+                   ConstVectorView f_grid,
+                   const Index& f_index,
+                   const Verbosity& verbosity);
+
 void cloud_RT_surface(Workspace& ws,
                       //Output
                       Tensor6View doit_i_field_mono,
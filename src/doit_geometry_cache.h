@@ -0,0 +1,87 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   doit_geometry_cache.h
+
+  \brief  Storage of the propagation path steps of 3D DOIT sweeps between
+          calls of *doit_i_fieldUpdateSeq3D*.
+
+  The steps depend only on the atmospheric state and the grids, and are
+  shared by all frequencies and iterations of a DOIT calculation.
+*/
+
+#ifndef doit_geometry_cache_h
+#define doit_geometry_cache_h
+
+#include <ostream>
+#include <vector>
+#include "keyed_cache.h"
+
+//! Propagation path steps of a 3D DOIT sweep.
+/*!
+  For each grid point of the cloudbox and each propagation direction, the
+  path step to the upwind intersection with the cloudbox grid, together
+  with all quantities along the step that depend neither on frequency nor
+  on the radiation field. The data of all steps are stored in common
+  arrays, step i covers the points start[i] to start[i+1]-1.
+
+  The steps are numbered as (((za * n_aa + aa) * n_p + p) * n_lat + lat) *
+  n_lon + lon, with all indices relative to the cloudbox. Steps that are
+  not part of the sweep, or that leave the cloudbox, have no points.
+*/
+struct DoitGeometry3D {
+  DoitGeometry3D() : n_species(0) {}
+
+  //! Number of species in vmr.
+  Index n_species;
+
+  //! First point of each step, one extra element at the end.
+  std::vector<Index> start;
+
+  //! Grid positions of the points, 5 for each point.
+  /*! In the order pressure, latitude and longitude inside the cloudbox,
+    zenith and azimuth angle. Only the index and the first interpolation
+    weight (fd[0]) are stored. */
+  std::vector<int> idx;
+  std::vector<Numeric> fd;
+
+  //! Length of the path from each point to the next one [m].
+  std::vector<Numeric> lstep;
+
+  //! Pressure [Pa] and temperature [K] at the points.
+  std::vector<Numeric> p;
+  std::vector<Numeric> t;
+
+  //! VMR of all species at the points, n_species for each point.
+  std::vector<Numeric> vmr;
+
+  //! Number of points of step i.
+  Index npoints(Index i) const {
+    return start[size_t(i) + 1] - start[size_t(i)];
+  }
+};
+
+class DoitGeometryCache : public KeyedCache<DoitGeometry3D> {};
+
+inline std::ostream& operator<<(std::ostream& os, const DoitGeometryCache& c) {
+  os << "DoitGeometryCache: " << c.hits() << " hits, " << c.misses()
+     << " misses";
+  return os;
+}
+
+#endif /* doit_geometry_cache_h */
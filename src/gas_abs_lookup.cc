@@ -24,6 +24,7 @@
 */
 
 #include "gas_abs_lookup.h"
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include "check_input.h"
@@ -121,6 +122,11 @@ void GasAbsLookup::Adapt(const ArrayOfArrayOfSpeciesTag& current_species,
   CREATE_OUT2;
   CREATE_OUT3;
 
+  // Compressed tables are adapted in uncompressed form.
+  const bool was_compressed = IsCompressed();
+  const Numeric original_compression_error = compression_error;
+  if (was_compressed) Decompress();
+
   // Some constants we will need:
   const Index n_current_species = current_species.nelem();
   const Index n_current_f_grid = current_f_grid.nelem();
@@ -456,6 +462,11 @@ void GasAbsLookup::Adapt(const ArrayOfArrayOfSpeciesTag& current_species,
   // 6. Initialize fgp_default.
   fgp_default.resize(f_grid.nelem());
   gridpos_poly(fgp_default, f_grid, f_grid, 0);
+
+  if (was_compressed) {
+    Compress();
+    compression_error = max(compression_error, original_compression_error);
+  }
 }
 
 //! Extract scalar gas absorption coefficients from the lookup table.
@@ -597,7 +608,10 @@ void GasAbsLookup::Extract(Matrix& sga,
     //            << b << ", "
     //            << c << ", "
     //            << d << "\n";
-    assert(is_size(xsec, a, b, c, d));
+    if (IsCompressed())
+      assert(xsec_compressed.size() == size_t(a * b * c * d));
+    else
+      assert(is_size(xsec, a, b, c, d));
   })
 
   // Make sure that log_p_grid is initialized:
@@ -790,7 +804,7 @@ void GasAbsLookup::Extract(Matrix& sga,
   // We do the interpolation in log(p). Test have shown that this
   // gives slightly better accuracy than interpolating in p directly.
   ArrayOfGridPosPoly pgp(1);
-  gridpos_poly(pgp, log_p_grid, log(p), p_interp_order);
+  gridpos_poly(pgp[0], log_p_grid, log(p), p_interp_order);
 
   // Pressure interpolation weights:
   Vector pitw;
@@ -855,6 +869,11 @@ void GasAbsLookup::Extract(Matrix& sga,
   // the ones without.
   Tensor4 itw_withH2O, itw_noH2O, *itw;
 
+  // Buffer for decompressed cross sections and the grid positions to use
+  // with it, only used for compressed tables.
+  Tensor3 xsec_slab;
+  ArrayOfGridPosPoly slab_tgp, slab_vgp;
+
   for (Index pi = 0; pi < p_interp_order + 1; ++pi) {
     // Throw a runtime error if one of the reference VMR profiles is zero, but
     // abs_vmrs is not. (This means that the lookup table was calculated with a
@@ -934,7 +953,7 @@ void GasAbsLookup::Extract(Matrix& sga,
         }
       }
 
-      gridpos_poly(tgp_withT, t_pert, T_offset, t_interp_order, extpolfac);
+      gridpos_poly(tgp_withT[0], t_pert, T_offset, t_interp_order, extpolfac);
     }
 
     // Determine the H2O VMR grid position. We need to do this only
@@ -993,7 +1012,8 @@ void GasAbsLookup::Extract(Matrix& sga,
       }
 
       // For now, do linear interpolation in the fractional VMR.
-      gridpos_poly(vgp_h2o, nls_pert, VMR_frac, h2o_interp_order, extpolfac);
+      gridpos_poly(
+          vgp_h2o[0], nls_pert, VMR_frac, h2o_interp_order, extpolfac);
     }
 
     // Precalculate interpolation weights.
@@ -1061,20 +1081,39 @@ void GasAbsLookup::Extract(Matrix& sga,
         itw = &itw_noH2O;
       }
 
-      // Get the right view on xsec.
-      ConstTensor3View this_xsec =
-          xsec(Range(joker),                 // Temperature range
-               Range(fpi, this_h2o_extent),  // VMR profile range
-               Range(joker),                 // Frequency range
-               this_p_grid_index);           // Pressure index
-
-      // Do interpolation.
-      interp(res,        // result
-             *itw,       // weights
-             this_xsec,  // input
-             *tgp,
-             *vgp,
-             *fgp);  // grid positions
+      if (IsCompressed()) {
+        // Decompress the points needed for the interpolation.
+        DecompressSlab(xsec_slab,
+                       slab_tgp,
+                       slab_vgp,
+                       *tgp,
+                       *vgp,
+                       fpi,
+                       this_p_grid_index);
+
+        // Do interpolation.
+        interp(res,        // result
+               *itw,       // weights
+               xsec_slab,  // input
+               slab_tgp,
+               slab_vgp,
+               *fgp);  // grid positions
+      } else {
+        // Get the right view on xsec.
+        ConstTensor3View this_xsec =
+            xsec(Range(joker),                 // Temperature range
+                 Range(fpi, this_h2o_extent),  // VMR profile range
+                 Range(joker),                 // Frequency range
+                 this_p_grid_index);           // Pressure index
+
+        // Do interpolation.
+        interp(res,        // result
+               *itw,       // weights
+               this_xsec,  // input
+               *tgp,
+               *vgp,
+               *fgp);  // grid positions
+      }
 
       // Increase fpi. fpi marks the position of the first profile
       // of the current species in xsec. This is needed to find
@@ -1088,7 +1127,7 @@ void GasAbsLookup::Extract(Matrix& sga,
 
     // fpi should have reached the end of that dimension of xsec. Check
     // this with an assertion:
-    assert(fpi == xsec.npages());
+    assert(fpi == (IsCompressed() ? xsec_scale.nelem() : xsec.npages()));
 
   }  // End of pressure index loop (below and above gp)
 
@@ -1126,6 +1165,427 @@ void GasAbsLookup::Extract(Matrix& sga,
   // That's it, we're done!
 }
 
+//! Check if two vectors have the same values.
+/*!
+  Values are compared relative to their magnitude, the same way as
+  frequencies are compared in find_new_grid_in_old_grid.
+
+  \param a First vector.
+  \param b Second vector.
+  \return True if both vectors have the same size and values.
+*/
+static bool same_values(ConstVectorView a, ConstVectorView b) {
+  if (a.nelem() != b.nelem()) return false;
+  for (Index i = 0; i < a.nelem(); ++i)
+    if (abs(a[i] - b[i]) > max(abs(a[i]), abs(b[i])) * 2 * DBL_EPSILON)
+      return false;
+  return true;
+}
+
+//! Check if another table has the same setup as this one.
+/*!
+  Two tables have the same setup, if they have the same species,
+  nonlinear species, grids, perturbations, and reference profiles. The
+  cross sections are not compared.
+
+  \param[in] other        The other lookup table.
+  \param[in] check_f_grid If false, the frequency grids may differ.
+
+  \return True if the setups are the same.
+*/
+bool GasAbsLookup::HasSameSetup(const GasAbsLookup& other,
+                                const bool check_f_grid) const {
+  if (species != other.species) return false;
+  if (nonlinear_species != other.nonlinear_species) return false;
+  if (check_f_grid && !same_values(f_grid, other.f_grid)) return false;
+  if (!same_values(p_grid, other.p_grid)) return false;
+  if (!same_values(t_ref, other.t_ref)) return false;
+  if (!same_values(t_pert, other.t_pert)) return false;
+  if (!same_values(nls_pert, other.nls_pert)) return false;
+  if (vmrs_ref.nrows() != other.vmrs_ref.nrows()) return false;
+  for (Index i = 0; i < vmrs_ref.nrows(); ++i)
+    if (!same_values(vmrs_ref(i, joker), other.vmrs_ref(i, joker)))
+      return false;
+  return true;
+}
+
+//! Append the frequencies of another table to this one.
+/*!
+  This allows to calculate a lookup table in several independent jobs,
+  each one for a part of the frequency range, and to merge the parts
+  afterwards. The other table must have the same setup (see HasSameSetup)
+  apart from the frequency grid, and its frequencies must not occur in
+  this table. The merged frequency grid is sorted.
+
+  The merged table has to be adapted to the current calculation again.
+
+  \param[in] other The table with the frequencies to append.
+*/
+void GasAbsLookup::AppendFrequencies(const GasAbsLookup& other) {
+  if (IsCompressed() || other.IsCompressed()) {
+    throw runtime_error("Compressed lookup tables cannot be merged.");
+  }
+
+  if (!HasSameSetup(other, false)) {
+    throw runtime_error(
+        "Lookup tables can only be merged if they have the same species,\n"
+        "nonlinear species, pressure grid, perturbations and reference\n"
+        "profiles.");
+  }
+
+  const Index n_f_this = f_grid.nelem();
+  const Index n_f_other = other.f_grid.nelem();
+  const Index n_f = n_f_this + n_f_other;
+
+  // Merge the frequency grids. Both grids are sorted, so this can be
+  // done in a single pass. src_table[i] and src_index[i] hold the table
+  // and the frequency index for merged frequency i.
+  Vector new_f_grid(n_f);
+  ArrayOfIndex src_table(n_f), src_index(n_f);
+  for (Index i = 0, a = 0, b = 0; i < n_f; ++i) {
+    if (b >= n_f_other || (a < n_f_this && f_grid[a] < other.f_grid[b])) {
+      new_f_grid[i] = f_grid[a];
+      src_table[i] = 0;
+      src_index[i] = a++;
+    } else {
+      new_f_grid[i] = other.f_grid[b];
+      src_table[i] = 1;
+      src_index[i] = b++;
+    }
+    if (i > 0 && new_f_grid[i] <= new_f_grid[i - 1]) {
+      ostringstream os;
+      os << "The frequency grids of the lookup tables to merge overlap.\n"
+         << "Frequency " << new_f_grid[i] << " Hz is contained in both.";
+      throw runtime_error(os.str());
+    }
+  }
+
+  Tensor4 new_xsec(xsec.nbooks(), xsec.npages(), n_f, xsec.ncols());
+  for (Index i = 0; i < n_f; ++i) {
+    const Tensor4& x = src_table[i] ? other.xsec : xsec;
+    new_xsec(joker, joker, i, joker) = x(joker, joker, src_index[i], joker);
+  }
+
+  f_grid = new_f_grid;
+  xsec = new_xsec;
+
+  // fgp_default only fits an adapted table.
+  fgp_default.resize(0);
+}
+
+//! Replace the cross sections by a k-distribution.
+/*!
+  The frequency grid of the table is divided into the bands given by
+  band_edges. Inside each band the frequencies are sorted by the column
+  optical depth of all species together, calculated for the reference
+  profiles of the table, and the cumulative distribution of the sorted
+  frequencies is divided into the g-intervals given by g_edges. Each
+  non-empty interval becomes a g-point, having the mean cross sections of
+  its frequencies, for each species, pressure and perturbation. As the
+  same ordering is used for all species, the absorption of overlapping
+  species is treated as fully correlated.
+
+  The frequency grid of the table is replaced by the mean frequency of
+  each g-point, which is where the Planck function will be evaluated. The
+  g-points are sorted by this frequency. The original frequency grid is
+  integrated with the trapezoidal rule, and the weights give the part of
+  that integral represented by each g-point.
+
+  The table must be adapted and must not be compressed. It stays adapted
+  to the new frequency grid.
+
+  \param[out] weights    The integration weight of each g-point [Hz].
+  \param[in] band_edges  Limits of the bands [Hz]. An empty vector gives
+                         a single band covering the frequency grid.
+  \param[in] g_edges     Limits of the g-intervals, from 0 to 1.
+*/
+void GasAbsLookup::ConvertToKDistribution(Vector& weights,
+                                          ConstVectorView band_edges,
+                                          ConstVectorView g_edges) {
+  const Index n_f = f_grid.nelem();
+  const Index n_p = p_grid.nelem();
+  const Index n_species = species.nelem();
+  const Index n_g_edges = g_edges.nelem();
+
+  if (IsCompressed())
+    throw runtime_error(
+        "Compressed lookup tables cannot be converted to a k-distribution.");
+  if (fgp_default.nelem() != n_f)
+    throw runtime_error(
+        "The lookup table must be adapted before it can be converted\n"
+        "to a k-distribution.");
+  if (n_f < 2)
+    throw runtime_error(
+        "The lookup table must have at least two frequencies.");
+
+  if (n_g_edges < 2 || g_edges[0] != 0 || g_edges[n_g_edges - 1] != 1)
+    throw runtime_error("*g_edges* must start with 0 and end with 1.");
+  chk_if_increasing("g_edges", g_edges);
+
+  Vector edges{f_grid[0], f_grid[n_f - 1]};
+  if (band_edges.nelem()) {
+    chk_if_increasing("band_edges", band_edges);
+    if (band_edges.nelem() < 2 || band_edges[0] > f_grid[0] ||
+        band_edges[band_edges.nelem() - 1] < f_grid[n_f - 1]) {
+      ostringstream os;
+      os << "The bands must cover the frequency grid of the lookup table,\n"
+         << f_grid[0] << " to " << f_grid[n_f - 1] << " Hz.";
+      throw runtime_error(os.str());
+    }
+    edges = band_edges;
+  }
+  const Index n_bands = edges.nelem() - 1;
+
+  // Trapezoidal integration weights of the original frequency grid:
+  Vector wf(n_f);
+  for (Index i = 0; i < n_f; ++i)
+    wf[i] = 0.5 * (f_grid[min(i + 1, n_f - 1)] - f_grid[max(i - 1, Index(0))]);
+
+  // The column optical depth of all species for the reference profiles,
+  // up to a constant factor. With hydrostatic equilibrium and the ideal
+  // gas law, dz is proportional to T/p dp.
+  Vector tau(n_f, 0);
+  {
+    Matrix sga;
+    for (Index ip = 0; ip < n_p; ++ip) {
+      const Numeric dp =
+          n_p > 1 ? 0.5 * abs(p_grid[min(ip + 1, n_p - 1)] -
+                              p_grid[max(ip - 1, Index(0))])
+                  : 1;
+      Extract(sga,
+              0,
+              0,
+              0,
+              0,
+              p_grid[ip],
+              t_ref[ip],
+              vmrs_ref(joker, ip),
+              f_grid,
+              0.5);
+      const Numeric scale = t_ref[ip] / p_grid[ip] * dp;
+      for (Index is = 0; is < n_species; ++is)
+        for (Index i = 0; i < n_f; ++i)
+          if (std::isfinite(sga(is, i))) tau[i] += sga(is, i) * scale;
+    }
+  }
+
+  // Assign the frequencies to g-points, band by band:
+  ArrayOfIndex g_of_f(n_f);
+  std::vector<Numeric> g_weight, g_freq;
+  std::vector<Index> order;
+  for (Index ib = 0, i = 0; ib < n_bands; ++ib) {
+    order.clear();
+    while (i < n_f && (f_grid[i] < edges[ib + 1] || ib == n_bands - 1))
+      order.push_back(i++);
+    if (order.empty()) continue;
+
+    std::stable_sort(order.begin(), order.end(), [&tau](Index a, Index b) {
+      return tau[a] < tau[b];
+    });
+
+    Numeric band_weight = 0;
+    for (const Index j : order) band_weight += wf[j];
+
+    Numeric cum_weight = 0;
+    Index k = 0, last_k = -1;
+    for (const Index j : order) {
+      const Numeric g = (cum_weight + 0.5 * wf[j]) / band_weight;
+      cum_weight += wf[j];
+      while (k < n_g_edges - 2 && g > g_edges[k + 1]) ++k;
+      if (k != last_k) {
+        g_weight.push_back(0);
+        g_freq.push_back(0);
+        last_k = k;
+      }
+      g_of_f[j] = Index(g_weight.size()) - 1;
+      g_weight.back() += wf[j];
+      g_freq.back() += wf[j] * f_grid[j];
+    }
+  }
+  const Index n_g = Index(g_weight.size());
+
+  // Sort the g-points by their mean frequency:
+  ArrayOfIndex g_order(n_g), g_rank(n_g);
+  for (Index k = 0; k < n_g; ++k) {
+    g_freq[size_t(k)] /= g_weight[size_t(k)];
+    g_order[k] = k;
+  }
+  std::stable_sort(g_order.begin(), g_order.end(), [&g_freq](Index a, Index b) {
+    return g_freq[size_t(a)] < g_freq[size_t(b)];
+  });
+
+  Vector new_f_grid(n_g);
+  weights.resize(n_g);
+  for (Index k = 0; k < n_g; ++k) {
+    g_rank[g_order[k]] = k;
+    new_f_grid[k] = g_freq[size_t(g_order[k])];
+    weights[k] = g_weight[size_t(g_order[k])];
+    // The frequency grid must be strictly increasing. Two g-points with
+    // the same mean frequency are extremely unlikely, but possible.
+    if (k > 0 && new_f_grid[k] <= new_f_grid[k - 1])
+      new_f_grid[k] = nextafter(new_f_grid[k - 1], DBL_MAX);
+  }
+
+  Tensor4 new_xsec(xsec.nbooks(), xsec.npages(), n_g, xsec.ncols(), 0);
+  for (Index i = 0; i < n_f; ++i) {
+    const Index k = g_rank[g_of_f[i]];
+    const Numeric w = wf[i] / weights[k];
+    for (Index ia = 0; ia < xsec.nbooks(); ++ia)
+      for (Index ib = 0; ib < xsec.npages(); ++ib)
+        for (Index ip = 0; ip < xsec.ncols(); ++ip)
+          new_xsec(ia, ib, k, ip) += w * xsec(ia, ib, i, ip);
+  }
+
+  f_grid = new_f_grid;
+  xsec = new_xsec;
+
+  fgp_default.resize(n_g);
+  gridpos_poly(fgp_default, f_grid, f_grid, 0);
+}
+
+//! Compress the absorption cross sections.
+/*!
+  The cross sections are converted to single precision, which halves the
+  memory needed for the table. To make use of the full range of single
+  precision numbers, each species (and H2O VMR variant) is scaled by its
+  maximum absolute value first. The maximum relative error caused by the
+  conversion is stored and can be obtained with GetCompressionError().
+
+  Extract works transparently on compressed tables, decompressing only
+  the part of the table it needs.
+*/
+void GasAbsLookup::Compress() {
+  if (IsCompressed()) return;
+
+  const Index a = xsec.nbooks();
+  const Index b = xsec.npages();
+  const Index c = xsec.nrows();
+  const Index d = xsec.ncols();
+
+  Vector scale(b, 0);
+  for (Index ib = 0; ib < b; ++ib) {
+    for (Index ia = 0; ia < a; ++ia)
+      for (Index ic = 0; ic < c; ++ic)
+        for (Index id = 0; id < d; ++id)
+          scale[ib] = max(scale[ib], abs(xsec(ia, ib, ic, id)));
+    // Avoid division by zero for species without absorption (or
+    // trivial species which are set to NAN):
+    if (!(scale[ib] > 0) || !std::isfinite(scale[ib])) scale[ib] = 1;
+  }
+
+  Numeric max_rel_err = 0;
+  xsec_compressed.resize(size_t(a * b * c * d));
+  std::vector<float>::iterator it = xsec_compressed.begin();
+  for (Index ia = 0; ia < a; ++ia)
+    for (Index ib = 0; ib < b; ++ib)
+      for (Index id = 0; id < d; ++id)
+        for (Index ic = 0; ic < c; ++ic, ++it) {
+          const Numeric x = xsec(ia, ib, ic, id);
+          *it = static_cast<float>(x / scale[ib]);
+          if (x != 0 && std::isfinite(x))
+            max_rel_err = max(max_rel_err,
+                              abs((Numeric(*it) * scale[ib] - x) / x));
+        }
+
+  xsec_scale = scale;
+  compression_error = max_rel_err;
+  xsec.resize(0, 0, 0, 0);
+}
+
+//! Undo the compression of the absorption cross sections.
+/*!
+  Restores the cross sections in double precision. The error introduced
+  by the compression remains.
+*/
+void GasAbsLookup::Decompress() {
+  if (!IsCompressed()) return;
+
+  Tensor4 x;
+  GetXsec(x);
+  xsec = x;
+  xsec_compressed.clear();
+  xsec_compressed.shrink_to_fit();
+  xsec_scale.resize(0);
+}
+
+//! Get the absorption cross sections.
+/*!
+  For an uncompressed table this is a copy of xsec, for a compressed
+  table the decompressed cross sections.
+
+  \param[out] x The absorption cross sections, see xsec for dimensions.
+*/
+void GasAbsLookup::GetXsec(Tensor4& x) const {
+  if (!IsCompressed()) {
+    x = xsec;
+    return;
+  }
+
+  const Index a = t_pert.nelem() ? t_pert.nelem() : 1;
+  const Index b = xsec_scale.nelem();
+  const Index c = f_grid.nelem();
+  const Index d = p_grid.nelem();
+
+  x.resize(a, b, c, d);
+  std::vector<float>::const_iterator it = xsec_compressed.begin();
+  for (Index ia = 0; ia < a; ++ia)
+    for (Index ib = 0; ib < b; ++ib)
+      for (Index id = 0; id < d; ++id)
+        for (Index ic = 0; ic < c; ++ic, ++it)
+          x(ia, ib, ic, id) = Numeric(*it) * xsec_scale[ib];
+}
+
+//! Decompress the part of a compressed table needed for an interpolation.
+/*!
+  Only the temperature and H2O VMR perturbations that the interpolation
+  uses are decompressed, so that the work is proportional to that of the
+  interpolation itself. The slab holds them in the order of the
+  interpolation points, and slab_tgp and slab_vgp are the grid positions
+  to use with the slab instead of tgp and vgp.
+
+  \param[out] slab      The decompressed cross sections, dimensions are the
+                        points of tgp, the points of vgp and frequency.
+  \param[out] slab_tgp  Temperature grid positions for the slab.
+  \param[out] slab_vgp  H2O VMR grid positions for the slab.
+  \param[in]  tgp       Temperature grid positions in the table.
+  \param[in]  vgp       H2O VMR grid positions in the table, relative to
+                        b_start.
+  \param[in]  b_start   First index of the species in the second dimension
+                        of xsec.
+  \param[in]  p_index   The pressure index.
+*/
+void GasAbsLookup::DecompressSlab(Tensor3& slab,
+                                  ArrayOfGridPosPoly& slab_tgp,
+                                  ArrayOfGridPosPoly& slab_vgp,
+                                  const ArrayOfGridPosPoly& tgp,
+                                  const ArrayOfGridPosPoly& vgp,
+                                  const Index b_start,
+                                  const Index p_index) const {
+  assert(tgp.nelem() == 1);
+  assert(vgp.nelem() == 1);
+
+  const Index b = xsec_scale.nelem();
+  const Index c = f_grid.nelem();
+  const Index d = p_grid.nelem();
+  const Index nt = tgp[0].idx.nelem();
+  const Index nv = vgp[0].idx.nelem();
+
+  slab.resize(nt, nv, c);
+  for (Index it = 0; it < nt; ++it)
+    for (Index iv = 0; iv < nv; ++iv) {
+      const Index ib = b_start + vgp[0].idx[iv];
+      const Numeric scale = xsec_scale[ib];
+      const float* x = &xsec_compressed[size_t(
+          ((tgp[0].idx[it] * b + ib) * d + p_index) * c)];
+      for (Index ic = 0; ic < c; ++ic) slab(it, iv, ic) = Numeric(x[ic]) * scale;
+    }
+
+  slab_tgp = tgp;
+  for (Index it = 0; it < nt; ++it) slab_tgp[0].idx[it] = it;
+  slab_vgp = vgp;
+  for (Index iv = 0; iv < nv; ++iv) slab_vgp[0].idx[iv] = iv;
+}
+
 const Vector& GasAbsLookup::GetFgrid() const { return f_grid; }
 
 const Vector& GasAbsLookup::GetPgrid() const { return p_grid; }
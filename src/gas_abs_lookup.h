@@ -26,6 +26,7 @@
 #ifndef gas_abs_lookup_h
 #define gas_abs_lookup_h
 
+#include <vector>
 #include "abs_species_tags.h"
 #include "absorption.h"
 #include "interpolation_poly.h"
@@ -53,7 +54,10 @@ class GasAbsLookup {
         t_ref(),
         t_pert(),
         nls_pert(),
-        xsec() { /* Nothing to do here */
+        xsec(),
+        xsec_compressed(),
+        xsec_scale(),
+        compression_error(0) { /* Nothing to do here */
   }
 
   // Documentation is with the implementation!
@@ -73,6 +77,33 @@ class GasAbsLookup {
                ConstVectorView new_f_grid,
                const Numeric& extpolfac) const;
 
+  // Documentation is with the implementation!
+  void Compress();
+
+  // Documentation is with the implementation!
+  void Decompress();
+
+  //! Check if the cross sections are stored in compressed form.
+  bool IsCompressed() const { return xsec_scale.nelem() > 0; }
+
+  //! Maximum relative error of the cross sections caused by compression.
+  Numeric GetCompressionError() const { return compression_error; }
+
+  // Documentation is with the implementation!
+  void GetXsec(Tensor4& x) const;
+
+  // Documentation is with the implementation!
+  bool HasSameSetup(const GasAbsLookup& other,
+                    const bool check_f_grid = true) const;
+
+  // Documentation is with the implementation!
+  void AppendFrequencies(const GasAbsLookup& other);
+
+  // Documentation is with the implementation!
+  void ConvertToKDistribution(Vector& weights,
+                              ConstVectorView band_edges,
+                              ConstVectorView g_edges);
+
   const Vector& GetFgrid() const;
 
   const Vector& GetPgrid() const;
@@ -107,6 +138,8 @@ class GasAbsLookup {
       const Vector& abs_t_pert,
       const Vector& abs_nls_pert,
       const Agenda& abs_xsec_agenda,
+      // WS Generic Input:
+      const String& checkpoint_dir,
       // Verbosity object:
       const Verbosity& verbosity);
 
@@ -150,6 +183,26 @@ class GasAbsLookup {
       // Verbosity object:
       const Verbosity& verbosity);
 
+  friend void abs_lookupTestKDistribution(  // WS Generic Output:
+      Matrix& irradiance_lbl,
+      Matrix& irradiance_ckd,
+      Vector& heating_rates_lbl,
+      Vector& heating_rates_ckd,
+      // WS Input:
+      const GasAbsLookup& abs_lookup,
+      const Index& abs_lookup_is_adapted,
+      const Index& abs_p_interp_order,
+      const Index& abs_t_interp_order,
+      const Index& abs_nls_interp_order,
+      const Numeric& g0,
+      const Numeric& molarmass_dry_air,
+      // WS Generic Input:
+      const GasAbsLookup& abs_lookup_lbl,
+      const Vector& f_grid_weights,
+      const Numeric& specific_heat,
+      // Verbosity object:
+      const Verbosity& verbosity);
+
   friend void nca_read_from_file(const int ncid,
                                  GasAbsLookup& gal,
                                  const Verbosity&);
@@ -159,6 +212,15 @@ class GasAbsLookup {
                                 const Verbosity&);
 
  private:
+  // Documentation is with the implementation!
+  void DecompressSlab(Tensor3& slab,
+                      ArrayOfGridPosPoly& slab_tgp,
+                      ArrayOfGridPosPoly& slab_vgp,
+                      const ArrayOfGridPosPoly& tgp,
+                      const ArrayOfGridPosPoly& vgp,
+                      const Index b_start,
+                      const Index p_index) const;
+
   //! The species tags for which the table is valid.
   ArrayOfArrayOfSpeciesTag species;
 
@@ -274,6 +336,27 @@ class GasAbsLookup {
     dimensions of abs_per_tg in ARTS-1-0. This should simplify
     computation of the lookup table with the old ARTS version.  */
   Tensor4 xsec;
+
+  //! Compressed absorption cross sections.
+  /*!
+    Only used if the table has been compressed with Compress(), xsec is
+    then empty. The cross sections are stored in single precision,
+    divided by the scaling factor in xsec_scale for the second dimension
+    of xsec. The element order is [a, b, d, c], that is, pressure comes
+    before frequency, so that the data for one pressure level are
+    contiguous.
+
+    This is not stored with the table. */
+  std::vector<float> xsec_compressed;
+
+  //! Scaling factors for xsec_compressed.
+  /*!
+    One for each element of the second dimension of xsec. The vector is
+    empty for an uncompressed table. */
+  Vector xsec_scale;
+
+  //! Maximum relative error of the cross sections caused by compression.
+  Numeric compression_error;
 };
 
 ostream& operator<<(ostream& os, const GasAbsLookup& gal);
@@ -131,6 +131,7 @@ void define_wsv_group_names() {
   wsv_group_names.push_back("ArrayOfXsecRecord");
   wsv_group_names.push_back("CIARecord");
   wsv_group_names.push_back("CovarianceMatrix");
+  wsv_group_names.push_back("DoitGeometryCache");
   wsv_group_names.push_back("GasAbsLookup");
   wsv_group_names.push_back("GridPos");
   wsv_group_names.push_back("GriddedField1");
@@ -140,14 +141,17 @@ void define_wsv_group_names() {
   wsv_group_names.push_back("GriddedField5");
   wsv_group_names.push_back("GriddedField6");
   wsv_group_names.push_back("Index");
+  wsv_group_names.push_back("IybCache");
   wsv_group_names.push_back("MCAntenna");
   wsv_group_names.push_back("Matrix");
   wsv_group_names.push_back("Numeric");
+  wsv_group_names.push_back("PndFieldCache");
   wsv_group_names.push_back("Ppath");
   wsv_group_names.push_back("PropagationMatrix");
   wsv_group_names.push_back("QuantumIdentifier");
   wsv_group_names.push_back("RadiationVector");
   wsv_group_names.push_back("Rational");
+  wsv_group_names.push_back("ScatteringDatabase");
   wsv_group_names.push_back("ScatteringMetaData");
   wsv_group_names.push_back("SingleScatteringData");
   wsv_group_names.push_back("Sparse");
@@ -9,8 +9,10 @@ extern std::string string_buffer;
 
 namespace global_data {
 extern Array<MdRecord> md_data;
+extern ArrayOfString wsv_group_names;
 }
 using global_data::md_data;
+using global_data::wsv_group_names;
 
 Index get_wsv_id(const char *);
 
@@ -40,6 +42,105 @@ MdRecord callback_mr = MdRecord("APICallback",
                                 false,
                                 false);
 
+//! Workspace variable bound to external memory.
+/*!
+  Common base of the tensor objects that are placed on the workspace
+  by InteractiveWorkspace::set_variable_view.
+*/
+class ExternalData {
+ public:
+  virtual ~ExternalData() = default;
+
+  //! Pointer to the tensor object as expected by the workspace.
+  virtual void *wsv() = 0;
+};
+
+//! Tensor using memory that it does not own.
+/*!
+  The data pointer and the ranges of the tensor are set directly to
+  describe the external, row-major memory. The pointer is reset before
+  the destructor of the tensor class runs so the memory is never freed.
+*/
+template <typename T>
+class ExternalTensor : public ExternalData, public T {
+ public:
+  ExternalTensor(const long *dimensions, const Numeric *src) {
+    // The memory is only exposed as input to methods, see find_view.
+    this->mdata = const_cast<Numeric *>(src);
+    set_ranges(dimensions);
+  }
+
+  ~ExternalTensor() { this->mdata = nullptr; }
+
+  void *wsv() { return static_cast<T *>(this); }
+
+ private:
+  void set_ranges(const long *d);
+};
+
+//! Stride of dimension i of a row-major tensor with n dimensions.
+static Index row_major_stride(const long *d, Index i, Index n) {
+  Index stride = 1;
+  for (Index j = i + 1; j < n; ++j) stride *= d[j];
+  return stride;
+}
+
+template <>
+void ExternalTensor<Vector>::set_ranges(const long *d) {
+  mrange = Range(0, d[0]);
+}
+
+template <>
+void ExternalTensor<Matrix>::set_ranges(const long *d) {
+  mrr = Range(0, d[0], row_major_stride(d, 0, 2));
+  mcr = Range(0, d[1]);
+}
+
+template <>
+void ExternalTensor<Tensor3>::set_ranges(const long *d) {
+  mpr = Range(0, d[0], row_major_stride(d, 0, 3));
+  mrr = Range(0, d[1], row_major_stride(d, 1, 3));
+  mcr = Range(0, d[2]);
+}
+
+template <>
+void ExternalTensor<Tensor4>::set_ranges(const long *d) {
+  mbr = Range(0, d[0], row_major_stride(d, 0, 4));
+  mpr = Range(0, d[1], row_major_stride(d, 1, 4));
+  mrr = Range(0, d[2], row_major_stride(d, 2, 4));
+  mcr = Range(0, d[3]);
+}
+
+template <>
+void ExternalTensor<Tensor5>::set_ranges(const long *d) {
+  msr = Range(0, d[0], row_major_stride(d, 0, 5));
+  mbr = Range(0, d[1], row_major_stride(d, 1, 5));
+  mpr = Range(0, d[2], row_major_stride(d, 2, 5));
+  mrr = Range(0, d[3], row_major_stride(d, 3, 5));
+  mcr = Range(0, d[4]);
+}
+
+template <>
+void ExternalTensor<Tensor6>::set_ranges(const long *d) {
+  mvr = Range(0, d[0], row_major_stride(d, 0, 6));
+  msr = Range(0, d[1], row_major_stride(d, 1, 6));
+  mbr = Range(0, d[2], row_major_stride(d, 2, 6));
+  mpr = Range(0, d[3], row_major_stride(d, 3, 6));
+  mrr = Range(0, d[4], row_major_stride(d, 4, 6));
+  mcr = Range(0, d[5]);
+}
+
+template <>
+void ExternalTensor<Tensor7>::set_ranges(const long *d) {
+  mlr = Range(0, d[0], row_major_stride(d, 0, 7));
+  mvr = Range(0, d[1], row_major_stride(d, 1, 7));
+  msr = Range(0, d[2], row_major_stride(d, 2, 7));
+  mbr = Range(0, d[3], row_major_stride(d, 3, 7));
+  mpr = Range(0, d[4], row_major_stride(d, 4, 7));
+  mrr = Range(0, d[5], row_major_stride(d, 5, 7));
+  mcr = Range(0, d[6]);
+}
+
 InteractiveWorkspace::InteractiveWorkspace(const Index verbosity,
                                            const Index agenda_verbosity)
     : Workspace() {
@@ -50,6 +151,12 @@ InteractiveWorkspace::InteractiveWorkspace(const Index verbosity,
   verbosity_at_launch.set_file_verbosity(0);
 }
 
+InteractiveWorkspace::~InteractiveWorkspace() {
+  while (!views_.empty()) {
+    release_variable_view(views_.begin()->first);
+  }
+}
+
 void InteractiveWorkspace::initialize() {
   define_wsv_group_names();
   Workspace::define_wsv_data();
@@ -74,6 +181,13 @@ void InteractiveWorkspace::initialize() {
 
 const char *InteractiveWorkspace::execute_agenda(const Agenda *a) {
   resize();
+  std::set<Index> visited;
+  Index i = find_view(*a, visited);
+  if (i >= 0) {
+    string_buffer = "Agenda " + a->name() + " has " + wsv_data[i].Name() +
+                    " as output but it is bound to external memory.";
+    return string_buffer.c_str();
+  }
   try {
     a->execute(*this);
   } catch (const std::exception &e) {
@@ -97,6 +211,16 @@ const char *InteractiveWorkspace::execute_workspace_method(
   }
 
   // Make sure verbosity is set.
+  std::set<Index> visited;
+  Index i_view = find_view(output, input, Agenda(), visited);
+  if (i_view < 0 && m.Name() == "Delete")
+    i_view = find_view(input, ArrayOfIndex(), Agenda(), visited);
+  if (i_view >= 0) {
+    string_buffer = "Method " + m.Name() + " has " + wsv_data[i_view].Name() +
+                    " as output but it is bound to external memory.";
+    return string_buffer.c_str();
+  }
+
   Index wsv_id_verbosity = get_wsv_id("verbosity");
   Verbosity &verbosity = *((Verbosity *)this->operator[](wsv_id_verbosity));
   verbosity.set_main_agenda(true);
@@ -268,6 +392,101 @@ void InteractiveWorkspace::set_sparse_variable(Index id,
   dst->insert_elements(nnz, row_indices, column_indices, elements);
 }
 
+void InteractiveWorkspace::set_variable_view(Index id,
+                                             Index group_id,
+                                             const long *dimensions,
+                                             const Numeric *src) {
+  if (wsv_data[id].Group() != group_id) {
+    throw runtime_error("Group of variable " + wsv_data[id].Name() +
+                        " does not match the given group.");
+  }
+
+  if (!src) {
+    throw runtime_error("Can not bind variable " + wsv_data[id].Name() +
+                        " to a null pointer.");
+  }
+
+  const String &group = wsv_group_names[group_id];
+  std::unique_ptr<ExternalData> view;
+  if (group == "Vector") {
+    view.reset(new ExternalTensor<Vector>(dimensions, src));
+  } else if (group == "Matrix") {
+    view.reset(new ExternalTensor<Matrix>(dimensions, src));
+  } else if (group == "Tensor3") {
+    view.reset(new ExternalTensor<Tensor3>(dimensions, src));
+  } else if (group == "Tensor4") {
+    view.reset(new ExternalTensor<Tensor4>(dimensions, src));
+  } else if (group == "Tensor5") {
+    view.reset(new ExternalTensor<Tensor5>(dimensions, src));
+  } else if (group == "Tensor6") {
+    view.reset(new ExternalTensor<Tensor6>(dimensions, src));
+  } else if (group == "Tensor7") {
+    view.reset(new ExternalTensor<Tensor7>(dimensions, src));
+  } else {
+    throw runtime_error("Variables of group " + group +
+                        " can not be bound to external memory.");
+  }
+
+  release_variable_view(id);
+  push(id, view->wsv());
+  views_[id] = std::move(view);
+}
+
+void InteractiveWorkspace::release_variable_view(Index id) {
+  auto it = views_.find(id);
+  if (it == views_.end()) {
+    return;
+  }
+  // The view is not auto allocated, so pop does not free it.
+  pop(id);
+  views_.erase(it);
+}
+
+Index InteractiveWorkspace::find_view(const ArrayOfIndex &output,
+                                      const ArrayOfIndex &input,
+                                      const Agenda &tasks,
+                                      std::set<Index> &visited) {
+  if (views_.empty()) {
+    return -1;
+  }
+  for (Index i : output) {
+    if (is_view(i)) {
+      return i;
+    }
+  }
+
+  Index i_view = find_view(tasks, visited);
+  for (Index i : input) {
+    if (i_view >= 0) break;
+    if (!is_agenda_group_id(wsv_data[i].Group()) || !is_initialized(i) ||
+        !visited.insert(i).second) {
+      continue;
+    }
+    if (wsv_group_names[wsv_data[i].Group()] == "Agenda") {
+      i_view = find_view(*reinterpret_cast<Agenda *>(this->operator[](i)),
+                         visited);
+    } else {
+      for (const Agenda &a :
+           *reinterpret_cast<ArrayOfAgenda *>(this->operator[](i))) {
+        i_view = find_view(a, visited);
+        if (i_view >= 0) break;
+      }
+    }
+  }
+  return i_view;
+}
+
+Index InteractiveWorkspace::find_view(const Agenda &a,
+                                      std::set<Index> &visited) {
+  for (const MRecord &mr : a.Methods()) {
+    Index i = find_view(mr.Out(), mr.In(), mr.Tasks(), visited);
+    if (i >= 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 void InteractiveWorkspace::resize() {
   Array<stack<WsvStruct *>> ws_new(wsv_data.nelem());
   std::copy(ws.begin(), ws.end(), ws_new.begin());
@@ -275,6 +494,7 @@ void InteractiveWorkspace::resize() {
 }
 
 void InteractiveWorkspace::initialize_variable(Index i) {
+  release_variable_view(i);
   this->operator[](i);
   this->pop_free(i);
   this->operator[](i);
@@ -309,6 +529,15 @@ Index InteractiveWorkspace::add_variable(Index group_id, const char *name) {
 }
 
 void InteractiveWorkspace::erase_variable(Index i, Index group_id) {
+  release_variable_view(i);
+
+  // Views of variables behind the erased one move down by one index.
+  std::map<Index, std::unique_ptr<ExternalData>> views;
+  for (auto &v : views_) {
+    views[v.first > i ? v.first - 1 : v.first] = std::move(v.second);
+  }
+  std::swap(views_, views);
+
   WsvStruct *wsvs;
   while (ws[i].size()) {
     wsvs = ws[i].top();
@@ -326,6 +555,16 @@ void InteractiveWorkspace::erase_variable(Index i, Index group_id) {
 }
 
 void InteractiveWorkspace::swap(Index i, Index j) {
+  if (is_view(i) || is_view(j)) {
+    std::unique_ptr<ExternalData> vi, vj;
+    if (is_view(i)) vi = std::move(views_[i]);
+    if (is_view(j)) vj = std::move(views_[j]);
+    views_.erase(i);
+    views_.erase(j);
+    if (vi) views_[j] = std::move(vi);
+    if (vj) views_[i] = std::move(vj);
+  }
+
   if (is_initialized(i) && is_initialized(j)) {
     std::swap(ws[i], ws[j]);
   } else if (!is_initialized(i) && is_initialized(j)) {
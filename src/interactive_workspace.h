@@ -30,12 +30,16 @@
 #ifndef INTERACTIVE_WORKSPACE_INCLUDED
 #define INTERACTIVE_WORKSPACE_INCLUDED
 
+#include <map>
+#include <memory>
+#include <set>
 #include "agenda_class.h"
 #include "workspace_ng.h"
 
 extern void (*getaways[])(Workspace &, const MRecord &);
 
 class InteractiveWorkspace;
+class ExternalData;
 
 //! External callbacks.
 /*!
@@ -71,6 +75,8 @@ class InteractiveWorkspace : private Workspace {
   InteractiveWorkspace(const Index verbosity = 1,
                        const Index agenda_verbosity = 0);
 
+  ~InteractiveWorkspace();
+
   using Workspace::is_initialized;
   using Workspace::operator[];
 
@@ -127,6 +133,42 @@ class InteractiveWorkspace : private Workspace {
                            const int *outer_ptr);
   void resize();
 
+  //! Bind workspace variable to external memory.
+  /*!
+    Places a tensor object on top of the stack of the given workspace
+    variable that uses the given memory as its data without copying it.
+    The memory must be contiguous, in row-major order and remain valid
+    until the view is released. The previous value of the variable is
+    restored when the view is released.
+
+    Views are read-only from the point of view of the workspace: methods
+    and agendas that have a view among their outputs are not executed.
+
+    Supported groups are Vector, Matrix and Tensor3 to Tensor7.
+
+    \param id Workspace variable index of the variable to bind.
+    \param group_id Index of the group of the variable.
+    \param dimensions Pointer to array holding the size of each dimension.
+    \param src Pointer to the data of the tensor.
+    */
+  void set_variable_view(Index id,
+                         Index group_id,
+                         const long *dimensions,
+                         const Numeric *src);
+
+  //! Release view of external memory.
+  /*!
+    Removes the view created by set_variable_view from the workspace. The
+    external memory is not touched. Does nothing if the variable is not
+    bound to external memory.
+
+    \param id Workspace variable index of the variable.
+    */
+  void release_variable_view(Index id);
+
+  //! Check whether workspace variable is bound to external memory.
+  bool is_view(Index id) const { return views_.count(id) > 0; }
+
   void execute_callback(Index callback_id) {
     callbacks_[callback_id]->execute(*this);
   }
@@ -177,6 +219,25 @@ class InteractiveWorkspace : private Workspace {
   void swap(Index i, Index j);
 
  private:
+  //! Return index of first view in list of outputs or -1.
+  /*!
+    The methods of the agendas among the inputs, and of tasks, are searched
+    as well, since they may write to any variable when executed.
+
+    \param output Workspace variable indices of the outputs.
+    \param input Workspace variable indices of the inputs.
+    \param tasks Agenda given directly to the method.
+    \param visited Agenda variables that have already been searched.
+    */
+  Index find_view(const ArrayOfIndex &output,
+                  const ArrayOfIndex &input,
+                  const Agenda &tasks,
+                  std::set<Index> &visited);
+
+  //! Return index of first view among the outputs of an agenda or -1.
+  Index find_view(const Agenda &a, std::set<Index> &visited);
+
+  std::map<Index, std::unique_ptr<ExternalData>> views_;
   static size_t n_anonymous_variables_;
   static std::vector<Callback *> callbacks_;
 };
@@ -403,8 +403,11 @@ void gridpos(ArrayOfGridPos& gp,
 /*!
    Creates a grid position structure.
   
-   This is a gateway to the function for arrays of grid positions, to be
-   used for e.g. "red interpolation".
+   This is the single point version of the function for arrays of grid
+   positions, to be used for e.g. "red interpolation". The result is
+   identical to calling that function with a new grid of length 1, but
+   the position is found by bisection and no temporary arrays are
+   allocated.
 
    \retval  gp         The GridPos structure. 
    \param   old_grid   The original grid.
@@ -425,10 +428,47 @@ void gridpos(GridPos& gp,
              ConstVectorView old_grid,
              const Numeric& new_grid,
              const Numeric& extpolfac) {
-  ArrayOfGridPos agp(1);
-  Vector v(1, new_grid);
-  gridpos(agp, old_grid, v, extpolfac);
-  gridpos_copy(gp, agp[0]);
+  const Index n_old = old_grid.nelem();
+
+  // Assert, that the old grid has more than one element
+  assert(1 < n_old);
+
+  const bool ascending = (old_grid[0] <= old_grid[1]);
+
+  // Check extrapolation limits, as done by the array version
+#ifndef NDEBUG
+  const Numeric og_first =
+      old_grid[0] - extpolfac * (old_grid[1] - old_grid[0]);
+  const Numeric og_last =
+      old_grid[n_old - 1] +
+      extpolfac * (old_grid[n_old - 1] - old_grid[n_old - 2]);
+  if (ascending) {
+    assert(og_first <= new_grid);
+    assert(new_grid <= og_last);
+  } else {
+    assert(og_last <= new_grid);
+    assert(new_grid <= og_first);
+  }
+#else
+  (void)extpolfac;
+#endif
+
+  // Find the last grid point at or below (ascending), or at or above
+  // (descending), new_grid. The range is limited to [0, n_old-2], so that
+  // the outermost intervals are used for extrapolation and a point on top
+  // of the last grid point gets fd[0] = 1.
+  Index lo = 0, hi = n_old - 1;
+  while (hi - lo > 1) {
+    const Index mid = (lo + hi) / 2;
+    if (ascending ? old_grid[mid] <= new_grid : old_grid[mid] >= new_grid)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  gp.idx = lo;
+  gp.fd[0] = (new_grid - old_grid[lo]) / (old_grid[lo + 1] - old_grid[lo]);
+  gp.fd[1] = 1.0 - gp.fd[0];
 }
 
 //! gridpos_1to1
@@ -620,6 +660,28 @@ void gridpos_upperend_check(ArrayOfGridPos& gp, const Index& ie) {
   }
 }
 
+//! gridpos_lowerend_check
+/*!
+   A function to handle the lower end after shifts of grid positions
+
+   The counterpart of gridpos_upperend_check. A position exactly at the
+   lower cloudbox boundary can be given as the end of the grid range
+   below, which after the shift results in gp.idx = -1.
+
+   \retval   gp     Grid position structure.
+
+   \author ARTS developers
+   \date   2020-06-24
+*/
+void gridpos_lowerend_check(GridPos& gp) {
+  if (gp.idx == -1) {
+    assert(gp.fd[0] > 0.995);  // To capture obviously bad cases
+    gp.idx = 0;
+    gp.fd[0] = 0.0;
+    gp.fd[1] = 1.0;
+  }
+}
+
 //! Grid position matching a grid of length 1
 /*!
   The function sets *gp* to the expected values if there would exist a grid of
@@ -115,6 +115,8 @@ void gridpos_upperend_check(GridPos& gp, const Index& ie);
 
 void gridpos_upperend_check(ArrayOfGridPos& gp, const Index& ie);
 
+void gridpos_lowerend_check(GridPos& gp);
+
 void gp4length1grid(ArrayOfGridPos& gp);
 
 bool is_gridpos_at_index_i(const GridPos& gp,
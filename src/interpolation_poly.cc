@@ -215,6 +215,38 @@ void gridpos_poly(ArrayOfGridPosPoly& gp,
   }
 }
 
+//! Fill a GridPosPoly from a FixedGridPosPoly of order N.
+/*!
+  The storage of gp is only reallocated if its size does not already
+  match N+1.
+*/
+template <Index N>
+static void gridpos_poly_from_fixed(GridPosPoly& gp,
+                                    ConstVectorView old_grid,
+                                    const Numeric& new_grid,
+                                    const Numeric& extpolfac) {
+  FixedGridPosPoly<N> fgp;
+  gridpos_poly(fgp, old_grid, new_grid, extpolfac);
+
+  gp.idx.resize(N + 1);
+  gp.w.resize(N + 1);
+  for (Index i = 0; i < N + 1; ++i) {
+    gp.idx[i] = fgp.idx[i];
+    gp.w[i] = fgp.w[i];
+  }
+}
+
+//! Fixed order implementation of interp_poly_point.
+template <Index N>
+static Numeric interp_poly_point_fixed(ConstVectorView a,
+                                       ConstVectorView old_grid,
+                                       const Numeric& new_grid,
+                                       const Numeric& extpolfac) {
+  FixedGridPosPoly<N> gp;
+  gridpos_poly(gp, old_grid, new_grid, extpolfac);
+  return interp(a, gp);
+}
+
 //! gridpos_poly
 /*!
    Creates a grid position structure for higher order interpolation.
@@ -243,9 +275,66 @@ void gridpos_poly(GridPosPoly& gp,
                   const Numeric& new_grid,
                   const Index order,
                   const Numeric& extpolfac) {
-  ArrayOfGridPosPoly agp(1);
-  gridpos_poly(agp, old_grid, new_grid, order, extpolfac);
-  gp = agp[0];
+  switch (order) {
+    case 0:
+      gridpos_poly_from_fixed<0>(gp, old_grid, new_grid, extpolfac);
+      break;
+    case 1:
+      gridpos_poly_from_fixed<1>(gp, old_grid, new_grid, extpolfac);
+      break;
+    case 2:
+      gridpos_poly_from_fixed<2>(gp, old_grid, new_grid, extpolfac);
+      break;
+    case 3:
+      gridpos_poly_from_fixed<3>(gp, old_grid, new_grid, extpolfac);
+      break;
+    default: {
+      ArrayOfGridPosPoly agp(1);
+      gridpos_poly(agp, old_grid, new_grid, order, extpolfac);
+      gp = agp[0];
+    }
+  }
+}
+
+//! Interpolate a vector to a single point.
+/*!
+   Combines gridpos_poly, interpweights and interp for the common case of
+   interpolating a 1D field to a single position. For orders 0 to 3 this
+   is done with FixedGridPosPoly, without any memory allocation.
+
+   \param   a          The field to interpolate.
+   \param   old_grid   The grid of a.
+   \param   new_grid   The position where we want to have the interpolated
+                       value.
+   \param   order      Interpolation order.
+   \param   extpolfac  Extrapolation factor. Default value is 0.5.
+
+   \return  The interpolated value.
+*/
+Numeric interp_poly_point(ConstVectorView a,
+                          ConstVectorView old_grid,
+                          const Numeric& new_grid,
+                          const Index order,
+                          const Numeric& extpolfac) {
+  assert(is_size(a, old_grid.nelem()));
+
+  switch (order) {
+    case 0:
+      return interp_poly_point_fixed<0>(a, old_grid, new_grid, extpolfac);
+    case 1:
+      return interp_poly_point_fixed<1>(a, old_grid, new_grid, extpolfac);
+    case 2:
+      return interp_poly_point_fixed<2>(a, old_grid, new_grid, extpolfac);
+    case 3:
+      return interp_poly_point_fixed<3>(a, old_grid, new_grid, extpolfac);
+    default: {
+      GridPosPoly gp;
+      gridpos_poly(gp, old_grid, new_grid, order, extpolfac);
+      Vector itw(gp.w.nelem());
+      interpweights(itw, gp);
+      return interp(itw, a, gp);
+    }
+  }
 }
 
 //! Set up grid positions for higher order interpolation on longitudes.
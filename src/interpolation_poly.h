@@ -27,6 +27,7 @@
 #define interpolation_poly_h
 
 #include "interpolation.h"
+#include "logic.h"
 #include "matpackI.h"
 
 //! Structure to store a grid position for higher order interpolation.
@@ -116,6 +117,198 @@ void gridpos_poly_cyclic_longitudinal(GridPosPoly& gp,
                                       const Index order,
                                       const Numeric& extpolfac = 0.5);
 
+//! Grid position for polynomial interpolation of fixed order.
+/*!
+  This serves the same purpose as GridPosPoly, but the interpolation
+  order N is a template parameter. The indices and weights are then
+  stored inline, so no memory is allocated when grid positions are
+  created, and the loops over the N+1 interpolation points in
+  interpweights and interp can be completely unrolled by the compiler.
+
+  Orders 0 (nearest neighbour) to 3 (cubic) are supported. Grid positions
+  and weights are identical to those given by gridpos_poly for a
+  GridPosPoly of the same order.
+*/
+template <Index N>
+struct FixedGridPosPoly {
+  static_assert(N >= 0 && N <= 3,
+                "FixedGridPosPoly is only defined for orders 0 to 3.");
+
+  /*! Indices of the interpolation points in the original grid. */
+  Index idx[N + 1];
+  /*! Interpolation weight for each grid point to use. */
+  Numeric w[N + 1];
+};
+
+//! Set up a grid position for fixed order polynomial interpolation.
+/*!
+  Fixed order version of gridpos_poly for a single point. See that
+  function for details.
+
+  \param[out] gp         The grid position.
+  \param[in]  old_grid   Original grid.
+  \param[in]  new_grid   The position where we want to have the
+                         interpolated value.
+  \param[in]  extpolfac  Extrapolation fraction. Should normally not be
+                         specified, then the default of 0.5 is used.
+*/
+template <Index N>
+inline void gridpos_poly(FixedGridPosPoly<N>& gp,
+                         ConstVectorView old_grid,
+                         const Numeric& new_grid,
+                         const Numeric& extpolfac = 0.5) {
+  const Index m = N + 1;
+  const Index n_old = old_grid.nelem();
+
+  assert(n_old >= m);
+
+  GridPos gp_trad;
+  if (n_old > 1) {
+    gridpos(gp_trad, old_grid, new_grid, extpolfac);
+  } else {
+    // Only possible for nearest neighbour interpolation, see gridpos_poly
+    gp_trad.idx = 0;
+    gp_trad.fd[0] = 0;
+    gp_trad.fd[1] = 1;
+  }
+
+  // First point of the range used for the interpolation, exactly as in
+  // gridpos_poly
+  Index k;
+  if (m != 1) {
+    k = gp_trad.idx - (m - 1) / 2;
+    if (k < 0) k = 0;
+    if (k > n_old - m) k = n_old - m;
+  } else {
+    k = gp_trad.fd[0] <= 0.5 ? gp_trad.idx : gp_trad.idx + 1;
+  }
+
+  for (Index i = 0; i < m; ++i) {
+    gp.idx[i] = k + i;
+
+    // Numerical Recipes, 2nd edition, section 3.1, eq. 3.1.1.
+    Numeric num = 1, denom = 1;
+    for (Index j = 0; j < m; ++j)
+      if (j != i) {
+        num *= new_grid - old_grid[k + j];
+        denom *= old_grid[k + i] - old_grid[k + j];
+      }
+
+    gp.w[i] = num / denom;
+  }
+}
+
+//! Red 1D interpolation weights, fixed order.
+/*!
+  \param[out] itw  Interpolation weights, of size N+1.
+  \param[in]  tc   The grid position for the column dimension.
+*/
+template <Index N>
+inline void interpweights(VectorView itw, const FixedGridPosPoly<N>& tc) {
+  assert(is_size(itw, N + 1));
+  for (Index i = 0; i < N + 1; ++i) itw[i] = tc.w[i];
+}
+
+//! Red 2D interpolation weights, fixed order.
+/*!
+  The weights are stored in the same order as for GridPosPoly.
+
+  \param[out] itw  Interpolation weights, of size (N+1)*(M+1).
+  \param[in]  tr   The grid position for the row dimension.
+  \param[in]  tc   The grid position for the column dimension.
+*/
+template <Index N, Index M>
+inline void interpweights(VectorView itw,
+                          const FixedGridPosPoly<N>& tr,
+                          const FixedGridPosPoly<M>& tc) {
+  assert(is_size(itw, (N + 1) * (M + 1)));
+  Index iti = 0;
+  for (Index r = 0; r < N + 1; ++r)
+    for (Index c = 0; c < M + 1; ++c) itw[iti++] = tr.w[r] * tc.w[c];
+}
+
+//! Red 1D interpolation, fixed order.
+/*!
+  \param[in] itw  Interpolation weights, from interpweights.
+  \param[in] a    The field to interpolate.
+  \param[in] tc   The grid position for the column dimension.
+
+  \return Interpolated value.
+*/
+template <Index N>
+inline Numeric interp(ConstVectorView itw,
+                      ConstVectorView a,
+                      const FixedGridPosPoly<N>& tc) {
+  assert(is_size(itw, N + 1));
+  Numeric tia = 0;
+  for (Index i = 0; i < N + 1; ++i) tia += a[tc.idx[i]] * itw[i];
+  return tia;
+}
+
+//! Red 2D interpolation, fixed order.
+/*!
+  \param[in] itw  Interpolation weights, from interpweights.
+  \param[in] a    The field to interpolate.
+  \param[in] tr   The grid position for the row dimension.
+  \param[in] tc   The grid position for the column dimension.
+
+  \return Interpolated value.
+*/
+template <Index N, Index M>
+inline Numeric interp(ConstVectorView itw,
+                      ConstMatrixView a,
+                      const FixedGridPosPoly<N>& tr,
+                      const FixedGridPosPoly<M>& tc) {
+  assert(is_size(itw, (N + 1) * (M + 1)));
+  Numeric tia = 0;
+  Index iti = 0;
+  for (Index r = 0; r < N + 1; ++r)
+    for (Index c = 0; c < M + 1; ++c)
+      tia += a(tr.idx[r], tc.idx[c]) * itw[iti++];
+  return tia;
+}
+
+//! Red 1D interpolation, fixed order, without precalculated weights.
+/*!
+  The weights stored in the grid position are applied directly.
+
+  \param[in] a    The field to interpolate.
+  \param[in] tc   The grid position for the column dimension.
+
+  \return Interpolated value.
+*/
+template <Index N>
+inline Numeric interp(ConstVectorView a, const FixedGridPosPoly<N>& tc) {
+  Numeric tia = 0;
+  for (Index i = 0; i < N + 1; ++i) tia += a[tc.idx[i]] * tc.w[i];
+  return tia;
+}
+
+//! Red 2D interpolation, fixed order, without precalculated weights.
+/*!
+  \param[in] a    The field to interpolate.
+  \param[in] tr   The grid position for the row dimension.
+  \param[in] tc   The grid position for the column dimension.
+
+  \return Interpolated value.
+*/
+template <Index N, Index M>
+inline Numeric interp(ConstMatrixView a,
+                      const FixedGridPosPoly<N>& tr,
+                      const FixedGridPosPoly<M>& tc) {
+  Numeric tia = 0;
+  for (Index r = 0; r < N + 1; ++r)
+    for (Index c = 0; c < M + 1; ++c)
+      tia += a(tr.idx[r], tc.idx[c]) * tr.w[r] * tc.w[c];
+  return tia;
+}
+
+Numeric interp_poly_point(ConstVectorView a,
+                          ConstVectorView old_grid,
+                          const Numeric& new_grid,
+                          const Index order,
+                          const Numeric& extpolfac = 0.5);
+
 ////////////////////////////////////////////////////////////////////////////
 //                      Red Interpolation
 ////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,61 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   iyb_cache.h
+
+  \brief  Storage of monochromatic pencil beam results between calls of
+          *yCalcCached*.
+
+  The cache holds *iyb*, the analytical part of its Jacobian and the
+  auxiliary data for each measurement block, keyed on the atmospheric and
+  spectroscopic state they were calculated for.
+*/
+
+#ifndef iyb_cache_h
+#define iyb_cache_h
+
+#include <ostream>
+#include "array.h"
+#include "keyed_cache.h"
+#include "matpackI.h"
+
+//! Pencil beam results of all measurement blocks.
+struct IybData {
+  ArrayOfVector iyb;
+  ArrayOfArrayOfMatrix diyb_dx;
+  ArrayOfArrayOfVector iyb_aux;
+  ArrayOfMatrix geo_pos;
+
+  void resize(Index nmblock) {
+    iyb.resize(nmblock);
+    diyb_dx.resize(nmblock);
+    iyb_aux.resize(nmblock);
+    geo_pos.resize(nmblock);
+  }
+};
+
+class IybCache : public KeyedCache<IybData> {};
+
+inline std::ostream& operator<<(std::ostream& os, const IybCache& c) {
+  std::shared_ptr<const IybData> d = c.value();
+  os << "IybCache: " << (d ? d->iyb.nelem() : 0) << " measurement blocks, "
+     << c.hits() << " hits, " << c.misses() << " misses";
+  return os;
+}
+
+#endif /* iyb_cache_h */
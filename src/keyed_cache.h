@@ -0,0 +1,171 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   keyed_cache.h
+
+  \brief  Storage of a calculated value together with the state it was
+          calculated for.
+
+  Base of the workspace groups keeping results between method calls, such
+  as IybCache. Copies of a KeyedCache share the stored value, so the value
+  is kept when an agenda duplicates the variable, and is seen by all
+  threads of ybatchCalc or DoitCalc. All access is serialised and stored
+  values are never modified, only replaced.
+*/
+
+#ifndef keyed_cache_h
+#define keyed_cache_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "matpackI.h"
+#include "matpackIII.h"
+#include "matpackIV.h"
+#include "mystring.h"
+
+template <class T>
+class KeyedCache {
+ public:
+  KeyedCache() : mdata(std::make_shared<Data>()) {}
+
+  //! Get the value stored for a given state.
+  /*!
+    Counts a hit if a value is stored for the state, otherwise a miss.
+
+    \param key    Numeric description of the state.
+    \param names  Textual description of the state.
+    \return       The stored value, or nullptr.
+  */
+  std::shared_ptr<const T> find(const Vector& key,
+                                const String& names = String()) {
+    Data& d = *mdata;
+    std::lock_guard<std::mutex> lock(d.mutex);
+    if (d.matches(key, names)) {
+      d.hits++;
+      return d.value;
+    }
+    d.misses++;
+    return nullptr;
+  }
+
+  //! Store a value, replacing the one stored before.
+  /*!
+    \param key    Numeric description of the state.
+    \param names  Textual description of the state.
+    \param value  The value calculated for the state.
+  */
+  void store(const Vector& key,
+             const String& names,
+             std::shared_ptr<const T> value) {
+    Data& d = *mdata;
+    std::lock_guard<std::mutex> lock(d.mutex);
+    d.key = key;
+    d.names = names;
+    d.value = std::move(value);
+  }
+
+  //! Get the value for a given state, calculating it if not stored.
+  /*!
+    The calculation is done while holding the lock, so threads asking for
+    the same state wait for it instead of repeating it.
+
+    \param key   Numeric description of the state.
+    \param calc  Function filling a T.
+    \return      The stored or calculated value.
+  */
+  template <typename Calc>
+  std::shared_ptr<const T> get(const Vector& key, Calc calc) {
+    Data& d = *mdata;
+    std::lock_guard<std::mutex> lock(d.mutex);
+    if (d.matches(key, String())) {
+      d.hits++;
+      return d.value;
+    }
+    d.misses++;
+    d.value.reset();
+    std::shared_ptr<T> value = std::make_shared<T>();
+    calc(*value);
+    d.key = key;
+    d.names.clear();
+    d.value = value;
+    return d.value;
+  }
+
+  //! Remove all stored data.
+  void clear() { mdata = std::make_shared<Data>(); }
+
+  //! Number of calls served from the cache.
+  Index hits() const {
+    std::lock_guard<std::mutex> lock(mdata->mutex);
+    return mdata->hits;
+  }
+
+  //! Number of calls that required new calculations.
+  Index misses() const {
+    std::lock_guard<std::mutex> lock(mdata->mutex);
+    return mdata->misses;
+  }
+
+  //! The stored value, or nullptr.
+  std::shared_ptr<const T> value() const {
+    std::lock_guard<std::mutex> lock(mdata->mutex);
+    return mdata->value;
+  }
+
+ private:
+  struct Data {
+    Data() : hits(0), misses(0) {}
+
+    bool matches(const Vector& k, const String& n) const {
+      if (!value || names != n || key.nelem() != k.nelem()) return false;
+      for (Index i = 0; i < k.nelem(); i++)
+        if (key[i] != k[i]) return false;
+      return true;
+    }
+
+    std::mutex mutex;
+    Vector key;
+    String names;
+    std::shared_ptr<const T> value;
+    Index hits;
+    Index misses;
+  };
+
+  std::shared_ptr<Data> mdata;
+};
+
+//! Append the elements of a matpack object to a key
+inline void key_append(std::vector<Numeric>& key, ConstVectorView v) {
+  for (Index i = 0; i < v.nelem(); i++) key.push_back(v[i]);
+}
+
+inline void key_append(std::vector<Numeric>& key, ConstMatrixView m) {
+  for (Index r = 0; r < m.nrows(); r++) key_append(key, m(r, joker));
+}
+
+inline void key_append(std::vector<Numeric>& key, ConstTensor3View t) {
+  for (Index p = 0; p < t.npages(); p++) key_append(key, t(p, joker, joker));
+}
+
+inline void key_append(std::vector<Numeric>& key, ConstTensor4View t) {
+  for (Index b = 0; b < t.nbooks(); b++)
+    key_append(key, t(b, joker, joker, joker));
+}
+
+#endif /* keyed_cache_h */
@@ -96,6 +96,43 @@ extern "C" void zgetri_(int *n,
                         int *lwork,
                         int *info);
 
+//! Cholesky decomposition.
+/*!
+  Computes the Cholesky factorization of a real symmetric positive definite
+  matrix A. See LAPACK reference.
+
+  \param[in] uplo 'U' if the upper triangle of A is stored, 'L' if the lower.
+  \param[in] n The number of rows and columns of the matrix A.
+  \param[in,out] A On input the matrix A, on output the factor.
+  \param[in] lda The leading dimension of A.
+  \param[out] info Integer indicating if operation was successful: 0 if success,
+  otherwise failure. A positive value means that A is not positive definite.
+*/
+extern "C" void dpotrf_(char *uplo, int *n, double *A, int *lda, int *info);
+
+//! Solve linear system of equations using Cholesky factor.
+/*!
+  Solves A * X = B with the Cholesky factorization of A computed by dpotrf_.
+
+  \param[in] uplo As given to dpotrf_.
+  \param[in] n The size of the system.
+  \param[in] nrhs The number of right-hand sides.
+  \param[in] A The factor as returned by dpotrf_.
+  \param[in] lda The leading dimension of A.
+  \param[in,out] b The matrix containing the right-hand side vectors, on output
+  the solution.
+  \param[in] ldb The leading dimension of b.
+  \param[out] info Integer indicating succes of the operation.
+*/
+extern "C" void dpotrs_(char *uplo,
+                        int *n,
+                        int *nrhs,
+                        double *A,
+                        int *lda,
+                        double *b,
+                        int *ldb,
+                        int *info);
+
 //! Optimal parameters for computation.
 /*!
   This function returns problem-dependent parameters for the computing
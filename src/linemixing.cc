@@ -107,6 +107,93 @@ inline BasisRate basis_rate(const SpeciesTag& main,
 // A helper for insider relaxation_matrix_calculations
 enum class Species { CO2, O2_66 };
 
+static Species relaxation_matrix_species(const SpeciesTag& main) {
+  if (main.IsSpecies("CO2"))
+    return Species::CO2;
+  else if (main.IsSpecies("O2") and main.IsIsotopologue("66"))
+    return Species::O2_66;
+  else
+    throw "Unsupported species";
+}
+
+Tensor3 relaxation_matrix_couplings(const ArrayOfLineRecord& lines,
+                                    const SpeciesTag& main,
+                                    const Index& size) try {
+  const Index n = lines.nelem();
+  const Species spec = relaxation_matrix_species(main);
+
+  // The number of symbols differs between the pairs for CO2
+  Array<ArrayOfVector> wigner(n, ArrayOfVector(n));
+
+  bool failed = false;
+  String fail_msg;
+
+#pragma omp parallel for schedule( \
+    guided, 1) if (DO_FAST_WIGNER && !arts_omp_in_parallel())
+  for (Index i = 0; i < n; i++) {
+    if (failed) continue;
+
+    // Create a temporary table to allow openmp
+    wig_temp_init(2 * int(size));
+
+    try {
+      for (Index j = 0; j < n; j++) {
+        if (i not_eq j) {
+          switch (spec) {
+            case Species::CO2:
+              wigner[i][j] =
+                  OffDiagonalElement::CO2_IR_wigner(lines[i], lines[j]);
+              break;
+            case Species::O2_66:
+              wigner[i][j] =
+                  OffDiagonalElement::O2_66_MW_wigner(lines[i], lines[j]);
+              break;
+          }
+        }
+      }
+    } catch (const char* e) {
+#pragma omp critical(relaxation_matrix_couplings_fail)
+      {
+        fail_msg = e;
+        failed = true;
+      }
+    } catch (const std::exception& e) {
+#pragma omp critical(relaxation_matrix_couplings_fail)
+      {
+        fail_msg = e.what();
+        failed = true;
+      }
+    }
+
+    // Remove the temporary table
+    wig_temp_free();
+  }
+
+  if (failed) throw std::runtime_error(fail_msg);
+
+  Index nl = 0;
+  for (Index i = 0; i < n; i++)
+    for (Index j = 0; j < n; j++) nl = std::max(nl, wigner[i][j].nelem());
+
+  Tensor3 couplings(n, n, nl, 0);
+  for (Index i = 0; i < n; i++)
+    for (Index j = 0; j < n; j++)
+      if (wigner[i][j].nelem())
+        couplings(i, j, Range(0, wigner[i][j].nelem())) = wigner[i][j];
+
+  return couplings;
+} catch (const char* e) {
+  std::ostringstream os;
+  os << "Errors raised by *relaxation_matrix_couplings*:\n";
+  os << "\tError: " << e << '\n';
+  throw std::runtime_error(os.str());
+} catch (const std::exception& e) {
+  std::ostringstream os;
+  os << "Errors in calls by *relaxation_matrix_couplings*:\n";
+  os << e.what();
+  throw std::runtime_error(os.str());
+}
+
 /*! Computes an individual W
  \param lines: all absorption lines
  \param population: population distribution of the absorption lines
@@ -114,6 +201,7 @@ enum class Species { CO2, O2_66 };
  \param collider: species broadening main
  \param collider_vmr: vmr of species broadening main
  \param T: Atmospheric temperature
+ \param couplings: Wigner symbols from relaxation_matrix_couplings
  \return An individual W
 */
 Matrix relaxation_matrix_calculations(const ArrayOfLineRecord& lines,
@@ -122,7 +210,7 @@ Matrix relaxation_matrix_calculations(const ArrayOfLineRecord& lines,
                                       const SpeciesTag& collider,
                                       const Numeric& collider_vmr,
                                       const Numeric& T,
-                                      const Index& size) try {
+                                      const Tensor3& couplings) try {
   const Index n = lines.nelem();
   Matrix W(n, n);
 
@@ -133,29 +221,27 @@ Matrix relaxation_matrix_calculations(const ArrayOfLineRecord& lines,
       {ArrayOfSpeciesTag(1, collider), ArrayOfSpeciesTag(1, main)});
   const Vector pseudo_vmrs({1, 0});
 
-  Species spec;
-  if (main.IsSpecies("CO2"))
-    spec = Species::CO2;
-  else if (main.IsSpecies("O2") and main.IsIsotopologue("66"))
-    spec = Species::O2_66;
-  else
-    throw "Unsupported species";
+  const Species spec = relaxation_matrix_species(main);
 
-#pragma omp parallel for schedule( \
-    guided, 1) if (DO_FAST_WIGNER && !arts_omp_in_parallel())
+  bool failed = false;
+  String fail_msg;
+
+  // No Wigner symbols are calculated here, so this is safe also without
+  // the fast Wigner library. Both elements of a pair are set when handling
+  // the line of higher index, so each thread writes to its own elements.
+#pragma omp parallel for schedule(guided, 1) if (!arts_omp_in_parallel())
   for (Index i = 0; i < n; i++) {
-    // Create a temporary table to allow openmp
-    wig_temp_init(2 * int(size));
+    if (failed) continue;
 
-    const auto shape_parameters =
-        lines[i].GetShapeParams(T, 1, pseudo_vmrs, pseudo_species);
-    W(i, i) = shape_parameters.G0;
+    try {
+      const auto shape_parameters =
+          lines[i].GetShapeParams(T, 1, pseudo_vmrs, pseudo_species);
+      W(i, i) = shape_parameters.G0;
 
-    const Numeric& popi = population[i];
-    for (Index j = 0; j < n; j++) {
-      const Numeric& popj = population[j];
+      const Numeric& popi = population[i];
+      for (Index j = 0; j < i; j++) {
+        const Numeric& popj = population[j];
 
-      if (i not_eq j) {
         OffDiagonalElementOutput X;
         switch (spec) {
           case Species::CO2:
@@ -168,11 +254,17 @@ Matrix relaxation_matrix_calculations(const ArrayOfLineRecord& lines,
                                            T,
                                            B0,
                                            main.SpeciesMass(),
-                                           collider.SpeciesMass());
+                                           collider.SpeciesMass(),
+                                           couplings(i, j, joker));
             break;
           case Species::O2_66:
-            X = OffDiagonalElement::O2_66_MW(
-                lines[i], lines[j], popi, popj, T, collider.SpeciesMass());
+            X = OffDiagonalElement::O2_66_MW(lines[i],
+                                             lines[j],
+                                             popi,
+                                             popj,
+                                             T,
+                                             collider.SpeciesMass(),
+                                             couplings(i, j, joker));
             break;
           default:
             throw "DEVELOPER BUG:  Add species here as well, the other one is to check if the computations are valid at all...";
@@ -181,12 +273,23 @@ Matrix relaxation_matrix_calculations(const ArrayOfLineRecord& lines,
         W(i, j) = X.ij;
         W(j, i) = X.ji;
       }
+    } catch (const char* e) {
+#pragma omp critical(relaxation_matrix_calculations_fail)
+      {
+        fail_msg = e;
+        failed = true;
+      }
+    } catch (const std::exception& e) {
+#pragma omp critical(relaxation_matrix_calculations_fail)
+      {
+        fail_msg = e.what();
+        failed = true;
+      }
     }
-
-    // Remove the temporary table
-    wig_temp_free();
   }
 
+  if (failed) throw std::runtime_error(fail_msg);
+
   // rescale by the VMR
   W *= collider_vmr;
   return W;
@@ -301,6 +404,8 @@ void normalize_relaxation_matrix(Matrix& W,
  \param colliders: species broadening main
  \param colliders_vmr: vmr of species broadening main
  \param T: Atmospheric temperature
+ \param couplings: Wigner symbols from relaxation_matrix_couplings
+ \param normalize: apply the sum rule renormalization
  \return A normalized relaxation matrix
 */
 inline Matrix hartmann_relaxation_matrix(
@@ -312,7 +417,8 @@ inline Matrix hartmann_relaxation_matrix(
     const Vector& colliders_vmr,
     const SpeciesAuxData& partition_functions,
     const Numeric& T,
-    const Index& size) try {
+    const Tensor3& couplings,
+    const bool normalize) try {
   // Size of problem
   const Index n = abs_lines.nelem();
   const Index c = colliders.nelem();
@@ -327,9 +433,10 @@ inline Matrix hartmann_relaxation_matrix(
                                           colliders[ic],
                                           colliders_vmr[ic],
                                           T,
-                                          size);
-    normalize_relaxation_matrix(
-        W, population, d0, abs_lines, partition_functions, T);
+                                          couplings);
+    if (normalize)
+      normalize_relaxation_matrix(
+          W, population, d0, abs_lines, partition_functions, T);
   }
 
   return W;
@@ -538,9 +645,28 @@ Matrix hartmann_ecs_interface(const ArrayOfLineRecord& abs_lines,
                               const Vector& collider_species_vmr,
                               const SpeciesAuxData& partition_functions,
                               const Numeric& T,
-                              const Index& size) try {
+                              const Index& size) {
+  return hartmann_ecs_interface(
+      abs_lines,
+      main_species,
+      collider_species,
+      collider_species_vmr,
+      partition_functions,
+      T,
+      relaxation_matrix_couplings(abs_lines, main_species[0], size));
+}
+
+Matrix hartmann_ecs_interface(const ArrayOfLineRecord& abs_lines,
+                              const ArrayOfSpeciesTag& main_species,
+                              const ArrayOfSpeciesTag& collider_species,
+                              const Vector& collider_species_vmr,
+                              const SpeciesAuxData& partition_functions,
+                              const Numeric& T,
+                              const Tensor3& couplings,
+                              const bool normalize) try {
   const Vector population =
-      population_density_vector(abs_lines, partition_functions, T);
+      normalize ? population_density_vector(abs_lines, partition_functions, T)
+                : Vector(abs_lines.nelem(), 1);
   const Vector dipole = dipole_vector(abs_lines, partition_functions);
   const Matrix W = hartmann_relaxation_matrix(abs_lines,
                                               main_species[0],
@@ -550,7 +676,8 @@ Matrix hartmann_ecs_interface(const ArrayOfLineRecord& abs_lines,
                                               collider_species_vmr,
                                               partition_functions,
                                               T,
-                                              size);
+                                              couplings,
+                                              normalize);
   return W;
 } catch (const std::exception& e) {
   std::ostringstream os;
@@ -559,17 +686,14 @@ Matrix hartmann_ecs_interface(const ArrayOfLineRecord& abs_lines,
   throw std::runtime_error(os.str());
 }
 
-OffDiagonalElementOutput OffDiagonalElement::CO2_IR(
-    const LineRecord& j_line,
-    const LineRecord& k_line,
-    const Numeric& j_rho,
-    const Numeric& k_rho,
-    const BasisRate& br,
-    const AdiabaticFactor& af,
-    const Numeric& T,
-    const Numeric& B0,
-    const Numeric& main_mass,
-    const Numeric& collider_mass) {
+//! Quantum numbers of a pair of CO2 lines as used by the ECS model
+struct CO2IRPair {
+  bool jbig;
+  int Ji, Jf, Ji_p, Jf_p, li, lf;
+};
+
+static CO2IRPair co2_ir_pair(const LineRecord& j_line,
+                             const LineRecord& k_line) {
   // Point at quantum numbers
   const Rational Jku = k_line.UpperQuantumNumber(QuantumNumberType::J);
   const Rational Jju = j_line.UpperQuantumNumber(QuantumNumberType::J);
@@ -580,27 +704,81 @@ OffDiagonalElementOutput OffDiagonalElement::CO2_IR(
   const Rational l2kl = k_line.LowerQuantumNumber(QuantumNumberType::l2);
   const Rational l2jl = j_line.LowerQuantumNumber(QuantumNumberType::l2);
 
-  const bool jbig = Jjl >= Jkl;
+  CO2IRPair x;
+  x.jbig = Jjl >= Jkl;
 
   // Prepare for the wigner calculations --- NOTE: twice the values of J and l2 required for fast Wigner-solver
   // Also, prepare for initial and final phase to go from j to k if Jj >= Jk and vice verse
-  const int Ji = (2 * (jbig ? Jju : Jku)).toInt();
-  const int Jf = (2 * (jbig ? Jjl : Jkl)).toInt();
-  const int Ji_p = (2 * (jbig ? Jku : Jju)).toInt();
-  const int Jf_p = (2 * (jbig ? Jkl : Jjl)).toInt();
-  const int li = (2 * (jbig ? l2ju : l2ku)).toInt();
-  const int lf = (2 * (jbig ? l2jl : l2kl)).toInt();
+  x.Ji = (2 * (x.jbig ? Jju : Jku)).toInt();
+  x.Jf = (2 * (x.jbig ? Jjl : Jkl)).toInt();
+  x.Ji_p = (2 * (x.jbig ? Jku : Jju)).toInt();
+  x.Jf_p = (2 * (x.jbig ? Jkl : Jjl)).toInt();
+  x.li = (2 * (x.jbig ? l2ju : l2ku)).toInt();
+  x.lf = (2 * (x.jbig ? l2jl : l2kl)).toInt();
+  return x;
+}
+
+Vector OffDiagonalElement::CO2_IR_wigner(const LineRecord& j_line,
+                                         const LineRecord& k_line) {
+  const CO2IRPair x = co2_ir_pair(j_line, k_line);
 
   // Find best start and end-point of the summing loop
   //   const int st = std::max(Ji - Ji_p, Jf - Jf_p);
-  const int en = std::min(Ji + Ji_p, Jf + Jf_p);
+  const int en = std::min(x.Ji + x.Ji_p, x.Jf + x.Jf_p);
+
+  // The wigner-symbol following Niro etal 2004
+  Vector wigner(en < 4 ? 0 : (en - 4) / 4 + 1);
+  for (int L = 4; L <= en; L += 4)
+    wigner[(L - 4) / 4] =
+        co2_ecs_wigner_symbol(x.Ji, x.Jf, x.Ji_p, x.Jf_p, L, x.li, x.lf);
+  return wigner;
+}
+
+OffDiagonalElementOutput OffDiagonalElement::CO2_IR(
+    const LineRecord& j_line,
+    const LineRecord& k_line,
+    const Numeric& j_rho,
+    const Numeric& k_rho,
+    const BasisRate& br,
+    const AdiabaticFactor& af,
+    const Numeric& T,
+    const Numeric& B0,
+    const Numeric& main_mass,
+    const Numeric& collider_mass) {
+  return CO2_IR(j_line,
+                k_line,
+                j_rho,
+                k_rho,
+                br,
+                af,
+                T,
+                B0,
+                main_mass,
+                collider_mass,
+                CO2_IR_wigner(j_line, k_line));
+}
+
+OffDiagonalElementOutput OffDiagonalElement::CO2_IR(
+    const LineRecord& j_line,
+    const LineRecord& k_line,
+    const Numeric& j_rho,
+    const Numeric& k_rho,
+    const BasisRate& br,
+    const AdiabaticFactor& af,
+    const Numeric& T,
+    const Numeric& B0,
+    const Numeric& main_mass,
+    const Numeric& collider_mass,
+    ConstVectorView wigner) {
+  const CO2IRPair x = co2_ir_pair(j_line, k_line);
+  const int en = std::min(x.Ji + x.Ji_p, x.Jf + x.Jf_p);
 
   // Adiabatic factor for Ji
-  const Numeric AF1 = af.get(Ji / 2, B0, T, main_mass, collider_mass);
+  const Numeric AF1 = af.get(x.Ji / 2, B0, T, main_mass, collider_mass);
 
   // Scale constant for final state NOTE: "%4" and lack of 2*J because Fast library already doubles these numbers
-  const Numeric K1 = ((li + lf) % 4 ? 1.0 : -1.0) * Numeric(Ji_p + 1) *
-                     sqrt(Numeric((Jf + 1) * (Jf_p + 1))) * AF1;
+  const Numeric K1 = ((x.li + x.lf) % 4 ? 1.0 : -1.0) * Numeric(x.Ji_p + 1) *
+                     sqrt(Numeric((x.Jf + 1) * (x.Jf_p + 1))) * AF1;
 
   Numeric sum = 0;
   for (int L = 4; L <= en; L += 4) {
@@ -611,17 +789,14 @@ OffDiagonalElementOutput OffDiagonalElement::CO2_IR(
     // Adiabatic factor for L
     const Numeric AF2 = af.get(L / 2, B0, T, main_mass, collider_mass);
 
-    // The wigner-symbol following Niro etal 2004
-    const Numeric y = co2_ecs_wigner_symbol(Ji, Jf, Ji_p, Jf_p, L, li, lf);
-
     // Sum to the total
-    sum += QL * y / AF2;
+    sum += QL * wigner[(L - 4) / 4] / AF2;
   }
 
   sum *= K1;
 
   const Numeric r = k_rho / j_rho;
-  return {jbig ? sum : sum * r, jbig ? sum / r : sum};
+  return {x.jbig ? sum : sum * r, x.jbig ? sum / r : sum};
 }
 
 constexpr auto params = 10;
@@ -777,13 +952,14 @@ Numeric o2_66_adiabatic_factor_makarov(int L,
                             vm2 / 24.0);
 }
 
-OffDiagonalElementOutput OffDiagonalElement::O2_66_MW(
-    const LineRecord& line1,
-    const LineRecord& line2,
-    const Numeric& rho1,
-    const Numeric& rho2,
-    const Numeric& T,
-    const Numeric& collider_mass) {
+//! Quantum numbers of a pair of O2-66 lines as used by the ECS model
+struct O266MWPair {
+  bool onebig;
+  int Nk, Jk, Jkp, Nl, Jl, Jlp;
+};
+
+static O266MWPair o2_66_mw_pair(const LineRecord& line1,
+                                const LineRecord& line2) {
   const Rational J1u = line1.UpperQuantumNumber(QuantumNumberType::J);
   const Rational N1u = line1.UpperQuantumNumber(QuantumNumberType::N);
   const Rational J1l = line1.LowerQuantumNumber(QuantumNumberType::J);
@@ -793,49 +969,147 @@ OffDiagonalElementOutput OffDiagonalElement::O2_66_MW(
   const Rational J2l = line2.LowerQuantumNumber(QuantumNumberType::J);
   const Rational N2l = line2.LowerQuantumNumber(QuantumNumberType::N);
 
+  O266MWPair x;
+
   // Find which is the 'upper' transition
-  const bool onebig =
+  x.onebig =
       Molecule::O2_66::hamiltonian_freq(
           J1u.toNumeric(), (J1u - N1u).toInt(), (J1u - N1u).toInt()) >
       Molecule::O2_66::hamiltonian_freq(
           J2u.toNumeric(), (J2u - N2u).toInt(), (J2u - N2u).toInt());
 
   // Define the transitions as in Makarov etal 2013, double the value for wiglib
-  const int Nk = (2 * (onebig ? N1u : N2u).toInt());
-  const int Nkp = (2 * (onebig ? N1l : N2l).toInt());
-  const int Jk = (2 * (onebig ? J1u : J2u).toInt());
-  const int Jkp = (2 * (onebig ? J1l : J2l).toInt());
-  const int Nl = (2 * (onebig ? N2u : N1u).toInt());
-  const int Nlp = (2 * (onebig ? N2l : N1l).toInt());
-  const int Jl = (2 * (onebig ? J2u : J1u).toInt());
-  const int Jlp = (2 * (onebig ? J2l : J1l).toInt());
+  x.Nk = (2 * (x.onebig ? N1u : N2u).toInt());
+  const int Nkp = (2 * (x.onebig ? N1l : N2l).toInt());
+  x.Jk = (2 * (x.onebig ? J1u : J2u).toInt());
+  x.Jkp = (2 * (x.onebig ? J1l : J2l).toInt());
+  x.Nl = (2 * (x.onebig ? N2u : N1u).toInt());
+  const int Nlp = (2 * (x.onebig ? N2l : N1l).toInt());
+  x.Jl = (2 * (x.onebig ? J2u : J1u).toInt());
+  x.Jlp = (2 * (x.onebig ? J2l : J1l).toInt());
+
+  if (x.Nl not_eq Nlp or x.Nk not_eq Nkp) throw "ERRROR, bad N-values";
+
+  return x;
+}
 
-  if (Nl not_eq Nlp or Nk not_eq Nkp) throw "ERRROR, bad N-values";
+//! Upper limit (exclusive) of the sum over L in the O2-66 ECS model
+constexpr int O2_66_MW_LMAX = 400;
+
+Vector OffDiagonalElement::O2_66_MW_wigner(const LineRecord& line1,
+                                           const LineRecord& line2) {
+  const O266MWPair x = o2_66_mw_pair(line1, line2);
+
+  Vector wigner((O2_66_MW_LMAX - 4 - 1) / 4 + 1);
+  for (int L = 4; L < O2_66_MW_LMAX; L += 4)
+    wigner[(L - 4) / 4] =
+        o2_ecs_wigner_symbol(x.Nl, x.Nk, x.Jl, x.Jk, x.Jlp, x.Jkp, L);
+  return wigner;
+}
+
+OffDiagonalElementOutput OffDiagonalElement::O2_66_MW(
+    const LineRecord& line1,
+    const LineRecord& line2,
+    const Numeric& rho1,
+    const Numeric& rho2,
+    const Numeric& T,
+    const Numeric& collider_mass) {
+  return O2_66_MW(line1,
+                  line2,
+                  rho1,
+                  rho2,
+                  T,
+                  collider_mass,
+                  O2_66_MW_wigner(line1, line2));
+}
+
+OffDiagonalElementOutput OffDiagonalElement::O2_66_MW(
+    const LineRecord& line1,
+    const LineRecord& line2,
+    const Numeric& rho1,
+    const Numeric& rho2,
+    const Numeric& T,
+    const Numeric& collider_mass,
+    ConstVectorView wigner) {
+  const O266MWPair x = o2_66_mw_pair(line1, line2);
 
   // 'length' of numbers
-  const Numeric lNk = std::sqrt(Nk + 1.0);
-  const Numeric lNl = std::sqrt(Nl + 1.0);
-  const Numeric lJk = std::sqrt(Jk + 1.0);
-  const Numeric lJl = std::sqrt(Jl + 1.0);
-  const Numeric lJkp = std::sqrt(Jkp + 1.0);
-  const Numeric lJlp = std::sqrt(Jlp + 1.0);
+  const Numeric lNk = std::sqrt(x.Nk + 1.0);
+  const Numeric lNl = std::sqrt(x.Nl + 1.0);
+  const Numeric lJk = std::sqrt(x.Jk + 1.0);
+  const Numeric lJl = std::sqrt(x.Jl + 1.0);
+  const Numeric lJkp = std::sqrt(x.Jkp + 1.0);
+  const Numeric lJlp = std::sqrt(x.Jlp + 1.0);
 
   // Constant independenf of L
   const Numeric const1 = lNk * lNl * std::sqrt(lJk * lJl * lJkp * lJlp) *
-                         o2_66_inelastic_cross_section_makarov(Nk / 2, T);
+                         o2_66_inelastic_cross_section_makarov(x.Nk / 2, T);
 
   Numeric sum = 0;
-  for (int L = 4; L < 400; L += 4) {
-    const int sgn = ((Jk + Jl + L + 2) % 4) ? 1 : -1;
+  for (int L = 4; L < O2_66_MW_LMAX; L += 4) {
+    const int sgn = ((x.Jk + x.Jl + L + 2) % 4) ? 1 : -1;
 
     const Numeric const2 =
         sgn * const1 * o2_66_adiabatic_factor_makarov(L / 2, T, collider_mass) /
         o2_66_inelastic_cross_section_makarov(L / 2, T);
 
-    sum += o2_ecs_wigner_symbol(Nl, Nk, Jl, Jk, Jlp, Jkp, L) * const2;
+    sum += wigner[(L - 4) / 4] * const2;
   }
 
-  return {onebig ? sum : sum * rho2 / rho1, onebig ? sum * rho1 / rho2 : sum};
+  return {x.onebig ? sum : sum * rho2 / rho1,
+          x.onebig ? sum * rho1 / rho2 : sum};
+}
+
+void hartmann_ecs_normalize(Matrix& W,
+                            const ArrayOfLineRecord& abs_lines,
+                            const ArrayOfSpeciesTag& main_species,
+                            const SpeciesAuxData& partition_functions,
+                            const Numeric& T) try {
+  const Index n = abs_lines.nelem();
+  if (not n) return;
+
+  const Vector population =
+      population_density_vector(abs_lines, partition_functions, T);
+  const Species spec = relaxation_matrix_species(main_species[0]);
+
+  // The population ratio enters one element of each pair, as in CO2_IR and
+  // O2_66_MW with line i first
+  for (Index i = 0; i < n; i++) {
+    for (Index j = 0; j < i; j++) {
+      bool ibig = false;
+      switch (spec) {
+        case Species::CO2:
+          ibig = co2_ir_pair(abs_lines[i], abs_lines[j]).jbig;
+          break;
+        case Species::O2_66:
+          ibig = o2_66_mw_pair(abs_lines[i], abs_lines[j]).onebig;
+          break;
+      }
+
+      const Numeric r = population[j] / population[i];
+      if (ibig)
+        W(j, i) /= r;
+      else
+        W(i, j) *= r;
+    }
+  }
+
+  normalize_relaxation_matrix(W,
+                              population,
+                              dipole_vector(abs_lines, partition_functions),
+                              abs_lines,
+                              partition_functions,
+                              T);
+} catch (const char* e) {
+  std::ostringstream os;
+  os << "Errors raised by *hartmann_ecs_normalize*:\n";
+  os << "\tError: " << e << '\n';
+  throw std::runtime_error(os.str());
+} catch (const std::exception& e) {
+  std::ostringstream os;
+  os << "Errors in calls by *hartmann_ecs_normalize*:\n";
+  os << e.what();
+  throw std::runtime_error(os.str());
 }
 
 /*! Computes adiabatic factor by
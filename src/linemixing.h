@@ -25,6 +25,7 @@
 #include "complex.h"
 #include "constants.h"
 #include "linerecord.h"
+#include "matpackIII.h"
 #include "rational.h"
 
 template <class T>
@@ -233,8 +234,51 @@ OffDiagonalElementOutput O2_66_MW(const LineRecord& line1,
                                   const Numeric& rho2,
                                   const Numeric& T,
                                   const Numeric& collider_mass);
+
+/* The Wigner symbols of the ECS models do not depend on temperature or
+   pressure. These versions take them precomputed, as returned by the
+   *_wigner functions, element L/4-1 being the symbol of angular momentum
+   L/2. */
+OffDiagonalElementOutput CO2_IR(const LineRecord& j_line,
+                                const LineRecord& k_line,
+                                const Numeric& j_rho,
+                                const Numeric& k_rho,
+                                const BasisRate& br,
+                                const AdiabaticFactor& af,
+                                const Numeric& T,
+                                const Numeric& B0,
+                                const Numeric& main_mass,
+                                const Numeric& collider_mass,
+                                ConstVectorView wigner);
+
+OffDiagonalElementOutput O2_66_MW(const LineRecord& line1,
+                                  const LineRecord& line2,
+                                  const Numeric& rho1,
+                                  const Numeric& rho2,
+                                  const Numeric& T,
+                                  const Numeric& collider_mass,
+                                  ConstVectorView wigner);
+
+Vector CO2_IR_wigner(const LineRecord& j_line, const LineRecord& k_line);
+
+Vector O2_66_MW_wigner(const LineRecord& line1, const LineRecord& line2);
 };  // namespace OffDiagonalElement
 
+/*! Temperature independent coupling terms of the relaxation matrix
+
+ The Wigner symbols of all pairs of lines of a band, (i, j, L/4-1). They
+ can be calculated once per band and then be passed to
+ hartmann_ecs_interface for any temperature.
+
+ \param lines: all absorption lines of the band
+ \param main: species of interest
+ \param size: largest angular momentum of the Wigner tables
+ \return The couplings
+ */
+Tensor3 relaxation_matrix_couplings(const ArrayOfLineRecord& lines,
+                                    const SpeciesTag& main,
+                                    const Index& size);
+
 Matrix hartmann_ecs_interface(const ArrayOfLineRecord& abs_lines,
                               const ArrayOfSpeciesTag& main_species,
                               const ArrayOfSpeciesTag& collider_species,
@@ -243,6 +287,36 @@ Matrix hartmann_ecs_interface(const ArrayOfLineRecord& abs_lines,
                               const Numeric& T,
                               const Index& size);
 
+Matrix hartmann_ecs_interface(const ArrayOfLineRecord& abs_lines,
+                              const ArrayOfSpeciesTag& main_species,
+                              const ArrayOfSpeciesTag& collider_species,
+                              const Vector& collider_species_vmr,
+                              const SpeciesAuxData& partition_functions,
+                              const Numeric& T,
+                              const Tensor3& couplings,
+                              const bool normalize = true);
+
+/*! Completes a relaxation matrix calculated without populations
+
+ With normalize = false, hartmann_ecs_interface uses unit populations and
+ skips the sum rule renormalization. The remaining matrix changes smoothly
+ with temperature and can be interpolated. This function then applies the
+ population ratios and the renormalization at the temperature of use. The
+ renormalization orders the lines by their strength at T, and can change
+ the matrix abruptly with temperature.
+
+ \param W: relaxation matrix to be completed
+ \param abs_lines: all absorption lines of the band
+ \param main_species: species of interest
+ \param partition_functions: the partition functions
+ \param T: Atmospheric temperature
+ */
+void hartmann_ecs_normalize(Matrix& W,
+                            const ArrayOfLineRecord& abs_lines,
+                            const ArrayOfSpeciesTag& main_species,
+                            const SpeciesAuxData& partition_functions,
+                            const Numeric& T);
+
 Vector population_density_vector(const ArrayOfLineRecord& abs_lines,
                                  const SpeciesAuxData& partition_functions,
                                  const Numeric& T);
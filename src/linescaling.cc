@@ -339,14 +339,8 @@ void CalculatePartitionFctFromData(Numeric& q_ref,
                                    ConstVectorView t_grid,
                                    ConstVectorView q_grid,
                                    const Index& interp_order) {
-  GridPosPoly gp_t, gp_ref;
-  gridpos_poly(gp_t, t_grid, t, interp_order);
-  gridpos_poly(gp_ref, t_grid, ref, interp_order);
-  Vector itw_t(gp_t.idx.nelem()), itw_ref(gp_ref.idx.nelem());
-  interpweights(itw_t, gp_t);
-  interpweights(itw_ref, gp_ref);
-  q_t = interp(itw_t, q_grid, gp_t);
-  q_ref = interp(itw_ref, q_grid, gp_ref);
+  q_t = interp_poly_point(q_grid, t_grid, t, interp_order);
+  q_ref = interp_poly_point(q_grid, t_grid, ref, interp_order);
 }
 
 void CalculatePartitionFctFromData_perturbed(Numeric& dQ_dT,
@@ -356,11 +350,7 @@ void CalculatePartitionFctFromData_perturbed(Numeric& dQ_dT,
                                              ConstVectorView t_grid,
                                              ConstVectorView q_grid,
                                              const Index& interp_order) {
-  GridPosPoly gp_t;
-  gridpos_poly(gp_t, t_grid, t + dT, interp_order);
-  Vector itw_t(gp_t.idx.nelem());
-  interpweights(itw_t, gp_t);
-  const Numeric q_t2 = interp(itw_t, q_grid, gp_t);
+  const Numeric q_t2 = interp_poly_point(q_grid, t_grid, t + dT, interp_order);
 
   // FIXME:  Is there a way to have interp return the derivative instead?  This way always undershoots the curve...  Should we have other point-derivatives, e.g., 2-point?
   dQ_dT = (q_t - q_t2) / dT;
@@ -461,11 +451,7 @@ Numeric SingleCalculatePartitionFctFromData(const Numeric& T,
                                             ConstVectorView t_grid,
                                             ConstVectorView q_grid,
                                             const Index& interp_order) {
-  GridPosPoly gp;
-  gridpos_poly(gp, t_grid, T, interp_order);
-  Vector itw(gp.idx.nelem());
-  interpweights(itw, gp);
-  return interp(itw, q_grid, gp);
+  return interp_poly_point(q_grid, t_grid, T, interp_order);
 }
 
 Numeric SingleCalculatePartitionFctFromData_dT(const Numeric& QT,
@@ -474,11 +460,7 @@ Numeric SingleCalculatePartitionFctFromData_dT(const Numeric& QT,
                                                ConstVectorView t_grid,
                                                ConstVectorView q_grid,
                                                const Index& interp_order) {
-  GridPosPoly gp;
-  gridpos_poly(gp, t_grid, T + dT, interp_order);
-  Vector itw(gp.idx.nelem());
-  interpweights(itw, gp);
-  return (interp(itw, q_grid, gp) - QT) / dT;
+  return (interp_poly_point(q_grid, t_grid, T + dT, interp_order) - QT) / dT;
 }
 
 Numeric single_partition_function(const Numeric& T,
@@ -956,6 +956,48 @@ void abs_lines_per_speciesCompact(  // WS Output:
   }
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_lines_per_speciesPruneWeakLines(  // WS Output:
+    ArrayOfArrayOfLineRecord& abs_lines_per_species,
+    // WS Input:
+    const ArrayOfArrayOfSpeciesTag& abs_species,
+    const Vector& f_grid,
+    const Vector& abs_p,
+    const Vector& abs_t,
+    const Matrix& abs_vmrs,
+    const SpeciesAuxData& isotopologue_ratios,
+    const SpeciesAuxData& partition_functions,
+    // Control Parameters:
+    const Numeric& tolerance,
+    const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  if (abs_lines_per_species.nelem() != abs_species.nelem())
+    throw runtime_error(
+        "*abs_lines_per_species* and *abs_species* must have the same "
+        "length.");
+  chk_size("abs_t", abs_t, abs_p.nelem());
+  chk_size("abs_vmrs", abs_vmrs, abs_species.nelem(), abs_p.nelem());
+  if (tolerance < 0 || tolerance >= 1)
+    throw runtime_error("*tolerance* must be >= 0 and < 1.");
+
+  for (Index i = 0; i < abs_lines_per_species.nelem(); i++) {
+    const Index nl = abs_lines_per_species[i].nelem();
+    const Numeric error_bound = prune_weak_lines(abs_lines_per_species[i],
+                                                 tolerance,
+                                                 f_grid,
+                                                 abs_p,
+                                                 abs_t,
+                                                 abs_vmrs,
+                                                 abs_species,
+                                                 isotopologue_ratios,
+                                                 partition_functions);
+    out2 << "  " << get_tag_group_name(abs_species[i]) << ": "
+         << nl - abs_lines_per_species[i].nelem() << " of " << nl
+         << " lines removed, relative error bound " << error_bound << "\n";
+  }
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void abs_speciesDefineAllInScenario(  // WS Output:
     ArrayOfArrayOfSpeciesTag& tgs,
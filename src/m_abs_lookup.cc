@@ -23,7 +23,11 @@
   \brief  Methods related to absorption, lookup table, etc.
 */
 
+#include <sys/stat.h>
 #include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
 #include <limits>
 #include <map>
 
@@ -34,6 +38,7 @@
 #include "auto_md.h"
 #include "check_input.h"
 #include "cloudbox.h"
+#include "file.h"
 #include "gas_abs_lookup.h"
 #include "global_data.h"
 #include "interpolation_poly.h"
@@ -42,9 +47,12 @@
 #include "messages.h"
 #include "physics_funcs.h"
 #include "rng.h"
+#include "xml_io.h"
 
 extern const Index GFIELD4_FIELD_NAMES;
 extern const Index GFIELD4_P_GRID;
+extern const Numeric GAS_CONSTANT;
+extern const Numeric PI;
 
 /* Workspace method: Doxygen documentation will be auto-generated */
 void abs_lookupInit(GasAbsLookup& x, const Verbosity& verbosity) {
@@ -56,6 +64,48 @@ void abs_lookupInit(GasAbsLookup& x, const Verbosity& verbosity) {
   out2 << "  Created an empty gas absorption lookup table.\n";
 }
 
+//! Key of the input to abs_lookupCalc that is not part of the table setup.
+/*!
+  The cross sections depend also on the methods of abs_xsec_agenda and on
+  the spectroscopic lines that these methods use. The agenda is not given
+  the lines as input, so they are taken from *abs_lines_per_species* in
+  the workspace, if that is set. The lines enter the key by their number
+  and the 64 bit FNV-1a hash of their catalogue entries.
+
+  \param ws               The workspace.
+  \param abs_xsec_agenda  The absorption agenda.
+  \return                 The key.
+*/
+static String abs_lookup_checkpoint_key(Workspace& ws,
+                                        const Agenda& abs_xsec_agenda) {
+  ostringstream os;
+  os << "abs_xsec_agenda:\n";
+  abs_xsec_agenda.print(os, "  ");
+
+  const map<String, Index>::const_iterator it =
+      Workspace::WsvMap.find("abs_lines_per_species");
+  if (it != Workspace::WsvMap.end() && ws.is_initialized(it->second)) {
+    const ArrayOfArrayOfLineRecord& lines =
+        *static_cast<ArrayOfArrayOfLineRecord*>(ws[it->second]);
+    uint64_t hash = 14695981039346656037ULL;
+    os << "abs_lines_per_species:";
+    for (Index i = 0; i < lines.nelem(); ++i) {
+      os << " " << lines[i].nelem();
+      for (Index j = 0; j < lines[i].nelem(); ++j) {
+        ostringstream line;
+        line << lines[i][j];
+        const String& s = line.str();
+        for (size_t k = 0; k < s.size(); ++k) {
+          hash ^= (unsigned char)s[k];
+          hash *= 1099511628211ULL;
+        }
+      }
+    }
+    os << "\nhash: " << std::hex << hash << "\n";
+  }
+  return os.str();
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void abs_lookupCalc(  // Workspace reference:
     Workspace& ws,
@@ -72,15 +122,13 @@ void abs_lookupCalc(  // Workspace reference:
     const Vector& abs_t_pert,
     const Vector& abs_nls_pert,
     const Agenda& abs_xsec_agenda,
+    // WS Generic Input:
+    const String& checkpoint_dir,
     // Verbosity object:
     const Verbosity& verbosity) {
   CREATE_OUT2;
   CREATE_OUT3;
 
-  // We need this temporary variable to make a local copy of all VMRs,
-  // where we then perturb the H2O profile as needed
-  Matrix these_all_vmrs = abs_vmrs;
-
   // We will be calling an absorption agenda one species at a
   // time. This is better than doing all simultaneously, because is
   // saves memory and allows for consistent treatment of nonlinear
@@ -106,25 +154,17 @@ void abs_lookupCalc(  // Workspace reference:
 
   // 3. Input to absorption calculations:
 
-  // Absorption vmrs and temperature:
-  Matrix this_vmr(1, n_p_grid);
-  Vector abs_h2o(n_p_grid);
+  // Absorption temperature:
   Vector this_t;  // Has same dimension, but is
                   // initialized by assignment later.
   const Matrix this_t_nlte_dummy;
 
-  // Species list, lines, and line shapes, all with only 1 element:
-  ArrayOfArrayOfSpeciesTag this_species(1);
-  ArrayOfArrayOfLineRecord these_lines(1);
-  ArrayOfLineshapeSpec this_lineshape(1);
-
   // List of active species for agenda call. Will always be filled with only
   // one species.
   ArrayOfIndex abs_species_active(1);
 
-  // Local copy of nls_pert and t_pert:
-  Vector these_nls_pert;  // Is resized every time when used
-  Vector these_t_pert;    // Is resized later on
+  // Local copy of t_pert:
+  Vector these_t_pert;  // Is resized later on
 
   // 4. Checks of input parameter correctness:
 
@@ -205,6 +245,7 @@ void abs_lookupCalc(  // Workspace reference:
   }
 
   // 5. Set general lookup table properties:
+  abs_lookup = GasAbsLookup();
   abs_lookup.species = abs_species;  // Species list
   abs_lookup.nonlinear_species =
       abs_nls_idx;             // Nonlinear species   (e.g., H2O, O2)
@@ -253,15 +294,19 @@ void abs_lookupCalc(  // Workspace reference:
 
   const Index these_t_pert_nelem = these_t_pert.nelem();
 
-  // 7. Now we have to fill abs_lookup.xsec with the right values!
-
-  String fail_msg;
-  bool failed = false;
-
-  // We have to make a local copy of the Workspace and the agenda because
-  // only non-reference types can be declared firstprivate in OpenMP
-  Workspace l_ws(ws);
-  Agenda l_abs_xsec_agenda(abs_xsec_agenda);
+  // 7. Set up the list of jobs. Each job calculates one slab
+  // abs_lookup.xsec(j, spec, joker, joker) of the table, that is one
+  // species and H2O VMR variant at one temperature perturbation. The jobs
+  // are independent of each other, so that all of them can be distributed
+  // over the threads at once, not only the temperature perturbations of a
+  // single species.
+  struct XsecJob {
+    Index i;     // Index in abs_species
+    Index s;     // Index of H2O VMR perturbation
+    Index spec;  // Index in second dimension of abs_lookup.xsec
+    Index j;     // Index of temperature perturbation
+  };
+  Array<XsecJob> jobs;
 
   // Loop species:
   for (Index i = 0, spec = 0; i < n_species; ++i) {
@@ -274,176 +319,224 @@ void abs_lookupCalc(  // Workspace reference:
       continue;
     }
 
-    // spec is the index for the second dimension of abs_lookup.xsec.
+    // For nonlinear species we loop the H2O VMR perturbations, for all
+    // others there is only the unperturbed case.
+    const Index n_variants = non_linear[i] ? n_nls_pert : 1;
 
-    // Prepare absorption agenda input for this species:
-    out2 << "  Doing species " << i + 1 << " of " << n_species << ": "
-         << abs_species[i] << ".\n";
+    out2 << "  Species " << i + 1 << " of " << n_species << ": "
+         << abs_species[i] << ", " << n_variants * these_t_pert_nelem
+         << " jobs.\n";
 
-    // Set active species:
-    abs_species_active[0] = i;
+    for (Index s = 0; s < n_variants; ++s, ++spec) {
+      for (Index j = 0; j < these_t_pert_nelem; ++j) {
+        XsecJob job;
+        job.i = i;
+        job.s = s;
+        job.spec = spec;
+        job.j = j;
+        jobs.push_back(job);
+      }
+    }
+  }
 
-    // Get a dummy list of tag groups with only the current element:
-    this_species[0].resize(abs_species[i].nelem());
-    this_species[0] = abs_species[i];
+  const Index n_jobs = jobs.nelem();
 
-    // Set up these_nls_pert. This is done so that we can use the
-    // same loop over the perturbations, independent of
-    // whether we have nonlinear species or not.
-    if (non_linear[i]) {
-      out2 << "  This is a species with H2O VMR perturbations.\n";
-      these_nls_pert.resize(n_nls_pert);
-      these_nls_pert = abs_nls_pert;
+  // 7.a. Prepare checkpointing. Completed slabs are stored in
+  // checkpoint_dir, together with the table setup. Slabs already found
+  // there are read back instead of being calculated again, so that an
+  // interrupted calculation can be resumed.
+  const bool do_checkpoint = checkpoint_dir.nelem() > 0;
+  if (do_checkpoint) {
+    if (mkdir(checkpoint_dir.c_str(), 0777) && errno != EEXIST) {
+      ostringstream os;
+      os << "Could not create checkpoint directory " << checkpoint_dir
+         << ".";
+      throw runtime_error(os.str());
+    }
+
+    const String setup_file = checkpoint_dir + "/abs_lookup_setup.xml";
+    const String key_file = checkpoint_dir + "/abs_lookup_key.xml";
+    const String key = abs_lookup_checkpoint_key(ws, abs_xsec_agenda);
+    if (file_exists(setup_file)) {
+      GasAbsLookup checkpoint_setup;
+      String checkpoint_key;
+      xml_read_from_file(setup_file, checkpoint_setup, verbosity);
+      if (file_exists(key_file))
+        xml_read_from_file(key_file, checkpoint_key, verbosity);
+      if (!checkpoint_setup.HasSameSetup(abs_lookup) ||
+          checkpoint_key != key) {
+        ostringstream os;
+        os << "The checkpoint directory " << checkpoint_dir << "\n"
+           << "belongs to a lookup table with a different setup, absorption\n"
+           << "agenda or line catalogue.\n"
+           << "Remove its content or use another checkpoint directory.";
+        throw runtime_error(os.str());
+      }
+      out2 << "  Resuming from checkpoint directory " << checkpoint_dir
+           << ".\n";
     } else {
-      these_nls_pert.resize(1);
-      these_nls_pert = 1;
+      // Write the setup without the cross sections. Binary format, so
+      // that the grids are read back exactly.
+      GasAbsLookup checkpoint_setup = abs_lookup;
+      checkpoint_setup.xsec.resize(0, 0, 0, 0);
+      xml_write_to_file(key_file, key, FILE_TYPE_ASCII, 0, verbosity);
+      xml_write_to_file(
+          setup_file, checkpoint_setup, FILE_TYPE_BINARY, 0, verbosity);
     }
+  }
+
+  // 8. Now we have to fill abs_lookup.xsec with the right values!
 
-    // Loop these_nls_pert:
-    for (Index s = 0; s < these_nls_pert.nelem(); ++s, ++spec) {
-      // Remember, spec is the index for the second dimension of
-      // abs_lookup.xsec
+  String fail_msg;
+  bool failed = false;
+  Index n_jobs_done = 0;
+
+  // We have to make a local copy of the Workspace and the agenda because
+  // only non-reference types can be declared firstprivate in OpenMP
+  Workspace l_ws(ws);
+  Agenda l_abs_xsec_agenda(abs_xsec_agenda);
+
+  // We need this temporary variable to make a local copy of all VMRs,
+  // where we then perturb the H2O profile as needed
+  Matrix these_all_vmrs = abs_vmrs;
 
-      if (non_linear[i]) {
-        out2 << "  Doing H2O VMR variant " << s + 1 << " of " << n_nls_pert
-             << ": " << abs_nls_pert[s] << ".\n";
+  // There is something strange here: abs_lookup seems to be
+  // "shared" by default, although I have set default(none). I
+  // suspect that the reason for this behavior is that
+  // abs_lookup is a return by reference parameter of this
+  // function. Anyway, shared is the correct setting for
+  // abs_lookup, so there is no problem.
+
+#pragma omp parallel for schedule(dynamic) if (!arts_omp_in_parallel() && \
+                                               n_jobs > 1)                \
+    private(this_t,                                                       \
+            abs_xsec_per_species,                                         \
+            src_xsec_per_species,                                         \
+            dabs_xsec_per_species_dx,                                     \
+            dsrc_xsec_per_species_dx)                                     \
+    firstprivate(l_ws, l_abs_xsec_agenda, these_all_vmrs, abs_species_active)
+  for (Index ijob = 0; ijob < n_jobs; ++ijob) {
+    // Skip remaining iterations if an error occurred
+    if (failed) continue;
+
+    const XsecJob& job = jobs[ijob];
+
+    // The try block here is necessary to correctly handle
+    // exceptions inside the parallel region.
+    try {
+      String slab_file;
+      if (do_checkpoint) {
+        ostringstream os;
+        os << checkpoint_dir << "/abs_lookup_slab_" << job.spec << "_"
+           << job.j << ".xml";
+        slab_file = os.str();
+
+        if (file_exists(slab_file)) {
+          Matrix slab;
+          xml_read_from_file(slab_file, slab, verbosity);
+          if (slab.nrows() != n_f_grid || slab.ncols() != n_p_grid) {
+            ostringstream os2;
+            os2 << "Checkpoint file " << slab_file << " has wrong size.";
+            throw runtime_error(os2.str());
+          }
+          abs_lookup.xsec(job.j, job.spec, joker, joker) = slab;
+          continue;
+        }
       }
 
-      // Make a local copy of the VMRs, and manipulate the H2O VMR within it.
+      {
+        // We first prepare the output in a string here,
+        // so that we can write it to out3 with a single
+        // operation. This avoids messy output from
+        // multiple threads.
+        ostringstream os;
+        os << "  Doing species " << job.i + 1 << " of " << n_species;
+        if (non_linear[job.i])
+          os << ", H2O VMR variant " << job.s + 1 << " of " << n_nls_pert;
+        if (0 != n_t_pert)
+          os << ", temperature variant " << job.j + 1 << " of " << n_t_pert;
+        os << ".\n";
+        out3 << os.str();
+      }
+
+      // Set active species:
+      abs_species_active[0] = job.i;
+
+      // Manipulate the H2O VMR within the local copy of the VMRs.
       // Note: We do not need a runtime error check that h2o_index is ok here,
       // because earlier on we throw an error if there is no H2O species although we
       // need it. So, if h2o_indes is -1, we here simply assume that there
       // should not be a perturbation
       if (h2o_index >= 0) {
         these_all_vmrs(h2o_index, joker) = abs_vmrs(h2o_index, joker);
-        these_all_vmrs(h2o_index, joker) *=
-            these_nls_pert[s];  // Add perturbation
+        if (non_linear[job.i])
+          these_all_vmrs(h2o_index, joker) *=
+              abs_nls_pert[job.s];  // Add perturbation
       }
 
-      // VMR for this species (still needed by interfact to continua):
-      // FIXME: This variable may go away eventually, when the continuum
-      // part no longer needs it.
-      this_vmr(0, joker) = these_all_vmrs(i, joker);
-
-      // For abs_h2o, we can always add the perturbations (it will
-      // not make a difference if the species itself is also H2O).
-      // Attention, we need to treat here also the case that there
-      // is no H2O species. We will then set abs_h2o to
-      // -1. Absorption routines that do not really need abs_h2o
-      // will still run.
-      //
-      // FIXME: abs_h2o is currently still needed by the continuum part.
-      // Should go away eventually.
-      if (h2o_index == -1) {
-        // The case without H2O species.
-        abs_h2o.resize(1);
-        abs_h2o = -1;
-      } else {
-        // The normal case.
-        abs_h2o = these_all_vmrs(h2o_index, joker);
+      // Create perturbed temperature profile:
+      this_t = abs_lookup.t_ref;
+      this_t += these_t_pert[job.j];
+
+      // Call agenda to calculate absorption:
+      abs_xsec_agendaExecute(l_ws,
+                             abs_xsec_per_species,
+                             src_xsec_per_species,
+                             dabs_xsec_per_species_dx,
+                             dsrc_xsec_per_species_dx,
+                             abs_species,
+                             ArrayOfRetrievalQuantity(0),
+                             abs_species_active,
+                             f_grid,
+                             abs_p,
+                             this_t,
+                             this_t_nlte_dummy,
+                             these_all_vmrs,
+                             l_abs_xsec_agenda);
+
+      // Store in the right place. There used to be a division by the
+      // number density n here. This is no longer necessary, since
+      // abs_xsec_per_species now contains true absorption cross sections.
+      abs_lookup.xsec(job.j, job.spec, joker, joker) =
+          abs_xsec_per_species[job.i];
+
+      if (do_checkpoint) {
+        // Write to a temporary file first and rename afterwards, so that
+        // an interrupted write never leaves an incomplete slab behind.
+        const String tmp_file = slab_file + ".tmp.xml";
+        xml_write_to_file(tmp_file,
+                          abs_xsec_per_species[job.i],
+                          FILE_TYPE_BINARY,
+                          0,
+                          verbosity);
+        if (std::rename((tmp_file + ".bin").c_str(),
+                        (slab_file + ".bin").c_str()) ||
+            std::rename(tmp_file.c_str(), slab_file.c_str())) {
+          ostringstream os;
+          os << "Could not write checkpoint file " << slab_file << ".";
+          throw runtime_error(os.str());
+        }
       }
 
-      // Loop temperature perturbations
-      // ------------------------------
-
-      // We use a parallel for loop for this.
-
-      // There is something strange here: abs_lookup seems to be
-      // "shared" by default, although I have set default(none). I
-      // suspect that the reason for this behavior is that
-      // abs_lookup is a return by reference parameter of this
-      // function. Anyway, shared is the correct setting for
-      // abs_lookup, so there is no problem.
-
-#pragma omp parallel for if (                                         \
-    !arts_omp_in_parallel() &&                                        \
-    these_t_pert_nelem >=                                             \
-        arts_omp_get_max_threads()) private(this_t,                   \
-                                            abs_xsec_per_species,     \
-                                            src_xsec_per_species,     \
-                                            dabs_xsec_per_species_dx, \
-                                            dsrc_xsec_per_species_dx) \
-    firstprivate(l_ws, l_abs_xsec_agenda)
-      for (Index j = 0; j < these_t_pert_nelem; ++j) {
-        // Skip remaining iterations if an error occurred
-        if (failed) continue;
-
-        // The try block here is necessary to correctly handle
-        // exceptions inside the parallel region.
-        try {
-          if (0 != n_t_pert) {
-            // We first prepare the output in a string here,
-            // so that we can write it to out3 with a single
-            // operation. This avoids messy output from
-            // multiple threads.
-            ostringstream os;
-
-            os << "  Doing temperature variant " << j + 1 << " of " << n_t_pert
-               << ": " << these_t_pert[j] << ".\n";
-
-            out3 << os.str();
-          }
-
-          // Create perturbed temperature profile:
-          this_t = abs_lookup.t_ref;
-          this_t += these_t_pert[j];
-
-          // Call agenda to calculate absorption:
-          abs_xsec_agendaExecute(l_ws,
-                                 abs_xsec_per_species,
-                                 src_xsec_per_species,
-                                 dabs_xsec_per_species_dx,
-                                 dsrc_xsec_per_species_dx,
-                                 abs_species,
-                                 ArrayOfRetrievalQuantity(0),
-                                 abs_species_active,
-                                 f_grid,
-                                 abs_p,
-                                 this_t,
-                                 this_t_nlte_dummy,
-                                 these_all_vmrs,
-                                 l_abs_xsec_agenda);
-
-          // Store in the right place:
-          // Loop through all altitudes
-          for (Index p = 0; p < n_p_grid; ++p) {
-            abs_lookup.xsec(j, spec, Range(joker), p) =
-                abs_xsec_per_species[i](Range(joker), p);
-
-            // There used to be a division by the number density
-            // n here. This is no longer necessary, since
-            // abs_xsec_per_species now contains true absorption
-            // cross sections.
-
-            // IMPORTANT: There was a bug in my old Matlab
-            // function "create_lookup.m" to generate the lookup
-            // table. (The number density was always the
-            // reference one, and did not change for different
-            // temperatures.) Patricks Atmlab function
-            // "arts_abstable_from_arts1.m" did *not* have this bug.
-
-            // Calculate the number density for the given pressure and
-            // temperature:
-            // n = n0*T0/p0 * p/T or n = p/kB/t, ideal gas law
-            //                  const Numeric n = number_density( abs_lookup.p_grid[p],
-            //                                                    this_t[p]   );
-            //                  abs_lookup.xsec( j, spec, Range(joker), p ) /= n;
-          }
-        }  // end of try block
-        catch (const std::runtime_error& e) {
+#pragma omp atomic
+      n_jobs_done++;
+    }  // end of try block
+    catch (const std::runtime_error& e) {
 #pragma omp critical(abs_lookupCalc_fail)
-          {
-            fail_msg = e.what();
-            failed = true;
-          }
-        }
-      }  // end of parallel for loop
-
-      if (failed) throw runtime_error(fail_msg);
+      {
+        fail_msg = e.what();
+        failed = true;
+      }
     }
-  }
+  }  // end of parallel for loop
 
-  // 6. Initialize fgp_default.
+  if (failed) throw runtime_error(fail_msg);
+
+  out2 << "  Calculated " << n_jobs_done << " of " << n_jobs
+       << " table slabs, " << n_jobs - n_jobs_done
+       << " read from checkpoint.\n";
+
+  // 9. Initialize fgp_default.
   abs_lookup.fgp_default.resize(f_grid.nelem());
   gridpos_poly(abs_lookup.fgp_default, abs_lookup.f_grid, abs_lookup.f_grid, 0);
 
@@ -452,6 +545,53 @@ void abs_lookupCalc(  // Workspace reference:
   abs_lookup_is_adapted = 1;
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_lookupAppendFrequencies(GasAbsLookup& abs_lookup,
+                                 Index& abs_lookup_is_adapted,
+                                 const GasAbsLookup& abs_lookup_other,
+                                 const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  abs_lookup.AppendFrequencies(abs_lookup_other);
+  abs_lookup_is_adapted = 0;
+
+  out2 << "  Merged lookup table has " << abs_lookup.GetFgrid().nelem()
+       << " frequencies.\n";
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_lookupCompress(GasAbsLookup& abs_lookup, const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  abs_lookup.Compress();
+
+  out2 << "  Max. relative error caused by compression: "
+       << abs_lookup.GetCompressionError() << "\n";
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_lookupKDistribution(GasAbsLookup& abs_lookup,
+                             Vector& f_grid,
+                             Vector& f_grid_weights,
+                             const Index& abs_lookup_is_adapted,
+                             const Vector& band_edges,
+                             const Vector& g_edges,
+                             const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  if (1 != abs_lookup_is_adapted)
+    throw runtime_error(
+        "Gas absorption lookup table must be adapted,\n"
+        "use method abs_lookupAdapt.");
+
+  const Index n_f = abs_lookup.GetFgrid().nelem();
+  abs_lookup.ConvertToKDistribution(f_grid_weights, band_edges, g_edges);
+  f_grid = abs_lookup.GetFgrid();
+
+  out2 << "  " << n_f << " frequencies replaced by " << f_grid.nelem()
+       << " g-points.\n";
+}
+
 //! Find continuum species in abs_species.
 /*! 
   Returns an index array with indexes of those species in abs_species
@@ -2228,7 +2368,7 @@ void propmat_clearsky_fieldCalc(Workspace& ws,
                                 n_pressures,
                                 n_latitudes,
                                 n_longitudes);
-  if (t_nlte_field.empty()) {
+  if (not t_nlte_field.empty()) {
     out2 << "  Creating source field with dimensions:\n"
          << "    " << n_species << "   gas species,\n"
          << "    " << n_frequencies << "   frequencies,\n"
@@ -2863,6 +3003,13 @@ void abs_lookupTestAccuracy(  // Workspace reference:
        << "  Pressure interpolation:    " << err_p << "%\n"
        << "  Total error:               " << err_tot << "%\n";
 
+  if (al.IsCompressed()) {
+    out2 << "  The table is compressed, all errors above include the\n"
+         << "  compression error.\n"
+         << "  Compression (cross sections): "
+         << al.GetCompressionError() * 100 << "%\n";
+  }
+
   // Check pressure interpolation
 
   //   assert(p_grid.nelem()==log_p_grid.nelem()); // Make sure that log_p_grid is initialized.
@@ -3108,3 +3255,192 @@ void abs_lookupTestAccMC(  // Workspace reference:
   out2 << "  Mean relative error: " << total_mean << "%\n"
        << "  Standard deviation:  " << total_std << "%\n";
 }
+
+//! Clear-sky longwave irradiance for the reference atmosphere of a table.
+/*!
+  This is a helper function used by abs_lookupTestKDistribution. The
+  atmosphere is given by the pressure grid and the reference profiles of
+  the table, the lowest level is the surface, which is a black body. The
+  calculation is non-scattering, using the two-stream approximation with
+  a diffusivity factor of 1.66.
+
+  \param[out] irradiance     Irradiance [W/m2], see *irradiance_field*.
+                             Dimension: [p_grid, 2].
+  \param[out] heating_rates  Heating rates [K/s]. Dimension: [p_grid].
+  \param[in] al              The lookup table.
+  \param[in] t_ref           Temperature profile.
+  \param[in] vmrs_ref        VMR profiles.
+  \param[in] f_weights       Integration weight of each frequency [Hz].
+  \param[in] p_interp_order  Pressure interpolation order.
+  \param[in] t_interp_order  Temperature interpolation order.
+  \param[in] nls_interp_order  H2O interpolation order.
+  \param[in] g0              Gravity.
+  \param[in] molarmass       Molar mass of air [g/mol].
+  \param[in] specific_heat   Specific heat capacity of air [J/(kg K)].
+*/
+static void lookup_reference_irradiance(Matrix& irradiance,
+                                        Vector& heating_rates,
+                                        const GasAbsLookup& al,
+                                        ConstVectorView t_ref,
+                                        ConstMatrixView vmrs_ref,
+                                        ConstVectorView f_weights,
+                                        const Index& p_interp_order,
+                                        const Index& t_interp_order,
+                                        const Index& nls_interp_order,
+                                        const Numeric& g0,
+                                        const Numeric& molarmass,
+                                        const Numeric& specific_heat) {
+  const Numeric diffusivity = 1.66;
+
+  const Vector& p_grid = al.GetPgrid();
+  const Vector& f_grid = al.GetFgrid();
+  const Index n_p = p_grid.nelem();
+  const Index n_f = f_grid.nelem();
+
+  if (n_p < 2)
+    throw runtime_error("The lookup table must have at least two pressures.");
+
+  // Absorption coefficient times dz/dp, from hydrostatic equilibrium and
+  // the ideal gas law:
+  Matrix abs_dz_dp(n_p, n_f, 0);
+  Matrix sga;
+  for (Index ip = 0; ip < n_p; ++ip) {
+    al.Extract(sga,
+               p_interp_order,
+               t_interp_order,
+               nls_interp_order,
+               0,
+               p_grid[ip],
+               t_ref[ip],
+               vmrs_ref(joker, ip),
+               f_grid,
+               0.5);
+    const Numeric dz_dp =
+        GAS_CONSTANT * t_ref[ip] / (p_grid[ip] * molarmass * 1e-3 * g0);
+    for (Index is = 0; is < sga.nrows(); ++is)
+      for (Index i = 0; i < n_f; ++i) abs_dz_dp(ip, i) += sga(is, i) * dz_dp;
+  }
+
+  irradiance.resize(n_p, 2);
+  irradiance = 0;
+  Vector b(n_p), trans(n_p - 1), down(n_p), up(n_p);
+  for (Index i = 0; i < n_f; ++i) {
+    for (Index ip = 0; ip < n_p; ++ip)
+      b[ip] = PI * planck(f_grid[i], t_ref[ip]);
+    for (Index ip = 0; ip < n_p - 1; ++ip)
+      trans[ip] = exp(-diffusivity * 0.5 *
+                      (abs_dz_dp(ip, i) + abs_dz_dp(ip + 1, i)) *
+                      abs(p_grid[ip] - p_grid[ip + 1]));
+
+    down[n_p - 1] = 0;
+    for (Index ip = n_p - 2; ip >= 0; --ip)
+      down[ip] = down[ip + 1] * trans[ip] +
+                 0.5 * (b[ip] + b[ip + 1]) * (1 - trans[ip]);
+    up[0] = b[0];
+    for (Index ip = 1; ip < n_p; ++ip)
+      up[ip] = up[ip - 1] * trans[ip - 1] +
+               0.5 * (b[ip - 1] + b[ip]) * (1 - trans[ip - 1]);
+
+    for (Index ip = 0; ip < n_p; ++ip) {
+      irradiance(ip, 0) -= f_weights[i] * down[ip];
+      irradiance(ip, 1) += f_weights[i] * up[ip];
+    }
+  }
+
+  heating_rates.resize(n_p);
+  for (Index ip = 0; ip < n_p; ++ip) {
+    const Index lo = max(ip - 1, Index(0));
+    const Index hi = min(ip + 1, n_p - 1);
+    heating_rates[ip] = (irradiance(hi, 0) + irradiance(hi, 1) -
+                         irradiance(lo, 0) - irradiance(lo, 1)) /
+                        (p_grid[hi] - p_grid[lo]) * g0 / specific_heat;
+  }
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void abs_lookupTestKDistribution(  // WS Generic Output:
+    Matrix& irradiance_lbl,
+    Matrix& irradiance_ckd,
+    Vector& heating_rates_lbl,
+    Vector& heating_rates_ckd,
+    // WS Input:
+    const GasAbsLookup& abs_lookup,
+    const Index& abs_lookup_is_adapted,
+    const Index& abs_p_interp_order,
+    const Index& abs_t_interp_order,
+    const Index& abs_nls_interp_order,
+    const Numeric& g0,
+    const Numeric& molarmass_dry_air,
+    // WS Generic Input:
+    const GasAbsLookup& abs_lookup_lbl,
+    const Vector& f_grid_weights,
+    const Numeric& specific_heat,
+    // Verbosity object:
+    const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  if (1 != abs_lookup_is_adapted)
+    throw runtime_error(
+        "Gas absorption lookup table must be adapted,\n"
+        "use method abs_lookupAdapt.");
+
+  const Vector& f_lbl = abs_lookup_lbl.f_grid;
+  const Index n_f_lbl = f_lbl.nelem();
+  if (abs_lookup_lbl.fgp_default.nelem() != n_f_lbl || n_f_lbl < 2)
+    throw runtime_error(
+        "*abs_lookup_lbl* must be an adapted table with at least two\n"
+        "frequencies.");
+  if (!abs_lookup.HasSameSetup(abs_lookup_lbl, false))
+    throw runtime_error(
+        "*abs_lookup* and *abs_lookup_lbl* must have the same species,\n"
+        "nonlinear species, pressure grid, perturbations and reference\n"
+        "profiles.");
+  chk_size("f_grid_weights", f_grid_weights, abs_lookup.f_grid.nelem());
+
+  // Trapezoidal integration weights of the line-by-line frequency grid,
+  // as used by *abs_lookupKDistribution*:
+  Vector w_lbl(n_f_lbl);
+  for (Index i = 0; i < n_f_lbl; ++i)
+    w_lbl[i] = 0.5 * (f_lbl[min(i + 1, n_f_lbl - 1)] -
+                      f_lbl[max(i - 1, Index(0))]);
+
+  lookup_reference_irradiance(irradiance_lbl,
+                              heating_rates_lbl,
+                              abs_lookup_lbl,
+                              abs_lookup.t_ref,
+                              abs_lookup.vmrs_ref,
+                              w_lbl,
+                              abs_p_interp_order,
+                              abs_t_interp_order,
+                              abs_nls_interp_order,
+                              g0,
+                              molarmass_dry_air,
+                              specific_heat);
+  lookup_reference_irradiance(irradiance_ckd,
+                              heating_rates_ckd,
+                              abs_lookup,
+                              abs_lookup.t_ref,
+                              abs_lookup.vmrs_ref,
+                              f_grid_weights,
+                              abs_p_interp_order,
+                              abs_t_interp_order,
+                              abs_nls_interp_order,
+                              g0,
+                              molarmass_dry_air,
+                              specific_heat);
+
+  Numeric max_down = 0, max_up = 0, max_hr = 0;
+  for (Index ip = 0; ip < irradiance_lbl.nrows(); ++ip) {
+    max_down =
+        max(max_down, abs(irradiance_ckd(ip, 0) - irradiance_lbl(ip, 0)));
+    max_up = max(max_up, abs(irradiance_ckd(ip, 1) - irradiance_lbl(ip, 1)));
+    max_hr =
+        max(max_hr, abs(heating_rates_ckd[ip] - heating_rates_lbl[ip]));
+  }
+
+  out2 << "  Max. difference of downward irradiance: " << max_down
+       << " W/m2\n"
+       << "  Max. difference of upward irradiance:   " << max_up << " W/m2\n"
+       << "  Max. difference of heating rate:        " << max_hr * 86400
+       << " K/day\n";
+}
@@ -46,6 +46,7 @@ using namespace std;
 #include "physics_funcs.h"
 #include "rte.h"
 #include "xml_io.h"
+#include "ybatch_file.h"
 
 extern const Numeric PI;
 extern const Numeric DEG2RAD;
@@ -234,6 +235,156 @@ void ybatchCalc(Workspace& ws,
   }
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void ybatchCalcToFile(Workspace& ws,
+                      // WS Input:
+                      const Index& ybatch_start,
+                      const Index& ybatch_n,
+                      const Agenda& ybatch_calc_agenda,
+                      // Control Parameters:
+                      const String& filename,
+                      const Index& robust,
+                      const Verbosity& verbosity) {
+  CREATE_OUTS;
+
+  ArrayOfString fail_msg;
+  bool do_abort = false;
+
+  // The file can only be continued by the same calculation
+  ostringstream key;
+  key << "ybatch_start: " << ybatch_start << "\nybatch_n: " << ybatch_n
+      << "\nybatch_calc_agenda:\n";
+  ybatch_calc_agenda.print(key, "  ");
+
+  // The results are handed over to the writer thread through a queue that
+  // is long enough to keep all calculation threads busy.
+  YbatchFileWriter writer(filename, key.str(), 2 * arts_omp_get_max_threads());
+
+  Index n_todo = 0;
+  for (Index i = 0; i < ybatch_n; i++)
+    if (!writer.contains(ybatch_start + i)) n_todo++;
+
+  if (n_todo < ybatch_n)
+    out1 << "  " << ybatch_n - n_todo << " of " << ybatch_n
+         << " jobs are already in " << filename << ", skipping them.\n";
+
+  Index job_counter = 0;
+
+  // We have to make a local copy of the Workspace and the agendas because
+  // only non-reference types can be declared firstprivate in OpenMP
+  Workspace l_ws(ws);
+  Agenda l_ybatch_calc_agenda(ybatch_calc_agenda);
+
+  if (n_todo)
+#pragma omp parallel for schedule(dynamic) if (!arts_omp_in_parallel() && \
+                                               n_todo > 1)                \
+    firstprivate(l_ws, l_ybatch_calc_agenda)
+    for (Index ybatch_index = 0; ybatch_index < ybatch_n; ybatch_index++) {
+      Index l_job_counter;  // Thread-local copy of job counter.
+
+      if (do_abort || writer.contains(ybatch_start + ybatch_index)) continue;
+#pragma omp critical(ybatchCalcToFile_job_counter)
+      { l_job_counter = ++job_counter; }
+
+      {
+        ostringstream os;
+        os << "  Job " << l_job_counter << " of " << n_todo << ", Index "
+           << ybatch_start + ybatch_index << ", Thread-Id "
+           << arts_omp_get_thread_num() << "\n";
+        out2 << os.str();
+      }
+
+      try {
+        Vector y;
+        ArrayOfVector y_aux;
+        Matrix jacobian;
+
+        ybatch_calc_agendaExecute(l_ws,
+                                  y,
+                                  y_aux,
+                                  jacobian,
+                                  ybatch_start + ybatch_index,
+                                  l_ybatch_calc_agenda);
+
+        const Index Knr = jacobian.nrows();
+        const Index Knc = jacobian.ncols();
+
+        if ((Knr != 0 || Knc != 0) && Knr != y.nelem()) {
+          ostringstream os;
+          os << "First dimension of Jacobian must have same length as the measurement *y*.\n"
+             << "Length of *y*: " << y.nelem() << "\n"
+             << "Dimensions of *jacobian*: (" << Knr << ", " << Knc << ")\n";
+#pragma omp critical(ybatchCalcToFile_setabort)
+          do_abort = true;
+
+          throw runtime_error(os.str());
+        }
+
+        // Failing to write is fatal as well, all later results would be
+        // lost.
+        try {
+          writer.push(ybatch_start + ybatch_index, y, y_aux, jacobian);
+        } catch (const std::exception&) {
+#pragma omp critical(ybatchCalcToFile_setabort)
+          do_abort = true;
+
+          throw;
+        }
+      } catch (const std::exception& e) {
+        if (robust && !do_abort) {
+          ostringstream os;
+          os << "WARNING! Job at ybatch_index " << ybatch_start + ybatch_index
+             << " failed.\n"
+             << "It is not stored in the output file and will be repeated\n"
+             << "if the calculation is restarted.\n"
+             << "The runtime error produced was:\n"
+             << e.what() << "\n";
+          out0 << os.str();
+        } else {
+#pragma omp critical(ybatchCalcToFile_setabort)
+          do_abort = true;
+
+          ostringstream os;
+          os << "  Job at ybatch_index " << ybatch_start + ybatch_index
+             << " failed. Aborting...\n";
+          out1 << os.str();
+        }
+        ostringstream os;
+        os << "Run-time error at ybatch_index " << ybatch_start + ybatch_index
+           << ": \n"
+           << e.what();
+#pragma omp critical(ybatchCalcToFile_push_fail_msg)
+        fail_msg.push_back(os.str());
+      }
+    }
+
+  // Results of jobs completed before an abort are still written, so they
+  // are not repeated when the calculation is restarted.
+  try {
+    writer.finish();
+  } catch (const std::exception& e) {
+    if (!do_abort) {
+      do_abort = true;
+      fail_msg.push_back(e.what());
+    }
+  }
+
+  if (fail_msg.nelem()) {
+    ostringstream os;
+
+    if (!do_abort) os << "\nError messages from failed batch cases:\n";
+    for (ArrayOfString::const_iterator it = fail_msg.begin();
+         it != fail_msg.end();
+         it++)
+      os << *it << '\n';
+
+    if (do_abort)
+      throw runtime_error(os.str());
+    else
+      out0 << os.str();
+  }
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void ybatchMetProfiles(Workspace& ws,
                        //Output
@@ -648,6 +799,26 @@ void ybatchMetProfilesClear(Workspace& ws,
   }  // closing the loop over profile basenames
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void ybatchReadFile(
+    // WS Output:
+    ArrayOfVector& ybatch,
+    ArrayOfArrayOfVector& ybatch_aux,
+    ArrayOfMatrix& ybatch_jacobians,
+    // WS Input:
+    const Index& ybatch_start,
+    const Index& ybatch_n,
+    // Control Parameters:
+    const String& filename,
+    const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  out2 << "  Reading " << filename << '\n';
+
+  ybatch_file_read(
+      ybatch, ybatch_aux, ybatch_jacobians, filename, ybatch_start, ybatch_n);
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void DOBatchCalc(Workspace& ws,
                  ArrayOfTensor7& dobatch_doit_i_field,
@@ -39,6 +39,7 @@
 #include <cmath>
 #include <stdexcept>
 #include "arts.h"
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "logic.h"
 #include "messages.h"
@@ -51,6 +52,45 @@ extern const Numeric PI;
 extern const Numeric SPEED_OF_LIGHT;
 extern const String SCATSPECIES_MAINTAG;
 
+//! Bulk back-scattering matrices
+/*!
+    Sums the back-scattering matrices of the scattering elements, weighted
+    with their number densities (or derivatives of number densities), for
+    all frequencies of one path point. The matrices of one scattering
+    element and path point are contiguous over frequency and Stokes
+    elements, and are added in a single loop over that block.
+
+    \param   P     Out: Bulk back-scattering matrices, [nf, ns, ns].
+    \param   Pe    Back-scattering matrices of the scattering elements,
+                   [ne, np, nf, ns, ns].
+    \param   pnd   Weight for each scattering element.
+    \param   ip    Index of the path point.
+
+    \author ARTS developers
+*/
+static void bulk_backscattering(Tensor3View P,
+                                ConstTensor5View Pe,
+                                ConstVectorView pnd,
+                                const Index& ip) {
+  const Index nf = P.npages();
+  const Index ns = P.nrows();
+  assert(pnd.nelem() == Pe.nshelves());
+
+  P = 0;
+  for (Index i = 0; i < pnd.nelem(); i++) {
+    const Numeric w = pnd[i];
+    if (w != 0) {
+      for (Index iv = 0; iv < nf; iv++) {
+        for (Index is1 = 0; is1 < ns; is1++) {
+          for (Index is2 = 0; is2 < ns; is2++) {
+            P(iv, is1, is2) += w * Pe(i, ip, iv, is1, is2);
+          }
+        }
+      }
+    }
+  }
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void iyActiveSingleScat(Workspace& ws,
                         Matrix& iy,
@@ -519,22 +559,31 @@ void iyActiveSingleScat(Workspace& ws,
     return;
   }
 
+  // Bulk back-scattering matrices of a path point, for all frequencies,
+  // and their derivatives with respect to the scattering species
+  Tensor3 Pbulk(nf, ns, ns);
+  Tensor4 dPbulk;
+  if (j_analytical_do) dPbulk.resize(nq, nf, ns, ns);
+
   // Radiative transfer calculations
   for (Index ip = 0; ip < np; ip++) {
     // Radar return only possible if inside cloudbox
     if (clear2cloudy[ip] >= 0) {
-      for (Index iv = 0; iv < nf; iv++) {
-        // Calculate bulk back-scattering
-        Matrix P(ns, ns, 0);
-        for (Index i = 0; i < ne; i++) {
-          if (ppvar_pnd(i, ip) != 0) {
-            for (Index is1 = 0; is1 < ns; is1++) {
-              for (Index is2 = 0; is2 < ns; is2++) {
-                P(is1, is2) += ppvar_pnd(i, ip) * Pe(i, ip, iv, is1, is2);
-              }
-            }
+      // Calculate bulk back-scattering, for all frequencies at once
+      bulk_backscattering(Pbulk, Pe, ppvar_pnd(joker, ip), ip);
+      if (j_analytical_do) {
+        for (Index iq = 0; iq < nq; iq++) {
+          if (jacobian_quantities[iq].Analytical() && jac_scat_i[iq] >= 0) {
+            bulk_backscattering(dPbulk(iq, joker, joker, joker),
+                                Pe,
+                                ppvar_dpnd_dx[iq](joker, ip),
+                                ip);
           }
         }
+      }
+
+      for (Index iv = 0; iv < nf; iv++) {
+        ConstMatrixView P = Pbulk(iv, joker, joker);
 
         // Combine iy0, double transmission and scattering matrix
         Vector iy1(ns), iy2(ns);
@@ -561,22 +610,10 @@ void iyActiveSingleScat(Workspace& ws,
           for (Index iq = 0; iq < nq; iq++) {
             if (jacobian_quantities[iq].Analytical()) {
               if (jac_scat_i[iq] >= 0) {
-                // Change of scattering scattering matrix
-                P = 0.0;
-                for (Index i = 0; i < ne; i++) {
-                  if (ppvar_dpnd_dx[iq](i, ip) != 0) {
-                    for (Index is1 = 0; is1 < ns; is1++) {
-                      for (Index is2 = 0; is2 < ns; is2++) {
-                        P(is1, is2) +=
-                            ppvar_dpnd_dx[iq](i, ip) * Pe(i, ip, iv, is1, is2);
-                      }
-                    }
-                  }
-                }
-
-                // Apply transmissions as above
+                // Change of scattering scattering matrix, and apply
+                // transmissions as above
                 Vector iy_tmp(ns);
-                mult(iy_tmp, P, iy1);
+                mult(iy_tmp, dPbulk(iq, iv, joker, joker), iy1);
                 mult(diy_dpath[iq](ip, iout, joker),
                      ppvar_trans_cumulat(ip, iv, joker, joker),
                      iy_tmp);
@@ -1355,188 +1392,216 @@ void yActive(Workspace& ws,
   // The calculations
   //---------------------------------------------------------------------------
 
-  // Loop positions
-  for (Index p = 0; p < npos; p++) {
-    // RT part
-    Tensor3 iy_transmission(0, 0, 0);
-    ArrayOfTensor3 diy_dx;
-    Vector rte_pos2(0);
-    Matrix iy;
-    Ppath ppath;
-    ArrayOfMatrix iy_aux;
-    const Index iy_id = (Index)1e6 * p;
-    //
-    iy_main_agendaExecute(ws,
-                          iy,
-                          iy_aux,
-                          ppath,
-                          diy_dx,
-                          1,
-                          iy_unit,
-                          iy_transmission,
-                          iy_aux_vars,
-                          iy_id,
-                          cloudbox_on,
-                          jacobian_do,
-                          t_field,
-                          z_field,
-                          vmr_field,
-                          nlte_field,
-                          f_grid,
-                          sensor_pos(p, joker),
-                          sensor_los(p, joker),
-                          rte_pos2,
-                          iy_main_agenda);
-
-    // Check if path and size OK
-    const Index np = ppath.np;
-    if (np == 1)
-      throw runtime_error(
-          "A path consisting of a single point found. "
-          "This is not allowed.");
-    error_if_limb_ppath(ppath);
-    if (iy.nrows() != nf * np)
-      throw runtime_error(
-          "The size of *iy* returned from *iy_main_agenda* "
-          "is not correct (for this method).");
-
-    // Range of ppath, in altitude or time
-    Vector range(np);
-    if (is_z) {
-      range = ppath.pos(joker, 0);
-    } else {  // Calculate round-trip time
-      range[0] = 2 * ppath.end_lstep / SPEED_OF_LIGHT;
-      for (Index i = 1; i < np; i++) {
-        range[i] = range[i - 1] + ppath.lstep[i - 1] *
-                                      (ppath.ngroup[i - 1] + ppath.ngroup[i]) /
-                                      SPEED_OF_LIGHT;
-      }
-    }
-    const Numeric range_end1 = min(range[0], range[np - 1]);
-    const Numeric range_end2 = max(range[0], range[np - 1]);
+  // Copies of workspace and agendas for the threads
+  Workspace l_ws(ws);
+  Agenda l_iy_main_agenda(iy_main_agenda);
+  Agenda l_geo_pos_agenda(geo_pos_agenda);
 
-    // Loop radar bins
-    for (Index b = 0; b < nbins; b++) {
-      if (!(range_bins[b] >= range_end2 ||     // Otherwise bin totally outside
-            range_bins[b + 1] <= range_end1))  // range of ppath
-      {
-        // Bin limits
-        Numeric blim1 = max(range_bins[b], range_end1);
-        Numeric blim2 = min(range_bins[b + 1], range_end2);
+  String fail_msg;
+  bool failed = false;
 
-        // Determine weight vector to obtain mean inside bin
-        Vector hbin(np);
-        integration_bin_by_vecmult(hbin, range, blim1, blim2);
-        // The function above handles integration over the bin, while we
-        // want the average, so divide weights with bin width
-        hbin /= (blim2 - blim1);
-
-        for (Index iv = 0; iv < nf; iv++) {
-          // Pick out part of iy for frequency
-          Matrix I = iy(Range(iv * np, np), joker);
-          ArrayOfTensor3 dI(njq);
-          if (j_analytical_do) {
-            FOR_ANALYTICAL_JACOBIANS_DO(
-                dI[iq] = diy_dx[iq](joker, Range(iv * np, np), joker);)
-          }
-          ArrayOfMatrix A(naux);
-          for (Index a = 0; a < naux; a++) {
-            A[a] = iy_aux[a](Range(iv * np, np), joker);
-          }
-
-          // Variables to hold data for one freq and one pol
-          Vector refl(np);
-          ArrayOfMatrix drefl(njq);
-          if (j_analytical_do) {
-            FOR_ANALYTICAL_JACOBIANS_DO(drefl[iq].resize(dI[iq].npages(), np);)
-          }
-          ArrayOfVector auxvar(naux);
-          for (Index a = 0; a < naux; a++) {
-            auxvar[a].resize(np);
-          }
+  // Loop positions. The positions are independent, and each one fills its
+  // own part of the output variables.
+#pragma omp parallel for if (!arts_omp_in_parallel() && npos > 1) \
+    firstprivate(l_ws, l_iy_main_agenda, l_geo_pos_agenda)
+  for (Index p = 0; p < npos; p++) {
+    if (failed) continue;
+
+    try {
+      // RT part
+      Tensor3 iy_transmission(0, 0, 0);
+      ArrayOfTensor3 diy_dx;
+      Vector rte_pos2(0);
+      Matrix iy;
+      Ppath ppath;
+      ArrayOfMatrix iy_aux;
+      const Index iy_id = (Index)1e6 * p;
+      //
+      iy_main_agendaExecute(l_ws,
+                            iy,
+                            iy_aux,
+                            ppath,
+                            diy_dx,
+                            1,
+                            iy_unit,
+                            iy_transmission,
+                            iy_aux_vars,
+                            iy_id,
+                            cloudbox_on,
+                            jacobian_do,
+                            t_field,
+                            z_field,
+                            vmr_field,
+                            nlte_field,
+                            f_grid,
+                            sensor_pos(p, joker),
+                            sensor_los(p, joker),
+                            rte_pos2,
+                            l_iy_main_agenda);
+
+      // Check if path and size OK
+      const Index np = ppath.np;
+      if (np == 1)
+        throw runtime_error(
+            "A path consisting of a single point found. "
+            "This is not allowed.");
+      error_if_limb_ppath(ppath);
+      if (iy.nrows() != nf * np)
+        throw runtime_error(
+            "The size of *iy* returned from *iy_main_agenda* "
+            "is not correct (for this method).");
+
+      // Range of ppath, in altitude or time
+      Vector range(np);
+      if (is_z) {
+        range = ppath.pos(joker, 0);
+      } else {  // Calculate round-trip time
+        range[0] = 2 * ppath.end_lstep / SPEED_OF_LIGHT;
+        for (Index i = 1; i < np; i++) {
+          range[i] =
+              range[i - 1] + ppath.lstep[i - 1] *
+                                 (ppath.ngroup[i - 1] + ppath.ngroup[i]) /
+                                 SPEED_OF_LIGHT;
+        }
+      }
+      const Numeric range_end1 = min(range[0], range[np - 1]);
+      const Numeric range_end2 = max(range[0], range[np - 1]);
 
-          for (Index ip = 0; ip < instrument_pol_array[iv].nelem(); ip++) {
-            // Apply weights on each Stokes element
-            mult(refl, I, W[iv][ip]);
+      // Loop radar bins
+      for (Index b = 0; b < nbins; b++) {
+        if (!(range_bins[b] >= range_end2 ||  // Otherwise bin totally outside
+              range_bins[b + 1] <= range_end1))  // range of ppath
+        {
+          // Bin limits
+          Numeric blim1 = max(range_bins[b], range_end1);
+          Numeric blim2 = min(range_bins[b + 1], range_end2);
+
+          // Determine weight vector to obtain mean inside bin
+          Vector hbin(np);
+          integration_bin_by_vecmult(hbin, range, blim1, blim2);
+          // The function above handles integration over the bin, while we
+          // want the average, so divide weights with bin width
+          hbin /= (blim2 - blim1);
+
+          for (Index iv = 0; iv < nf; iv++) {
+            // Pick out part of iy for frequency
+            Matrix I = iy(Range(iv * np, np), joker);
+            ArrayOfTensor3 dI(njq);
             if (j_analytical_do) {
-              FOR_ANALYTICAL_JACOBIANS_DO(for (Index k = 0;
-                                               k < drefl[iq].nrows();
-                                               k++) {
-                mult(drefl[iq](k, joker), dI[iq](k, joker, joker), W[iv][ip]);
-              })
+              FOR_ANALYTICAL_JACOBIANS_DO(
+                  dI[iq] = diy_dx[iq](joker, Range(iv * np, np), joker);)
             }
+            ArrayOfMatrix A(naux);
             for (Index a = 0; a < naux; a++) {
-              if (iy_aux_vars[a] == "Backscattering") {
-                mult(auxvar[a], A[a], W[iv][ip]);
-              } else {
-                for (Index j = 0; j < np; j++) {
-                  auxvar[a][j] = A[a](j, 0);
-                }
-              }
+              A[a] = iy_aux[a](Range(iv * np, np), joker);
             }
 
-            // Apply bin weight vector to get final values.
-            Index iout = nbins * (p * npolcum[nf] + npolcum[iv] + ip) + b;
-            y[iout] = cfac[iv] * (hbin * refl);
-            //
+            // Variables to hold data for one freq and one pol
+            Vector refl(np);
+            ArrayOfMatrix drefl(njq);
             if (j_analytical_do) {
               FOR_ANALYTICAL_JACOBIANS_DO(
-                  for (Index k = 0; k < drefl[iq].nrows(); k++) {
-                    jacobian(iout, jacobian_indices[iq][0] + k) =
-                        cfac[iv] * (hbin * drefl[iq](k, joker));
-                    if (iy_unit == "dBZe") {
-                      jacobian(iout, jacobian_indices[iq][0] + k) *=
-                          jfac / max(y[iout], ze_min);
-                    }
-                  })
+                  drefl[iq].resize(dI[iq].npages(), np);)
             }
-
-            if (iy_unit == "dBZe") {
-              y[iout] = y[iout] <= ze_min ? dbze_min : 10 * log10(y[iout]);
+            ArrayOfVector auxvar(naux);
+            for (Index a = 0; a < naux; a++) {
+              auxvar[a].resize(np);
             }
 
-            // Same for aux variables
-            for (Index a = 0; a < naux; a++) {
-              if (iy_aux_vars[a] == "Backscattering") {
-                y_aux[a][iout] = cfac[iv] * (hbin * auxvar[a]);
-                if (iy_unit == "dBZe") {
-                  y_aux[a][iout] = y_aux[a][iout] <= ze_min
-                                       ? dbze_min
-                                       : 10 * log10(y_aux[a][iout]);
+            for (Index ip = 0; ip < instrument_pol_array[iv].nelem(); ip++) {
+              // Apply weights on each Stokes element
+              mult(refl, I, W[iv][ip]);
+              if (j_analytical_do) {
+                FOR_ANALYTICAL_JACOBIANS_DO(for (Index k = 0;
+                                                 k < drefl[iq].nrows();
+                                                 k++) {
+                  mult(drefl[iq](k, joker), dI[iq](k, joker, joker), W[iv][ip]);
+                })
+              }
+              for (Index a = 0; a < naux; a++) {
+                if (iy_aux_vars[a] == "Backscattering") {
+                  mult(auxvar[a], A[a], W[iv][ip]);
+                } else {
+                  for (Index j = 0; j < np; j++) {
+                    auxvar[a][j] = A[a](j, 0);
+                  }
+                }
+              }
+
+              // Apply bin weight vector to get final values.
+              Index iout = nbins * (p * npolcum[nf] + npolcum[iv] + ip) + b;
+              y[iout] = cfac[iv] * (hbin * refl);
+              //
+              if (j_analytical_do) {
+                FOR_ANALYTICAL_JACOBIANS_DO(
+                    for (Index k = 0; k < drefl[iq].nrows(); k++) {
+                      jacobian(iout, jacobian_indices[iq][0] + k) =
+                          cfac[iv] * (hbin * drefl[iq](k, joker));
+                      if (iy_unit == "dBZe") {
+                        jacobian(iout, jacobian_indices[iq][0] + k) *=
+                            jfac / max(y[iout], ze_min);
+                      }
+                    })
+              }
+
+              if (iy_unit == "dBZe") {
+                y[iout] = y[iout] <= ze_min ? dbze_min : 10 * log10(y[iout]);
+              }
+
+              // Same for aux variables
+              for (Index a = 0; a < naux; a++) {
+                if (iy_aux_vars[a] == "Backscattering") {
+                  y_aux[a][iout] = cfac[iv] * (hbin * auxvar[a]);
+                  if (iy_unit == "dBZe") {
+                    y_aux[a][iout] = y_aux[a][iout] <= ze_min
+                                         ? dbze_min
+                                         : 10 * log10(y_aux[a][iout]);
+                  }
+                } else {
+                  y_aux[a][iout] = hbin * auxvar[a];
                 }
-              } else {
-                y_aux[a][iout] = hbin * auxvar[a];
               }
             }
-          }
-        }  // Frequency
+          }  // Frequency
+        }
       }
-    }
 
-    // Other aux variables
-    //
-    Vector geo_pos;
-    geo_pos_agendaExecute(ws, geo_pos, ppath, geo_pos_agenda);
-    if (geo_pos.nelem() && geo_pos.nelem() != atmosphere_dim) {
-      throw runtime_error(
-          "Wrong size of *geo_pos* obtained from "
-          "*geo_pos_agenda*.\nThe length of *geo_pos* must "
-          "be zero or equal to *atmosphere_dim*.");
-    }
-    //
-    for (Index b = 0; b < nbins; b++) {
-      for (Index iv = 0; iv < nf; iv++) {
-        for (Index ip = 0; ip < instrument_pol_array[iv].nelem(); ip++) {
-          const Index iout = nbins * (p * npolcum[nf] + npolcum[iv] + ip) + b;
-          y_f[iout] = f_grid[iv];
-          y_pol[iout] = instrument_pol_array[iv][ip];
-          y_pos(iout, joker) = sensor_pos(p, joker);
-          y_los(iout, joker) = sensor_los(p, joker);
-          if (geo_pos.nelem()) {
-            y_geo(iout, joker) = geo_pos;
+      // Other aux variables
+      //
+      Vector geo_pos;
+      geo_pos_agendaExecute(l_ws, geo_pos, ppath, l_geo_pos_agenda);
+      if (geo_pos.nelem() && geo_pos.nelem() != atmosphere_dim) {
+        throw runtime_error(
+            "Wrong size of *geo_pos* obtained from "
+            "*geo_pos_agenda*.\nThe length of *geo_pos* must "
+            "be zero or equal to *atmosphere_dim*.");
+      }
+      //
+      for (Index b = 0; b < nbins; b++) {
+        for (Index iv = 0; iv < nf; iv++) {
+          for (Index ip = 0; ip < instrument_pol_array[iv].nelem(); ip++) {
+            const Index iout = nbins * (p * npolcum[nf] + npolcum[iv] + ip) + b;
+            y_f[iout] = f_grid[iv];
+            y_pol[iout] = instrument_pol_array[iv][ip];
+            y_pos(iout, joker) = sensor_pos(p, joker);
+            y_los(iout, joker) = sensor_los(p, joker);
+            if (geo_pos.nelem()) {
+              y_geo(iout, joker) = geo_pos;
+            }
           }
         }
       }
+    } catch (const std::exception& e) {
+      ostringstream os;
+      os << "Error for position " << p << ":\n" << e.what();
+#pragma omp critical(yActive_fail)
+      {
+        failed = true;
+        fail_msg = os.str();
+      }
+      continue;
     }
   }
+
+  if (failed) throw runtime_error(fail_msg);
 }
@@ -1108,6 +1108,7 @@ void doit_i_fieldUpdateSeq3D(
     Workspace& ws,
     // WS Output and Input:
     Tensor6& doit_i_field_mono,
+    DoitGeometryCache& doit_geometry_cache,
     // WS Input:
     const Tensor6& doit_scat_field,
     const ArrayOfIndex& cloudbox_limits,
@@ -1133,6 +1134,7 @@ void doit_i_fieldUpdateSeq3D(
     const Vector& f_grid,
     const Index& f_index,
     const Index& doit_za_interp,
+    const Index& level_parallel,
     const Verbosity& verbosity) {
   CREATE_OUT2;
   CREATE_OUT3;
@@ -1215,6 +1217,68 @@ void doit_i_fieldUpdateSeq3D(
 
   // ---------- End of checks ------------------------------------------
 
+  //=======================================================================
+  // Propagation path steps
+  //=======================================================================
+
+  // The path steps depend on the atmospheric state and the grids, but not
+  // on the radiation field. They are reused as long as the key matches.
+  // Refraction can make the paths frequency dependent.
+  std::vector<Numeric> key_data;
+  key_data.push_back((Numeric)N_scat_za);
+  key_data.push_back((Numeric)N_scat_aa);
+  key_data.push_back((Numeric)p_grid.nelem());
+  key_data.push_back((Numeric)lat_grid.nelem());
+  key_data.push_back((Numeric)lon_grid.nelem());
+  key_data.push_back((Numeric)vmr_field.nbooks());
+  key_data.push_back(ppath_lmax);
+  key_data.push_back(ppath_lraytrace);
+  for (Index i = 0; i < cloudbox_limits.nelem(); i++)
+    key_data.push_back((Numeric)cloudbox_limits[i]);
+  for (Index i = 0; i < refellipsoid.nelem(); i++)
+    key_data.push_back(refellipsoid[i]);
+  for (Index i = 0; i < N_scat_za; i++) key_data.push_back(scat_za_grid[i]);
+  for (Index i = 0; i < N_scat_aa; i++) key_data.push_back(scat_aa_grid[i]);
+  for (Index i = 0; i < p_grid.nelem(); i++) key_data.push_back(p_grid[i]);
+  for (Index i = 0; i < lat_grid.nelem(); i++) key_data.push_back(lat_grid[i]);
+  for (Index i = 0; i < lon_grid.nelem(); i++) key_data.push_back(lon_grid[i]);
+  for (Index ip = 0; ip < p_grid.nelem(); ip++) {
+    for (Index ilat = 0; ilat < lat_grid.nelem(); ilat++) {
+      for (Index ilon = 0; ilon < lon_grid.nelem(); ilon++) {
+        key_data.push_back(z_field(ip, ilat, ilon));
+        key_data.push_back(t_field(ip, ilat, ilon));
+        for (Index is = 0; is < vmr_field.nbooks(); is++)
+          key_data.push_back(vmr_field(is, ip, ilat, ilon));
+      }
+    }
+  }
+  if (ppath_step_agenda.has_method("ppath_stepRefractionBasic"))
+    key_data.push_back(f_grid[f_index]);
+  const Vector key(key_data);
+
+  const std::shared_ptr<const DoitGeometry3D> geometry =
+      doit_geometry_cache.get(key, [&](DoitGeometry3D& g) {
+        out3 << "Calculate propagation path steps\n";
+        cloud_geometry3D_calc(ws,
+                              g,
+                              scat_za_grid,
+                              scat_aa_grid,
+                              cloudbox_limits,
+                              ppath_step_agenda,
+                              ppath_lmax,
+                              ppath_lraytrace,
+                              p_grid,
+                              lat_grid,
+                              lon_grid,
+                              z_field,
+                              refellipsoid,
+                              t_field,
+                              vmr_field,
+                              f_grid,
+                              f_index,
+                              verbosity);
+      });
+
   //=======================================================================
   // Calculate coefficients for all positions in the cloudbox
   //=======================================================================
@@ -1234,23 +1298,48 @@ void doit_i_fieldUpdateSeq3D(
   const Index lat_up = cloudbox_limits[3];
   const Index lon_low = cloudbox_limits[4];
   const Index lon_up = cloudbox_limits[5];
+  const Index N_lat = lat_up - lat_low + 1;
+  const Index N_lon = lon_up - lon_low + 1;
+  const Index N_cells = N_lat * N_lon;
 
   // To use special interpolation functions for atmospheric fields we
   // use ext_mat_field and abs_vec_field:
-  Tensor5 ext_mat_field(p_up - p_low + 1,
-                        lat_up - lat_low + 1,
-                        lon_up - lon_low + 1,
-                        stokes_dim,
-                        stokes_dim,
-                        0.);
-  Tensor4 abs_vec_field(p_up - p_low + 1,
-                        lat_up - lat_low + 1,
-                        lon_up - lon_low + 1,
-                        stokes_dim,
-                        0.);
+  Tensor5 ext_mat_field(
+      p_up - p_low + 1, N_lat, N_lon, stokes_dim, stokes_dim, 0.);
+  Tensor4 abs_vec_field(p_up - p_low + 1, N_lat, N_lon, stokes_dim, 0.);
+
+  // Radiation field of the grid points being updated
+  Tensor3 doit_i_field_level(N_lat, N_lon, stokes_dim);
+
+  String fail_msg;
+  bool failed = false;
+
+  // Error message for a failed update of a grid point
+  auto update_error = [&](const Index p_index,
+                          const Index i_cell,
+                          const Index scat_za_index,
+                          const Index scat_aa_index,
+                          const std::exception& e) {
+    ostringstream os;
+    os << "Error for p_index = " << p_index + p_low
+       << ", lat_index = " << i_cell / N_lon + lat_low
+       << ", lon_index = " << i_cell % N_lon + lon_low
+       << ", scat_za_index = " << scat_za_index
+       << " and scat_aa_index = " << scat_aa_index << ":\n"
+       << e.what();
+    return String(os.str());
+  };
 
   //Loop over all directions, defined by scat_za_grid
   for (Index scat_za_index = 0; scat_za_index < N_scat_za; scat_za_index++) {
+    // Pressure levels in the order of the sequential update
+    ArrayOfIndex p_indices;
+    cloud_sweep3D_levels(p_indices,
+                         scat_za_grid[scat_za_index],
+                         cloudbox_limits,
+                         z_field,
+                         refellipsoid);
+
     //Loop over azimuth directions (scat_aa_grid). First and last point in
     // azimuth angle grid are euqal. Start with second element.
     for (Index scat_aa_index = 1; scat_aa_index < N_scat_aa; scat_aa_index++) {
@@ -1272,144 +1361,105 @@ void doit_i_fieldUpdateSeq3D(
                        pnd_field,
                        verbosity);
 
-      Vector stokes_vec(stokes_dim, 0.);
-
-      Numeric theta_lim = 180. - asin((refellipsoid[0] + z_field(p_low, 0, 0)) /
-                                      (refellipsoid[0] + z_field(p_up, 0, 0))) *
-                                     RAD2DEG;
-
-      // Sequential update for uplooking angles
-      if (scat_za_grid[scat_za_index] <= 90.) {
-        // Loop over all positions inside the cloud box defined by the
-        // cloudbox_limits exculding the upper boundary. For uplooking
-        // directions, we start from cloudbox_limits[1]-1 and go down
-        // to cloudbox_limits[0] to do a sequential update of the
-        // aradiation field
-        for (Index p_index = p_up - 1; p_index >= p_low; p_index--) {
-          for (Index lat_index = lat_low; lat_index <= lat_up; lat_index++) {
-            for (Index lon_index = lon_low; lon_index <= lon_up; lon_index++) {
-              cloud_ppath_update3D(ws,
-                                   doit_i_field_mono,
-                                   p_index,
-                                   lat_index,
-                                   lon_index,
-                                   scat_za_index,
-                                   scat_aa_index,
-                                   scat_za_grid,
-                                   scat_aa_grid,
-                                   cloudbox_limits,
-                                   doit_scat_field,
-                                   propmat_clearsky_agenda,
-                                   vmr_field,
-                                   ppath_step_agenda,
-                                   ppath_lmax,
-                                   ppath_lraytrace,
-                                   p_grid,
-                                   lat_grid,
-                                   lon_grid,
-                                   z_field,
-                                   refellipsoid,
-                                   t_field,
-                                   f_grid,
-                                   f_index,
-                                   ext_mat_field,
-                                   abs_vec_field,
-                                   doit_za_interp,
-                                   verbosity);
+      const Index i_dir = scat_za_index * N_scat_aa + scat_aa_index;
+
+      if (!level_parallel) {
+        // Sequential update, in the order of the pressure levels and then
+        // latitude and longitude. The new radiances of a grid point are
+        // used as upwind radiances by the following grid points.
+        for (Index i_p = 0; i_p < p_indices.nelem(); i_p++) {
+          const Index p_index = p_indices[i_p] - p_low;
+          const Index i_step0 =
+              (i_dir * (p_up - p_low + 1) + p_index) * N_cells;
+
+          for (Index i_cell = 0; i_cell < N_cells; i_cell++) {
+            if (!geometry->npoints(i_step0 + i_cell)) continue;
+            const Index lat_index = i_cell / N_lon;
+            const Index lon_index = i_cell % N_lon;
+            try {
+              cloud_ppath_update3D(
+                  ws,
+                  doit_i_field_level(lat_index, lon_index, joker),
+                  *geometry,
+                  i_step0 + i_cell,
+                  doit_i_field_mono,
+                  doit_scat_field,
+                  propmat_clearsky_agenda,
+                  f_grid,
+                  f_index,
+                  ext_mat_field,
+                  abs_vec_field,
+                  verbosity);
+            } catch (const std::exception& e) {
+              throw runtime_error(update_error(
+                  p_index, i_cell, scat_za_index, scat_aa_index, e));
             }
+            doit_i_field_mono(p_index,
+                              lat_index,
+                              lon_index,
+                              scat_za_index,
+                              scat_aa_index,
+                              joker) =
+                doit_i_field_level(lat_index, lon_index, joker);
           }
         }
-      }  // close up-looking case
-      else if (scat_za_grid[scat_za_index] > theta_lim) {
-        //
-        // Sequential updating for downlooking angles
-        //
-        for (Index p_index = p_low + 1; p_index <= p_up; p_index++) {
-          for (Index lat_index = lat_low; lat_index <= lat_up; lat_index++) {
-            for (Index lon_index = lon_low; lon_index <= lon_up; lon_index++) {
-              cloud_ppath_update3D(ws,
-                                   doit_i_field_mono,
-                                   p_index,
-                                   lat_index,
-                                   lon_index,
-                                   scat_za_index,
-                                   scat_aa_index,
-                                   scat_za_grid,
-                                   scat_aa_grid,
-                                   cloudbox_limits,
-                                   doit_scat_field,
-                                   propmat_clearsky_agenda,
-                                   vmr_field,
-                                   ppath_step_agenda,
-                                   ppath_lmax,
-                                   ppath_lraytrace,
-                                   p_grid,
-                                   lat_grid,
-                                   lon_grid,
-                                   z_field,
-                                   refellipsoid,
-                                   t_field,
-                                   f_grid,
-                                   f_index,
-                                   ext_mat_field,
-                                   abs_vec_field,
-                                   doit_za_interp,
-                                   verbosity);
+      } else {
+        // The grid points of a level do not depend on each other (the
+        // upwind points are taken from the radiation field before the
+        // level is updated) and are updated in parallel.
+        Workspace l_ws(ws);
+        Agenda l_propmat_clearsky_agenda(propmat_clearsky_agenda);
+#pragma omp parallel if (!arts_omp_in_parallel() && N_cells > 1) \
+    firstprivate(l_ws, l_propmat_clearsky_agenda)
+        {
+          for (Index i_p = 0; i_p < p_indices.nelem(); i_p++) {
+            const Index p_index = p_indices[i_p] - p_low;
+            const Index i_step0 =
+                (i_dir * (p_up - p_low + 1) + p_index) * N_cells;
+
+#pragma omp for schedule(dynamic)
+            for (Index i_cell = 0; i_cell < N_cells; i_cell++) {
+              if (failed || !geometry->npoints(i_step0 + i_cell)) continue;
+              try {
+                cloud_ppath_update3D(
+                    l_ws,
+                    doit_i_field_level(i_cell / N_lon, i_cell % N_lon, joker),
+                    *geometry,
+                    i_step0 + i_cell,
+                    doit_i_field_mono,
+                    doit_scat_field,
+                    l_propmat_clearsky_agenda,
+                    f_grid,
+                    f_index,
+                    ext_mat_field,
+                    abs_vec_field,
+                    verbosity);
+              } catch (const std::exception& e) {
+                const String msg = update_error(
+                    p_index, i_cell, scat_za_index, scat_aa_index, e);
+#pragma omp critical(doit_i_fieldUpdateSeq3D_fail)
+                {
+                  failed = true;
+                  fail_msg = msg;
+                }
+              }
             }
-          }
-        }
-      }  // end if downlooking.
 
-      //
-      // Limb looking:
-      // We have to include a special case here, as we may miss the endpoints
-      // when the intersection point is at the same level as the actual point.
-      // To be save we loop over the full cloudbox. Inside the function
-      // cloud_ppath_update3D it is checked whether the intersection point is
-      // inside the cloudbox or not.
-      else if (scat_za_grid[scat_za_index] > 90. &&
-               scat_za_grid[scat_za_index] < theta_lim) {
-        for (Index p_index = p_low; p_index <= p_up; p_index++) {
-          // For this case the cloudbox goes down to the surface an we
-          // look downwards. These cases are outside the cloudbox and
-          // not needed. Switch is included here, as ppath_step_agenda
-          // gives an error for such cases.
-          if (!(p_index == 0 && scat_za_grid[scat_za_index] > 90.)) {
-            for (Index lat_index = lat_low; lat_index <= lat_up; lat_index++) {
-              for (Index lon_index = lon_low; lon_index <= lon_up;
-                   lon_index++) {
-                cloud_ppath_update3D(ws,
-                                     doit_i_field_mono,
-                                     p_index,
-                                     lat_index,
-                                     lon_index,
-                                     scat_za_index,
-                                     scat_aa_index,
-                                     scat_za_grid,
-                                     scat_aa_grid,
-                                     cloudbox_limits,
-                                     doit_scat_field,
-                                     propmat_clearsky_agenda,
-                                     vmr_field,
-                                     ppath_step_agenda,
-                                     ppath_lmax,
-                                     ppath_lraytrace,
-                                     p_grid,
-                                     lat_grid,
-                                     lon_grid,
-                                     z_field,
-                                     refellipsoid,
-                                     t_field,
-                                     f_grid,
-                                     f_index,
-                                     ext_mat_field,
-                                     abs_vec_field,
-                                     doit_za_interp,
-                                     verbosity);
-              }
+#pragma omp for schedule(static)
+            for (Index i_cell = 0; i_cell < N_cells; i_cell++) {
+              if (failed || !geometry->npoints(i_step0 + i_cell)) continue;
+              doit_i_field_mono(p_index,
+                                i_cell / N_lon,
+                                i_cell % N_lon,
+                                scat_za_index,
+                                scat_aa_index,
+                                joker) =
+                  doit_i_field_level(i_cell / N_lon, i_cell % N_lon, joker);
             }
           }
         }
+
+        if (failed) throw runtime_error(fail_msg);
       }
     }  //  Closes loop over aa_grid.
   }    // Closes loop over scat_za_grid.
@@ -1595,6 +1645,8 @@ void DoitInit(  //WS Output
     Tensor6& doit_scat_field,
     Tensor7& doit_i_field,
     Index& doit_is_initialized,
+    // The geometry cache is kept, as it checks its own validity
+    DoitGeometryCache&,
     // WS Input
     const Index& stokes_dim,
     const Index& atmosphere_dim,
@@ -331,12 +331,19 @@ void irradiance_fieldFromRadiance(Tensor4 &irradiance_field,
 void RadiationFieldSpectralIntegrate(Tensor4 &radiation_field,
                                      const Vector &f_grid,
                                      const Tensor5 &spectral_radiation_field,
+                                     const Vector &f_grid_weights,
                                      const Verbosity &) {
   if (f_grid.nelem() != spectral_radiation_field.nshelves()) {
     throw runtime_error(
         "The length of f_grid does not match with\n"
         " the first dimension of the spectral_radiation_field");
   }
+  if (f_grid_weights.nelem() &&
+      f_grid_weights.nelem() != spectral_radiation_field.nshelves()) {
+    throw runtime_error(
+        "The length of f_grid_weights does not match with\n"
+        " the first dimension of the spectral_radiation_field");
+  }
 
   //allocate
   radiation_field.resize(spectral_radiation_field.nbooks(),
@@ -345,6 +352,23 @@ void RadiationFieldSpectralIntegrate(Tensor4 &radiation_field,
                          spectral_radiation_field.ncols());
   radiation_field = 0;
 
+  // weighted sum, e.g. over the g-points of a k-distribution
+  if (f_grid_weights.nelem()) {
+    for (Index i = 0; i < spectral_radiation_field.nshelves(); i++) {
+      for (Index b = 0; b < radiation_field.nbooks(); b++) {
+        for (Index p = 0; p < radiation_field.npages(); p++) {
+          for (Index r = 0; r < radiation_field.nrows(); r++) {
+            for (Index c = 0; c < radiation_field.ncols(); c++) {
+              radiation_field(b, p, r, c) +=
+                  spectral_radiation_field(i, b, p, r, c) * f_grid_weights[i];
+            }
+          }
+        }
+      }
+    }
+    return;
+  }
+
   // frequency integration
   for (Index i = 0; i < spectral_radiation_field.nshelves() - 1; i++) {
     const Numeric df = f_grid[i + 1] - f_grid[i];
@@ -368,12 +392,19 @@ void RadiationFieldSpectralIntegrate(Tensor4 &radiation_field,
 void RadiationFieldSpectralIntegrate(Tensor5 &radiation_field,
                                      const Vector &f_grid,
                                      const Tensor7 &spectral_radiation_field,
+                                     const Vector &f_grid_weights,
                                      const Verbosity &) {
   if (f_grid.nelem() != spectral_radiation_field.nlibraries()) {
     throw runtime_error(
         "The length of f_grid does not match with\n"
         " the first dimension of the spectral_radiation_field");
   }
+  if (f_grid_weights.nelem() &&
+      f_grid_weights.nelem() != spectral_radiation_field.nlibraries()) {
+    throw runtime_error(
+        "The length of f_grid_weights does not match with\n"
+        " the first dimension of the spectral_radiation_field");
+  }
 
   //allocate
   radiation_field.resize(spectral_radiation_field.nvitrines(),
@@ -383,6 +414,26 @@ void RadiationFieldSpectralIntegrate(Tensor5 &radiation_field,
                          spectral_radiation_field.nrows());
   radiation_field = 0;
 
+  // weighted sum, e.g. over the g-points of a k-distribution
+  if (f_grid_weights.nelem()) {
+    for (Index i = 0; i < spectral_radiation_field.nlibraries(); i++) {
+      for (Index s = 0; s < radiation_field.nshelves(); s++) {
+        for (Index b = 0; b < radiation_field.nbooks(); b++) {
+          for (Index p = 0; p < radiation_field.npages(); p++) {
+            for (Index r = 0; r < radiation_field.nrows(); r++) {
+              for (Index c = 0; c < radiation_field.ncols(); c++) {
+                radiation_field(s, b, p, r, c) +=
+                    spectral_radiation_field(i, s, b, p, r, c, 0) *
+                    f_grid_weights[i];
+              }
+            }
+          }
+        }
+      }
+    }
+    return;
+  }
+
   // frequency integration
   for (Index i = 0; i < spectral_radiation_field.nlibraries() - 1; i++) {
     const Numeric df = f_grid[i + 1] - f_grid[i];
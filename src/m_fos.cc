@@ -1077,11 +1077,14 @@ void iyHybrid(Workspace& ws,
   // Get atmospheric and radiative variables along the propagation path
   //
   ppvar_trans_cumulat.resize(np, nf, ns, ns);
-  Tensor3 J(np, nf, ns);
-  Tensor4 trans_partial(np, nf, ns, ns);
-  Tensor5 dtrans_partial_dx_above(np, nq, nf, ns, ns);
-  Tensor5 dtrans_partial_dx_below(np, nq, nf, ns, ns);
-  Tensor4 dJ_dx(np, nq, nf, ns);
+  RteScratchGuard scratch_guard;
+  RteScratch& scratch = scratch_guard.get();
+  scratch.resize_tensors(np, nq, nf, ns);
+  Tensor3& J = scratch.J;
+  Tensor4& trans_partial = scratch.trans_partial;
+  Tensor5& dtrans_partial_dx_above = scratch.dtrans_partial_dx_above;
+  Tensor5& dtrans_partial_dx_below = scratch.dtrans_partial_dx_below;
+  Tensor4& dJ_dx = scratch.dJ_dx;
   ArrayOfIndex clear2cloudy;
   //
   if (np == 1 && rbi == 1)  // i.e. ppath is totally outside the atmosphere:
@@ -1641,18 +1644,18 @@ void iyHybrid2(Workspace& ws,
   ppvar_trans_cumulat.resize(np, nf, ns, ns);
   ppvar_iy.resize(nf, ns, np);
 
-  ArrayOfTransmissionMatrix lyr_tra(np, TransmissionMatrix(nf, ns));
-  ArrayOfRadiationVector lvl_rad(np, RadiationVector(nf, ns));
-  ArrayOfArrayOfRadiationVector dlvl_rad(
-      np, ArrayOfRadiationVector(nq, RadiationVector(nf, ns)));
-  ArrayOfRadiationVector src_rad(np, RadiationVector(nf, ns));
-  ArrayOfArrayOfRadiationVector dsrc_rad(
-      np, ArrayOfRadiationVector(nq, RadiationVector(nf, ns)));
+  RteScratchGuard scratch_guard;
+  RteScratch& scratch = scratch_guard.get();
+  scratch.resize(np, nq, nf, ns);
 
-  ArrayOfArrayOfTransmissionMatrix dlyr_tra_above(
-      np, ArrayOfTransmissionMatrix(nq, TransmissionMatrix(nf, ns)));
-  ArrayOfArrayOfTransmissionMatrix dlyr_tra_below(
-      np, ArrayOfTransmissionMatrix(nq, TransmissionMatrix(nf, ns)));
+  ArrayOfTransmissionMatrix& lyr_tra = scratch.lyr_tra;
+  ArrayOfRadiationVector& lvl_rad = scratch.lvl_rad;
+  ArrayOfArrayOfRadiationVector& dlvl_rad = scratch.dlvl_rad;
+  ArrayOfRadiationVector& src_rad = scratch.src_rad;
+  ArrayOfArrayOfRadiationVector& dsrc_rad = scratch.dsrc_rad;
+
+  ArrayOfArrayOfTransmissionMatrix& dlyr_tra_above = scratch.dlyr_tra_above;
+  ArrayOfArrayOfTransmissionMatrix& dlyr_tra_below = scratch.dlyr_tra_below;
 
   ArrayOfIndex clear2cloudy;
   //
@@ -1858,15 +1861,17 @@ void iyHybrid2(Workspace& ws,
     }
   }
 
-  const ArrayOfTransmissionMatrix tot_tra =
-      cumulative_transmission(lyr_tra, CumulativeTransmission::Forward);
+  ArrayOfTransmissionMatrix& tot_tra = scratch.tot_tra;
+  cumulative_transmission(tot_tra, lyr_tra, CumulativeTransmission::Forward);
 
   // iy_transmission
-  Tensor3 iy_trans_new;
+  Tensor3& iy_trans_new = scratch.iy_trans_new;
   if (iy_agenda_call1)
-    iy_trans_new = tot_tra[np - 1];
-  else
-    iy_transmission_mult(iy_trans_new, iy_transmission, tot_tra[np - 1]);
+    tot_tra[np - 1].to_tensor3(iy_trans_new);
+  else {
+    tot_tra[np - 1].to_tensor3(scratch.tot_tra_path);
+    iy_transmission_mult(iy_trans_new, iy_transmission, scratch.tot_tra_path);
+  }
 
   // Copy transmission to iy_aux
   for (Index i = 0; i < naux; i++)
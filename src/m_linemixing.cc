@@ -17,9 +17,12 @@
 
 #include <Eigen/Eigenvalues>
 #include "arts.h"
+#include "arts_omp.h"
 #include "auto_md.h"
+#include "check_input.h"
 #include "file.h"
 #include "global_data.h"
+#include "interpolation.h"
 #include "lin_alg.h"
 #include "linefunctions.h"
 #include "linemixing.h"
@@ -2765,21 +2768,14 @@ void PrintSelfLineMixingStatus(
   }
 }
 
-void relmatInAir(Matrix& relmat,
-                 const ArrayOfLineRecord& abs_lines,
-                 const ArrayOfArrayOfSpeciesTag& abs_species,
-                 const SpeciesAuxData& partition_functions,
-                 const Index& wigner_initialized,
-                 const Numeric& temperature,
-                 const Index& species,
-                 const Verbosity&) try {
+//! Checks a band and calculates its temperature independent couplings
+Tensor3 relmatInAirCouplings(const ArrayOfLineRecord& abs_lines,
+                             const ArrayOfArrayOfSpeciesTag& abs_species,
+                             const SpeciesAuxData& partition_functions,
+                             const Index& wigner_initialized,
+                             const Index& species) try {
   checkPartitionFunctions(abs_species, partition_functions);
 
-  // Only for Earth's atmosphere
-  const ArrayOfSpeciesTag collider_species = {SpeciesTag("O2-66"),
-                                              SpeciesTag("N2-44")};
-  const Vector collider_species_vmr = {0.21, 0.79};
-
   // Ensure the species are consistent
   const auto& st = abs_species[species][0];
 
@@ -2792,13 +2788,41 @@ void relmatInAir(Matrix& relmat,
     if (line.Species() not_eq st.Species() or
         line.Isotopologue() not_eq st.Isotopologue())
       throw "Must be same Isotopologue and Species in all lines.";
+
+  return relaxation_matrix_couplings(abs_lines, st, wigner_initialized);
+} catch (const char* e) {
+  std::ostringstream os;
+  os << "Errors raised by *relmatInAirCouplings*:\n";
+  os << "\tError: " << e << '\n';
+  throw std::runtime_error(os.str());
+} catch (const std::exception& e) {
+  std::ostringstream os;
+  os << "Errors in calls by *relmatInAirCouplings*:\n";
+  os << e.what();
+  throw std::runtime_error(os.str());
+}
+
+void relmatInAir(Matrix& relmat,
+                 const ArrayOfLineRecord& abs_lines,
+                 const ArrayOfArrayOfSpeciesTag& abs_species,
+                 const SpeciesAuxData& partition_functions,
+                 const Tensor3& couplings,
+                 const Numeric& temperature,
+                 const Index& species,
+                 const bool normalize = true) try {
+  // Only for Earth's atmosphere
+  const ArrayOfSpeciesTag collider_species = {SpeciesTag("O2-66"),
+                                              SpeciesTag("N2-44")};
+  const Vector collider_species_vmr = {0.21, 0.79};
+
   relmat = hartmann_ecs_interface(abs_lines,
                                   abs_species[species],
                                   collider_species,
                                   collider_species_vmr,
                                   partition_functions,
                                   temperature,
-                                  wigner_initialized);
+                                  couplings,
+                                  normalize);
 } catch (const char* e) {
   std::ostringstream os;
   os << "Errors raised by *relmatInAir*:\n";
@@ -2817,7 +2841,7 @@ void relmat_per_bandInAir(ArrayOfArrayOfMatrix& relmat_per_band,
                           const SpeciesAuxData& partition_functions,
                           const Index& wigner_initialized,
                           const Vector& temperatures,
-                          const Verbosity& verbosity) try {
+                          const Verbosity&) try {
   auto lsize = abs_lines_per_band.nelem();
   auto tsize = temperatures.nelem();
 
@@ -2831,16 +2855,37 @@ void relmat_per_bandInAir(ArrayOfArrayOfMatrix& relmat_per_band,
   for (auto& r : relmat_per_band) r.resize(tsize);
 
   for (auto j = 0; j < lsize; j++) {
+    const Tensor3 couplings = relmatInAirCouplings(abs_lines_per_band[j],
+                                                   abs_species_per_band,
+                                                   partition_functions,
+                                                   wigner_initialized,
+                                                   j);
+
+    bool failed = false;
+    String fail_msg;
+
+#pragma omp parallel for if (!arts_omp_in_parallel() && tsize > 1)
     for (auto i = 0; i < tsize; i++) {
-      relmatInAir(relmat_per_band[j][i],
-                  abs_lines_per_band[j],
-                  abs_species_per_band,
-                  partition_functions,
-                  wigner_initialized,
-                  temperatures[i],
-                  j,
-                  verbosity);
+      if (failed) continue;
+
+      try {
+        relmatInAir(relmat_per_band[j][i],
+                    abs_lines_per_band[j],
+                    abs_species_per_band,
+                    partition_functions,
+                    couplings,
+                    temperatures[i],
+                    j);
+      } catch (const std::exception& e) {
+#pragma omp critical(relmat_per_bandInAir_fail)
+        {
+          fail_msg = e.what();
+          failed = true;
+        }
+      }
     }
+
+    if (failed) throw std::runtime_error(fail_msg);
   }
 } catch (const char* e) {
   std::ostringstream os;
@@ -3062,101 +3107,199 @@ void abs_xsec_per_speciesAddLineMixedLinesInAir(  // WS Output:
     const SpeciesAuxData& partition_functions,
     const Index& wigner_initialized,
     const Index& minimum_line_count,
+    const Vector& temperatures,
     const Verbosity& verbosity) try {
   CREATE_OUT2;
 
   const auto nb = abs_lines_per_band.nelem();
   const auto nf = f_grid.nelem();
   const auto np = abs_t.nelem();
+  const auto nt = temperatures.nelem();
+
+  // Interpolation of the relaxation matrix in temperature. The elements
+  // of the matrix without populations follow power laws in temperature
+  // closely, so the interpolation is done in logarithms.
+  ArrayOfGridPos gp_t(0);
+  if (nt) {
+    if (nt < 2) throw "GIN temperatures must be empty or have at least two elements";
+    for (auto i = 1; i < nt; i++)
+      if (temperatures[i] <= temperatures[i - 1])
+        throw "Must have strictly increasing GIN temperatures";
+    chk_interpolation_grids(
+        "Relaxation matrix temperature interpolation", temperatures, abs_t);
+    Vector log_t(nt), log_abs_t(np);
+    transform(log_t, log, temperatures);
+    transform(log_abs_t, log, abs_t);
+    gp_t.resize(np);
+    gridpos(gp_t, log_t, log_abs_t);
+  }
 
-  ComplexVector F(nf);
   for (auto ib = 0; ib < nb; ib++) {
     const auto N = abs_lines_per_band[ib].nelem();
-    for (auto ip = 0; ip < np; ip++) {
-      out2 << "Computing band " << ib + 1 << "/" << nb << " on level " << ip + 1
-           << "/" << np << " with " << N << " lines\n";
-
-      const Index pos = find_first(abs_species, abs_species_per_band[ib]);
-      if (pos < 0) throw "Bad input, band species is not in absorption species";
-      const auto& species = abs_species_per_band[pos][0];
-      const auto& band = abs_lines_per_band[ib];
 
-      // nb. Make this agenda once more possibilities are available...
-      Eigen::MatrixXcd M(N, N);
-      if (minimum_line_count > N) {
-        Matrix W;
-        relmatInAir(W,
+    const Index pos = find_first(abs_species, abs_species_per_band[ib]);
+    if (pos < 0) throw "Bad input, band species is not in absorption species";
+    const auto& species = abs_species_per_band[pos][0];
+    const auto& band = abs_lines_per_band[ib];
+
+    // The Wigner symbols do not depend on the atmospheric state, so they
+    // are calculated once for all levels
+    const bool do_relmat = minimum_line_count > N;
+    Tensor3 couplings;
+    ArrayOfMatrix W_t(0);
+    if (do_relmat) {
+      out2 << "Computing couplings of band " << ib + 1 << "/" << nb
+           << " with " << N << " lines\n";
+      couplings = relmatInAirCouplings(abs_lines_per_band[ib],
+                                       abs_species_per_band,
+                                       partition_functions,
+                                       wigner_initialized,
+                                       ib);
+
+      W_t.resize(nt);
+      for (auto it = 0; it < nt; it++)
+        relmatInAir(W_t[it],
                     abs_lines_per_band[ib],
                     abs_species_per_band,
                     partition_functions,
-                    wigner_initialized,
-                    abs_t[ip],
+                    couplings,
+                    temperatures[it],
                     ib,
-                    verbosity);
-        for (auto i1 = 0; i1 < N; i1++) {
-          auto x = abs_lines_per_band[ib][i1].GetShapeParams(
-              abs_t[ip],
-              abs_p[ip],
-              Vector({0.21, 0.79, 0}),
-              ArrayOfArrayOfSpeciesTag(
-                  {ArrayOfSpeciesTag(1, SpeciesTag("O2")),
-                   ArrayOfSpeciesTag(1, SpeciesTag("N2")),
-                   ArrayOfSpeciesTag(1,
-                                     SpeciesTag(species.SpeciesNameMain()))}));
-          for (auto i2 = 0; i2 < N; i2++) {
-            if (i1 not_eq i2)
-              M(i1, i2) = +Complex(0, abs_p[ip]) * W(i1, i2);
-            else
-              M(i1, i2) =
-                  band[i1].F() + x.D0 + Complex(0, abs_p[ip]) * W(i1, i2);
-          }
-        }
-      } else {
-        M.setZero();
-        for (auto il = 0; il < N; il++) {
-          // "AIR"
-          auto x = abs_lines_per_band[ib][il].GetShapeParams(
-              abs_t[ip],
-              abs_p[ip],
-              Vector({0.21, 0.79, 0}),
-              ArrayOfArrayOfSpeciesTag(
-                  {ArrayOfSpeciesTag(1, SpeciesTag("O2")),
-                   ArrayOfSpeciesTag(1, SpeciesTag("N2")),
-                   ArrayOfSpeciesTag(1,
-                                     SpeciesTag(species.SpeciesNameMain()))}));
-          M(il, il) = Complex(0, x.G0);
-        }
-      }
+                    false);
+    }
 
-      const Vector population =
-          population_density_vector(band, partition_functions, abs_t[ip]);
-      const Vector dipole = dipole_vector(band, partition_functions);
-      const Eigen::ComplexEigenSolver<Eigen::MatrixXcd> decM(M, true);
-      const auto& D = decM.eigenvalues();
-      const ComplexVector B =
-          equivalent_linestrengths(population, dipole, decM);
+    bool failed = false;
+    String fail_msg;
 
-      F = 0;
-      for (Index il = 0; il < N; il++) {
-        const Numeric gammaD =
-            Linefunctions::DopplerConstant(abs_t[ip], species.SpeciesMass()) *
-            D[il].real();
-        for (auto iv = 0; iv < nf; iv++) {
-          const Complex z = (f_grid[iv] - conj(D[il])) / gammaD;
-          const Complex w = Faddeeva::w(z);
-          const Complex zm = (f_grid[iv] + D[il]) / gammaD;
-          const Complex wm = Faddeeva::w(zm);
+#pragma omp parallel for if (!arts_omp_in_parallel() && np > 1)
+    for (auto ip = 0; ip < np; ip++) {
+      if (failed) continue;
 
-          F[iv] +=
-              (Constant::inv_sqrt_pi / gammaD) * (w * conj(B[il]) + wm * B[il]);
+      try {
+        {
+          std::ostringstream os;
+          os << "Computing band " << ib + 1 << "/" << nb << " on level "
+             << ip + 1 << "/" << np << " with " << N << " lines\n";
+          out2 << os.str();
         }
-      }
 
-      for (Index iv = 0; iv < nf; iv++) {
-        abs_xsec_per_species[pos](iv, ip) +=
-            isotopologue_ratios.getIsotopologueRatio(species) * F[iv].real();
+        // nb. Make this agenda once more possibilities are available...
+        Eigen::MatrixXcd M(N, N);
+        if (do_relmat) {
+          Matrix W;
+          if (nt) {
+            Vector itw(2);
+            interpweights(itw, gp_t[ip]);
+            W = W_t[gp_t[ip].idx];
+            if (itw[1] not_eq 0) {
+              const Matrix& W1 = W_t[gp_t[ip].idx + 1];
+              for (auto i1 = 0; i1 < N; i1++) {
+                for (auto i2 = 0; i2 < N; i2++) {
+                  const Numeric w0 = W(i1, i2), w1 = W1(i1, i2);
+                  if (w0 * w1 > 0)
+                    W(i1, i2) = std::copysign(
+                        std::exp(itw[0] * std::log(std::abs(w0)) +
+                                 itw[1] * std::log(std::abs(w1))),
+                        w0);
+                  else
+                    W(i1, i2) = itw[0] * w0 + itw[1] * w1;
+                }
+              }
+            }
+            hartmann_ecs_normalize(W,
+                                   abs_lines_per_band[ib],
+                                   abs_species_per_band[ib],
+                                   partition_functions,
+                                   abs_t[ip]);
+          } else
+            relmatInAir(W,
+                        abs_lines_per_band[ib],
+                        abs_species_per_band,
+                        partition_functions,
+                        couplings,
+                        abs_t[ip],
+                        ib);
+          for (auto i1 = 0; i1 < N; i1++) {
+            auto x = abs_lines_per_band[ib][i1].GetShapeParams(
+                abs_t[ip],
+                abs_p[ip],
+                Vector({0.21, 0.79, 0}),
+                ArrayOfArrayOfSpeciesTag(
+                    {ArrayOfSpeciesTag(1, SpeciesTag("O2")),
+                     ArrayOfSpeciesTag(1, SpeciesTag("N2")),
+                     ArrayOfSpeciesTag(
+                         1, SpeciesTag(species.SpeciesNameMain()))}));
+            for (auto i2 = 0; i2 < N; i2++) {
+              if (i1 not_eq i2)
+                M(i1, i2) = +Complex(0, abs_p[ip]) * W(i1, i2);
+              else
+                M(i1, i2) =
+                    band[i1].F() + x.D0 + Complex(0, abs_p[ip]) * W(i1, i2);
+            }
+          }
+        } else {
+          M.setZero();
+          for (auto il = 0; il < N; il++) {
+            // "AIR"
+            auto x = abs_lines_per_band[ib][il].GetShapeParams(
+                abs_t[ip],
+                abs_p[ip],
+                Vector({0.21, 0.79, 0}),
+                ArrayOfArrayOfSpeciesTag(
+                    {ArrayOfSpeciesTag(1, SpeciesTag("O2")),
+                     ArrayOfSpeciesTag(1, SpeciesTag("N2")),
+                     ArrayOfSpeciesTag(
+                         1, SpeciesTag(species.SpeciesNameMain()))}));
+            M(il, il) = Complex(0, x.G0);
+          }
+        }
+
+        const Vector population =
+            population_density_vector(band, partition_functions, abs_t[ip]);
+        const Vector dipole = dipole_vector(band, partition_functions);
+        const Eigen::ComplexEigenSolver<Eigen::MatrixXcd> decM(M, true);
+        const auto& D = decM.eigenvalues();
+        const ComplexVector B =
+            equivalent_linestrengths(population, dipole, decM);
+
+        ComplexVector F(nf);
+        F = 0;
+        for (Index il = 0; il < N; il++) {
+          const Numeric gammaD =
+              Linefunctions::DopplerConstant(abs_t[ip], species.SpeciesMass()) *
+              D[il].real();
+          for (auto iv = 0; iv < nf; iv++) {
+            const Complex z = (f_grid[iv] - conj(D[il])) / gammaD;
+            const Complex w = Faddeeva::w(z);
+            const Complex zm = (f_grid[iv] + D[il]) / gammaD;
+            const Complex wm = Faddeeva::w(zm);
+
+            F[iv] += (Constant::inv_sqrt_pi / gammaD) *
+                     (w * conj(B[il]) + wm * B[il]);
+          }
+        }
+
+        // Each level is a separate column, no need for a critical section
+        for (Index iv = 0; iv < nf; iv++) {
+          abs_xsec_per_species[pos](iv, ip) +=
+              isotopologue_ratios.getIsotopologueRatio(species) * F[iv].real();
+        }
+      } catch (const char* e) {
+#pragma omp critical(abs_xsec_per_speciesAddLineMixedLinesInAir_fail)
+        {
+          fail_msg = e;
+          failed = true;
+        }
+      } catch (const std::exception& e) {
+#pragma omp critical(abs_xsec_per_speciesAddLineMixedLinesInAir_fail)
+        {
+          fail_msg = e.what();
+          failed = true;
+        }
       }
     }
+
+    if (failed) throw std::runtime_error(fail_msg);
   }
 } catch (const char* e) {
   std::ostringstream os;
@@ -40,9 +40,11 @@
 #include <cmath>
 #include <cstdlib>
 #include <stdexcept>
+#include <vector>
 
 #include "array.h"
 #include "arts.h"
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "cloudbox.h"
@@ -56,6 +58,7 @@
 #include "optproperties.h"
 #include "parameters.h"
 #include "physics_funcs.h"
+#include "pnd_field_cache.h"
 #include "psd.h"
 #include "rte.h"
 #include "sorting.h"
@@ -775,6 +778,11 @@ void pnd_fieldCalcFromParticleBulkProps(
     }
   }
 
+  // Copies of the workspace and agendas for the threads
+  const Index ncol = nlat * nlon;
+  Workspace l_ws(ws);
+  ArrayOfAgenda l_pnd_agenda_array(pnd_agenda_array);
+
   // Extract data from pnd-agenda array
   for (Index is = 0; is < nss; is++) {
     // Index range with respect to pnd_field
@@ -812,17 +820,28 @@ void pnd_fieldCalcFromParticleBulkProps(
       }
     }
 
-    // Loop lat/lon positions and call *pnd_agenda*
-    for (Index ilon = 0; ilon < nlon; ilon++) {
-      for (Index ilat = 0; ilat < nlat; ilat++) {
-        // Note that we don't need any calculations for end points
+    // Loop lat/lon positions and call *pnd_agenda*. The columns are
+    // independent and are distributed over the threads.
+    String fail_msg;
+    bool failed = false;
 
-        // Here we consider this for lat and lon
-        if ((nlat > 1 && (ilat == 0 || ilat == nlat - 1)) ||
-            (nlon > 1 && (ilon == 0 || ilon == nlon - 1))) {
-          continue;
-        }
+#pragma omp parallel for if (!arts_omp_in_parallel() && ncol > 1) \
+    firstprivate(l_ws, l_pnd_agenda_array)
+    for (Index icol = 0; icol < ncol; icol++) {
+      if (failed) continue;
+
+      const Index ilon = icol / nlat;
+      const Index ilat = icol % nlat;
+
+      // Note that we don't need any calculations for end points
+
+      // Here we consider this for lat and lon
+      if ((nlat > 1 && (ilat == 0 || ilat == nlat - 1)) ||
+          (nlon > 1 && (ilon == 0 || ilon == nlon - 1))) {
+        continue;
+      }
 
+      try {
         // Pressure handled here, by not including end points in loops
 
         Matrix pnd_agenda_input(np, nin);
@@ -848,7 +867,7 @@ void pnd_fieldCalcFromParticleBulkProps(
         Matrix pnd_data;
         Tensor3 dpnd_data_dx;
         //
-        pnd_agenda_arrayExecute(ws,
+        pnd_agenda_arrayExecute(l_ws,
                                 pnd_data,
                                 dpnd_data_dx,
                                 is,
@@ -856,7 +875,7 @@ void pnd_fieldCalcFromParticleBulkProps(
                                 pnd_agenda_input,
                                 pnd_agenda_array_input_names[is],
                                 dpnd_data_dx_names,
-                                pnd_agenda_array);
+                                l_pnd_agenda_array);
 
         // Copy to output variables
         for (Index ip = 0; ip < np; ip++) {
@@ -868,11 +887,150 @@ void pnd_fieldCalcFromParticleBulkProps(
                 dpnd_data_dx(ix, ip, joker);
           }
         }
+      } catch (const std::exception& e) {
+        ostringstream os;
+        os << "Error for scattering species " << is << " at latitude index "
+           << ilat_offset + ilat << " and longitude index "
+           << ilon_offset + ilon << ":\n"
+           << e.what();
+#pragma omp critical(pnd_fieldCalcFromParticleBulkProps_fail)
+        {
+          failed = true;
+          fail_msg = os.str();
+        }
+        continue;
       }
     }
+
+    if (failed) throw runtime_error(fail_msg);
   }
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void pnd_fieldCalcFromParticleBulkPropsCached(
+    Workspace& ws,
+    Tensor4& pnd_field,
+    ArrayOfTensor4& dpnd_field_dx,
+    PndFieldCache& pnd_field_cache,
+    const Index& atmosphere_dim,
+    const Vector& p_grid,
+    const Vector& lat_grid,
+    const Vector& lon_grid,
+    const Tensor3& t_field,
+    const Index& cloudbox_on,
+    const ArrayOfIndex& cloudbox_limits,
+    const ArrayOfString& scat_species,
+    const ArrayOfArrayOfSingleScatteringData& scat_data,
+    const ArrayOfArrayOfScatteringMetaData& scat_meta,
+    const Tensor4& particle_bulkprop_field,
+    const ArrayOfString& particle_bulkprop_names,
+    const ArrayOfAgenda& pnd_agenda_array,
+    const ArrayOfArrayOfString& pnd_agenda_array_input_names,
+    const Index& jacobian_do,
+    const ArrayOfRetrievalQuantity& jacobian_quantities,
+    const Verbosity& verbosity) {
+  CREATE_OUT3;
+
+  // Do nothing if cloudbox is inactive
+  if (!cloudbox_on) {
+    return;
+  }
+
+  // Key describing the state
+  //
+  std::vector<Numeric> k;
+  k.push_back((Numeric)atmosphere_dim);
+  k.push_back((Numeric)jacobian_do);
+  k.push_back((Numeric)p_grid.nelem());
+  k.push_back((Numeric)lat_grid.nelem());
+  k.push_back((Numeric)lon_grid.nelem());
+  key_append(k, p_grid);
+  key_append(k, lat_grid);
+  key_append(k, lon_grid);
+  for (Index i = 0; i < cloudbox_limits.nelem(); i++)
+    k.push_back((Numeric)cloudbox_limits[i]);
+  for (Index i = 0; i < scat_data.nelem(); i++)
+    k.push_back((Numeric)scat_data[i].nelem());
+  for (Index i = 0; i < scat_meta.nelem(); i++) {
+    k.push_back((Numeric)scat_meta[i].nelem());
+    for (Index j = 0; j < scat_meta[i].nelem(); j++) {
+      k.push_back(scat_meta[i][j].mass);
+      k.push_back(scat_meta[i][j].diameter_max);
+      k.push_back(scat_meta[i][j].diameter_volume_equ);
+      k.push_back(scat_meta[i][j].diameter_area_equ_aerodynamical);
+    }
+  }
+  k.push_back((Numeric)t_field.npages());
+  k.push_back((Numeric)t_field.nrows());
+  k.push_back((Numeric)t_field.ncols());
+  key_append(k, t_field);
+  k.push_back((Numeric)particle_bulkprop_field.nbooks());
+  k.push_back((Numeric)particle_bulkprop_field.npages());
+  k.push_back((Numeric)particle_bulkprop_field.nrows());
+  k.push_back((Numeric)particle_bulkprop_field.ncols());
+  key_append(k, particle_bulkprop_field);
+  const Vector key(k);
+  //
+  // Names and agendas are compared as text
+  ostringstream names;
+  for (Index i = 0; i < scat_species.nelem(); i++)
+    names << "scat_species " << scat_species[i] << "\n";
+  for (Index i = 0; i < scat_meta.nelem(); i++)
+    for (Index j = 0; j < scat_meta[i].nelem(); j++)
+      names << "scat_meta " << scat_meta[i][j].description << "\n"
+            << scat_meta[i][j].source << "\n"
+            << scat_meta[i][j].refr_index << "\n";
+  for (Index i = 0; i < particle_bulkprop_names.nelem(); i++)
+    names << "particle_bulkprop_names " << particle_bulkprop_names[i] << "\n";
+  for (Index i = 0; i < pnd_agenda_array.nelem(); i++)
+    names << "pnd_agenda_array " << pnd_agenda_array[i].name() << "\n"
+          << pnd_agenda_array[i];
+  for (Index i = 0; i < pnd_agenda_array_input_names.nelem(); i++)
+    for (Index j = 0; j < pnd_agenda_array_input_names[i].nelem(); j++)
+      names << "pnd_agenda_array_input_names " << i << " "
+            << pnd_agenda_array_input_names[i][j] << "\n";
+  for (Index i = 0; i < jacobian_quantities.nelem(); i++)
+    names << "jacobian_quantities " << jacobian_quantities[i].MainTag() << " "
+          << jacobian_quantities[i].Subtag() << " "
+          << jacobian_quantities[i].SubSubtag() << "\n";
+
+  // Reuse stored fields if the key matches
+  const std::shared_ptr<const PndFieldData> cached =
+      pnd_field_cache.find(key, names.str());
+  if (cached) {
+    pnd_field = cached->pnd_field;
+    dpnd_field_dx = cached->dpnd_field_dx;
+    out3 << "  Reusing *pnd_field* and *dpnd_field_dx* of an earlier call.\n";
+    return;
+  }
+
+  pnd_fieldCalcFromParticleBulkProps(ws,
+                                     pnd_field,
+                                     dpnd_field_dx,
+                                     atmosphere_dim,
+                                     p_grid,
+                                     lat_grid,
+                                     lon_grid,
+                                     t_field,
+                                     cloudbox_on,
+                                     cloudbox_limits,
+                                     scat_species,
+                                     scat_data,
+                                     scat_meta,
+                                     particle_bulkprop_field,
+                                     particle_bulkprop_names,
+                                     pnd_agenda_array,
+                                     pnd_agenda_array_input_names,
+                                     jacobian_do,
+                                     jacobian_quantities,
+                                     verbosity);
+
+  std::shared_ptr<PndFieldData> calculated = std::make_shared<PndFieldData>();
+  calculated->pnd_field = pnd_field;
+  calculated->dpnd_field_dx = dpnd_field_dx;
+  pnd_field_cache.store(key, names.str(), calculated);
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void dNdD_F07(  //WS Output:
     Vector& dNdD,
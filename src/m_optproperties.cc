@@ -51,6 +51,7 @@
 #include "messages.h"
 #include "montecarlo.h"
 #include "optproperties.h"
+#include "scat_database.h"
 #include "sorting.h"
 #include "xml_io.h"
 
@@ -2258,6 +2259,182 @@ void scat_data_monoExtract(ArrayOfArrayOfSingleScatteringData& scat_data_mono,
   }
 }
 
+//! Check that the database can be interpolated to f_grid.
+/*!
+  The same checks as in *scat_dataCalc*.
+
+  \param scat_database  The scattering database.
+  \param f_grid         The frequencies.
+  \param interp_order   Interpolation order.
+*/
+static void chk_scat_database_f_grid(const ScatteringDatabase& scat_database,
+                                     ConstVectorView f_grid,
+                                     const Index& interp_order) {
+  if (!scat_database.is_open())
+    throw runtime_error(
+        "*scat_database* is not open. Use *scat_databaseOpen*.");
+
+  const String which_interpolation = "scat_database.f_grid to f_grid";
+  for (Index i_ss = 0; i_ss < scat_database.nspecies(); i_ss++) {
+    for (Index i_se = 0; i_se < scat_database.nelements(i_ss); i_se++) {
+      const Vector& f_grid_se = scat_database.f_grid(i_ss, i_se);
+      if (f_grid_se.nelem() == 1 && f_grid.nelem() == 1)
+        if (!is_same_within_epsilon(f_grid_se[0], f_grid[0], 2 * DBL_EPSILON)) {
+          ostringstream os;
+          os << "There is a problem with the grids for the following "
+             << "interpolation:\n"
+             << which_interpolation << "\n"
+             << "If original grid has only 1 element, the new grid must also have\n"
+             << "only a single element and hold the same value as the original grid.";
+          throw runtime_error(os.str());
+        }
+
+      chk_interpolation_grids(
+          which_interpolation, f_grid_se, f_grid, interp_order);
+    }
+  }
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void ScatteringDatabaseWrite(
+    const ArrayOfArrayOfSingleScatteringData& scat_data_raw,
+    const String& filename,
+    const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  ArrayOfIndex n_elements(scat_data_raw.nelem());
+  for (Index i_ss = 0; i_ss < scat_data_raw.nelem(); i_ss++)
+    n_elements[i_ss] = scat_data_raw[i_ss].nelem();
+
+  out2 << "  Writing scattering database " << filename << "\n";
+  ScatteringDatabase::write(
+      filename,
+      n_elements,
+      [&](Index i_ss, Index i_se) -> const SingleScatteringData& {
+        return scat_data_raw[i_ss][i_se];
+      });
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void ScatteringDatabaseWriteFromFiles(
+    const String& filename,
+    const ArrayOfArrayOfString& scat_data_files,
+    const Verbosity& verbosity) {
+  CREATE_OUT2;
+  CREATE_OUT3;
+
+  ArrayOfIndex n_elements(scat_data_files.nelem());
+  for (Index i_ss = 0; i_ss < scat_data_files.nelem(); i_ss++)
+    n_elements[i_ss] = scat_data_files[i_ss].nelem();
+
+  // Only one scattering element is kept in memory at a time
+  SingleScatteringData ssd;
+
+  out2 << "  Writing scattering database " << filename << "\n";
+  ScatteringDatabase::write(
+      filename,
+      n_elements,
+      [&](Index i_ss, Index i_se) -> const SingleScatteringData& {
+        out3 << "  Read single scattering data file "
+             << scat_data_files[i_ss][i_se] << "\n";
+        xml_read_from_file(scat_data_files[i_ss][i_se], ssd, verbosity);
+        return ssd;
+      });
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void scat_databaseOpen(ScatteringDatabase& scat_database,
+                       const String& filename,
+                       const Numeric& cache_size,
+                       const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  if (cache_size < 0)
+    throw runtime_error("*cache_size* must not be negative.");
+
+  out2 << "  Opening scattering database " << filename << "\n";
+  scat_database.open(filename, Index(cache_size));
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void scat_dataFromDatabase(ArrayOfArrayOfSingleScatteringData& scat_data,
+                           const ScatteringDatabase& scat_database,
+                           const Vector& f_grid,
+                           const Index& interp_order,
+                           const Verbosity&) {
+  chk_scat_database_f_grid(scat_database, f_grid, interp_order);
+
+  // The database shares its cache between copies
+  ScatteringDatabase db(scat_database);
+
+  const Index nf = f_grid.nelem();
+  scat_data.resize(db.nspecies());
+  for (Index i_ss = 0; i_ss < db.nspecies(); i_ss++) {
+    scat_data[i_ss].resize(db.nelements(i_ss));
+    for (Index i_se = 0; i_se < db.nelements(i_ss); i_se++) {
+      SingleScatteringData& ssd = scat_data[i_ss][i_se];
+      for (Index i_f = 0; i_f < nf; i_f++) {
+        const std::shared_ptr<const SingleScatteringData> slice =
+            db.slice(i_ss, i_se, f_grid[i_f], interp_order);
+        const SingleScatteringData& s = *slice;
+
+        if (i_f == 0) {
+          ssd.ptype = s.ptype;
+          ssd.description = s.description;
+          ssd.f_grid = f_grid;
+          ssd.T_grid = s.T_grid;
+          ssd.za_grid = s.za_grid;
+          ssd.aa_grid = s.aa_grid;
+          ssd.pha_mat_data.resize(nf,
+                                  s.pha_mat_data.nvitrines(),
+                                  s.pha_mat_data.nshelves(),
+                                  s.pha_mat_data.nbooks(),
+                                  s.pha_mat_data.npages(),
+                                  s.pha_mat_data.nrows(),
+                                  s.pha_mat_data.ncols());
+          ssd.ext_mat_data.resize(nf,
+                                  s.ext_mat_data.nbooks(),
+                                  s.ext_mat_data.npages(),
+                                  s.ext_mat_data.nrows(),
+                                  s.ext_mat_data.ncols());
+          ssd.abs_vec_data.resize(nf,
+                                  s.abs_vec_data.nbooks(),
+                                  s.abs_vec_data.npages(),
+                                  s.abs_vec_data.nrows(),
+                                  s.abs_vec_data.ncols());
+        }
+
+        ssd.pha_mat_data(i_f, joker, joker, joker, joker, joker, joker) =
+            s.pha_mat_data(0, joker, joker, joker, joker, joker, joker);
+        ssd.ext_mat_data(i_f, joker, joker, joker, joker) =
+            s.ext_mat_data(0, joker, joker, joker, joker);
+        ssd.abs_vec_data(i_f, joker, joker, joker, joker) =
+            s.abs_vec_data(0, joker, joker, joker, joker);
+      }
+    }
+  }
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void scat_data_monoFromDatabase(
+    ArrayOfArrayOfSingleScatteringData& scat_data_mono,
+    const ScatteringDatabase& scat_database,
+    const Vector& f_grid,
+    const Index& f_index,
+    const Verbosity&) {
+  chk_scat_database_f_grid(scat_database, f_grid[Range(f_index, 1)], 1);
+
+  // The database shares its cache between copies
+  ScatteringDatabase db(scat_database);
+
+  scat_data_mono.resize(db.nspecies());
+  for (Index i_ss = 0; i_ss < db.nspecies(); i_ss++) {
+    scat_data_mono[i_ss].resize(db.nelements(i_ss));
+    for (Index i_se = 0; i_se < db.nelements(i_ss); i_se++)
+      scat_data_mono[i_ss][i_se] = *db.slice(i_ss, i_se, f_grid[f_index], 1);
+  }
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void opt_prop_sptFromMonoData(  // Output and Input:
     ArrayOfPropagationMatrix& ext_mat_spt,
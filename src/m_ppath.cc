@@ -1195,6 +1195,8 @@ void ppath_stepGeometric(  // WS Output:
     const Vector& refellipsoid,
     const Matrix& z_surface,
     const Numeric& ppath_lmax,
+    // WS Generic Input:
+    const Index& analytic,
     const Verbosity&) {
   // Input checks here would be rather costly as this function is called
   // many times. So we perform asserts in the sub-functions, but no checks
@@ -1227,7 +1229,8 @@ void ppath_stepGeometric(  // WS Output:
                          z_field,
                          refellipsoid,
                          z_surface,
-                         ppath_lmax);
+                         ppath_lmax,
+                         analytic);
     }
 
     else {
@@ -337,6 +337,13 @@ void psdMgd(Matrix& psd_data,
     }
   }
 
+  // The size dependent part of the MGD is the same for all levels
+  Vector log_size_grid(nsi);
+  for (Index i = 0; i < nsi; i++) {
+    log_size_grid[i] = log(psd_size_grid[i]);
+  }
+  Matrix jac_data(4, nsi);
+
   // Loop input data and calculate PSDs
   for (Index ip = 0; ip < np; ip++) {
     // Extract MGD parameters
@@ -372,11 +379,10 @@ void psdMgd(Matrix& psd_data,
       throw runtime_error("Bad MGD parameter detected: ga <= 0");
 
     // Calculate PSD and derivatives
-    Matrix jac_data(4, nsi);
-    //
     mgd_with_derivatives(psd_data(ip, joker),
                          jac_data,
                          psd_size_grid,
+                         log_size_grid,
                          mgd_pars[0],
                          mgd_pars[1],
                          mgd_pars[2],
@@ -511,6 +517,13 @@ void psdMgdMass(Matrix& psd_data,
     }
   }
 
+  // The size dependent part of the MGD is the same for all levels
+  Vector log_size_grid(nsi);
+  for (Index i = 0; i < nsi; i++) {
+    log_size_grid[i] = log(psd_size_grid[i]);
+  }
+  Matrix jac_data(4, nsi);
+
   // Loop input data and calculate PSDs
   for (Index ip = 0; ip < np; ip++) {
     // Extract mass
@@ -575,10 +588,10 @@ void psdMgdMass(Matrix& psd_data,
       throw runtime_error("Bad MGD parameter detected: ga <= 0");
 
     // Calculate PSS
-    Matrix jac_data(4, nsi);
     mgd_with_derivatives(psd_data(ip, joker),
                          jac_data,
                          psd_size_grid,
+                         log_size_grid,
                          mgd_pars[0],
                          mgd_pars[1],
                          mgd_pars[2],
@@ -733,6 +746,13 @@ void psd_mgd_mass_and_something(Matrix& psd_data,
     }
   }
 
+  // The size dependent part of the MGD is the same for all levels
+  Vector log_size_grid(nsi);
+  for (Index i = 0; i < nsi; i++) {
+    log_size_grid[i] = log(psd_size_grid[i]);
+  }
+  Matrix jac_data(4, nsi);
+
   // Loop input data and calculate PSDs
   for (Index ip = 0; ip < np; ip++) {
     // Extract mass
@@ -868,10 +888,10 @@ void psd_mgd_mass_and_something(Matrix& psd_data,
       throw runtime_error("Bad MGD parameter detected: ga <= 0");
 
     // Calculate PSD and derivatives
-    Matrix jac_data(4, nsi);
     mgd_with_derivatives(psd_data(ip, joker),
                          jac_data,
                          psd_size_grid,
+                         log_size_grid,
                          mgd_pars[0],
                          mgd_pars[1],
                          mgd_pars[2],
@@ -38,11 +38,13 @@
 
 #include <cmath>
 #include <stdexcept>
+#include <vector>
 #include "arts.h"
 #include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "geodetic.h"
+#include "iyb_cache.h"
 #include "jacobian.h"
 #include "logic.h"
 #include "math_funcs.h"
@@ -57,9 +59,14 @@
 extern const Numeric PI;
 extern const Numeric SPEED_OF_LIGHT;
 extern const String ABSSPECIES_MAINTAG;
+extern const String FREQUENCY_MAINTAG;
+extern const String POINTING_MAINTAG;
+extern const String POLYFIT_MAINTAG;
+extern const String SINEFIT_MAINTAG;
 extern const String SURFACE_MAINTAG;
 extern const String SCATSPECIES_MAINTAG;
 extern const String TEMPERATURE_MAINTAG;
+extern const String PROPMAT_SUBSUBTAG;
 extern const String WIND_MAINTAG;
 extern const Index GFIELD4_FIELD_NAMES;
 extern const Index GFIELD4_P_GRID;
@@ -312,19 +319,19 @@ void iyEmissionStandard(Workspace& ws,
   ppvar_trans_partial.resize(np, nf, ns, ns);
   ppvar_iy.resize(nf, ns, np);
 
-  ArrayOfRadiationVector lvl_rad(np, RadiationVector(nf, ns));
-  ArrayOfArrayOfRadiationVector dlvl_rad(
-      np, ArrayOfRadiationVector(nq, RadiationVector(nf, ns)));
+  RteScratchGuard scratch_guard;
+  RteScratch& scratch = scratch_guard.get();
+  scratch.resize(np, nq, nf, ns);
 
-  ArrayOfRadiationVector src_rad(np, RadiationVector(nf, ns));
-  ArrayOfArrayOfRadiationVector dsrc_rad(
-      np, ArrayOfRadiationVector(nq, RadiationVector(nf, ns)));
+  ArrayOfRadiationVector& lvl_rad = scratch.lvl_rad;
+  ArrayOfArrayOfRadiationVector& dlvl_rad = scratch.dlvl_rad;
 
-  ArrayOfTransmissionMatrix lyr_tra(np, TransmissionMatrix(nf, ns));
-  ArrayOfArrayOfTransmissionMatrix dlyr_tra_above(
-      np, ArrayOfTransmissionMatrix(nq, TransmissionMatrix(nf, ns)));
-  ArrayOfArrayOfTransmissionMatrix dlyr_tra_below(
-      np, ArrayOfTransmissionMatrix(nq, TransmissionMatrix(nf, ns)));
+  ArrayOfRadiationVector& src_rad = scratch.src_rad;
+  ArrayOfArrayOfRadiationVector& dsrc_rad = scratch.dsrc_rad;
+
+  ArrayOfTransmissionMatrix& lyr_tra = scratch.lyr_tra;
+  ArrayOfArrayOfTransmissionMatrix& dlyr_tra_above = scratch.dlyr_tra_above;
+  ArrayOfArrayOfTransmissionMatrix& dlyr_tra_below = scratch.dlyr_tra_below;
 
   if (np == 1 && rbi == 1) {  // i.e. ppath is totally outside the atmosphere:
     ppvar_p.resize(0);
@@ -470,15 +477,17 @@ void iyEmissionStandard(Workspace& ws,
     }
   }
 
-  const ArrayOfTransmissionMatrix tot_tra =
-      cumulative_transmission(lyr_tra, CumulativeTransmission::Forward);
+  ArrayOfTransmissionMatrix& tot_tra = scratch.tot_tra;
+  cumulative_transmission(tot_tra, lyr_tra, CumulativeTransmission::Forward);
 
   // iy_transmission
-  Tensor3 iy_trans_new;
+  Tensor3& iy_trans_new = scratch.iy_trans_new;
   if (iy_agenda_call1)
-    iy_trans_new = tot_tra[np - 1];
-  else
-    iy_transmission_mult(iy_trans_new, iy_transmission, tot_tra[np - 1]);
+    tot_tra[np - 1].to_tensor3(iy_trans_new);
+  else {
+    tot_tra[np - 1].to_tensor3(scratch.tot_tra_path);
+    iy_transmission_mult(iy_trans_new, iy_transmission, scratch.tot_tra_path);
+  }
 
   // iy_aux: Optical depth
   if (auxOptDepth >= 0)
@@ -577,8 +586,122 @@ void iyEmissionStandard(Workspace& ws,
   }
 }
 
-/* Workspace method: Doxygen documentation will be auto-generated */
-void iyEmissionStandardParallel(
+//! Propagation matrices along the path from propmat_clearsky_agenda
+/*!
+  Used by iyEmissionStandardParallel. Each thread gets its own copy, and
+  then its own workspace and agenda.
+*/
+class PropmatFromAgenda {
+ public:
+  PropmatFromAgenda(Workspace& ws, const Agenda& propmat_clearsky_agenda)
+      : mws(ws), magenda(propmat_clearsky_agenda) {}
+
+  void operator()(PropagationMatrix& K,
+                  StokesVector& S,
+                  Index& lte,
+                  ArrayOfPropagationMatrix& dK_dx,
+                  ArrayOfStokesVector& dS_dx,
+                  const Index ip,
+                  const Ppath& ppath,
+                  ConstMatrixView ppvar_f,
+                  ConstMatrixView ppvar_mag,
+                  ConstMatrixView ppvar_nlte,
+                  ConstMatrixView ppvar_vmr,
+                  ConstVectorView ppvar_t,
+                  ConstVectorView ppvar_p,
+                  const ArrayOfRetrievalQuantity& jacobian_quantities,
+                  const ArrayOfIndex& jac_species_i,
+                  const bool j_analytical_do) {
+    get_stepwise_clearsky_propmat(mws,
+                                  K,
+                                  S,
+                                  lte,
+                                  dK_dx,
+                                  dS_dx,
+                                  magenda,
+                                  jacobian_quantities,
+                                  ppvar_f(joker, ip),
+                                  ppvar_mag(joker, ip),
+                                  ppath.los(ip, joker),
+                                  ppvar_nlte(joker, ip),
+                                  ppvar_vmr(joker, ip),
+                                  ppvar_t[ip],
+                                  ppvar_p[ip],
+                                  jac_species_i,
+                                  j_analytical_do);
+  }
+
+ private:
+  Workspace mws;
+  Agenda magenda;
+};
+
+//! Propagation matrices along the path from propmat_clearsky_field
+/*!
+  Used by iyEmissionStandardFromPropmatField. The interpolation buffers
+  are kept between the points handled by a thread.
+*/
+class PropmatFromField {
+ public:
+  PropmatFromField(const Tensor7& propmat_clearsky_field,
+                   const Tensor6& nlte_source_field,
+                   const Index atmosphere_dim)
+      : mpropmat_clearsky_field(propmat_clearsky_field),
+        mnlte_source_field(nlte_source_field),
+        matmosphere_dim(atmosphere_dim) {}
+
+  void operator()(PropagationMatrix& K,
+                  StokesVector& S,
+                  Index& lte,
+                  ArrayOfPropagationMatrix& dK_dx,
+                  ArrayOfStokesVector& dS_dx,
+                  const Index ip,
+                  const Ppath& ppath,
+                  ConstMatrixView,
+                  ConstMatrixView,
+                  ConstMatrixView,
+                  ConstMatrixView,
+                  ConstVectorView,
+                  ConstVectorView,
+                  const ArrayOfRetrievalQuantity& jacobian_quantities,
+                  const ArrayOfIndex& jac_species_i,
+                  const bool j_analytical_do) {
+    get_stepwise_clearsky_propmat_from_field(
+        K,
+        S,
+        lte,
+        dK_dx,
+        dS_dx,
+        mKbuf,
+        mSbuf,
+        mpropmat_clearsky_field,
+        mnlte_source_field,
+        ppath.gp_p[ip],
+        matmosphere_dim > 1 ? ppath.gp_lat[ip] : ppath.gp_p[ip],
+        matmosphere_dim > 2 ? ppath.gp_lon[ip] : ppath.gp_p[ip],
+        matmosphere_dim,
+        jacobian_quantities,
+        jac_species_i,
+        j_analytical_do);
+  }
+
+ private:
+  const Tensor7& mpropmat_clearsky_field;
+  const Tensor6& mnlte_source_field;
+  Index matmosphere_dim;
+  Matrix mKbuf;
+  Vector mSbuf;
+};
+
+//! Emission radiative transfer along a propagation path
+/*!
+  The common part of iyEmissionStandardParallel and
+  iyEmissionStandardFromPropmatField. The arguments are as for these
+  methods, but the propagation matrices are taken from propmat, see
+  PropmatFromAgenda and PropmatFromField.
+*/
+template <class Propmat>
+static void iy_emission_standard_parallel(
     Workspace& ws,
     Matrix& iy,
     ArrayOfMatrix& iy_aux,
@@ -616,7 +739,6 @@ void iyEmissionStandardParallel(
     const ArrayOfRetrievalQuantity& jacobian_quantities,
     const Ppath& ppath,
     const Vector& rte_pos2,
-    const Agenda& propmat_clearsky_agenda,
     const Agenda& water_p_eq_agenda,
     const Agenda& iy_main_agenda,
     const Agenda& iy_space_agenda,
@@ -626,6 +748,7 @@ void iyEmissionStandardParallel(
     const Tensor3& iy_transmission,
     const Numeric& rte_alonglos_v,
     const Tensor3& surface_props_data,
+    Propmat propmat,
     const Verbosity& verbosity) {
   // Some basic sizes
   const Index nf = f_grid.nelem();
@@ -709,19 +832,19 @@ void iyEmissionStandardParallel(
   ppvar_trans_partial.resize(np, nf, ns, ns);
   ppvar_iy.resize(nf, ns, np);
 
-  ArrayOfRadiationVector lvl_rad(np, RadiationVector(nf, ns));
-  ArrayOfArrayOfRadiationVector dlvl_rad(
-      np, ArrayOfRadiationVector(nq, RadiationVector(nf, ns)));
+  RteScratchGuard scratch_guard;
+  RteScratch& scratch = scratch_guard.get();
+  scratch.resize(np, nq, nf, ns);
+
+  ArrayOfRadiationVector& lvl_rad = scratch.lvl_rad;
+  ArrayOfArrayOfRadiationVector& dlvl_rad = scratch.dlvl_rad;
 
-  ArrayOfRadiationVector src_rad(np, RadiationVector(nf, ns));
-  ArrayOfArrayOfRadiationVector dsrc_rad(
-      np, ArrayOfRadiationVector(nq, RadiationVector(nf, ns)));
+  ArrayOfRadiationVector& src_rad = scratch.src_rad;
+  ArrayOfArrayOfRadiationVector& dsrc_rad = scratch.dsrc_rad;
 
-  ArrayOfTransmissionMatrix lyr_tra(np, TransmissionMatrix(nf, ns));
-  ArrayOfArrayOfTransmissionMatrix dlyr_tra_above(
-      np, ArrayOfTransmissionMatrix(nq, TransmissionMatrix(nf, ns)));
-  ArrayOfArrayOfTransmissionMatrix dlyr_tra_below(
-      np, ArrayOfTransmissionMatrix(nq, TransmissionMatrix(nf, ns)));
+  ArrayOfTransmissionMatrix& lyr_tra = scratch.lyr_tra;
+  ArrayOfArrayOfTransmissionMatrix& dlyr_tra_above = scratch.dlyr_tra_above;
+  ArrayOfArrayOfTransmissionMatrix& dlyr_tra_below = scratch.dlyr_tra_below;
 
   if (np == 1 && rbi == 1) {  // i.e. ppath is totally outside the atmosphere:
     ppvar_p.resize(0);
@@ -759,16 +882,15 @@ void iyEmissionStandardParallel(
     // Size radiative variables always used
     Vector B(nf);
     StokesVector a(nf, ns), S(nf, ns), Sp(nf, ns);
-    ArrayOfIndex lte(np);
 
-    ArrayOfPropagationMatrix K(np);
-    for (Index ip = 0; ip < np; ip++) {
-      K[ip] = PropagationMatrix(nf, ns);
-    }
+    // Propagation matrices of all path points
+    scratch.resize_propmat(np, nq, nf, ns);
+    ArrayOfIndex& lte = scratch.lte;
+    ArrayOfPropagationMatrix& K = scratch.K;
+    ArrayOfArrayOfPropagationMatrix& dK_dx = scratch.dK_dx;
 
     // Init variables only used if analytical jacobians done
     Vector dB_dT(0);
-    ArrayOfArrayOfPropagationMatrix dK_dx(np);
     ArrayOfStokesVector da_dx(nq), dS_dx(nq);
 
     // HSE variables
@@ -777,10 +899,6 @@ void iyEmissionStandardParallel(
 
     if (j_analytical_do) {
       dB_dT.resize(nf);
-      for (Index ip = 0; ip < np; ip++) {
-        dK_dx[ip].resize(nq);
-        FOR_ANALYTICAL_JACOBIANS_DO(dK_dx[ip][iq] = PropagationMatrix(nf, ns);)
-      }
       FOR_ANALYTICAL_JACOBIANS_DO(
           da_dx[iq] = StokesVector(nf, ns); dS_dx[iq] = StokesVector(nf, ns);
           if (jacobian_quantities[iq].IsTemperature()) {
@@ -791,32 +909,29 @@ void iyEmissionStandardParallel(
     const bool temperature_jacobian =
         j_analytical_do and do_temperature_jacobian(jacobian_quantities);
 
-    Agenda l_propmat_clearsky_agenda(propmat_clearsky_agenda);
-    Workspace l_ws(ws);
     // Loop ppath points and determine radiative properties
 #pragma omp parallel for if (!arts_omp_in_parallel()) \
-    firstprivate(l_ws, l_propmat_clearsky_agenda, a, B, dB_dT, S, dS_dx)
+    firstprivate(propmat, a, B, dB_dT, S, dS_dx, da_dx)
     for (Index ip = 0; ip < np; ip++) {
       get_stepwise_blackbody_radiation(
           B, dB_dT, ppvar_f(joker, ip), ppvar_t[ip], temperature_jacobian);
 
-      get_stepwise_clearsky_propmat(l_ws,
-                                    K[ip],
-                                    S,
-                                    lte[ip],
-                                    dK_dx[ip],
-                                    dS_dx,
-                                    l_propmat_clearsky_agenda,
-                                    jacobian_quantities,
-                                    ppvar_f(joker, ip),
-                                    ppvar_mag(joker, ip),
-                                    ppath.los(ip, joker),
-                                    ppvar_nlte(joker, ip),
-                                    ppvar_vmr(joker, ip),
-                                    ppvar_t[ip],
-                                    ppvar_p[ip],
-                                    jac_species_i,
-                                    j_analytical_do);
+      propmat(K[ip],
+              S,
+              lte[ip],
+              dK_dx[ip],
+              dS_dx,
+              ip,
+              ppath,
+              ppvar_f,
+              ppvar_mag,
+              ppvar_nlte,
+              ppvar_vmr,
+              ppvar_t,
+              ppvar_p,
+              jacobian_quantities,
+              jac_species_i,
+              j_analytical_do);
 
       if (j_analytical_do)
         adapt_stepwise_partial_derivatives(dK_dx[ip],
@@ -872,15 +987,17 @@ void iyEmissionStandardParallel(
     }
   }
 
-  const ArrayOfTransmissionMatrix tot_tra =
-      cumulative_transmission(lyr_tra, CumulativeTransmission::Forward);
+  ArrayOfTransmissionMatrix& tot_tra = scratch.tot_tra;
+  cumulative_transmission(tot_tra, lyr_tra, CumulativeTransmission::Forward);
 
   // iy_transmission
-  Tensor3 iy_trans_new;
+  Tensor3& iy_trans_new = scratch.iy_trans_new;
   if (iy_agenda_call1)
-    iy_trans_new = tot_tra[np - 1];
-  else
-    iy_transmission_mult(iy_trans_new, iy_transmission, tot_tra[np - 1]);
+    tot_tra[np - 1].to_tensor3(iy_trans_new);
+  else {
+    tot_tra[np - 1].to_tensor3(scratch.tot_tra_path);
+    iy_transmission_mult(iy_trans_new, iy_transmission, scratch.tot_tra_path);
+  }
 
   // iy_aux: Optical depth
   if (auxOptDepth >= 0)
@@ -979,6 +1096,262 @@ void iyEmissionStandardParallel(
   }
 }
 
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void iyEmissionStandardParallel(
+    Workspace& ws,
+    Matrix& iy,
+    ArrayOfMatrix& iy_aux,
+    ArrayOfTensor3& diy_dx,
+    Vector& ppvar_p,
+    Vector& ppvar_t,
+    Matrix& ppvar_nlte,
+    Matrix& ppvar_vmr,
+    Matrix& ppvar_wind,
+    Matrix& ppvar_mag,
+    Matrix& ppvar_f,
+    Tensor3& ppvar_iy,
+    Tensor4& ppvar_trans_cumulat,
+    Tensor4& ppvar_trans_partial,
+    const Index& iy_id,
+    const Index& stokes_dim,
+    const Vector& f_grid,
+    const Index& atmosphere_dim,
+    const Vector& p_grid,
+    const Tensor3& z_field,
+    const Tensor3& t_field,
+    const Tensor4& nlte_field,
+    const Tensor4& vmr_field,
+    const ArrayOfArrayOfSpeciesTag& abs_species,
+    const Tensor3& wind_u_field,
+    const Tensor3& wind_v_field,
+    const Tensor3& wind_w_field,
+    const Tensor3& mag_u_field,
+    const Tensor3& mag_v_field,
+    const Tensor3& mag_w_field,
+    const Index& cloudbox_on,
+    const String& iy_unit,
+    const ArrayOfString& iy_aux_vars,
+    const Index& jacobian_do,
+    const ArrayOfRetrievalQuantity& jacobian_quantities,
+    const Ppath& ppath,
+    const Vector& rte_pos2,
+    const Agenda& propmat_clearsky_agenda,
+    const Agenda& water_p_eq_agenda,
+    const Agenda& iy_main_agenda,
+    const Agenda& iy_space_agenda,
+    const Agenda& iy_surface_agenda,
+    const Agenda& iy_cloudbox_agenda,
+    const Index& iy_agenda_call1,
+    const Tensor3& iy_transmission,
+    const Numeric& rte_alonglos_v,
+    const Tensor3& surface_props_data,
+    const Verbosity& verbosity) {
+  iy_emission_standard_parallel(ws,
+                                iy,
+                                iy_aux,
+                                diy_dx,
+                                ppvar_p,
+                                ppvar_t,
+                                ppvar_nlte,
+                                ppvar_vmr,
+                                ppvar_wind,
+                                ppvar_mag,
+                                ppvar_f,
+                                ppvar_iy,
+                                ppvar_trans_cumulat,
+                                ppvar_trans_partial,
+                                iy_id,
+                                stokes_dim,
+                                f_grid,
+                                atmosphere_dim,
+                                p_grid,
+                                z_field,
+                                t_field,
+                                nlte_field,
+                                vmr_field,
+                                abs_species,
+                                wind_u_field,
+                                wind_v_field,
+                                wind_w_field,
+                                mag_u_field,
+                                mag_v_field,
+                                mag_w_field,
+                                cloudbox_on,
+                                iy_unit,
+                                iy_aux_vars,
+                                jacobian_do,
+                                jacobian_quantities,
+                                ppath,
+                                rte_pos2,
+                                water_p_eq_agenda,
+                                iy_main_agenda,
+                                iy_space_agenda,
+                                iy_surface_agenda,
+                                iy_cloudbox_agenda,
+                                iy_agenda_call1,
+                                iy_transmission,
+                                rte_alonglos_v,
+                                surface_props_data,
+                                PropmatFromAgenda(ws, propmat_clearsky_agenda),
+                                verbosity);
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void iyEmissionStandardFromPropmatField(
+    Workspace& ws,
+    Matrix& iy,
+    ArrayOfMatrix& iy_aux,
+    ArrayOfTensor3& diy_dx,
+    Vector& ppvar_p,
+    Vector& ppvar_t,
+    Matrix& ppvar_nlte,
+    Matrix& ppvar_vmr,
+    Matrix& ppvar_wind,
+    Matrix& ppvar_mag,
+    Matrix& ppvar_f,
+    Tensor3& ppvar_iy,
+    Tensor4& ppvar_trans_cumulat,
+    Tensor4& ppvar_trans_partial,
+    const Index& iy_id,
+    const Index& stokes_dim,
+    const Vector& f_grid,
+    const Index& atmosphere_dim,
+    const Vector& p_grid,
+    const Vector& lat_grid,
+    const Vector& lon_grid,
+    const Tensor3& z_field,
+    const Tensor3& t_field,
+    const Tensor4& nlte_field,
+    const Tensor4& vmr_field,
+    const ArrayOfArrayOfSpeciesTag& abs_species,
+    const Tensor3& wind_u_field,
+    const Tensor3& wind_v_field,
+    const Tensor3& wind_w_field,
+    const Tensor3& mag_u_field,
+    const Tensor3& mag_v_field,
+    const Tensor3& mag_w_field,
+    const Index& cloudbox_on,
+    const String& iy_unit,
+    const ArrayOfString& iy_aux_vars,
+    const Index& jacobian_do,
+    const ArrayOfRetrievalQuantity& jacobian_quantities,
+    const Ppath& ppath,
+    const Vector& rte_pos2,
+    const Tensor7& propmat_clearsky_field,
+    const Tensor6& nlte_source_field,
+    const Agenda& water_p_eq_agenda,
+    const Agenda& iy_main_agenda,
+    const Agenda& iy_space_agenda,
+    const Agenda& iy_surface_agenda,
+    const Agenda& iy_cloudbox_agenda,
+    const Index& iy_agenda_call1,
+    const Tensor3& iy_transmission,
+    const Numeric& rte_alonglos_v,
+    const Tensor3& surface_props_data,
+    const Verbosity& verbosity) {
+  const Index nf = f_grid.nelem();
+  const Index ns = stokes_dim;
+
+  if (propmat_clearsky_field.nlibraries() != abs_species.nelem() ||
+      propmat_clearsky_field.nvitrines() != nf ||
+      propmat_clearsky_field.nshelves() != ns ||
+      propmat_clearsky_field.nbooks() != ns ||
+      propmat_clearsky_field.npages() != p_grid.nelem() ||
+      propmat_clearsky_field.nrows() != max(Index(1), lat_grid.nelem()) ||
+      propmat_clearsky_field.ncols() != max(Index(1), lon_grid.nelem()))
+    throw runtime_error(
+        "The size of *propmat_clearsky_field* does not match *abs_species*, "
+        "*f_grid*, *stokes_dim* and the atmospheric grids. Have you run "
+        "*propmat_clearsky_fieldCalc* with the present settings?");
+  if (!nlte_source_field.empty() &&
+      (nlte_source_field.nvitrines() != abs_species.nelem() ||
+       nlte_source_field.nshelves() != nf ||
+       nlte_source_field.nbooks() != ns ||
+       nlte_source_field.npages() != p_grid.nelem() ||
+       nlte_source_field.nrows() != max(Index(1), lat_grid.nelem()) ||
+       nlte_source_field.ncols() != max(Index(1), lon_grid.nelem())))
+    throw runtime_error(
+        "The size of *nlte_source_field* does not match "
+        "*propmat_clearsky_field*.");
+  if (rte_alonglos_v != 0)
+    throw runtime_error(
+        "Doppler shifts are not handled by this method, "
+        "*rte_alonglos_v* must be zero.");
+  for (const Tensor3* wind : {&wind_u_field, &wind_v_field, &wind_w_field})
+    if (!wind->empty() && (max(*wind) != 0 || min(*wind) != 0))
+      throw runtime_error(
+          "Doppler shifts are not handled by this method, "
+          "the wind fields must be zero.");
+
+  // The field holds no information on how the absorption changes with
+  // anything else than the amount of each species
+  if (jacobian_do)
+    FOR_ANALYTICAL_JACOBIANS_DO(
+        if (jacobian_quantities[iq].MainTag() != ABSSPECIES_MAINTAG ||
+            jacobian_quantities[iq].SubSubtag() == PROPMAT_SUBSUBTAG) {
+          ostringstream os;
+          os << "The only analytical Jacobians supported when using "
+             << "*propmat_clearsky_field* are\n"
+             << "absorption species "
+             << "(not in \"" << PROPMAT_SUBSUBTAG << "\" mode), "
+             << "but you have selected:\n"
+             << jacobian_quantities[iq].MainTag() << " "
+             << jacobian_quantities[iq].Subtag();
+          throw runtime_error(os.str());
+        })
+
+  iy_emission_standard_parallel(ws,
+                                iy,
+                                iy_aux,
+                                diy_dx,
+                                ppvar_p,
+                                ppvar_t,
+                                ppvar_nlte,
+                                ppvar_vmr,
+                                ppvar_wind,
+                                ppvar_mag,
+                                ppvar_f,
+                                ppvar_iy,
+                                ppvar_trans_cumulat,
+                                ppvar_trans_partial,
+                                iy_id,
+                                stokes_dim,
+                                f_grid,
+                                atmosphere_dim,
+                                p_grid,
+                                z_field,
+                                t_field,
+                                nlte_field,
+                                vmr_field,
+                                abs_species,
+                                wind_u_field,
+                                wind_v_field,
+                                wind_w_field,
+                                mag_u_field,
+                                mag_v_field,
+                                mag_w_field,
+                                cloudbox_on,
+                                iy_unit,
+                                iy_aux_vars,
+                                jacobian_do,
+                                jacobian_quantities,
+                                ppath,
+                                rte_pos2,
+                                water_p_eq_agenda,
+                                iy_main_agenda,
+                                iy_space_agenda,
+                                iy_surface_agenda,
+                                iy_cloudbox_agenda,
+                                iy_agenda_call1,
+                                iy_transmission,
+                                rte_alonglos_v,
+                                surface_props_data,
+                                PropmatFromField(
+        propmat_clearsky_field, nlte_source_field, atmosphere_dim),
+                                verbosity);
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void iyIndependentBeamApproximation(Workspace& ws,
                                     Matrix& iy,
@@ -1803,40 +2176,58 @@ void yCalc_mblock_loop_body(bool& failed,
                             const Verbosity& verbosity,
                             const Index& mblock_index,
                             const Index& n1y,
-                            const Index& j_analytical_do) {
+                            const Index& j_analytical_do,
+                            const IybData* iyb_cached,
+                            IybData* iyb_store) {
   try {
-    // Calculate monochromatic pencil beam data for 1 measurement block
+    // Monochromatic pencil beam data are kept for later calls, if asked for
     //
-    Vector iyb, iyb_error, yb(n1y);
-    ArrayOfMatrix diyb_dx;
-    Matrix geo_pos_matrix;
+    Vector l_iyb, yb(n1y);
+    ArrayOfMatrix l_diyb_dx;
+    Matrix l_geo_pos_matrix;
     //
-    iyb_calc(ws,
-             iyb,
-             iyb_aux_array[mblock_index],
-             diyb_dx,
-             geo_pos_matrix,
-             mblock_index,
-             atmosphere_dim,
-             t_field,
-             z_field,
-             vmr_field,
-             nlte_field,
-             cloudbox_on,
-             stokes_dim,
-             f_grid,
-             sensor_pos,
-             sensor_los,
-             transmitter_pos,
-             mblock_dlos_grid,
-             iy_unit,
-             iy_main_agenda,
-             geo_pos_agenda,
-             j_analytical_do,
-             jacobian_quantities,
-             jacobian_indices,
-             iy_aux_vars,
-             verbosity);
+    Vector& iyb_out = iyb_store ? iyb_store->iyb[mblock_index] : l_iyb;
+    ArrayOfMatrix& diyb_dx_out =
+        iyb_store ? iyb_store->diyb_dx[mblock_index] : l_diyb_dx;
+    Matrix& geo_pos_out =
+        iyb_store ? iyb_store->geo_pos[mblock_index] : l_geo_pos_matrix;
+
+    // Calculate monochromatic pencil beam data for 1 measurement block,
+    // if not already calculated
+    //
+    if (!iyb_cached)
+      iyb_calc(ws,
+               iyb_out,
+               iyb_aux_array[mblock_index],
+               diyb_dx_out,
+               geo_pos_out,
+               mblock_index,
+               atmosphere_dim,
+               t_field,
+               z_field,
+               vmr_field,
+               nlte_field,
+               cloudbox_on,
+               stokes_dim,
+               f_grid,
+               sensor_pos,
+               sensor_los,
+               transmitter_pos,
+               mblock_dlos_grid,
+               iy_unit,
+               iy_main_agenda,
+               geo_pos_agenda,
+               j_analytical_do,
+               jacobian_quantities,
+               jacobian_indices,
+               iy_aux_vars,
+               verbosity);
+
+    const Vector& iyb = iyb_cached ? iyb_cached->iyb[mblock_index] : iyb_out;
+    const ArrayOfMatrix& diyb_dx =
+        iyb_cached ? iyb_cached->diyb_dx[mblock_index] : diyb_dx_out;
+    const Matrix& geo_pos_matrix =
+        iyb_cached ? iyb_cached->geo_pos[mblock_index] : geo_pos_out;
 
     // Apply sensor response matrix on iyb, and put into y
     //
@@ -1912,45 +2303,53 @@ void yCalc_mblock_loop_body(bool& failed,
   }
 }
 
-/* Workspace method: Doxygen documentation will be auto-generated */
-void yCalc(Workspace& ws,
-           Vector& y,
-           Vector& y_f,
-           ArrayOfIndex& y_pol,
-           Matrix& y_pos,
-           Matrix& y_los,
-           ArrayOfVector& y_aux,
-           Matrix& y_geo,
-           Matrix& jacobian,
-           const Index& atmgeom_checked,
-           const Index& atmfields_checked,
-           const Index& atmosphere_dim,
-           const Tensor3& t_field,
-           const Tensor3& z_field,
-           const Tensor4& vmr_field,
-           const Tensor4& nlte_field,
-           const Index& cloudbox_on,
-           const Index& cloudbox_checked,
-           const Index& scat_data_checked,
-           const Index& sensor_checked,
-           const Index& stokes_dim,
-           const Vector& f_grid,
-           const Matrix& sensor_pos,
-           const Matrix& sensor_los,
-           const Matrix& transmitter_pos,
-           const Matrix& mblock_dlos_grid,
-           const Sparse& sensor_response,
-           const Vector& sensor_response_f,
-           const ArrayOfIndex& sensor_response_pol,
-           const Matrix& sensor_response_dlos,
-           const String& iy_unit,
-           const Agenda& iy_main_agenda,
-           const Agenda& geo_pos_agenda,
-           const Agenda& jacobian_agenda,
-           const Index& jacobian_do,
-           const ArrayOfRetrievalQuantity& jacobian_quantities,
-           const ArrayOfString& iy_aux_vars,
-           const Verbosity& verbosity) {
+//! Core of yCalc and yCalcCached
+/*!
+  If *iyb_cached* is not NULL, no radiative transfer is performed and the
+  monochromatic pencil beam data are taken from it. Otherwise the data
+  are calculated and, if *iyb_store* is not NULL, stored in it. The
+  storage must then be sized to the number of measurement blocks.
+*/
+static void yCalc_impl(Workspace& ws,
+                       Vector& y,
+                       Vector& y_f,
+                       ArrayOfIndex& y_pol,
+                       Matrix& y_pos,
+                       Matrix& y_los,
+                       ArrayOfVector& y_aux,
+                       Matrix& y_geo,
+                       Matrix& jacobian,
+                       const Index& atmgeom_checked,
+                       const Index& atmfields_checked,
+                       const Index& atmosphere_dim,
+                       const Tensor3& t_field,
+                       const Tensor3& z_field,
+                       const Tensor4& vmr_field,
+                       const Tensor4& nlte_field,
+                       const Index& cloudbox_on,
+                       const Index& cloudbox_checked,
+                       const Index& scat_data_checked,
+                       const Index& sensor_checked,
+                       const Index& stokes_dim,
+                       const Vector& f_grid,
+                       const Matrix& sensor_pos,
+                       const Matrix& sensor_los,
+                       const Matrix& transmitter_pos,
+                       const Matrix& mblock_dlos_grid,
+                       const Sparse& sensor_response,
+                       const Vector& sensor_response_f,
+                       const ArrayOfIndex& sensor_response_pol,
+                       const Matrix& sensor_response_dlos,
+                       const String& iy_unit,
+                       const Agenda& iy_main_agenda,
+                       const Agenda& geo_pos_agenda,
+                       const Agenda& jacobian_agenda,
+                       const Index& jacobian_do,
+                       const ArrayOfRetrievalQuantity& jacobian_quantities,
+                       const ArrayOfString& iy_aux_vars,
+                       const Verbosity& verbosity,
+                       const IybData* iyb_cached,
+                       IybData* iyb_store) {
   CREATE_OUT3;
 
   // Basics
@@ -2010,7 +2409,10 @@ void yCalc(Workspace& ws,
 
   // For y_aux we don't know the number of quantities, and we need to
   // store all output
-  ArrayOfArrayOfVector iyb_aux_array(nmblock);
+  ArrayOfArrayOfVector l_iyb_aux_array;
+  ArrayOfArrayOfVector& iyb_aux_array =
+      iyb_store ? iyb_store->iyb_aux : l_iyb_aux_array;
+  if (!iyb_store) l_iyb_aux_array.resize(nmblock);
 
   // Jacobian variables
   //
@@ -2091,7 +2493,9 @@ void yCalc(Workspace& ws,
                              verbosity,
                              mblock_index,
                              n1y,
-                             j_analytical_do);
+                             j_analytical_do,
+                             iyb_cached,
+                             iyb_store);
     }  // End mblock loop
   } else {
     out3 << "  Not parallelizing mblock loop (" << nmblock << " iterations)\n";
@@ -2138,16 +2542,28 @@ void yCalc(Workspace& ws,
                              verbosity,
                              mblock_index,
                              n1y,
-                             j_analytical_do);
+                             j_analytical_do,
+                             iyb_cached,
+                             iyb_store);
     }  // End mblock loop
   }
 
   // Rethrow exception if a runtime error occurred in the mblock loop
   if (failed) throw runtime_error(fail_msg);
 
+  {
+    const RteScratchStatistics rs = rte_scratch_statistics();
+    out3 << "  Reusable RT storage, totals so far: " << rs.uses << " uses, "
+         << rs.grows << " growth events, nesting depth " << rs.max_depth
+         << ", peak " << rs.max_np << " path points and " << rs.max_elements
+         << " elements\n";
+  }
+
   // Compile y_aux
   //
-  const Index nq = iyb_aux_array[0].nelem();
+  const ArrayOfArrayOfVector& iyb_aux_all =
+      iyb_cached ? iyb_cached->iyb_aux : iyb_aux_array;
+  const Index nq = iyb_aux_all[0].nelem();
   y_aux.resize(nq);
   //
   for (Index q = 0; q < nq; q++) {
@@ -2166,18 +2582,332 @@ void yCalc(Workspace& ws,
           y_aux[q][row] = 0;
           for (Index j = 0; j < niyb; j++) {
             y_aux[q][row] +=
-                pow(sensor_response(i, j) * iyb_aux_array[mblock_index][q][j],
+                pow(sensor_response(i, j) * iyb_aux_all[mblock_index][q][j],
                     (Numeric)2.0);
           }
           y_aux[q][row] = sqrt(y_aux[q][row]);
         }
       } else {
-        mult(y_aux[q][rowind], sensor_response, iyb_aux_array[mblock_index][q]);
+        mult(y_aux[q][rowind], sensor_response, iyb_aux_all[mblock_index][q]);
       }
     }
   }
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void yCalc(Workspace& ws,
+           Vector& y,
+           Vector& y_f,
+           ArrayOfIndex& y_pol,
+           Matrix& y_pos,
+           Matrix& y_los,
+           ArrayOfVector& y_aux,
+           Matrix& y_geo,
+           Matrix& jacobian,
+           const Index& atmgeom_checked,
+           const Index& atmfields_checked,
+           const Index& atmosphere_dim,
+           const Tensor3& t_field,
+           const Tensor3& z_field,
+           const Tensor4& vmr_field,
+           const Tensor4& nlte_field,
+           const Index& cloudbox_on,
+           const Index& cloudbox_checked,
+           const Index& scat_data_checked,
+           const Index& sensor_checked,
+           const Index& stokes_dim,
+           const Vector& f_grid,
+           const Matrix& sensor_pos,
+           const Matrix& sensor_los,
+           const Matrix& transmitter_pos,
+           const Matrix& mblock_dlos_grid,
+           const Sparse& sensor_response,
+           const Vector& sensor_response_f,
+           const ArrayOfIndex& sensor_response_pol,
+           const Matrix& sensor_response_dlos,
+           const String& iy_unit,
+           const Agenda& iy_main_agenda,
+           const Agenda& geo_pos_agenda,
+           const Agenda& jacobian_agenda,
+           const Index& jacobian_do,
+           const ArrayOfRetrievalQuantity& jacobian_quantities,
+           const ArrayOfString& iy_aux_vars,
+           const Verbosity& verbosity) {
+  yCalc_impl(ws,
+             y,
+             y_f,
+             y_pol,
+             y_pos,
+             y_los,
+             y_aux,
+             y_geo,
+             jacobian,
+             atmgeom_checked,
+             atmfields_checked,
+             atmosphere_dim,
+             t_field,
+             z_field,
+             vmr_field,
+             nlte_field,
+             cloudbox_on,
+             cloudbox_checked,
+             scat_data_checked,
+             sensor_checked,
+             stokes_dim,
+             f_grid,
+             sensor_pos,
+             sensor_los,
+             transmitter_pos,
+             mblock_dlos_grid,
+             sensor_response,
+             sensor_response_f,
+             sensor_response_pol,
+             sensor_response_dlos,
+             iy_unit,
+             iy_main_agenda,
+             geo_pos_agenda,
+             jacobian_agenda,
+             jacobian_do,
+             jacobian_quantities,
+             iy_aux_vars,
+             verbosity,
+             NULL,
+             NULL);
+}
+
+//! Build the key describing the state of a yCalcCached calculation
+/*!
+  The elements of *x* belonging to atmospheric and surface quantities
+  are included, as these can be mapped to the atmosphere and the surface
+  in ways not seen by the other variables. Baseline fits and frequency
+  shift or stretch are applied after the monochromatic calculations,
+  and pointing is covered by *sensor_los*, so their parts of *x* are
+  left out. The key also tells if the analytical Jacobian is part of
+  the stored data.
+
+  Spectroscopy, surface properties other than z_surface, scattering data
+  and the agendas are not included, see the documentation of
+  yCalcCached.
+*/
+static void iyb_cache_key(Vector& key,
+                          String& names,
+                          const Vector& x,
+                          const Index& jacobian_do,
+                          const ArrayOfRetrievalQuantity& jacobian_quantities,
+                          const Index& atmosphere_dim,
+                          const Index& stokes_dim,
+                          const Index& cloudbox_on,
+                          const Tensor3& t_field,
+                          const Tensor3& z_field,
+                          const Tensor4& vmr_field,
+                          const Tensor4& nlte_field,
+                          const Tensor3& wind_u_field,
+                          const Tensor3& wind_v_field,
+                          const Tensor3& wind_w_field,
+                          const Tensor3& mag_u_field,
+                          const Tensor3& mag_v_field,
+                          const Tensor3& mag_w_field,
+                          const Matrix& z_surface,
+                          const Tensor4& pnd_field,
+                          const Vector& f_grid,
+                          const Matrix& sensor_pos,
+                          const Matrix& sensor_los,
+                          const Matrix& transmitter_pos,
+                          const Matrix& mblock_dlos_grid,
+                          const String& iy_unit,
+                          const ArrayOfString& iy_aux_vars) {
+  std::vector<Numeric> k;
+
+  k.push_back((Numeric)atmosphere_dim);
+  k.push_back((Numeric)stokes_dim);
+  k.push_back((Numeric)cloudbox_on);
+  k.push_back((Numeric)jacobian_do);
+
+  // Retrieval quantities and the non-sensor part of x
+  if (jacobian_quantities.nelem()) {
+    ArrayOfArrayOfIndex ji;
+    bool any_affine;
+    jac_ranges_indices(ji, any_affine, jacobian_quantities, true);
+    if (x.nelem() != ji[ji.nelem() - 1][1] + 1)
+      throw runtime_error(
+          "Length of *x* does not match length implied by "
+          "*jacobian_quantities*.");
+    for (Index q = 0; q < jacobian_quantities.nelem(); q++) {
+      k.push_back((Numeric)ji[q][0]);
+      k.push_back((Numeric)ji[q][1]);
+      const String& tag = jacobian_quantities[q].MainTag();
+      if (tag != POLYFIT_MAINTAG && tag != SINEFIT_MAINTAG &&
+          tag != FREQUENCY_MAINTAG && tag != POINTING_MAINTAG)
+        key_append(k, x[Range(ji[q][0], ji[q][1] - ji[q][0] + 1)]);
+    }
+  } else if (x.nelem()) {
+    throw runtime_error(
+        "*x* is not empty, but no retrieval quantities are defined.");
+  }
+
+  key_append(k, t_field);
+  key_append(k, z_field);
+  key_append(k, vmr_field);
+  key_append(k, nlte_field);
+  key_append(k, wind_u_field);
+  key_append(k, wind_v_field);
+  key_append(k, wind_w_field);
+  key_append(k, mag_u_field);
+  key_append(k, mag_v_field);
+  key_append(k, mag_w_field);
+  key_append(k, z_surface);
+  key_append(k, pnd_field);
+  key_append(k, f_grid);
+  key_append(k, sensor_pos);
+  key_append(k, sensor_los);
+  key_append(k, transmitter_pos);
+  key_append(k, mblock_dlos_grid);
+
+  key.resize((Index)k.size());
+  for (Index i = 0; i < key.nelem(); i++) key[i] = k[(size_t)i];
+
+  names = iy_unit;
+  for (Index i = 0; i < iy_aux_vars.nelem(); i++)
+    names += "\n" + iy_aux_vars[i];
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void yCalcCached(Workspace& ws,
+                 Vector& y,
+                 Vector& y_f,
+                 ArrayOfIndex& y_pol,
+                 Matrix& y_pos,
+                 Matrix& y_los,
+                 ArrayOfVector& y_aux,
+                 Matrix& y_geo,
+                 Matrix& jacobian,
+                 IybCache& iyb_cache,
+                 const Vector& x,
+                 const Index& atmgeom_checked,
+                 const Index& atmfields_checked,
+                 const Index& atmosphere_dim,
+                 const Tensor3& t_field,
+                 const Tensor3& z_field,
+                 const Tensor4& vmr_field,
+                 const Tensor4& nlte_field,
+                 const Tensor3& wind_u_field,
+                 const Tensor3& wind_v_field,
+                 const Tensor3& wind_w_field,
+                 const Tensor3& mag_u_field,
+                 const Tensor3& mag_v_field,
+                 const Tensor3& mag_w_field,
+                 const Matrix& z_surface,
+                 const Index& cloudbox_on,
+                 const Index& cloudbox_checked,
+                 const Tensor4& pnd_field,
+                 const Index& scat_data_checked,
+                 const Index& sensor_checked,
+                 const Index& stokes_dim,
+                 const Vector& f_grid,
+                 const Matrix& sensor_pos,
+                 const Matrix& sensor_los,
+                 const Matrix& transmitter_pos,
+                 const Matrix& mblock_dlos_grid,
+                 const Sparse& sensor_response,
+                 const Vector& sensor_response_f,
+                 const ArrayOfIndex& sensor_response_pol,
+                 const Matrix& sensor_response_dlos,
+                 const String& iy_unit,
+                 const Agenda& iy_main_agenda,
+                 const Agenda& geo_pos_agenda,
+                 const Agenda& jacobian_agenda,
+                 const Index& jacobian_do,
+                 const ArrayOfRetrievalQuantity& jacobian_quantities,
+                 const ArrayOfString& iy_aux_vars,
+                 const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  Vector key;
+  String names;
+  iyb_cache_key(key,
+                names,
+                x,
+                jacobian_do,
+                jacobian_quantities,
+                atmosphere_dim,
+                stokes_dim,
+                cloudbox_on,
+                t_field,
+                z_field,
+                vmr_field,
+                nlte_field,
+                wind_u_field,
+                wind_v_field,
+                wind_w_field,
+                mag_u_field,
+                mag_v_field,
+                mag_w_field,
+                z_surface,
+                pnd_field,
+                f_grid,
+                sensor_pos,
+                sensor_los,
+                transmitter_pos,
+                mblock_dlos_grid,
+                iy_unit,
+                iy_aux_vars);
+
+  const std::shared_ptr<const IybData> iyb_cached =
+      iyb_cache.find(key, names);
+  std::shared_ptr<IybData> iyb_store;
+  if (iyb_cached) {
+    out2 << "  Reusing monochromatic data in *iyb_cache*.\n";
+  } else {
+    out2 << "  No matching data in *iyb_cache*, performing radiative "
+         << "transfer.\n";
+    iyb_store = std::make_shared<IybData>();
+    iyb_store->resize(sensor_pos.nrows());
+  }
+
+  yCalc_impl(ws,
+             y,
+             y_f,
+             y_pol,
+             y_pos,
+             y_los,
+             y_aux,
+             y_geo,
+             jacobian,
+             atmgeom_checked,
+             atmfields_checked,
+             atmosphere_dim,
+             t_field,
+             z_field,
+             vmr_field,
+             nlte_field,
+             cloudbox_on,
+             cloudbox_checked,
+             scat_data_checked,
+             sensor_checked,
+             stokes_dim,
+             f_grid,
+             sensor_pos,
+             sensor_los,
+             transmitter_pos,
+             mblock_dlos_grid,
+             sensor_response,
+             sensor_response_f,
+             sensor_response_pol,
+             sensor_response_dlos,
+             iy_unit,
+             iy_main_agenda,
+             geo_pos_agenda,
+             jacobian_agenda,
+             jacobian_do,
+             jacobian_quantities,
+             iy_aux_vars,
+             verbosity,
+             iyb_cached.get(),
+             iyb_store.get());
+
+  if (iyb_store) iyb_cache.store(key, names, iyb_store);
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void yCalcAppend(Workspace& ws,
                  Vector& y,
@@ -41,6 +41,7 @@
 #include <stdexcept>
 #include <string>
 #include "arts.h"
+#include "arts_omp.h"
 #include "auto_md.h"
 #include "check_input.h"
 #include "interpolation_poly.h"
@@ -1432,17 +1433,17 @@ void sensor_responseBeamSwitching(Sparse& sensor_response,
   const Index n = sensor_response_f_grid.nelem();
 
   // Form H matrix representing beam switching
-  Sparse Hbswitch(n, 2 * n);
-  Vector hrow(2 * n, 0.0);
+  SparseRowBuilder hrows(n, 2 * n);
+  Vector hrow(2);
+  hrow[0] = w1;
+  hrow[1] = w2;
   //
   for (Index i = 0; i < n; i++) {
-    hrow[i] = w1;
-    hrow[i + n] = w2;
-    //
-    Hbswitch.insert_row(i, hrow);
-    //
-    hrow = 0;
+    hrows.set_row(i, hrow, i, n);
   }
+  //
+  Sparse Hbswitch;
+  hrows.build(Hbswitch);
 
   // Here we need a temporary sparse that is copy of the sensor_response
   // sparse matrix. We need it since the multiplication function can not
@@ -1505,17 +1506,17 @@ void sensor_responseFrequencySwitching(
         "the method.");
 
   // Form H matrix representing frequency switching
-  Sparse Hbswitch(n2, n);
-  Vector hrow(n, 0.0);
+  SparseRowBuilder hrows(n2, n);
+  Vector hrow(2);
+  hrow[0] = -1;
+  hrow[1] = 1;
   //
   for (Index i = 0; i < n2; i++) {
-    hrow[i] = -1;
-    hrow[i + n2] = 1;
-    //
-    Hbswitch.insert_row(i, hrow);
-    //
-    hrow = 0;
+    hrows.set_row(i, hrow, i, n2);
   }
+  //
+  Sparse Hbswitch;
+  hrows.build(Hbswitch);
 
   // Here we need a temporary sparse that is copy of the sensor_response
   // sparse matrix. We need it since the multiplication function can not
@@ -1651,28 +1652,31 @@ void sensor_responseFillFgrid(Sparse& sensor_response,
 
   // Set up H for this part
   //
-  Sparse hpoly(nnew * npol * nlos, nin);
-  Vector hrow(nin, 0.0);
+  SparseRowBuilder hrows(nnew * npol * nlos, nin);
   Index row = 0;
   //
   for (Index ilos = 0; ilos < nlos; ilos++) {
     for (Index iv = 0; iv < nnew; iv++) {
+      // Weights of the frequencies from the first to the last one used
+      const ArrayOfIndex& idx = gp[iv].idx;
+      const Index i0 = min(idx);
+      Vector hrow(max(idx) - i0 + 1, 0.0);
+      for (Index i = 0; i < idx.nelem(); i++) {
+        const Numeric w = gp[iv].w[i];
+        if (abs(w) > 1e-5) {
+          hrow[idx[i] - i0] = w;
+        }
+      }
       for (Index ip = 0; ip < npol; ip++) {
         const Index col0 = ilos * nf * npol;
-        for (Index i = 0; i < gp[iv].idx.nelem(); i++) {
-          const Numeric w = gp[iv].w[i];
-          if (abs(w) > 1e-5) {
-            hrow[col0 + gp[iv].idx[i] * npol + ip] = w;
-          }
-        }
-        hpoly.insert_row(row, hrow);
-        for (Index i = 0; i < gp[iv].idx.nelem(); i++) {
-          hrow[col0 + gp[iv].idx[i] * npol + ip] = 0;
-        }
+        hrows.set_row(row, hrow, col0 + i0 * npol + ip, npol);
         row += 1;
       }
     }
   }
+  //
+  Sparse hpoly;
+  hrows.build(hpoly);
 
   // Here we need a temporary sparse that is copy of the sensor_response
   // sparse matrix. We need it since the multiplication function can not
@@ -2220,9 +2224,12 @@ void sensor_responseMixerBackendPrecalcWeights(
 
   // Create response matrix
   //
-  Sparse hmb(nout, nin);
+  Sparse hmb;
   {
+    SparseRowBuilder hrows(nout, nin);
+
     // Loop output channels
+#pragma omp parallel for if (!arts_omp_in_parallel() && nout_f > 1)
     for (Index ifr = 0; ifr < nout_f; ifr++) {
       // The summation vector for 1 polarisation and 1 viewing direction
       Vector w1(nin_f, 0.0);
@@ -2235,15 +2242,16 @@ void sensor_responseMixerBackendPrecalcWeights(
       // (this code is copied from function spectrometer_matrix)
       for (Index sp = 0; sp < nlos; sp++) {
         for (Index pol = 0; pol < npol; pol++) {
-          // Distribute the compact weight vector into a complte one
-          Vector weights_long(nin, 0.0);
-          weights_long[Range(sp * nin_f * npol + pol, nin_f, npol)] = w1;
-
-          // Insert temp_long into H at the correct row
-          hmb.insert_row(sp * nout_f * npol + ifr * npol + pol, weights_long);
+          // Distribute the compact weight vector into the row of H
+          hrows.set_row(sp * nout_f * npol + ifr * npol + pol,
+                        w1,
+                        sp * nin_f * npol + pol,
+                        npol);
         }
       }
     }
+
+    hrows.build(hmb);
   }
 
   // Here we need a temporary sparse that is copy of the sensor_response
@@ -2406,9 +2414,7 @@ void sensor_responseMultiMixerBackend(
   const Index npolnew = sensor_response_pol_grid.nelem();
   const Index nfpolnew = nfnew * npolnew;
   //
-  sensor_response.resize(nlos * nfpolnew, ncols);
-  //
-  Vector dummy(ncols, 0.0);
+  SparseRowBuilder hrows(nlos * nfpolnew, ncols);
   //
   for (Index ilo = 0; ilo < nlo; ilo++) {
     const Index nfpolthis = (cumsumf[ilo + 1] - cumsumf[ilo]) * npolnew;
@@ -2418,16 +2424,14 @@ void sensor_responseMultiMixerBackend(
 
     for (Index ilos = 0; ilos < nlos; ilos++) {
       for (Index i = 0; i < nfpolthis; i++) {
-        // "Poor mans" transfer of a row from one sparse to another
-        for (Index ic = 0; ic < ncols; ic++) {
-          dummy[ic] = sr[ilo](ilos * nfpolthis + i, ic);
-        }
-
-        sensor_response.insert_row(ilos * nfpolnew + cumsumf[ilo] * npolnew + i,
-                                   dummy);
+        hrows.copy_row(ilos * nfpolnew + cumsumf[ilo] * npolnew + i,
+                       sr[ilo],
+                       ilos * nfpolthis + i);
       }
     }
   }
+  //
+  hrows.build(sensor_response);
 
   // Set aux variables
   sensor_aux_vectors(sensor_response_f,
@@ -2438,6 +2442,111 @@ void sensor_responseMultiMixerBackend(
                      sensor_response_dlos_grid);
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void sensor_responseOSSTrain(Vector& f_grid,
+                             Sparse& sensor_response,
+                             Vector& fit_error,
+                             const ArrayOfVector& ybatch,
+                             const Numeric& max_error,
+                             const Index& max_nfreq,
+                             const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  const Index nf = f_grid.nelem();
+  const Index nch = sensor_response.nrows();
+  const Index ncases = ybatch.nelem();
+
+  // Check input
+  if (sensor_response.ncols() != nf) {
+    ostringstream os;
+    os << "*sensor_response* must have one column per frequency, i.e.\n"
+       << "the training is only possible for a single polarisation and\n"
+       << "viewing direction.\n"
+       << "Number of frequencies: " << nf << "\n"
+       << "Number of columns of *sensor_response*: "
+       << sensor_response.ncols();
+    throw runtime_error(os.str());
+  }
+  if (ncases == 0) throw runtime_error("*ybatch* is empty.");
+  for (Index i = 0; i < ncases; i++) {
+    if (ybatch[i].nelem() != nf) {
+      ostringstream os;
+      os << "All spectra in *ybatch* must have one element per frequency,\n"
+         << "i.e. they must be calculated without sensor.\n"
+         << "Length of f_grid: " << nf << "\n"
+         << "Length of ybatch[" << i << "]: " << ybatch[i].nelem();
+      throw runtime_error(os.str());
+    }
+  }
+  if (max_error < 0) throw runtime_error("*max_error* must be >= 0.");
+  if (max_nfreq < 1) throw runtime_error("*max_nfreq* must be >= 1.");
+
+  // Training spectra, and the frequencies and weights of each channel
+  Matrix y_train(nf, ncases);
+  for (Index i = 0; i < ncases; i++) y_train(joker, i) = ybatch[i];
+
+  ArrayOfArrayOfIndex ch_f(nch);
+  Array<ArrayOfNumeric> ch_w(nch);
+  {
+    Vector values;
+    ArrayOfIndex rows, cols;
+    sensor_response.list_elements(values, rows, cols);
+    for (Index i = 0; i < values.nelem(); i++) {
+      ch_f[rows[i]].push_back(cols[i]);
+      ch_w[rows[i]].push_back(values[i]);
+    }
+  }
+
+  // Select frequencies channel by channel
+  ArrayOfArrayOfIndex sel_f(nch);
+  ArrayOfVector sel_w(nch);
+  fit_error.resize(nch);
+
+#pragma omp parallel for if (!arts_omp_in_parallel() && nch > 1)
+  for (Index ich = 0; ich < nch; ich++) {
+    Vector target(ncases, 0);
+    for (Index j = 0; j < ch_f[ich].nelem(); j++)
+      for (Index i = 0; i < ncases; i++)
+        target[i] += ch_w[ich][j] * y_train(ch_f[ich][j], i);
+
+    fit_error[ich] = oss_select_frequencies(sel_f[ich],
+                                            sel_w[ich],
+                                            y_train,
+                                            target,
+                                            ch_f[ich],
+                                            max_error,
+                                            max_nfreq);
+  }
+
+  // The new frequency grid holds the frequencies selected for any channel
+  ArrayOfIndex new_index(nf, -1);
+  for (Index ich = 0; ich < nch; ich++)
+    for (Index j = 0; j < sel_f[ich].nelem(); j++) new_index[sel_f[ich][j]] = 0;
+  Index nf_new = 0;
+  for (Index i = 0; i < nf; i++)
+    if (new_index[i] == 0) new_index[i] = nf_new++;
+
+  Vector f_new(nf_new);
+  for (Index i = 0; i < nf; i++)
+    if (new_index[i] >= 0) f_new[new_index[i]] = f_grid[i];
+
+  // New response matrix
+  SparseRowBuilder hrows(nch, nf_new);
+  for (Index ich = 0; ich < nch; ich++) {
+    Vector row(nf_new, 0);
+    for (Index j = 0; j < sel_f[ich].nelem(); j++)
+      row[new_index[sel_f[ich][j]]] = sel_w[ich][j];
+    hrows.set_row(ich, row);
+  }
+  hrows.build(sensor_response);
+
+  out2 << "  " << nf << " frequencies replaced by " << nf_new << " for " << nch
+       << " channels.\n"
+       << "  Maximum RMS fitting error: " << max(fit_error) << "\n";
+
+  f_grid = f_new;
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void sensor_responsePolarisation(Sparse& sensor_response,
                                  Vector& sensor_response_f,
@@ -2519,8 +2628,8 @@ void sensor_responsePolarisation(Sparse& sensor_response,
 
   // Form H matrix representing polarisation response
   //
-  Sparse Hpol(nfz * nnew, nin);
-  Vector hrow(nin, 0);
+  SparseRowBuilder hrows(nfz * nnew, nin);
+  Vector hrow(stokes_dim);
   Index row = 0;
   //
   for (Index i = 0; i < nfz; i++) {
@@ -2532,15 +2641,16 @@ void sensor_responsePolarisation(Sparse& sensor_response,
           for( Index iv=0; iv<pv[p].nelem(); iv++ )
             { hrow[col+iv] = pv[p][iv]; }
           */
-      stokes2pol(
-          hrow[Range(col, stokes_dim)], stokes_dim, instrument_pol[in], w);
+      stokes2pol(hrow, stokes_dim, instrument_pol[in], w);
       //
-      Hpol.insert_row(row, hrow);
+      hrows.set_row(row, hrow, col);
       //
-      hrow = 0;
       row += 1;
     }
   }
+  //
+  Sparse Hpol;
+  hrows.build(Hpol);
 
   // Here we need a temporary sparse that is copy of the sensor_response
   // sparse matrix. We need it since the multiplication function can not
@@ -2625,10 +2735,11 @@ void sensor_responseStokesRotation(Sparse& sensor_response,
 
   // Set up complete the H matrix for applying rotation
   //
-  Sparse H(sensor_response.nrows(), sensor_response.ncols());
+  Sparse H;
   {
+    SparseRowBuilder hrows(sensor_response.nrows(), sensor_response.ncols());
     Sparse Hrot(npol, npol);  // Mueller matrix for 1 Stokes vec
-    Vector row(H.ncols(), 0);
+    Vector row(npol);
     Index irow = 0;
     //
     for (Index ilos = 0; ilos < nlos; ilos++) {
@@ -2640,18 +2751,16 @@ void sensor_responseStokesRotation(Sparse& sensor_response,
           // Fill relevant part of row with matching (complete) row
           // in Hrot, and instert this row in H
           for (Index is = 0; is < npol; is++) {
-            row[irow + is] = Hrot.ro(ip, is);
-          }
-          H.insert_row(irow + ip, row);
-          // Re-zero row.
-          for (Index is = 0; is < npol; is++) {
-            row[irow + is] = 0;
+            row[is] = Hrot.ro(ip, is);
           }
+          hrows.set_row(irow + ip, row, irow);
         }
         // Update irow, i.e. jump to next frequency
         irow += npol;
       }
     }
+
+    hrows.build(H);
   }
 
   // Here we need a temporary sparse that is copy of the sensor_response
@@ -2988,9 +3097,7 @@ void sensor_responseGenericAMSU(  // WS Output:
   const Index npolnew = sensor_response_pol_grid.nelem();
   const Index nfpolnew = nfnew * npolnew;
   //
-  sensor_response.resize(nlos * nfpolnew, ncols);
-  //
-  Vector dummy(ncols, 0.0);
+  SparseRowBuilder hrows(nlos * nfpolnew, ncols);
   //
   for (Index ilo = 0; ilo < numLO; ilo++) {
     const Index nfpolthis = (cumsumf[ilo + 1] - cumsumf[ilo]) * npolnew;
@@ -3000,16 +3107,14 @@ void sensor_responseGenericAMSU(  // WS Output:
 
     for (Index ilos = 0; ilos < nlos; ilos++) {
       for (Index i = 0; i < nfpolthis; i++) {
-        // "Poor mans" transfer of a row from one sparse to another
-        for (Index ic = 0; ic < ncols; ic++) {
-          dummy[ic] = sr[ilo](ilos * nfpolthis + i, ic);
-        }
-
-        sensor_response.insert_row(ilos * nfpolnew + cumsumf[ilo] * npolnew + i,
-                                   dummy);
+        hrows.copy_row(ilos * nfpolnew + cumsumf[ilo] * npolnew + i,
+                       sr[ilo],
+                       ilos * nfpolthis + i);
       }
     }
   }
+  //
+  hrows.build(sensor_response);
 
   sensor_aux_vectors(sensor_response_f,
                      sensor_response_pol,
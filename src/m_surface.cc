@@ -1058,29 +1058,7 @@ void surfaceTelsem(Matrix& surface_los,
   }
   chk_if_in_range("Longitude input to TELSEM2", lon, 0.0, 360.0);
 
-  Index cellnumber = 0;
-  if (d_max <= 0.0) {
-    cellnumber = atlas.calc_cellnum(lat, lon);
-    // Check if cell is in atlas.
-    if (!atlas.contains(cellnumber)) {
-      throw std::runtime_error(
-          "Given coordinates are not contained in "
-          " TELSEM atlas. To enable nearest neighbor"
-          "interpolation set *d_max* to a positive "
-          "value.");
-    }
-  } else {
-    cellnumber = atlas.calc_cellnum_nearest_neighbor(lat, lon);
-    Numeric lat_nn, lon_nn;
-    std::tie(lat_nn, lon_nn) = atlas.get_coordinates(cellnumber);
-    Numeric d = sphdist(lat, lon, lat_nn, lon_nn);
-    if (d > d_max) {
-      std::ostringstream out{};
-      out << "Distance of nearest neighbor exceeds provided limit (";
-      out << d << " > " << d_max << ").";
-      throw std::runtime_error(out.str());
-    }
-  }
+  Index cellnumber = atlas.calc_cellnum_checked(lat, lon, d_max);
 
   Index class1 = atlas.get_class1(cellnumber);
   Index class2 = atlas.get_class2(cellnumber);
@@ -1153,22 +1131,11 @@ void surfaceTessem(Matrix& surface_los,
                                atmosphere_dim,
                                verbosity);
 
-  // TESSEM in and out
-  //
-  Vector out(2);
-  VectorView e_h = out[Range(0, 1)];
-  VectorView e_v = out[Range(1, 1)];
-  //
-  Vector in(5);
-  in[1] = 180.0 - abs(rtp_los[0]);
-  in[2] = wind_speed;
-  in[3] = surface_skin_t;
-  in[4] = salinity;
-
-  // Get Rv and Rh
+  // TESSEM in and out, all frequencies evaluated as one batch
   //
   const Index nf = f_grid.nelem();
-  Matrix surface_rv_rh(nf, 2);
+  Matrix in(nf, 5);
+  Matrix e_h(nf, 1), e_v(nf, 1);
   //
   for (Index i = 0; i < nf; ++i) {
     if (f_grid[i] < 5e9)
@@ -1176,13 +1143,23 @@ void surfaceTessem(Matrix& surface_los,
     if (f_grid[i] > 900e9)
       throw std::runtime_error("Only frequency <= 900 GHz are allowed");
 
-    in[0] = f_grid[i];
-
-    tessem_prop_nn(e_h, net_h, in);
-    tessem_prop_nn(e_v, net_v, in);
+    in(i, 0) = f_grid[i];
+    in(i, 1) = 180.0 - abs(rtp_los[0]);
+    in(i, 2) = wind_speed;
+    in(i, 3) = surface_skin_t;
+    in(i, 4) = salinity;
+  }
+  //
+  tessem_prop_nn_batch(e_h, net_h, in);
+  tessem_prop_nn_batch(e_v, net_v, in);
 
-    surface_rv_rh(i, 0) = min(max(1 - e_v[0], (Numeric)0), (Numeric)1);
-    surface_rv_rh(i, 1) = min(max(1 - e_h[0], (Numeric)0), (Numeric)1);
+  // Get Rv and Rh
+  //
+  Matrix surface_rv_rh(nf, 2);
+  //
+  for (Index i = 0; i < nf; ++i) {
+    surface_rv_rh(i, 0) = min(max(1 - e_v(i, 0), (Numeric)0), (Numeric)1);
+    surface_rv_rh(i, 1) = min(max(1 - e_h(i, 0), (Numeric)0), (Numeric)1);
   }
 
   surfaceFlatRvRh(surface_los,
@@ -42,28 +42,7 @@ void telsemStandalone(Matrix &emis,
   chk_if_in_range("Latitude input to TELSEM2", lat, -90.0, 90.0);
   chk_if_in_range("Longitude input to TELSEM2", lon, 0.0, 360.0);
 
-  Index cellnumber = 0;
-  if (dmax <= 0.0) {
-    cellnumber = ta.calc_cellnum(lat, lon);
-    if (!ta.contains(cellnumber)) {
-      throw std::runtime_error(
-          "Given coordinates are not contained in "
-          " TELSEM atlas. To enable nearest neighbor"
-          "interpolation set *dmax* to a positive "
-          "value.");
-    }
-  } else {
-    cellnumber = ta.calc_cellnum_nearest_neighbor(lat, lon);
-    Numeric lat_nn, lon_nn;
-    std::tie(lat_nn, lon_nn) = ta.get_coordinates(cellnumber);
-    Numeric d = sphdist(lat, lon, lat_nn, lon_nn);
-    if (d > dmax) {
-      std::ostringstream out{};
-      out << "Distance of nearest neighbor exceeds provided limit (";
-      out << d << " > " << dmax << ").";
-      throw std::runtime_error(out.str());
-    }
-  }
+  Index cellnumber = ta.calc_cellnum_checked(lat, lon, dmax);
 
   Index class1 = ta.get_class1(cellnumber);
   Index class2 = ta.get_class2(cellnumber);
@@ -77,6 +56,34 @@ void telsemStandalone(Matrix &emis,
   }
 }
 
+/* Workspace method: Doxygen documentation will be auto-generated */
+void telsemStandaloneBatch(Matrix &emis,
+                           const Vector &lat,
+                           const Vector &lon,
+                           const Vector &theta,
+                           const Vector &f,
+                           const TelsemAtlas &ta,
+                           const Numeric &dmax,
+                           const Verbosity &) {
+  const Index n = lat.nelem();
+  if (lon.nelem() != n || theta.nelem() != n || f.nelem() != n) {
+    std::ostringstream os;
+    os << "The GINs *lat*, *lon*, *theta* and *f* must have the same length.\n"
+       << "Lengths are: " << n << ", " << lon.nelem() << ", "
+       << theta.nelem() << ", " << f.nelem() << ".";
+    throw std::runtime_error(os.str());
+  }
+
+  Vector f_ghz(n);
+  for (Index i = 0; i < n; ++i) {
+    chk_if_in_range("Latitude input to TELSEM2", lat[i], -90.0, 90.0);
+    chk_if_in_range("Longitude input to TELSEM2", lon[i], 0.0, 360.0);
+    f_ghz[i] = f[i] * 1e-9;
+  }
+
+  ta.emis_interp_batch(emis, lat, lon, theta, f_ghz, dmax);
+}
+
 /* Workspace method: Doxygen documentation will be auto-generated */
 void telsemSurfaceTypeLandSea(Index &surface_type,
                               const Index &atmosphere_dim,
@@ -112,27 +112,33 @@ void diameter_volume_equFromDiameter_max(Numeric& diameter_volume_equ,
   diameter_volume_equ = pow((6. * volume) / PI, 1. / 3.);
 }
 
-/* Workspace method: Doxygen documentation will be auto-generated */
-void scat_data_singleTmatrix(SingleScatteringData& scat_data_single,
-                             ScatteringMetaData& scat_meta_single,
-                             const GriddedField3& complex_refr_index,
+//! Set up a T-matrix calculation for one scattering element.
+/*!
+  Sets the particle type, the description and the grids of ssd, after
+  checking the grids, and gives the shape coding and the aspect ratio to
+  use for calcSingleScatteringDataProperties.
+
+  See *scat_data_singleTmatrix* for the remaining arguments.
+
+  \param ssd  Out: Single scattering data with grids set.
+  \param np   Out: Shape coding.
+  \param ar   Out: Aspect ratio to use in the calculation.
+
+  \author Johan Strandgren, Patrick Eriksson
+*/
+static void tmatrix_ssd_init(SingleScatteringData& ssd,
+                             Index& np,
+                             Numeric& ar,
                              const String& shape,
                              const Numeric& diameter_volume_equ,
                              const Numeric& aspect_ratio,
-                             const Numeric& mass,
                              const String& ptype,
                              const Vector& data_f_grid,
                              const Vector& data_t_grid,
                              const Vector& data_za_grid,
-                             const Vector& data_aa_grid,
-                             const Numeric& precision,
-                             const String& cri_source,
-                             const Index& ndgs,
-                             const Index& robust,
-                             const Index& quiet,
-                             const Verbosity& verbosity) {
+                             const Vector& data_aa_grid) {
   // Get internal coding for ptype
-  scat_data_single.ptype = PTypeFromString(ptype);
+  ssd.ptype = PTypeFromString(ptype);
 
   // Set description
   {
@@ -140,15 +146,15 @@ void scat_data_singleTmatrix(SingleScatteringData& scat_data_single,
     os << "T-matrix calculation for a " << shape << " particle, with "
        << "diameter_volume_equ = " << 1e6 * diameter_volume_equ << "um and "
        << "aspect ratio = " << aspect_ratio << ".";
-    scat_data_single.description = os.str();
+    ssd.description = os.str();
   }
 
-  // Add grids to scat_data_single
+  // Add grids to ssd
   //
-  scat_data_single.f_grid = data_f_grid;
-  scat_data_single.T_grid = data_t_grid;
+  ssd.f_grid = data_f_grid;
+  ssd.T_grid = data_t_grid;
 
-  if (scat_data_single.ptype == PTYPE_TOTAL_RND) {
+  if (ssd.ptype == PTYPE_TOTAL_RND) {
     // tmatrix random orient requires equidistant angular grid. checking here
     // that given data_za_grid fulfills this requirement
     if (!(is_same_within_epsilon(data_za_grid[0], 0., 2 * DBL_EPSILON) &&
@@ -171,31 +177,31 @@ void scat_data_singleTmatrix(SingleScatteringData& scat_data_single,
       }
     }
   }
-  scat_data_single.za_grid = data_za_grid;
+  ssd.za_grid = data_za_grid;
 
-  if (scat_data_single.ptype == PTYPE_TOTAL_RND) {
+  if (ssd.ptype == PTYPE_TOTAL_RND) {
     // in case of random orientation, azimuth grid should be empty. We just
     // set that here, ignoring whatever is in data_aa_grid.
     Vector empty_grid(0);
-    scat_data_single.aa_grid = empty_grid;
+    ssd.aa_grid = empty_grid;
   } else {
     // For azimuthally-random oriented particles, the azimuth angle grid must cover
     // 0-180 degrees.
-    if (scat_data_single.ptype == PTYPE_AZIMUTH_RND &&
+    if (ssd.ptype == PTYPE_AZIMUTH_RND &&
         data_aa_grid.nelem() == 0) {
       ostringstream os;
       os << "For ptype = \"azimuthally_random\""
          << " the azimuth angle grid can not be empty.";
       throw runtime_error(os.str());
     }
-    if (scat_data_single.ptype == PTYPE_AZIMUTH_RND && data_aa_grid[0] != 0.) {
+    if (ssd.ptype == PTYPE_AZIMUTH_RND && data_aa_grid[0] != 0.) {
       ostringstream os;
       os << "For ptype = \"azimuthally_random\""
          << " the first value of the aa grid must be 0.";
       throw runtime_error(os.str());
     }
 
-    if (scat_data_single.ptype == PTYPE_AZIMUTH_RND &&
+    if (ssd.ptype == PTYPE_AZIMUTH_RND &&
         last(data_aa_grid) != 180.) {
       ostringstream os;
       os << "For ptype = \"azimuthally_random\""
@@ -203,12 +209,11 @@ void scat_data_singleTmatrix(SingleScatteringData& scat_data_single,
       throw runtime_error(os.str());
     }
 
-    scat_data_single.aa_grid = data_aa_grid;
+    ssd.aa_grid = data_aa_grid;
   }
 
   // Index coding for shape
-  Index np;
-  Numeric ar = aspect_ratio;
+  ar = aspect_ratio;
   if (shape == "spheroidal") {
     np = -1;
     if (aspect_ratio == 1)
@@ -228,6 +233,74 @@ void scat_data_singleTmatrix(SingleScatteringData& scat_data_single,
        << "Must be \"spheroidal\" or \"cylindrical\".";
     throw runtime_error(os.str());
   }
+}
+
+//! Meta data of a scattering element calculated by T-matrix.
+/*!
+  See *scat_data_singleTmatrix* for the arguments.
+
+  \author Johan Strandgren, Patrick Eriksson
+*/
+static void tmatrix_meta_set(ScatteringMetaData& scat_meta_single,
+                             const String& shape,
+                             const Numeric& diameter_volume_equ,
+                             const Numeric& aspect_ratio,
+                             const Numeric& mass,
+                             const String& cri_source,
+                             const Verbosity& verbosity) {
+  // Meta data
+  scat_meta_single.description =
+      "Meta data for associated file with single scattering data.";
+  scat_meta_single.source =
+      "ARTS interface to T-matrix code by Mishchenko et al.";
+  scat_meta_single.refr_index = cri_source;
+  //
+  Numeric diameter_max, area_max;
+  diameter_maxFromDiameter_volume_equ(diameter_max,
+                                      area_max,
+                                      shape,
+                                      diameter_volume_equ,
+                                      aspect_ratio,
+                                      verbosity);
+  //
+  scat_meta_single.mass = mass;
+  scat_meta_single.diameter_max = diameter_max;
+  scat_meta_single.diameter_volume_equ = diameter_volume_equ;
+  scat_meta_single.diameter_area_equ_aerodynamical = area_max;
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void scat_data_singleTmatrix(SingleScatteringData& scat_data_single,
+                             ScatteringMetaData& scat_meta_single,
+                             const GriddedField3& complex_refr_index,
+                             const String& shape,
+                             const Numeric& diameter_volume_equ,
+                             const Numeric& aspect_ratio,
+                             const Numeric& mass,
+                             const String& ptype,
+                             const Vector& data_f_grid,
+                             const Vector& data_t_grid,
+                             const Vector& data_za_grid,
+                             const Vector& data_aa_grid,
+                             const Numeric& precision,
+                             const String& cri_source,
+                             const Index& ndgs,
+                             const Index& robust,
+                             const Index& quiet,
+                             const Verbosity& verbosity) {
+  Index np;
+  Numeric ar;
+  tmatrix_ssd_init(scat_data_single,
+                   np,
+                   ar,
+                   shape,
+                   diameter_volume_equ,
+                   aspect_ratio,
+                   ptype,
+                   data_f_grid,
+                   data_t_grid,
+                   data_za_grid,
+                   data_aa_grid);
 
   // Interpolate refractive index to relevant grids
   //
@@ -254,25 +327,107 @@ void scat_data_singleTmatrix(SingleScatteringData& scat_data_single,
                                      robust,
                                      quiet);
 
-  // Meta data
-  scat_meta_single.description =
-      "Meta data for associated file with single scattering data.";
-  scat_meta_single.source =
-      "ARTS interface to T-matrix code by Mishchenko et al.";
-  scat_meta_single.refr_index = cri_source;
+  tmatrix_meta_set(scat_meta_single,
+                   shape,
+                   diameter_volume_equ,
+                   aspect_ratio,
+                   mass,
+                   cri_source,
+                   verbosity);
+}
+
+/* Workspace method: Doxygen documentation will be auto-generated */
+void ScatSpeciesTmatrix(ArrayOfArrayOfSingleScatteringData& scat_data_raw,
+                        ArrayOfArrayOfScatteringMetaData& scat_meta,
+                        const GriddedField3& complex_refr_index,
+                        const String& shape,
+                        const Vector& diameter_volume_equ,
+                        const Vector& aspect_ratio,
+                        const Vector& mass,
+                        const String& ptype,
+                        const Vector& data_f_grid,
+                        const Vector& data_t_grid,
+                        const Vector& data_za_grid,
+                        const Vector& data_aa_grid,
+                        const Numeric& precision,
+                        const String& cri_source,
+                        const Index& ndgs,
+                        const Index& robust,
+                        const Index& quiet,
+                        const String& cache_dir,
+                        const Index& nprocesses,
+                        const Verbosity& verbosity) {
+  const Index nelem = diameter_volume_equ.nelem();
+  if (aspect_ratio.nelem() != nelem)
+    throw runtime_error(
+        "*aspect_ratio* must have the same length as *diameter_volume_equ*.");
+  if (mass.nelem() != nelem && mass.nelem() != 0)
+    throw runtime_error(
+        "*mass* must be empty or have the same length as "
+        "*diameter_volume_equ*.");
+
+  // Interpolate refractive index to relevant grids
   //
-  Numeric diameter_max, area_max;
-  diameter_maxFromDiameter_volume_equ(diameter_max,
-                                      area_max,
-                                      shape,
-                                      diameter_volume_equ,
-                                      aspect_ratio,
-                                      verbosity);
+  const Index nf = data_f_grid.nelem();
+  const Index nt = data_t_grid.nelem();
   //
-  scat_meta_single.mass = mass;
-  scat_meta_single.diameter_max = diameter_max;
-  scat_meta_single.diameter_volume_equ = diameter_volume_equ;
-  scat_meta_single.diameter_area_equ_aerodynamical = area_max;
+  Tensor3 ncomp(nf, nt, 2);
+  complex_n_interp(ncomp(joker, joker, 0),
+                   ncomp(joker, joker, 1),
+                   complex_refr_index,
+                   "complex_refr_index",
+                   data_f_grid,
+                   data_t_grid);
+
+  ArrayOfSingleScatteringData ssd(nelem);
+  ArrayOfScatteringMetaData smd(nelem);
+  ArrayOfMatrix ref_index_real(nelem, ncomp(joker, joker, 0));
+  ArrayOfMatrix ref_index_imag(nelem, ncomp(joker, joker, 1));
+  Vector equiv_radius(nelem);
+  Vector ar(nelem);
+  Index np = 0;
+
+  for (Index i = 0; i < nelem; i++) {
+    tmatrix_ssd_init(ssd[i],
+                     np,
+                     ar[i],
+                     shape,
+                     diameter_volume_equ[i],
+                     aspect_ratio[i],
+                     ptype,
+                     data_f_grid,
+                     data_t_grid,
+                     data_za_grid,
+                     data_aa_grid);
+    // T-matrix takes size as volume equiv radius(!)
+    equiv_radius[i] = 0.5 * diameter_volume_equ[i];
+  }
+
+  calcSingleScatteringDataPropertiesBatch(ssd,
+                                          ref_index_real,
+                                          ref_index_imag,
+                                          equiv_radius,
+                                          np,
+                                          ar,
+                                          precision,
+                                          ndgs,
+                                          robust,
+                                          quiet,
+                                          cache_dir,
+                                          nprocesses,
+                                          verbosity);
+
+  for (Index i = 0; i < nelem; i++)
+    tmatrix_meta_set(smd[i],
+                     shape,
+                     diameter_volume_equ[i],
+                     aspect_ratio[i],
+                     mass.nelem() ? mass[i] : NAN,
+                     cri_source,
+                     verbosity);
+
+  scat_data_raw.push_back(ssd);
+  scat_meta.push_back(smd);
 }
 
 void TMatrixTest(const Verbosity& verbosity) {
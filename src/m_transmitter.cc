@@ -1178,15 +1178,16 @@ void iyTransmissionStandard(Workspace& ws,
   //
   ppvar_trans_cumulat.resize(np, nf, ns, ns);
 
-  ArrayOfRadiationVector lvl_rad(np, RadiationVector(nf, ns));
-  ArrayOfArrayOfRadiationVector dlvl_rad(
-      np, ArrayOfRadiationVector(nq, RadiationVector(nf, ns)));
+  RteScratchGuard scratch_guard;
+  RteScratch& scratch = scratch_guard.get();
+  scratch.resize(np, nq, nf, ns, false);
 
-  ArrayOfTransmissionMatrix lyr_tra(np, TransmissionMatrix(nf, ns));
-  ArrayOfArrayOfTransmissionMatrix dlyr_tra_above(
-      np, ArrayOfTransmissionMatrix(nq, TransmissionMatrix(nf, ns)));
-  ArrayOfArrayOfTransmissionMatrix dlyr_tra_below(
-      np, ArrayOfTransmissionMatrix(nq, TransmissionMatrix(nf, ns)));
+  ArrayOfRadiationVector& lvl_rad = scratch.lvl_rad;
+  ArrayOfArrayOfRadiationVector& dlvl_rad = scratch.dlvl_rad;
+
+  ArrayOfTransmissionMatrix& lyr_tra = scratch.lyr_tra;
+  ArrayOfArrayOfTransmissionMatrix& dlyr_tra_above = scratch.dlyr_tra_above;
+  ArrayOfArrayOfTransmissionMatrix& dlyr_tra_below = scratch.dlyr_tra_below;
 
   ArrayOfIndex clear2cloudy;
   //
@@ -1354,8 +1355,8 @@ void iyTransmissionStandard(Workspace& ws,
     }
   }
 
-  const ArrayOfTransmissionMatrix tot_tra =
-      cumulative_transmission(lyr_tra, CumulativeTransmission::Forward);
+  ArrayOfTransmissionMatrix& tot_tra = scratch.tot_tra;
+  cumulative_transmission(tot_tra, lyr_tra, CumulativeTransmission::Forward);
 
   // iy_aux: Optical depth
   if (auxOptDepth >= 0) {
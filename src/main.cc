@@ -42,6 +42,7 @@
 
 #include "absorption.h"
 #include "agenda_record.h"
+#include "arts_daemon.h"
 #include "arts_omp.h"
 #include "auto_md.h"
 #include "auto_version.h"
@@ -896,6 +897,11 @@ int main(int argc, char** argv) {
     polite_goodby();
   }
 
+  if (parameters.socket.nelem() && parameters.controlfiles.nelem() > 1) {
+    cerr << "The daemon mode (-u) requires exactly one control file.\n";
+    polite_goodby();
+  }
+
   // Set the basename according to the first control file, if not
   // explicitly specified.
   if ("" == parameters.basename) {
@@ -952,6 +958,10 @@ int main(int argc, char** argv) {
     arts_exit();
   }
 
+  if (parameters.asynclog)
+    async_log_start(parameters.asynclog_timestamps,
+                    parameters.asynclog_threadids);
+
   // Now comes the global try block. Exceptions caught after this
   // one are general stuff like file opening errors.
   try {
@@ -1033,6 +1043,12 @@ int main(int argc, char** argv) {
 
         // Execute main agenda:
         Arts2(workspace, tasklist, verbosity);
+
+        // Keep the workspace and serve requests on it:
+        if (parameters.socket.nelem()) {
+          ArtsDaemon daemon(workspace, parameters.socket, verbosity);
+          daemon.serve();
+        }
       } catch (const std::exception& x) {
         ostringstream os;
         os << "Run-time error in controlfile: " << parameters.controlfiles[i]
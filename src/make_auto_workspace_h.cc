@@ -69,6 +69,10 @@ int main() {
         << "#include \"telsem.h\"\n"
         << "#include \"tessem.h\"\n"
         << "#include \"hitran_xsec.h\"\n"
+        << "#include \"iyb_cache.h\"\n"
+        << "#include \"pnd_field_cache.h\"\n"
+        << "#include \"doit_geometry_cache.h\"\n"
+        << "#include \"scat_database.h\"\n"
         << "\n";
 
     ////////////////////////////////////////////////////////////////////
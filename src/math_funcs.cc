@@ -540,6 +540,60 @@ void mgd_with_derivatives(VectorView psd,
                           const bool& do_ga_jac) {
   const Index nx = x.nelem();
 
+  Vector log_x(nx);
+  for (Index ix = 0; ix < nx; ix++) {
+    log_x[ix] = log(x[ix]);
+  }
+
+  mgd_with_derivatives(psd,
+                       jac_data,
+                       x,
+                       log_x,
+                       n0,
+                       mu,
+                       la,
+                       ga,
+                       do_n0_jac,
+                       do_mu_jac,
+                       do_la_jac,
+                       do_ga_jac);
+}
+
+//! Power of x, given log(x)
+/*!
+    Matches pow(x, e) also for x = 0.
+*/
+static inline Numeric pow_from_log(const Numeric& log_x, const Numeric& e) {
+  return e == 0 ? 1 : exp(e * log_x);
+}
+
+/*! Modified gamma distribution, and derivatives, for precalculated log(x)
+
+    As the function above, but with log(x) as input. This allows the
+    logarithms to be shared between calls with the same x, for example
+    for all atmospheric levels of a PSD calculation. The powers of x are
+    obtained from log(x) by an exponential.
+
+    \param log_x   Natural logarithm of x.
+
+    \author ARTS developers
+    \date 2020-06-03
+*/
+void mgd_with_derivatives(VectorView psd,
+                          MatrixView jac_data,
+                          const Vector& x,
+                          ConstVectorView log_x,
+                          const Numeric& n0,
+                          const Numeric& mu,
+                          const Numeric& la,
+                          const Numeric& ga,
+                          const bool& do_n0_jac,
+                          const bool& do_mu_jac,
+                          const bool& do_la_jac,
+                          const bool& do_ga_jac) {
+  const Index nx = x.nelem();
+
+  assert(log_x.nelem() == nx);
   assert(psd.nelem() == nx);
   assert(jac_data.nrows() == 4);
   assert(jac_data.ncols() == nx);
@@ -567,18 +621,17 @@ void mgd_with_derivatives(VectorView psd,
       // Gamma distribution
       for (Index ix = 0; ix < nx; ix++) {
         const Numeric eterm = exp(-la * x[ix]);
-        const Numeric xterm = pow(x[ix], mu);
+        const Numeric xterm = pow_from_log(log_x[ix], mu);
         psd[ix] = n0 * xterm * eterm;
         if (do_n0_jac) {
           jac_data(0, ix) = xterm * eterm;
         }
         if (do_mu_jac) {
-          jac_data(1, ix) = log(x[ix]) * psd[ix];
+          jac_data(1, ix) = log_x[ix] * psd[ix];
         }
         if (do_la_jac) {
           jac_data(2, ix) = -x[ix] * psd[ix];
         }
-        psd[ix] = n0 * pow(x[ix], mu) * exp(-la * x[ix]);
       }
     }
   } else {
@@ -596,21 +649,21 @@ void mgd_with_derivatives(VectorView psd,
       throw runtime_error(os.str());
     }
     for (Index ix = 0; ix < nx; ix++) {
-      const Numeric pterm = pow(x[ix], ga);
+      const Numeric pterm = pow_from_log(log_x[ix], ga);
       const Numeric eterm = exp(-la * pterm);
-      const Numeric xterm = pow(x[ix], mu);
+      const Numeric xterm = pow_from_log(log_x[ix], mu);
       psd[ix] = n0 * xterm * eterm;
       if (do_n0_jac) {
         jac_data(0, ix) = xterm * eterm;
       }
       if (do_mu_jac) {
-        jac_data(1, ix) = log(x[ix]) * psd[ix];
+        jac_data(1, ix) = log_x[ix] * psd[ix];
       }
       if (do_la_jac) {
         jac_data(2, ix) = -pterm * psd[ix];
       }
       if (do_ga_jac) {
-        jac_data(3, ix) = -la * pterm * log(x[ix]) * psd[ix];
+        jac_data(3, ix) = -la * pterm * log_x[ix] * psd[ix];
       }
     }
   }
@@ -96,6 +96,19 @@ void mgd_with_derivatives(VectorView psd,
                           const bool& do_la_jac,
                           const bool& do_ga_jac);
 
+void mgd_with_derivatives(VectorView psd,
+                          MatrixView jac_data,
+                          const Vector& x,
+                          ConstVectorView log_x,
+                          const Numeric& n0,
+                          const Numeric& mu,
+                          const Numeric& la,
+                          const Numeric& ga,
+                          const bool& do_n0_jac,
+                          const bool& do_mu_jac,
+                          const bool& do_la_jac,
+                          const bool& do_ga_jac);
+
 /**! Shape functions for normalized PSD.
  *
  * This function implements the shape function F(X, alpha, beta) from
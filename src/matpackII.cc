@@ -311,7 +311,7 @@ void Sparse::split(Index offset, Index nrows_block) {
   \param r Where to insert the row
   \param v Vector to be inserted.
 */
-void Sparse::insert_row(Index r, Vector v) {
+void Sparse::insert_row(Index r, ConstVectorView v) {
   // Check if the row index and the Vector length are valid
   assert(0 <= r);
   assert(r < nrows());
@@ -348,6 +348,106 @@ void Sparse::insert_elements(Index nelems,
   matrix.setFromTriplets(tripletList.begin(), tripletList.end());
 }
 
+//! Constructor setting size.
+/*!
+  \param r Row dimension of the matrix to build.
+  \param c Column dimension of the matrix to build.
+*/
+SparseRowBuilder::SparseRowBuilder(Index r, Index c)
+    : mncols(c), mcolind(size_t(r)), mdata(size_t(r)) {
+  assert(0 <= r);
+  assert(0 <= c);
+}
+
+//! Set the elements of a row.
+/*!
+  Element i of v is placed in column offset + i * stride, all other
+  elements of the row are zero. Only non-zero values of v are stored. If
+  the row was set before, it is overwritten.
+
+  Different rows can be set by different threads at the same time.
+
+  \param r      Row index.
+  \param v      The values.
+  \param offset Column of the first element of v.
+  \param stride Column distance between the elements of v.
+*/
+void SparseRowBuilder::set_row(Index r,
+                               ConstVectorView v,
+                               Index offset,
+                               Index stride) {
+  assert(0 <= r);
+  assert(r < nrows());
+  assert(0 <= offset);
+  assert(0 < stride);
+  assert(v.nelem() == 0 || offset + (v.nelem() - 1) * stride < mncols);
+
+  std::vector<int>& colind = mcolind[size_t(r)];
+  std::vector<Numeric>& data = mdata[size_t(r)];
+  colind.clear();
+  data.clear();
+
+  for (Index i = 0; i < v.nelem(); i++) {
+    if (v[i] != 0) {
+      colind.push_back((int)(offset + i * stride));
+      data.push_back(v[i]);
+    }
+  }
+}
+
+//! Set a row to a row of a Sparse matrix.
+/*!
+  \param r  Row index.
+  \param A  Matrix with the same number of columns as the builder.
+  \param ra Index of the row of A to copy.
+*/
+void SparseRowBuilder::copy_row(Index r, const Sparse& A, Index ra) {
+  assert(0 <= r);
+  assert(r < nrows());
+  assert(0 <= ra);
+  assert(ra < A.nrows());
+  assert(A.ncols() == mncols);
+
+  std::vector<int>& colind = mcolind[size_t(r)];
+  std::vector<Numeric>& data = mdata[size_t(r)];
+  colind.clear();
+  data.clear();
+
+  typedef Eigen::SparseMatrix<Numeric, Eigen::RowMajor> EigenSparse;
+  for (EigenSparse::InnerIterator it(A.matrix, (int)ra); it; ++it) {
+    if (it.value() != 0) {
+      colind.push_back((int)it.col());
+      data.push_back(it.value());
+    }
+  }
+}
+
+//! Assemble the matrix.
+/*!
+  \param A The matrix, resized to the size of the builder. All data
+           previously in A are lost.
+*/
+void SparseRowBuilder::build(Sparse& A) const {
+  A.matrix.resize((int)nrows(), (int)mncols);
+
+  Index nnz = 0;
+  for (size_t r = 0; r < mcolind.size(); r++) nnz += (Index)mcolind[r].size();
+  A.matrix.resizeNonZeros(nnz);
+
+  int* row_start = A.matrix.outerIndexPtr();
+  int* colind = A.matrix.innerIndexPtr();
+  Numeric* data = A.matrix.valuePtr();
+
+  row_start[0] = 0;
+  Index k = 0;
+  for (size_t r = 0; r < mcolind.size(); r++) {
+    std::copy(mcolind[r].begin(), mcolind[r].end(), colind + k);
+    std::copy(mdata[r].begin(), mdata[r].end(), data + k);
+    k += (Index)mcolind[r].size();
+    row_start[r + 1] = (int)k;
+  }
+}
+
 //! Resize function.
 /*!
   If the size is already correct this function does nothing.
@@ -42,6 +42,7 @@
 #define matpackII_h
 
 #include <iostream>
+#include <vector>
 #include "Eigen/Core"
 #include "Eigen/SparseCore"
 #include "array.h"
@@ -66,7 +67,7 @@ class Sparse {
   void split(Index offset, Index nrows);
 
   // Insert functions
-  void insert_row(Index r, Vector v);
+  void insert_row(Index r, ConstVectorView v);
   void insert_elements(Index nnz,
                        const ArrayOfIndex& rowind,
                        const ArrayOfIndex& colind,
@@ -135,12 +136,39 @@ class Sparse {
   friend void sub(Sparse& A, const Sparse& B, const Sparse& C);
   friend void transpose(Sparse& A, const Sparse& B);
   friend void id_mat(Sparse& A);
+  friend class SparseRowBuilder;
 
  private:
   //! The actual matrix.
   Eigen::SparseMatrix<Numeric, Eigen::RowMajor> matrix;
 };
 
+//! Row by row construction of Sparse matrices.
+/*!
+  The non-zero elements of each row are collected separately, and the
+  compressed matrix is assembled by build in time linear in the number of
+  non-zero elements. In contrast to Sparse::insert_row, the dense row does
+  not have to be allocated, and different rows can be set in parallel.
+*/
+class SparseRowBuilder {
+ public:
+  SparseRowBuilder(Index r, Index c);
+
+  Index nrows() const { return (Index)mcolind.size(); }
+  Index ncols() const { return mncols; }
+
+  void set_row(Index r, ConstVectorView v, Index offset = 0, Index stride = 1);
+
+  void copy_row(Index r, const Sparse& A, Index ra);
+
+  void build(Sparse& A) const;
+
+ private:
+  Index mncols;
+  std::vector<std::vector<int>> mcolind;
+  std::vector<std::vector<Numeric>> mdata;
+};
+
 // Functions for general matrix operations
 void abs(Sparse& A, const Sparse& B);
 
@@ -26,6 +26,14 @@
 */
 
 #include "messages.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include "array.h"
 #include "arts.h"
 #include "mystring.h"
@@ -44,6 +52,236 @@ String out_basename;
 /** The report file. */
 ofstream report_file;
 
+/** Flag for the output operator of ArtsOut. */
+std::atomic<bool> async_log_active(false);
+
+//! A node of the queue between the threads and the writer.
+struct AsyncLogLine {
+  AsyncLogLine() : next(nullptr), target(ASYNC_LOG_SCREEN), text() {}
+  std::atomic<AsyncLogLine*> next;
+  AsyncLogTarget target;
+  String text;
+};
+
+//! Output of one thread.
+/*!
+  The streams are only used by the owning thread. The text not forming a
+  complete line yet is also read by async_log_stop, and is guarded by the
+  mutex.
+*/
+struct AsyncLogBuffer {
+  ostringstream stream[2];
+  std::mutex mutex;
+  String pending[2];
+};
+
+//! State of the asynchronous output.
+/*!
+  The queue is a multiple-producer single-consumer linked list: Producers
+  exchange the head and link the previous node to the new one, the writer
+  thread consumes from the tail, which is always a dummy node.
+*/
+struct AsyncLog {
+  AsyncLog(bool ts, bool ti)
+      : head(new AsyncLogLine),
+        tail(head.load()),
+        timestamps(ts),
+        thread_ids(ti),
+        stopping(false) {}
+
+  std::atomic<AsyncLogLine*> head;
+  AsyncLogLine* tail;
+  const bool timestamps;
+  const bool thread_ids;
+  std::atomic<bool> stopping;
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  std::thread writer;
+};
+
+static AsyncLog* async_log = nullptr;
+
+//! Buffers of all threads, kept also after async_log_stop.
+static std::mutex async_log_buffers_mutex;
+static Array<std::shared_ptr<AsyncLogBuffer> > async_log_buffers;
+static thread_local std::shared_ptr<AsyncLogBuffer> async_log_buffer;
+static thread_local bool async_log_registered = false;
+
+//! Prefix each line of text and pass it to the writer thread.
+static void async_log_push(AsyncLogTarget target, const String& text) {
+  AsyncLogLine* line = new AsyncLogLine;
+  line->target = target;
+
+  if (async_log->timestamps || async_log->thread_ids) {
+    String prefix;
+    if (async_log->timestamps) {
+      using namespace std::chrono;
+      const system_clock::time_point now = system_clock::now();
+      const time_t t = system_clock::to_time_t(now);
+      const long ms = long(
+          duration_cast<milliseconds>(now.time_since_epoch()).count() % 1000);
+      struct tm tm;
+      localtime_r(&t, &tm);
+      char stamp[32];
+      snprintf(stamp,
+               sizeof(stamp),
+               "[%02d:%02d:%02d.%03ld] ",
+               tm.tm_hour,
+               tm.tm_min,
+               tm.tm_sec,
+               ms);
+      prefix += stamp;
+    }
+    if (async_log->thread_ids) {
+      ostringstream os;
+      os << "[t" << arts_omp_get_thread_num() << "] ";
+      prefix += os.str();
+    }
+
+    size_t start = 0;
+    while (start < text.size()) {
+      size_t end = text.find('\n', start);
+      end = end == std::string::npos ? text.size() : end + 1;
+      line->text += prefix;
+      line->text.append(text, start, end - start);
+      start = end;
+    }
+  } else
+    line->text = text;
+
+  AsyncLogLine* prev = async_log->head.exchange(line);
+  prev->next.store(line, std::memory_order_release);
+  async_log->wakeup.notify_one();
+}
+
+//! Take the oldest line from the queue.
+/*!
+  \return false if the queue is empty.
+*/
+static bool async_log_pop(AsyncLogTarget& target, String& text) {
+  AsyncLogLine* next = async_log->tail->next.load(std::memory_order_acquire);
+  if (!next) return false;
+  target = next->target;
+  text.swap(next->text);
+  delete async_log->tail;
+  async_log->tail = next;
+  return true;
+}
+
+//! Main loop of the writer thread.
+static void async_log_write_loop() {
+  String batch[2];
+  AsyncLogTarget target;
+  String text;
+
+  while (true) {
+    // Read the flag first, everything pushed before stopping is then
+    // visible below
+    const bool stop = async_log->stopping.load();
+
+    while (async_log_pop(target, text)) batch[target] += text;
+
+    if (batch[ASYNC_LOG_SCREEN].size()) {
+      cout << batch[ASYNC_LOG_SCREEN] << flush;
+      batch[ASYNC_LOG_SCREEN].clear();
+    }
+    if (batch[ASYNC_LOG_FILE].size()) {
+      report_file << batch[ASYNC_LOG_FILE] << flush;
+      batch[ASYNC_LOG_FILE].clear();
+    }
+
+    if (stop) break;
+
+    std::unique_lock<std::mutex> lock(async_log->mutex);
+    async_log->wakeup.wait_for(lock, std::chrono::milliseconds(20));
+  }
+}
+
+void async_log_start(bool timestamps, bool thread_ids) {
+  // The buffers of the threads are not reset by async_log_stop, so
+  // asynchronous output can only be started once
+  static bool started = false;
+  if (started) return;
+  started = true;
+
+  async_log = new AsyncLog(timestamps, thread_ids);
+  async_log->writer = std::thread(async_log_write_loop);
+  async_log_active = true;
+  atexit(async_log_stop);
+}
+
+void async_log_stop() {
+  if (!async_log) return;
+
+  // Threads check the flag while holding the lock of their buffer, so no
+  // thread adds text once its buffer has been emptied here
+  async_log_active = false;
+  {
+    std::lock_guard<std::mutex> lock(async_log_buffers_mutex);
+    for (Index i = 0; i < async_log_buffers.nelem(); i++) {
+      AsyncLogBuffer& buffer = *async_log_buffers[i];
+      std::lock_guard<std::mutex> buffer_lock(buffer.mutex);
+      for (int target = 0; target < 2; target++) {
+        String& pending = buffer.pending[target];
+        if (pending.size()) async_log_push(AsyncLogTarget(target), pending);
+        pending.clear();
+      }
+    }
+  }
+
+  async_log->stopping = true;
+  async_log->wakeup.notify_one();
+  async_log->writer.join();
+
+  delete async_log->tail;
+  delete async_log;
+  async_log = nullptr;
+}
+
+ostream& async_log_stream(AsyncLogTarget target) {
+  if (!async_log_buffer) async_log_buffer = std::make_shared<AsyncLogBuffer>();
+  return async_log_buffer->stream[target];
+}
+
+void async_log_flush(AsyncLogTarget target) {
+  AsyncLogBuffer& buffer = *async_log_buffer;
+  ostringstream& stream = buffer.stream[target];
+  const String text = stream.str();
+  stream.str("");
+
+  if (!async_log_registered) {
+    std::lock_guard<std::mutex> lock(async_log_buffers_mutex);
+    if (async_log_active) {
+      async_log_buffers.push_back(async_log_buffer);
+      async_log_registered = true;
+    }
+  }
+
+  if (async_log_registered) {
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (async_log_active) {
+      String& pending = buffer.pending[target];
+      pending += text;
+
+      const size_t last = pending.rfind('\n');
+      if (last != std::string::npos) {
+        async_log_push(target, pending.substr(0, last + 1));
+        pending.erase(0, last + 1);
+      }
+      return;
+    }
+  }
+
+  // Asynchronous output has been stopped
+  if (target == ASYNC_LOG_SCREEN) {
+#pragma omp critical(ArtsOut_screen)
+    cout << text << flush;
+  } else {
+#pragma omp critical(ArtsOut_file)
+    report_file << text << flush;
+  }
+}
+
 ostream& operator<<(ostream& os, const Verbosity& v) {
   os << "Agenda Verbosity: " << v.get_agenda_verbosity() << "\n";
   os << "Screen Verbosity: " << v.get_screen_verbosity() << "\n";
@@ -39,8 +39,10 @@
 #ifndef messages_h
 #define messages_h
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include "array.h"
 #include "arts.h"
@@ -149,6 +151,47 @@ class ArtsOut3 : public ArtsOut {
   ArtsOut3(const Verbosity& v) : ArtsOut(3, v) {}
 };
 
+//! Targets of asynchronous output.
+enum AsyncLogTarget { ASYNC_LOG_SCREEN = 0, ASYNC_LOG_FILE = 1 };
+
+//! Is asynchronous output active?
+extern std::atomic<bool> async_log_active;
+
+//! Start writing screen and report file output from a background thread.
+/*!
+  Messages are collected in a buffer of each thread. Complete lines are
+  passed to the writer thread through a lock-free queue, and the writer
+  outputs whatever has arrived in one go. Error messages (out0) are still
+  written directly.
+
+  \param timestamps  Prefix each line with the time it was completed.
+  \param thread_ids  Prefix each line with the OpenMP thread number.
+*/
+void async_log_start(bool timestamps, bool thread_ids);
+
+//! Write all pending output and stop the writer thread.
+/*!
+  Lines not terminated yet are written as they are. Must be called before
+  the report file is closed. It is safe to call this function if
+  asynchronous output was never started.
+*/
+void async_log_stop();
+
+//! Output stream of the calling thread for asynchronous output.
+/*!
+  Each thread has one stream per target. As cout and the report file in
+  synchronous output, the streams keep their formatting state (precision,
+  fixed etc.) from one message to the next.
+*/
+ostream& async_log_stream(AsyncLogTarget target);
+
+//! Pass the complete lines written to the stream of the calling thread on.
+/*!
+  If asynchronous output has been stopped meanwhile, the text is written
+  directly instead.
+*/
+void async_log_flush(AsyncLogTarget target);
+
 /** Output operator for ArtsOut. */
 template <class T>
 ArtsOut& operator<<(ArtsOut& aos, const T& t) {
@@ -161,6 +204,19 @@ ArtsOut& operator<<(ArtsOut& aos, const T& t) {
   // screen or file.
 
   if (aos.sufficient_priority_agenda()) {
+    if (aos.get_priority() > 0 &&
+        async_log_active.load(std::memory_order_relaxed)) {
+      if (aos.sufficient_priority_screen()) {
+        async_log_stream(ASYNC_LOG_SCREEN) << t;
+        async_log_flush(ASYNC_LOG_SCREEN);
+      }
+      if (aos.sufficient_priority_file()) {
+        async_log_stream(ASYNC_LOG_FILE) << t;
+        async_log_flush(ASYNC_LOG_FILE);
+      }
+      return aos;
+    }
+
     // We are marking the actual output operations as omp
     // critical, to somewhat reduce the mess when several threads
     // output simultaneously.
@@ -1075,6 +1075,53 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("abs_lines_per_speciesPruneWeakLines"),
+      DESCRIPTION(
+          "Removes lines too weak to have a significant effect.\n"
+          "\n"
+          "For each line, an upper bound of its cross-section inside the\n"
+          "range of *f_grid* is determined for each level of *abs_p* and\n"
+          "*abs_t*. The bound considers the line strength, the peak of the\n"
+          "line shape, the distance of lines outside of *f_grid*, mirroring\n"
+          "and normalisation of the line shape. The bounds are divided by the\n"
+          "largest bound of all lines of the species at the same level, and\n"
+          "the largest ratio over the levels is the relative importance of\n"
+          "the line. Lines are removed in order of increasing importance, as\n"
+          "long as the sum of the importance of the removed lines does not\n"
+          "exceed *tolerance*.\n"
+          "\n"
+          "The removed lines can then at no frequency and level change the\n"
+          "cross-section of a species by more than *tolerance* times the\n"
+          "largest peak cross-section of any of its lines. The bounds are\n"
+          "conservative, and the actual error is normally much smaller. The\n"
+          "number of removed lines and the error bound are reported for each\n"
+          "species (verbosity level 2).\n"
+          "\n"
+          "Lines with line mixing or a non-LTE population are never removed.\n"
+          "\n"
+          "Call this method after *abs_lines_per_speciesCompact* and before\n"
+          "absorption is calculated, with *abs_p*, *abs_t* and *abs_vmrs*\n"
+          "covering the atmospheric states of concern, for example set by\n"
+          "*AbsInputFromAtmFields*.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("abs_lines_per_species"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("abs_lines_per_species",
+         "abs_species",
+         "f_grid",
+         "abs_p",
+         "abs_t",
+         "abs_vmrs",
+         "isotopologue_ratios",
+         "partition_functions"),
+      GIN("tolerance"),
+      GIN_TYPE("Numeric"),
+      GIN_DEFAULT("1e-4"),
+      GIN_DESC("Relative tolerance, see above.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("abs_lines_per_speciesReadFromCatalogues"),
       DESCRIPTION(
@@ -1229,6 +1276,33 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("abs_lookupAppendFrequencies"),
+      DESCRIPTION(
+          "Merges another gas absorption lookup table into *abs_lookup*.\n"
+          "\n"
+          "The frequencies of *abs_lookup_other* are added to *abs_lookup*.\n"
+          "This allows to calculate a table in several independent jobs, each\n"
+          "one for a part of the frequency range, and to merge the parts\n"
+          "afterwards.\n"
+          "\n"
+          "Both tables must have been calculated with the same species,\n"
+          "nonlinear species, pressure grid, perturbations and reference\n"
+          "profiles, and their frequency grids must not overlap.\n"
+          "\n"
+          "The merged table is not adapted. Use *abs_lookupAdapt* before\n"
+          "using it in a calculation.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("abs_lookup", "abs_lookup_is_adapted"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("abs_lookup"),
+      GIN("abs_lookup_other"),
+      GIN_TYPE("GasAbsLookup"),
+      GIN_DEFAULT(NODEF),
+      GIN_DESC("The lookup table to merge into *abs_lookup*.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("abs_lookupCalc"),
       DESCRIPTION(
@@ -1250,7 +1324,26 @@ void define_md_data_raw() {
           "In contrast to other absorption functions, this method does not use\n"
           "the input variable *abs_h2o*. This is because *abs_h2o* has to be set\n"
           "interally to allow perturbations. If there are more than one H2O\n"
-          "species, the first is assumed to be the main one.\n"),
+          "species, the first is assumed to be the main one.\n"
+          "\n"
+          "The table is calculated in independent slabs, one for each\n"
+          "combination of species, H2O VMR perturbation and temperature\n"
+          "perturbation. All slabs are distributed over the available threads.\n"
+          "\n"
+          "If *checkpoint_dir* is set, each completed slab is written to that\n"
+          "directory, which is created if it does not exist. If the\n"
+          "calculation is interrupted, a rerun with the same input and the\n"
+          "same *checkpoint_dir* reads the completed slabs back and only\n"
+          "calculates the missing ones. An error is thrown if the directory\n"
+          "holds slabs of a table with a different setup, or calculated with\n"
+          "other methods in *abs_xsec_agenda* or with other lines in\n"
+          "*abs_lines_per_species*. Other input of the agenda, such as\n"
+          "continuum parameters, is not checked. The checkpoint files are kept\n"
+          "after the calculation.\n"
+          "\n"
+          "To distribute the calculation over several processes or machines,\n"
+          "calculate tables for separate parts of *f_grid* and merge them with\n"
+          "*abs_lookupAppendFrequencies*.\n"),
       AUTHORS("Stefan Buehler"),
       OUT("abs_lookup", "abs_lookup_is_adapted"),
       GOUT(),
@@ -1265,6 +1358,34 @@ void define_md_data_raw() {
          "abs_t_pert",
          "abs_nls_pert",
          "abs_xsec_agenda"),
+      GIN("checkpoint_dir"),
+      GIN_TYPE("String"),
+      GIN_DEFAULT(""),
+      GIN_DESC("Directory for checkpoint files. Leave empty to disable"
+               " checkpointing.")));
+
+  md_data_raw.push_back(MdRecord(
+      NAME("abs_lookupCompress"),
+      DESCRIPTION(
+          "Compresses the gas absorption lookup table in memory.\n"
+          "\n"
+          "The absorption cross sections are stored in single precision,\n"
+          "after scaling each species by its largest cross section. This\n"
+          "halves the memory needed for the table. The maximum relative error\n"
+          "of the cross sections caused by the compression is of the order of\n"
+          "1e-7, it is reported at verbosity level 2 here and by\n"
+          "*abs_lookupTestAccuracy*.\n"
+          "\n"
+          "The absorption extraction works transparently with compressed\n"
+          "tables. A compressed table can be adapted with *abs_lookupAdapt*,\n"
+          "but note that this temporarily needs the memory of the uncompressed\n"
+          "table. Compressed tables are written to files in uncompressed form.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("abs_lookup"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("abs_lookup"),
       GIN(),
       GIN_TYPE(),
       GIN_DEFAULT(),
@@ -1288,6 +1409,56 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("abs_lookupKDistribution"),
+      DESCRIPTION(
+          "Converts the gas absorption lookup table to a k-distribution.\n"
+          "\n"
+          "For broadband fluxes and heating rates, the dense frequency grid\n"
+          "of a line-by-line table is replaced by a few g-points. The\n"
+          "frequency grid of the table is divided into the bands given by\n"
+          "*band_edges*. Inside each band, the frequencies are sorted by the\n"
+          "column optical depth of all species together, calculated for the\n"
+          "reference profiles of the table. The cumulative distribution of\n"
+          "the sorted frequencies is divided into the intervals given by\n"
+          "*g_edges*, and each non-empty interval becomes a g-point. The\n"
+          "cross sections of a g-point are the mean cross sections of its\n"
+          "frequencies, for each species, pressure level, temperature and\n"
+          "H2O perturbation. As one ordering is used for all species, their\n"
+          "overlap is treated as fully correlated, and the number of\n"
+          "g-points does not grow with the number of species.\n"
+          "\n"
+          "The frequency grid of the table and *f_grid* are replaced by the\n"
+          "mean frequency of each g-point, where the Planck function is\n"
+          "evaluated. The g-points are sorted by this frequency. The\n"
+          "spectral integration weight of each g-point is returned in\n"
+          "*f_grid_weights*, the weights integrate over the original\n"
+          "frequency grid with the trapezoidal rule.\n"
+          "\n"
+          "The converted table stays adapted, absorption at the g-points is\n"
+          "obtained with *propmat_clearskyAddFromLookup* as usual, and all\n"
+          "radiative transfer solvers run on the g-points. Pass\n"
+          "*f_grid_weights* to *RadiationFieldSpectralIntegrate* to obtain\n"
+          "broadband quantities. Note that the g-points of one band are\n"
+          "not spectrally localised, so this is only meaningful for\n"
+          "spectrally integrated results. The accuracy can be checked with\n"
+          "*abs_lookupTestKDistribution*.\n"
+          "\n"
+          "The table must be adapted and must not be compressed.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("abs_lookup", "f_grid"),
+      GOUT("f_grid_weights"),
+      GOUT_TYPE("Vector"),
+      GOUT_DESC("Spectral integration weight of each g-point [Hz]."),
+      IN("abs_lookup", "abs_lookup_is_adapted"),
+      GIN("band_edges", "g_edges"),
+      GIN_TYPE("Vector", "Vector"),
+      GIN_DEFAULT("[]",
+                  "[0, 0.3, 0.6, 0.8, 0.9, 0.95, 0.98, 0.99, 0.995, 0.999, 1]"),
+      GIN_DESC("Limits of the bands [Hz]. They must cover the frequency grid\n"
+               "of the table. Empty means a single band.",
+               "Limits of the g-intervals, increasing from 0 to 1.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("abs_lookupSetup"),
       DESCRIPTION(
@@ -1545,6 +1716,53 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("abs_lookupTestKDistribution"),
+      DESCRIPTION(
+          "Test accuracy of a k-distribution against line-by-line fluxes.\n"
+          "\n"
+          "Calculates clear-sky longwave irradiances and heating rates for\n"
+          "the reference atmosphere of the tables, once with the line-by-line\n"
+          "table *abs_lookup_lbl* and once with the k-distribution in\n"
+          "*abs_lookup*, obtained from *abs_lookup_lbl* by\n"
+          "*abs_lookupKDistribution*. The atmosphere is given by the pressure\n"
+          "grid and the reference temperature and VMR profiles of the tables,\n"
+          "in hydrostatic equilibrium. The lowest pressure level is the\n"
+          "surface, which is a black body. The calculation is non-scattering\n"
+          "and uses the two-stream approximation with a diffusivity factor of\n"
+          "1.66, which is sufficient to compare the two spectral\n"
+          "representations. The line-by-line frequency grid is integrated with\n"
+          "the trapezoidal rule.\n"
+          "\n"
+          "The irradiances follow the convention of *irradiance_field*: the\n"
+          "first column is the downward irradiance (negative), the second\n"
+          "column the upward irradiance. The maximum differences are reported\n"
+          "at verbosity level 2.\n"),
+      AUTHORS("ARTS developers"),
+      OUT(),
+      GOUT("irradiance_lbl",
+           "irradiance_ckd",
+           "heating_rates_lbl",
+           "heating_rates_ckd"),
+      GOUT_TYPE("Matrix", "Matrix", "Vector", "Vector"),
+      GOUT_DESC("Line-by-line irradiance [W/m2], dimension [p_grid, 2].",
+                "k-distribution irradiance [W/m2], dimension [p_grid, 2].",
+                "Line-by-line heating rates [K/s].",
+                "k-distribution heating rates [K/s]."),
+      IN("abs_lookup",
+         "abs_lookup_is_adapted",
+         "abs_p_interp_order",
+         "abs_t_interp_order",
+         "abs_nls_interp_order",
+         "g0",
+         "molarmass_dry_air"),
+      GIN("abs_lookup_lbl", "f_grid_weights", "specific_heat"),
+      GIN_TYPE("GasAbsLookup", "Vector", "Numeric"),
+      GIN_DEFAULT(NODEF, NODEF, "1005"),
+      GIN_DESC("The adapted line-by-line lookup table.",
+               "The weights of the g-points, from *abs_lookupKDistribution*.",
+               "Specific heat capacity of air [J/(kg K)].")));
+
   md_data_raw.push_back(MdRecord(
       NAME("abs_speciesAdd"),
       DESCRIPTION(
@@ -1955,7 +2173,19 @@ void define_md_data_raw() {
 
   md_data_raw.push_back(MdRecord(
       NAME("abs_xsec_per_speciesAddLineMixedLinesInAir"),
-      DESCRIPTION("Calculates the band-wise cross-section TEST FUNCTION\n"),
+      DESCRIPTION(
+          "Calculates the band-wise cross-section TEST FUNCTION\n"
+          "\n"
+          "The Wigner symbols of the relaxation matrix are calculated once\n"
+          "per band, and the pressure levels are calculated in parallel.\n"
+          "\n"
+          "If *temperatures* is given, the relaxation matrix of each band is\n"
+          "only calculated at these temperatures and interpolated to *abs_t*.\n"
+          "The interpolation is done without the populations, linear in the\n"
+          "logarithms of the temperature and the matrix elements. The\n"
+          "populations and the sum rule renormalization are applied at the\n"
+          "temperature of each level. The eigenvalue decomposition is still\n"
+          "done for each level, as it depends on pressure.\n"),
       AUTHORS("Richard Larsson"),
       OUT("abs_xsec_per_species"),
       GOUT(),
@@ -1971,11 +2201,14 @@ void define_md_data_raw() {
          "isotopologue_ratios",
          "partition_functions",
          "wigner_initialized"),
-      GIN("minimum_line_count"),
-      GIN_TYPE("Index"),
-      GIN_DEFAULT("10"),
+      GIN("minimum_line_count", "temperatures"),
+      GIN_TYPE("Index", "Vector"),
+      GIN_DEFAULT("10", "[]"),
       GIN_DESC("If less than this number of lines in a \"band\", "
-               "relaxation matrix is set diagonal")));
+               "relaxation matrix is set diagonal",
+               "Temperatures to calculate the relaxation matrix at, for\n"
+               "interpolation to *abs_t*. Must cover *abs_t*. If empty, the\n"
+               "relaxation matrix is calculated at each level.")));
 
   md_data_raw.push_back(MdRecord(
       NAME("abs_xsec_per_speciesAddLineMixedBands"),
@@ -2816,7 +3049,7 @@ void define_md_data_raw() {
           "The method extracts data for given latitude and longitude index\n"
           "to create a 1D atmosphere. *AtmosphereSet1D* is called to set\n"
           "output values of *atmosphere_dim*, *lat_grid* and *lon_grid*.\n"
-          "Nothing is done if *atmosphere_dim* alöready is 1.\n"),
+          "Nothing is done if *atmosphere_dim* alÃÂ¶ready is 1.\n"),
       AUTHORS("Patrick Eriksson"),
       OUT("atmosphere_dim",
           "lat_grid",
@@ -5238,9 +5471,16 @@ void define_md_data_raw() {
           "Note that multi-dimensional output variables (Tensors, specifically)\n"
           "are NaN-initialized. That is, this methods needs to be called\n"
           "BEFORE other WSMs that provide input to *DoitCalc*, e.g. before\n"
-          "*DoitGetIncoming*.\n"),
+          "*DoitGetIncoming*.\n"
+          "\n"
+          "*doit_geometry_cache* is created if it does not exist. An existing\n"
+          "cache is kept, it is only used if it matches the atmosphere and\n"
+          "the grids of the calculation.\n"),
       AUTHORS("Claudia Emde"),
-      OUT("doit_scat_field", "doit_i_field", "doit_is_initialized"),
+      OUT("doit_scat_field",
+          "doit_i_field",
+          "doit_is_initialized",
+          "doit_geometry_cache"),
       GOUT(),
       GOUT_TYPE(),
       GOUT_DESC(),
@@ -5787,13 +6027,27 @@ void define_md_data_raw() {
           "cloudbox. The method applies the sequential update. For more\n"
           "information please refer to AUG.\n"
           "Surface reflections are not yet implemented in 3D scattering\n"
-          "calculations.\n"),
+          "calculations.\n"
+          "\n"
+          "The propagation path steps are calculated by the first call and\n"
+          "are then taken from *doit_geometry_cache*, as long as the\n"
+          "atmosphere and the grids are unchanged.\n"
+          "\n"
+          "By default the grid points are updated one by one, and the new\n"
+          "radiances of a grid point are used as upwind radiances by the\n"
+          "following ones (Gauss-Seidel). If *level_parallel* is set to 1,\n"
+          "the grid points of each pressure level are instead updated in\n"
+          "parallel, all with upwind radiances taken from the radiation\n"
+          "field before the update of the level (Jacobi within a level).\n"
+          "This can need more iterations, but converges to the same\n"
+          "solution.\n"),
       AUTHORS("Claudia Emde"),
-      OUT("doit_i_field_mono"),
+      OUT("doit_i_field_mono", "doit_geometry_cache"),
       GOUT(),
       GOUT_TYPE(),
       GOUT_DESC(),
       IN("doit_i_field_mono",
+         "doit_geometry_cache",
          "doit_scat_field",
          "cloudbox_limits",
          "propmat_clearsky_agenda",
@@ -5814,10 +6068,11 @@ void define_md_data_raw() {
          "f_grid",
          "f_index",
          "doit_za_interp"),
-      GIN(),
-      GIN_TYPE(),
-      GIN_DEFAULT(),
-      GIN_DESC()));
+      GIN("level_parallel"),
+      GIN_TYPE("Index"),
+      GIN_DEFAULT("0"),
+      GIN_DESC("Flag (0=no, 1=yes) whether to update the grid points of\n"
+               "each pressure level in parallel.")));
 
   md_data_raw.push_back(MdRecord(
       NAME("doit_i_field_monoOptimizeReverse"),
@@ -7441,6 +7696,95 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("iyEmissionStandardFromPropmatField"),
+      DESCRIPTION(
+          "As *iyEmissionStandardParallel*, but takes the absorption from a\n"
+          "precomputed *propmat_clearsky_field*.\n"
+          "\n"
+          "Instead of executing *propmat_clearsky_agenda* for each point of\n"
+          "the propagation path, the propagation matrix (and the NLTE source\n"
+          "term, if *nlte_source_field* is set) is linearly interpolated from\n"
+          "the values at the atmospheric grid points, using the grid\n"
+          "positions of *ppath*. The field shall be calculated beforehand by\n"
+          "*propmat_clearsky_fieldCalc*, with empty *doppler* and *los*. This\n"
+          "is done once for the atmospheric state, and can then be used for\n"
+          "any number of propagation paths, such as all pencil beams of a\n"
+          "scan. The saving can be large for 2D and 3D atmospheres, and when\n"
+          "the propagation paths are sampled more densely than the pressure\n"
+          "grid.\n"
+          "\n"
+          "As the field is calculated at the rest frequencies, Doppler shifts\n"
+          "are not handled. Winds and *rte_alonglos_v* must be zero.\n"
+          "Further, a Zeeman effect is considered only as far as done by\n"
+          "*propmat_clearsky_fieldCalc*, that is without knowledge of the\n"
+          "line-of-sight.\n"
+          "\n"
+          "The only analytical Jacobians supported are absorption species,\n"
+          "and not the \"From propagation matrix\" variants. Their\n"
+          "derivatives are obtained by interpolating the field of the species\n"
+          "in question, in the same way as done when the absorption is\n"
+          "obtained species by species. Other Jacobians, such as temperature,\n"
+          "require *iyEmissionStandard* or *iyEmissionStandardParallel*.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("iy",
+          "iy_aux",
+          "diy_dx",
+          "ppvar_p",
+          "ppvar_t",
+          "ppvar_nlte",
+          "ppvar_vmr",
+          "ppvar_wind",
+          "ppvar_mag",
+          "ppvar_f",
+          "ppvar_iy",
+          "ppvar_trans_cumulat",
+          "ppvar_trans_partial"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("diy_dx",
+         "iy_id",
+         "stokes_dim",
+         "f_grid",
+         "atmosphere_dim",
+         "p_grid",
+         "lat_grid",
+         "lon_grid",
+         "z_field",
+         "t_field",
+         "nlte_field",
+         "vmr_field",
+         "abs_species",
+         "wind_u_field",
+         "wind_v_field",
+         "wind_w_field",
+         "mag_u_field",
+         "mag_v_field",
+         "mag_w_field",
+         "cloudbox_on",
+         "iy_unit",
+         "iy_aux_vars",
+         "jacobian_do",
+         "jacobian_quantities",
+         "ppath",
+         "rte_pos2",
+         "propmat_clearsky_field",
+         "nlte_source_field",
+         "water_p_eq_agenda",
+         "iy_main_agenda",
+         "iy_space_agenda",
+         "iy_surface_agenda",
+         "iy_cloudbox_agenda",
+         "iy_agenda_call1",
+         "iy_transmission",
+         "rte_alonglos_v",
+         "surface_props_data"),
+      GIN(),
+      GIN_TYPE(),
+      GIN_DEFAULT(),
+      GIN_DESC()));
+
   md_data_raw.push_back(MdRecord(
       NAME("iyEmissionStandardParallel"),
       DESCRIPTION(
@@ -12039,6 +12383,54 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("pnd_fieldCalcFromParticleBulkPropsCached"),
+      DESCRIPTION(
+          "As *pnd_fieldCalcFromParticleBulkProps* but reuses the result of\n"
+          "an earlier call if the input is unchanged.\n"
+          "\n"
+          "The method is intended for *inversion_iterate_agenda*, for\n"
+          "retrievals where *particle_bulkprop_field* is not changed by all\n"
+          "iterations (e.g. when only gas species or instrument parameters\n"
+          "are retrieved). The calculated fields are stored in\n"
+          "*pnd_field_cache*, together with a key made of all input\n"
+          "variables except *cloudbox_on*. Of *scat_data*, only the number\n"
+          "of scattering elements is part of the key, and the agendas of\n"
+          "*pnd_agenda_array* are compared by their methods and variable\n"
+          "names. If the key matches in the next call, *pnd_field* and\n"
+          "*dpnd_field_dx* are copied from the cache. Workspace variables\n"
+          "that the agendas read, other than their inputs, must not change\n"
+          "between the calls.\n"
+          "\n"
+          "*pnd_field_cache* must be initialised before *OEM* is called,\n"
+          "e.g. by *Touch*.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("pnd_field", "dpnd_field_dx", "pnd_field_cache"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("pnd_field_cache",
+         "atmosphere_dim",
+         "p_grid",
+         "lat_grid",
+         "lon_grid",
+         "t_field",
+         "cloudbox_on",
+         "cloudbox_limits",
+         "scat_species",
+         "scat_data",
+         "scat_meta",
+         "particle_bulkprop_field",
+         "particle_bulkprop_names",
+         "pnd_agenda_array",
+         "pnd_agenda_array_input_names",
+         "jacobian_do",
+         "jacobian_quantities"),
+      GIN(),
+      GIN_TYPE(),
+      GIN_DEFAULT(),
+      GIN_DESC()));
+
   md_data_raw.push_back(MdRecord(
       NAME("pnd_fieldCalcFrompnd_field_raw"),
       DESCRIPTION(
@@ -12547,6 +12939,14 @@ void define_md_data_raw() {
           "selected maximum length. No additional points are included if\n"
           "*ppath_lmax* is set to <= 0.\n"
           "\n"
+          "For 3D, the end of the path step inside a grid cell is by default\n"
+          "found by a bisection search along the path. If *analytic* is set\n"
+          "to 1, the crossings with the latitude and longitude faces of the\n"
+          "cell are instead calculated analytically, and the crossings with\n"
+          "the pressure levels and the surface by a bracketed root search.\n"
+          "This is faster and gives the same path within the accuracy of\n"
+          "the bisection search. The flag has no effect for 1D and 2D.\n"
+          "\n"
           "For further information, type see the on-line information for\n"
           "*ppath_step_agenda*.\n"),
       AUTHORS("Patrick Eriksson"),
@@ -12562,10 +12962,10 @@ void define_md_data_raw() {
          "refellipsoid",
          "z_surface",
          "ppath_lmax"),
-      GIN(),
-      GIN_TYPE(),
-      GIN_DEFAULT(),
-      GIN_DESC()));
+      GIN("analytic"),
+      GIN_TYPE("Index"),
+      GIN_DEFAULT("0"),
+      GIN_DESC("Flag to determine 3D path steps analytically.")));
 
   md_data_raw.push_back(MdRecord(
       NAME("ppath_stepRefractionBasic"),
@@ -13640,9 +14040,9 @@ void define_md_data_raw() {
   md_data_raw.push_back(MdRecord(
       NAME("psdD14"),
       DESCRIPTION(
-          "Normalized PSD as proposed in Delanoë et al. ((2014)),\n"
+          "Normalized PSD as proposed in DelanoÃÂ« et al. ((2014)),\n"
           "'Normalized particle size distribution for remote sensing\n"
-          "application', J. Geophys. Res. Atmos., 119, 4204–422.\n"
+          "application', J. Geophys. Res. Atmos., 119, 4204Ã¢ÂÂ422.\n"
           "\n"
           "The PSD has two independent parameters *N0star*, the intercept\n"
           " parameter, and *Dm*, the volume-weighted diameter.\n"
@@ -14120,17 +14520,23 @@ void define_md_data_raw() {
           "over frequency.\n"
           "Important, the first dimension must be the frequency dimension!\n"
           "If a field  like *doit_i_field* is input, the stokes dimension\n"
-          "is also removed.\n"),
+          "is also removed.\n"
+          "The integration uses the trapezoidal rule, or *f_grid_weights* if\n"
+          "they are given.\n"),
       AUTHORS("Manfred Brath"),
       OUT(),
       GOUT("radiation_field"),
       GOUT_TYPE("Tensor4, Tensor5"),
       GOUT_DESC("TBD"),
       IN("f_grid"),
-      GIN("spectral_radiation_field"),
-      GIN_TYPE("Tensor5, Tensor7"),
-      GIN_DEFAULT(NODEF),
-      GIN_DESC("TBD")));
+      GIN("spectral_radiation_field", "f_grid_weights"),
+      GIN_TYPE("Tensor5, Tensor7", "Vector"),
+      GIN_DEFAULT(NODEF, "[]"),
+      GIN_DESC("TBD",
+               "Spectral integration weights. If given, the integral is the\n"
+               "weighted sum over *f_grid*, e.g. for the g-points from\n"
+               "*abs_lookupKDistribution*. If empty, the trapezoidal rule\n"
+               "is used.")));
 
   md_data_raw.push_back(MdRecord(
       NAME("line_irradianceCalcForSingleSpeciesNonOverlappingLines"),
@@ -15954,6 +16360,154 @@ void define_md_data_raw() {
       GIN_DEFAULT(NODEF),
       GIN_DESC("Array of single scattering data file names.")));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("ScatSpeciesTmatrix"),
+      DESCRIPTION(
+          "T-matrix calculations for a set of scattering elements, forming\n"
+          "a new scattering species.\n"
+          "\n"
+          "Performs the same calculations as *scat_data_singleTmatrix* for\n"
+          "each element of *diameter_volume_equ*, *aspect_ratio* and *mass*,\n"
+          "and appends the result as a new scattering species to\n"
+          "*scat_data_raw* and *scat_meta*. See *scat_data_singleTmatrix* for\n"
+          "the definition of the input.\n"
+          "\n"
+          "The calculations are split into one job for each scattering\n"
+          "element, frequency and temperature. As the T-matrix code can not\n"
+          "be run in parallel threads, the jobs are distributed over\n"
+          "*nprocesses* worker processes. The default (0) is to use as many\n"
+          "processes as there are OpenMP threads. Asynchronous output (see\n"
+          "the -a option of arts) is stopped before the worker processes are\n"
+          "started, and all further output is written directly.\n"
+          "\n"
+          "If *cache_dir* is set, the result of each job is stored in that\n"
+          "directory, in a file named after a hash of all input affecting the\n"
+          "result. When the method is run again, only jobs without a stored\n"
+          "result are calculated. This applies also when the grids are\n"
+          "extended or further scattering elements are added. Results of\n"
+          "failed calculations (see *robust*) are not reused. The directory\n"
+          "is created if it does not exist.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("scat_data_raw", "scat_meta"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("scat_data_raw", "scat_meta", "complex_refr_index"),
+      GIN("shape",
+          "diameter_volume_equ",
+          "aspect_ratio",
+          "mass",
+          "ptype",
+          "data_f_grid",
+          "data_t_grid",
+          "data_za_grid",
+          "data_aa_grid",
+          "precision",
+          "cri_source",
+          "ndgs",
+          "robust",
+          "quiet",
+          "cache_dir",
+          "nprocesses"),
+      GIN_TYPE("String",
+               "Vector",
+               "Vector",
+               "Vector",
+               "String",
+               "Vector",
+               "Vector",
+               "Vector",
+               "Vector",
+               "Numeric",
+               "String",
+               "Index",
+               "Index",
+               "Index",
+               "String",
+               "Index"),
+      GIN_DEFAULT(NODEF,
+                  NODEF,
+                  NODEF,
+                  "[]",
+                  NODEF,
+                  NODEF,
+                  NODEF,
+                  NODEF,
+                  "[]",
+                  "0.001",
+                  "Set by user, unknown source.",
+                  "2",
+                  "0",
+                  "1",
+                  "",
+                  "0"),
+      GIN_DESC("Particle shape, see *scat_data_singleTmatrix*.",
+               "Particle volume equivalent diameters [m].",
+               "Particle aspect ratios, one for each diameter.",
+               "Particle masses, one for each diameter. Only included in the"
+               " meta data. If empty, mass is set to NaN.",
+               "Particle type/orientation, see *scat_data_singleTmatrix*.",
+               "Frequency grid of the scattering data to be calculated.",
+               "Temperature grid of the scattering data to be calculated.",
+               "Zenith angle grid of the scattering data to be calculated.",
+               "Azimuth angle grid of the scattering data to be calculated.",
+               "Accuracy of the computations.",
+               "String describing the source of *complex_refr_index*, for"
+               " inclusion in meta data.",
+               "See *scat_data_singleTmatrix*.",
+               "Continue even if individual T-matrix calculations fail. "
+               "Respective scattering element data will be NAN.",
+               "Suppress print output from tmatrix fortran code.",
+               "Directory for stored results. No storage if empty.",
+               "Maximum number of worker processes, 0 for the number of"
+               " OpenMP threads.")));
+
+  md_data_raw.push_back(MdRecord(
+      NAME("ScatteringDatabaseWrite"),
+      DESCRIPTION(
+          "Writes *scat_data_raw* to a scattering database file.\n"
+          "\n"
+          "The file can be opened with *scat_databaseOpen*. It is a binary\n"
+          "file in the native byte order of the machine, to be mapped into\n"
+          "memory. The database holds the scattering elements of all\n"
+          "scattering species, but no meta data.\n"
+          "\n"
+          "See *ScatteringDatabaseWriteFromFiles* for creating the file\n"
+          "without reading all data into *scat_data_raw* first.\n"),
+      AUTHORS("ARTS developers"),
+      OUT(),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("scat_data_raw"),
+      GIN("filename"),
+      GIN_TYPE("String"),
+      GIN_DEFAULT(NODEF),
+      GIN_DESC("Name of the database file.")));
+
+  md_data_raw.push_back(MdRecord(
+      NAME("ScatteringDatabaseWriteFromFiles"),
+      DESCRIPTION(
+          "Writes single scattering data files to a scattering database file.\n"
+          "\n"
+          "As *ScatteringDatabaseWrite*, but the scattering elements are read\n"
+          "one by one from the XML files given by *scat_data_files*, so only a\n"
+          "single element has to be kept in memory. Each element of\n"
+          "*scat_data_files* holds the files of one scattering species, as\n"
+          "given to *ScatSpeciesScatAndMetaRead*.\n"),
+      AUTHORS("ARTS developers"),
+      OUT(),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN(),
+      GIN("filename", "scat_data_files"),
+      GIN_TYPE("String", "ArrayOfArrayOfString"),
+      GIN_DEFAULT(NODEF, NODEF),
+      GIN_DESC("Name of the database file.",
+               "Single scattering data files, one array for each scattering "
+               "species.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("scat_data_singleTmatrix"),
       DESCRIPTION(
@@ -16186,6 +16740,54 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("scat_data_monoFromDatabase"),
+      DESCRIPTION(
+          "Interpolates *scat_database* by frequency to give *scat_data_mono*.\n"
+          "\n"
+          "As *scat_data_monoCalc*, but the data are taken from the scattering\n"
+          "database. Only the data around *f_grid*[*f_index*] are read from the\n"
+          "database file, and the interpolated data are kept in the cache of\n"
+          "*scat_database*. The method can replace *scat_data_monoCalc* in\n"
+          "*doit_mono_agenda*.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("scat_data_mono"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("scat_database", "f_grid", "f_index"),
+      GIN(),
+      GIN_TYPE(),
+      GIN_DEFAULT(),
+      GIN_DESC()));
+
+  md_data_raw.push_back(MdRecord(
+      NAME("scat_databaseOpen"),
+      DESCRIPTION(
+          "Opens a scattering database file.\n"
+          "\n"
+          "The file is mapped into memory, and only the grids of the\n"
+          "scattering elements are read. The optical properties are read and\n"
+          "interpolated when requested by *scat_dataFromDatabase* or\n"
+          "*scat_data_monoFromDatabase*.\n"
+          "\n"
+          "The interpolated data of each scattering element and frequency are\n"
+          "kept in a cache, so that repeated requests, e.g. from several\n"
+          "iterations or batch cases, are not interpolated again. When the\n"
+          "cache exceeds *cache_size*, the oldest data are removed. Set\n"
+          "*cache_size* to 0 to disable the cache.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("scat_database"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN(),
+      GIN("filename", "cache_size"),
+      GIN_TYPE("String", "Numeric"),
+      GIN_DEFAULT(NODEF, "1e9"),
+      GIN_DESC("Name of the database file.",
+               "Maximum size of the cache [bytes].")));
+
   md_data_raw.push_back(MdRecord(
       NAME("scat_dataCalc"),
       DESCRIPTION(
@@ -16239,6 +16841,32 @@ void define_md_data_raw() {
                " see above).",
                "Threshold for allowed albedo deviation (see above).")));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("scat_dataFromDatabase"),
+      DESCRIPTION(
+          "Prepares *scat_data* for the scattering solver from a scattering\n"
+          "database.\n"
+          "\n"
+          "As *scat_dataCalc*, but the data are taken from *scat_database*\n"
+          "instead of *scat_data_raw*. Only the data around the frequencies of\n"
+          "*f_grid* are read from the database file, so the memory use is set\n"
+          "by the size of *f_grid*, not by the frequency grids of the\n"
+          "database. This makes it possible to handle large databases in batch\n"
+          "calculations where each case covers a few frequencies.\n"
+          "\n"
+          "The interpolated data of each scattering element and frequency are\n"
+          "kept in the cache of *scat_database*.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("scat_data"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("scat_database", "f_grid"),
+      GIN("interp_order"),
+      GIN_TYPE("Index"),
+      GIN_DEFAULT("1"),
+      GIN_DESC("Interpolation order.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("scat_dataReduceT"),
       DESCRIPTION(
@@ -17038,6 +17666,53 @@ void define_md_data_raw() {
       GIN_DEFAULT(),
       GIN_DESC()));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("sensor_responseOSSTrain"),
+      DESCRIPTION(
+          "Optimal spectral sampling (OSS) of broadband channels.\n"
+          "\n"
+          "Broadband channels, such as set up by *f_gridFromSensorAMSU*,\n"
+          "*f_gridFromSensorHIRS* or *f_gridMetMM*, require many monochromatic\n"
+          "frequencies. This method selects a few representative frequencies\n"
+          "for each channel, and replaces *f_grid* and *sensor_response* with\n"
+          "a reduced frequency grid and a matching response matrix.\n"
+          "\n"
+          "The selection is trained on an ensemble of monochromatic spectra,\n"
+          "given as *ybatch*. These must be calculated for *f_grid* without\n"
+          "sensor, e.g. by *ybatchCalc* over a set of atmospheres with\n"
+          "*sensorOff* inside *ybatch_calc_agenda*, and with the same\n"
+          "*iy_unit* as the final calculations. The channel values of the\n"
+          "training cases are obtained with the present *sensor_response*.\n"
+          "For each channel, frequencies of the channel response are then\n"
+          "added one at a time, each time taking the one that reduces the\n"
+          "fitting error most. The weights of the selected frequencies are\n"
+          "the least squares fit of the channel values over the training\n"
+          "cases. The selection stops when the RMS fitting error is below\n"
+          "*max_error*, or when *max_nfreq* frequencies are selected.\n"
+          "\n"
+          "The reduced *f_grid* is the union of the frequencies selected for\n"
+          "all channels. The variables describing the sensor output, such as\n"
+          "*sensor_response_f*, are not changed. The RMS fitting error of\n"
+          "each channel is returned in *fit_error*. This error only\n"
+          "describes the training ensemble, the ensemble should hence cover\n"
+          "the range of atmospheric states of the application.\n"
+          "\n"
+          "The method handles only a single polarisation and viewing\n"
+          "direction, i.e. *sensor_response* must have one column per\n"
+          "frequency. Apply it after the backend response is included, but\n"
+          "before antenna and polarisation responses.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("f_grid", "sensor_response"),
+      GOUT("fit_error"),
+      GOUT_TYPE("Vector"),
+      GOUT_DESC("RMS fitting error of each channel, in the unit of *ybatch*."),
+      IN("f_grid", "sensor_response", "ybatch"),
+      GIN("max_error", "max_nfreq"),
+      GIN_TYPE("Numeric", "Index"),
+      GIN_DEFAULT("0.01", "10"),
+      GIN_DESC("Target RMS fitting error, in the unit of *ybatch*.",
+               "Maximum number of frequencies per channel.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("sensor_responsePolarisation"),
       DESCRIPTION(
@@ -17617,7 +18292,7 @@ void define_md_data_raw() {
           "\n"
           "This method computes surface emissivity and reflectivity matrices for\n"
           "ocean surfaces using the TESSEM emissivity model: Prigent, C., et al.\n"
-          "Sea‐surface emissivity parametrization from microwaves to millimetre\n"
+          "SeaÃ¢ÂÂsurface emissivity parametrization from microwaves to millimetre\n"
           "waves, QJRMS, 2017, 143.702: 596-605.\n"
           "\n"
           "The validity range of the parametrization of is 10 to 700 GHz, but for\n"
@@ -17651,7 +18326,7 @@ void define_md_data_raw() {
           "\n"
           "This method uses second version of the TELSEM model for calculating\n"
           "land surface emissivities (F. Aires et al, \"A Tool to Estimate \n"
-          " Land‐Surface Emissivities at Microwave frequencies (TELSEM) for use\n"
+          " LandÃ¢ÂÂSurface Emissivities at Microwave frequencies (TELSEM) for use\n"
           " in numerical weather prediction\" Quarterly Journal of the Royal\n"
           "Meteorological Society, vol. 137, (656), pp. 690-699, 2011.)\n"
           "This methods computes land surface emissivities for a given pencil beam\n"
@@ -18397,6 +19072,39 @@ void define_md_data_raw() {
                "The maximum allowed distance for nearest neighbor"
                " interpolation in meters.")));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("telsemStandaloneBatch"),
+      DESCRIPTION(
+          "Batched stand-alone evaluation of the Telsem model.\n"
+          "\n"
+          "As *telsemStandalone*, but evaluates the model for a whole set\n"
+          "of queries in one pass. Each query is given by the corresponding\n"
+          "elements of *lat*, *lon*, *theta* and *f*, which must all have\n"
+          "the same length. The queries are processed in parallel.\n"
+          "\n"
+          "Row i of the output holds the v and h emissivity of query i.\n"
+          "\n"
+          "Atlases read with *telsem_atlasReadAscii* can be stored in binary\n"
+          "XML format with *WriteXML*, which is much faster to read back\n"
+          "with *ReadXML* than the original ASCII files.\n"),
+      AUTHORS("ARTS developers"),
+      OUT(),
+      GOUT("emissivities"),
+      GOUT_TYPE("Matrix"),
+      GOUT_DESC("The computed v and h emissivites, one row per query."),
+      IN(),
+      GIN("lat", "lon", "theta", "f", "ta", "d_max"),
+      GIN_TYPE(
+          "Vector", "Vector", "Vector", "Vector", "TelsemAtlas", "Numeric"),
+      GIN_DEFAULT(NODEF, NODEF, NODEF, NODEF, NODEF, "-1"),
+      GIN_DESC("The latitudes of the queries.",
+               "The longitudes of the queries.",
+               "The incidence angles of the queries.",
+               "The frequencies of the queries.",
+               "The Telsem atlas to use.",
+               "The maximum allowed distance for nearest neighbor"
+               " interpolation in meters.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("telsemAtlasLookup"),
       DESCRIPTION(
@@ -20284,6 +20992,44 @@ void define_md_data_raw() {
                "(out1 output stream), and the *y* Vector entry for the\n"
                "failed job in *ybatch* is left empty.")));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("ybatchCalcToFile"),
+      DESCRIPTION(
+          "As *ybatchCalc*, but the results are written to a file instead of\n"
+          "being kept in memory.\n"
+          "\n"
+          "The jobs are performed as in *ybatchCalc*. The *y*, *y_aux* and\n"
+          "*jacobian* of each completed job are passed to a separate thread\n"
+          "that appends them to *filename*, together with the job index\n"
+          "(*ybatch_index*). The queue between the calculations and the\n"
+          "writing is short, so the memory needed does not grow with\n"
+          "*ybatch_n*.\n"
+          "\n"
+          "If *filename* already exists, the new results are appended and\n"
+          "jobs found in the file are not calculated again. An interrupted\n"
+          "batch calculation can thus be continued by just repeating the\n"
+          "call. Failed jobs are not stored and are repeated at the next\n"
+          "call. An incomplete record left by an interruption is removed.\n"
+          "*ybatch_start*, *ybatch_n* and *ybatch_calc_agenda* are stored in\n"
+          "the file, and an existing file is only continued if these match.\n"
+          "\n"
+          "The results are stored in the order the jobs were completed. Use\n"
+          "*ybatchReadFile* to read them back. The file format is binary,\n"
+          "in native byte order, and is described in ybatch_file.h.\n"),
+      AUTHORS("ARTS developers"),
+      OUT(),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("ybatch_start", "ybatch_n", "ybatch_calc_agenda"),
+      GIN("filename", "robust"),
+      GIN_TYPE("String", "Index"),
+      GIN_DEFAULT(NODEF, "0"),
+      GIN_DESC("Name of the output file.",
+               "A flag with value 1 or 0. If set to one, the batch\n"
+               "calculation will continue, even if individual jobs fail.\n"
+               "Failed jobs are not written to the file.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("ybatchMetProfiles"),
       DESCRIPTION(
@@ -20369,6 +21115,25 @@ void define_md_data_raw() {
       GIN_DEFAULT(NODEF, NODEF),
       GIN_DESC("FIXME DOC", "FIXME DOC")));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("ybatchReadFile"),
+      DESCRIPTION(
+          "Reads results of batch calculations written by *ybatchCalcToFile*.\n"
+          "\n"
+          "Job *ybatch_start* + i is stored at position i of *ybatch*,\n"
+          "*ybatch_aux* and *ybatch_jacobians*, as *ybatchCalc* does. Jobs\n"
+          "missing in the file give empty entries.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("ybatch", "ybatch_aux", "ybatch_jacobians"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("ybatch_start", "ybatch_n"),
+      GIN("filename"),
+      GIN_TYPE("String"),
+      GIN_DEFAULT(NODEF),
+      GIN_DESC("Name of the input file.")));
+
   md_data_raw.push_back(MdRecord(
       NAME("yCalc"),
       DESCRIPTION(
@@ -20537,6 +21302,99 @@ void define_md_data_raw() {
                "Flag controlling if instrumental weighting functions are "
                "appended or treated as different retrieval quantities.")));
 
+  md_data_raw.push_back(MdRecord(
+      NAME("yCalcCached"),
+      DESCRIPTION(
+          "As *yCalc* but reuses monochromatic results of earlier calls.\n"
+          "\n"
+          "The method is intended for *inversion_iterate_agenda*. The pencil\n"
+          "beam data (*iyb*), the analytical part of the Jacobian and the\n"
+          "auxiliary data of all measurement blocks are stored in *iyb_cache*,\n"
+          "together with a key describing the state they were calculated for.\n"
+          "If the key matches in the next call, no radiative transfer is\n"
+          "performed and *y* and *jacobian* are obtained by applying the\n"
+          "present *sensor_response* and *jacobian_agenda* on the stored data.\n"
+          "\n"
+          "The key consists of *atmosphere_dim*, *stokes_dim*, *cloudbox_on*,\n"
+          "*iy_unit*, *t_field*, *z_field*, *vmr_field*, *nlte_field*, the\n"
+          "wind and magnetic fields, *z_surface*, *pnd_field*, *f_grid*,\n"
+          "*sensor_pos*, *sensor_los*, *transmitter_pos*, *mblock_dlos_grid*,\n"
+          "*jacobian_do*, the ranges of the retrieval quantities and all\n"
+          "elements of *x* not belonging to baseline fits, frequency shift or\n"
+          "stretch, or pointing. Iterations where only these instrument\n"
+          "parameters change are then served from the cache, with the\n"
+          "exception of pointing as it changes *sensor_los*. The same applies\n"
+          "to a repeated evaluation of a state, e.g. after a rejected\n"
+          "Levenberg-Marquardt step.\n"
+          "\n"
+          "Other variables affecting the radiative transfer are not part of\n"
+          "the key. This concerns the spectroscopy (e.g. *abs_lookup* and\n"
+          "*abs_lines_per_species*), surface properties other than *z_surface*\n"
+          "(e.g. *t_surface*, *surface_props_data* and variables only used\n"
+          "inside the surface agendas), the scattering data and the agendas\n"
+          "themselves. These must either be constant or be mapped from *x*.\n"
+          "If any of them is changed between calls, the cache must be cleared\n"
+          "by *Delete* followed by *Touch* on *iyb_cache*.\n"
+          "\n"
+          "The cache can be used by several threads, e.g. inside\n"
+          "*ybatch_calc_agenda*. *iyb_cache* must be initialised before *OEM*\n"
+          "is called, e.g. by *Touch*.\n"),
+      AUTHORS("ARTS developers"),
+      OUT("y",
+          "y_f",
+          "y_pol",
+          "y_pos",
+          "y_los",
+          "y_aux",
+          "y_geo",
+          "jacobian",
+          "iyb_cache"),
+      GOUT(),
+      GOUT_TYPE(),
+      GOUT_DESC(),
+      IN("iyb_cache",
+         "x",
+         "atmgeom_checked",
+         "atmfields_checked",
+         "atmosphere_dim",
+         "t_field",
+         "z_field",
+         "vmr_field",
+         "nlte_field",
+         "wind_u_field",
+         "wind_v_field",
+         "wind_w_field",
+         "mag_u_field",
+         "mag_v_field",
+         "mag_w_field",
+         "z_surface",
+         "cloudbox_on",
+         "cloudbox_checked",
+         "pnd_field",
+         "scat_data_checked",
+         "sensor_checked",
+         "stokes_dim",
+         "f_grid",
+         "sensor_pos",
+         "sensor_los",
+         "transmitter_pos",
+         "mblock_dlos_grid",
+         "sensor_response",
+         "sensor_response_f",
+         "sensor_response_pol",
+         "sensor_response_dlos",
+         "iy_unit",
+         "iy_main_agenda",
+         "geo_pos_agenda",
+         "jacobian_agenda",
+         "jacobian_do",
+         "jacobian_quantities",
+         "iy_aux_vars"),
+      GIN(),
+      GIN_TYPE(),
+      GIN_DEFAULT(),
+      GIN_DESC()));
+
   md_data_raw.push_back(MdRecord(
       NAME("yActive"),
       DESCRIPTION(
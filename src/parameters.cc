@@ -115,6 +115,7 @@ bool get_parameters(int argc, char **argv) {
     };              
   */
   struct option longopts[] = {
+      {"asynclog", optional_argument, NULL, 'a'},
       {"basename", required_argument, NULL, 'b'},
       {"describe", required_argument, NULL, 'd'},
       {"groups", no_argument, NULL, 'g'},
@@ -127,6 +128,7 @@ bool get_parameters(int argc, char **argv) {
       {"outdir", required_argument, NULL, 'o'},
       {"plain", no_argument, NULL, 'p'},
       {"reporting", required_argument, NULL, 'r'},
+      {"socket", required_argument, NULL, 'u'},
 #ifdef ENABLE_DOCSERVER
       {"docserver", optional_argument, NULL, 's'},
       {"docdaemon", optional_argument, NULL, 'S'},
@@ -137,7 +139,8 @@ bool get_parameters(int argc, char **argv) {
       {NULL, no_argument, NULL, 0}};
 
   parameters.usage =
-      "Usage: arts [-bBdghimnrsSvw]\n"
+      "Usage: arts [-abBdghimnrsSuvw]\n"
+      "       [--asynclog[=ti]]\n"
       "       [--basename <name>]\n"
       "       [--describe <method or variable>]\n"
       "       [--groups]\n"
@@ -150,6 +153,7 @@ bool get_parameters(int argc, char **argv) {
       "       [--outdir <name>]\n"
       "       [--plain]\n"
       "       [--reporting <xyz>]\n"
+      "       [--socket <path>]\n"
 #ifdef ENABLE_DOCSERVER
       "       [--docserver[=<port>] --baseurl=BASEURL]\n"
       "       [--docdaemon[=<port>] --baseurl=BASEURL]\n"
@@ -159,6 +163,12 @@ bool get_parameters(int argc, char **argv) {
 
   parameters.helptext =
       "The Atmospheric Radiative Transfer Simulator.\n\n"
+      "-a, --asynclog      Write screen and report file output from a\n"
+      "                    background thread. Messages are collected line\n"
+      "                    by line for each thread, so output of parallel\n"
+      "                    calculations is not interleaved. Optionally, add\n"
+      "                    t to prefix each line with a timestamp and i to\n"
+      "                    prefix it with the thread id, e.g. arts -ati.\n"
       "-b, --basename      Set the basename for the report\n"
       "                    file and for other output files.\n"
       "-d, --describe      Print the description String of the given\n"
@@ -203,6 +213,11 @@ bool get_parameters(int argc, char **argv) {
       "                    The agenda setting applies in addition to both\n"
       "                    screen and file output.\n"
       "                    Default is 010.\n"
+      "-u, --socket        Run as daemon. The control file is executed once,\n"
+      "                    then requests are executed on copies of the\n"
+      "                    resulting workspace. Requests are accepted on the\n"
+      "                    Unix domain socket with the given path. See\n"
+      "                    arts_daemon.h for the protocol.\n"
 #ifdef ENABLE_DOCSERVER
       "-s, --docserver     Start documentation server. Optionally, specify\n"
       "                    the port number the server should listen on,\n"
@@ -257,6 +272,21 @@ bool get_parameters(int argc, char **argv) {
                      argc, argv, shortopts.c_str(), longopts, (int *)0))) {
     //      cout << "optc = " << optc << '\n';
     switch (optc) {
+      case 'a':
+        parameters.asynclog = true;
+        if (optarg) {
+          const String flags = optarg;
+          if (flags.find_first_not_of("ti") != std::string::npos) {
+            cerr << "Argument to --asynclog (-a) can only contain the "
+                 << "characters t and i!\n";
+            arts_exit();
+          }
+          parameters.asynclog_timestamps =
+              flags.find('t') != std::string::npos;
+          parameters.asynclog_threadids =
+              flags.find('i') != std::string::npos;
+        }
+        break;
       case 'h':
         parameters.help = true;
         break;
@@ -340,6 +370,9 @@ bool get_parameters(int argc, char **argv) {
         parameters.daemon = true;
         break;
       }
+      case 'u':
+        parameters.socket = optarg;
+        break;
       case 'U':
         parameters.baseurl = optarg;
         break;
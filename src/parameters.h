@@ -64,7 +64,11 @@ class Parameters {
         docserver(0),
         baseurl(""),
         daemon(false),
-        gui(false) { /* Nothing to be done here */
+        socket(""),
+        gui(false),
+        asynclog(false),
+        asynclog_timestamps(false),
+        asynclog_threadids(false) { /* Nothing to be done here */
   }
 
   /** Short message how to call the program. */
@@ -126,8 +130,17 @@ class Parameters {
   String baseurl;
   /** Flag to run the docserver in the background. */
   bool daemon;
+  /** Unix domain socket to serve requests on after executing the
+      controlfile. */
+  String socket;
   /** Flag to run with graphical user interface. */
   bool gui;
+  /** Flag to write messages from a background thread. */
+  bool asynclog;
+  /** Prefix asynchronous messages with a timestamp. */
+  bool asynclog_timestamps;
+  /** Prefix asynchronous messages with the thread id. */
+  bool asynclog_threadids;
 };
 
 /**
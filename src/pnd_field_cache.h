@@ -0,0 +1,50 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   pnd_field_cache.h
+
+  \brief  Storage of *pnd_field* and *dpnd_field_dx* between calls of
+          *pnd_fieldCalcFromParticleBulkPropsCached*.
+
+  The fields are keyed on the atmospheric state, the scattering species and
+  the pnd agendas they were calculated for.
+*/
+
+#ifndef pnd_field_cache_h
+#define pnd_field_cache_h
+
+#include <ostream>
+#include "array.h"
+#include "keyed_cache.h"
+#include "matpackIV.h"
+
+//! Particle number density fields and their derivatives.
+struct PndFieldData {
+  Tensor4 pnd_field;
+  ArrayOfTensor4 dpnd_field_dx;
+};
+
+class PndFieldCache : public KeyedCache<PndFieldData> {};
+
+inline std::ostream& operator<<(std::ostream& os, const PndFieldCache& c) {
+  os << "PndFieldCache: " << (c.value() ? "" : "(empty) ") << c.hits()
+     << " hits, " << c.misses() << " misses";
+  return os;
+}
+
+#endif /* pnd_field_cache_h */
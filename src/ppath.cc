@@ -3192,6 +3192,206 @@ void ppath_step_geom_2d(Ppath& ppath,
                ppc);
 }
 
+//! gridcell_3d_path_points
+/*!
+    Creates the path points of a geometrical step through a 3D grid cell.
+
+    Helper for do_gridcell_3d_byltest and do_gridcell_3d_analytic. The
+    points are evenly spaced along the step of length *l_end*, and the last
+    one is moved to *endface*. If *unsafe* is true, the points in between
+    are checked to be inside the cell. If this fails, false is returned and
+    *l* holds the length to the failing point.
+
+    \author Patrick Eriksson
+    \date   2002-11-28
+*/
+static bool gridcell_3d_path_points(Vector& r_v,
+                                    Vector& lat_v,
+                                    Vector& lon_v,
+                                    Vector& za_v,
+                                    Vector& aa_v,
+                                    Numeric& lstep,
+                                    Numeric& l,
+                                    const Index& endface,
+                                    const Numeric& l_end,
+                                    const bool& unsafe,
+                                    const bool& do_surface,
+                                    const Numeric& x,
+                                    const Numeric& y,
+                                    const Numeric& z,
+                                    const Numeric& dx,
+                                    const Numeric& dy,
+                                    const Numeric& dz,
+                                    const Numeric& r_start,
+                                    const Numeric& lat_start,
+                                    const Numeric& lon_start,
+                                    const Numeric& za_start,
+                                    const Numeric& aa_start,
+                                    const Numeric& ppc,
+                                    const Numeric& lmax,
+                                    const Numeric& lat1,
+                                    const Numeric& lat3,
+                                    const Numeric& lon5,
+                                    const Numeric& lon6,
+                                    const Numeric& r15a,
+                                    const Numeric& r35a,
+                                    const Numeric& r36a,
+                                    const Numeric& r16a,
+                                    const Numeric& r15b,
+                                    const Numeric& r35b,
+                                    const Numeric& r36b,
+                                    const Numeric& r16b,
+                                    const Numeric& rsurface15,
+                                    const Numeric& rsurface35,
+                                    const Numeric& rsurface36,
+                                    const Numeric& rsurface16) {
+  Numeric rlow, rupp;
+
+  //--- Create return vectors
+  //
+  Index n = 1;
+  //
+  if (lmax > 0) {
+    n = Index(ceil(abs(l_end / lmax)));
+    if (n < 1) {
+      n = 1;
+    }
+  }
+  //
+  r_v.resize(n + 1);
+  lat_v.resize(n + 1);
+  lon_v.resize(n + 1);
+  za_v.resize(n + 1);
+  aa_v.resize(n + 1);
+  //
+  r_v[0] = r_start;
+  lat_v[0] = lat_start;
+  lon_v[0] = lon_start;
+  za_v[0] = za_start;
+  aa_v[0] = aa_start;
+  //
+  lstep = l_end / (Numeric)n;
+  bool ready = true;
+  //
+  for (Index j = 1; j <= n; j++) {
+    l = lstep * (Numeric)j;
+    cart2poslos(r_v[j],
+                lat_v[j],
+                lon_v[j],
+                za_v[j],
+                aa_v[j],
+                x + dx * l,
+                y + dy * l,
+                z + dz * l,
+                dx,
+                dy,
+                dz,
+                ppc,
+                x,
+                y,
+                z,
+                lat_start,
+                lon_start,
+                za_start,
+                aa_start);
+
+    // Shall lon values be shifted (value 0 is already OK)?
+    resolve_lon(lon_v[j], lon5, lon6);
+
+    if (j < n) {
+      if (unsafe) {
+        // Check that r_v[j] is above lower pressure level and the
+        // surface. This can fail around tangent points. For p-levels
+        // with constant r this is easy to handle analytically, but the
+        // problem is tricky in the general case with a non-spherical
+        // geometry, and this crude solution is used instead. Not the
+        // most elegant solution, but it works! Added later the same
+        // check for upper level, after getting assert in that direction.
+        // The z_field was crazy, but still formerly correct.
+        rlow = rsurf_at_latlon(
+            lat1, lat3, lon5, lon6, r15a, r35a, r36a, r16a, lat_v[j], lon_v[j]);
+        if (do_surface) {
+          const Numeric r_surface = rsurf_at_latlon(lat1,
+                                                    lat3,
+                                                    lon5,
+                                                    lon6,
+                                                    rsurface15,
+                                                    rsurface35,
+                                                    rsurface36,
+                                                    rsurface16,
+                                                    lat_v[j],
+                                                    lon_v[j]);
+          const Numeric r_test = max(r_surface, rlow);
+          if (r_v[j] < r_test) {
+            ready = false;
+            break;
+          }
+        } else if (r_v[j] < rlow) {
+          ready = false;
+          break;
+        }
+
+        rupp = rsurf_at_latlon(
+            lat1, lat3, lon5, lon6, r15b, r35b, r36b, r16b, lat_v[j], lon_v[j]);
+        if (r_v[j] > rupp) {
+          ready = false;
+          break;
+        }
+      }
+    } else  // j==n
+    {
+      if (unsafe) {
+        // Set end point to be consistent with found endface.
+        //
+        if (endface == 1) {
+          lat_v[n] = lat1;
+        } else if (endface == 2) {
+          r_v[n] = rsurf_at_latlon(lat1,
+                                   lat3,
+                                   lon5,
+                                   lon6,
+                                   r15a,
+                                   r35a,
+                                   r36a,
+                                   r16a,
+                                   lat_v[n],
+                                   lon_v[n]);
+        } else if (endface == 3) {
+          lat_v[n] = lat3;
+        } else if (endface == 4) {
+          r_v[n] = rsurf_at_latlon(lat1,
+                                   lat3,
+                                   lon5,
+                                   lon6,
+                                   r15b,
+                                   r35b,
+                                   r36b,
+                                   r16b,
+                                   lat_v[n],
+                                   lon_v[n]);
+        } else if (endface == 5) {
+          lon_v[n] = lon5;
+        } else if (endface == 6) {
+          lon_v[n] = lon6;
+        } else if (endface == 7) {
+          r_v[n] = rsurf_at_latlon(lat1,
+                                   lat3,
+                                   lon5,
+                                   lon6,
+                                   rsurface15,
+                                   rsurface35,
+                                   rsurface36,
+                                   rsurface16,
+                                   lat_v[n],
+                                   lon_v[n]);
+        }
+      }
+    }
+  }
+
+  return ready;
+}
+
 //! do_gridcell_3d_byltest
 /*!
     See ATD for a description of the algorithm.
@@ -3462,150 +3662,576 @@ void do_gridcell_3d_byltest(Vector& r_v,
     }
   }
 
-  //--- Create return vectors
-  //
-  Index n = 1;
-  //
-  if (lmax > 0) {
-    n = Index(ceil(abs(l_end / lmax)));
-    if (n < 1) {
-      n = 1;
+  Numeric l;
+  const bool ready = gridcell_3d_path_points(r_v,
+                                             lat_v,
+                                             lon_v,
+                                             za_v,
+                                             aa_v,
+                                             lstep,
+                                             l,
+                                             endface,
+                                             l_end,
+                                             unsafe,
+                                             do_surface,
+                                             x,
+                                             y,
+                                             z,
+                                             dx,
+                                             dy,
+                                             dz,
+                                             r_start,
+                                             lat_start,
+                                             lon_start,
+                                             za_start,
+                                             aa_start,
+                                             ppc,
+                                             lmax,
+                                             lat1,
+                                             lat3,
+                                             lon5,
+                                             lon6,
+                                             r15a,
+                                             r35a,
+                                             r36a,
+                                             r16a,
+                                             r15b,
+                                             r35b,
+                                             r36b,
+                                             r16b,
+                                             rsurface15,
+                                             rsurface35,
+                                             rsurface36,
+                                             rsurface16);
+
+  if (!ready) {  // If an "outside" point found, restart with l as start search length
+    do_gridcell_3d_byltest(r_v,
+                           lat_v,
+                           lon_v,
+                           za_v,
+                           aa_v,
+                           lstep,
+                           endface,
+                           r_start,
+                           lat_start,
+                           lon_start,
+                           za_start,
+                           aa_start,
+                           l,
+                           icall + 1,
+                           ppc,
+                           lmax,
+                           lat1,
+                           lat3,
+                           lon5,
+                           lon6,
+                           r15a,
+                           r35a,
+                           r36a,
+                           r16a,
+                           r15b,
+                           r35b,
+                           r36b,
+                           r16b,
+                           rsurface15,
+                           rsurface35,
+                           rsurface36,
+                           rsurface16);
+  }
+}
+
+//! gridcell_3d_lat_crossing
+/*!
+    Length along a straight line to where it leaves a 3D grid cell through
+    a face of constant latitude.
+
+    The face is a cone (or the equatorial plane) and the crossing is
+    obtained by solving a quadratic equation. Only crossings where the
+    latitude changes in the direction out of the cell are considered.
+
+    \param   x       x-coordinate of the start point.
+    \param   y       y-coordinate of the start point.
+    \param   z       z-coordinate of the start point.
+    \param   dx      x-part of the LOS unit vector.
+    \param   dy      y-part of the LOS unit vector.
+    \param   dz      z-part of the LOS unit vector.
+    \param   lat     Latitude of the face.
+    \param   upper   True if the face is the upper latitude end of the cell.
+    \return          The length, or L_NOT_FOUND.
+
+    \author ARTS developers
+    \date   2020-06-02
+*/
+static Numeric gridcell_3d_lat_crossing(const Numeric& x,
+                                        const Numeric& y,
+                                        const Numeric& z,
+                                        const Numeric& dx,
+                                        const Numeric& dy,
+                                        const Numeric& dz,
+                                        const Numeric& lat,
+                                        const bool& upper) {
+  const Numeric s = sin(DEG2RAD * lat);
+  const Numeric s2 = s * s;
+  const Numeric pd = x * dx + y * dy + z * dz;
+  const Numeric r2 = x * x + y * y + z * z;
+
+  // Roots of (z+dz*l)^2 = s^2*|p+d*l|^2
+  Numeric roots[2];
+  Index nroots = 0;
+  const Numeric a = dz * dz - s2;
+  const Numeric b = 2 * (z * dz - s2 * pd);
+  const Numeric c = z * z - s2 * r2;
+  if (abs(a) < 1e-12) {
+    if (b != 0) {
+      roots[nroots++] = -c / b;
     }
+  } else {
+    const Numeric disc = b * b - 4 * a * c;
+    if (disc >= 0) {
+      // Numerically stable form of the quadratic formula
+      const Numeric q = -0.5 * (b + (b >= 0 ? 1 : -1) * sqrt(disc));
+      roots[nroots++] = q / a;
+      if (q != 0) {
+        roots[nroots++] = c / q;
+      }
+    }
+  }
+
+  Numeric l_cross = L_NOT_FOUND;
+  for (Index i = 0; i < nroots; i++) {
+    const Numeric l = roots[i];
+    if (l <= 0 || l >= l_cross) {
+      continue;
+    }
+    // Squaring the equation gives also the mirrored cone
+    const Numeric zl = z + dz * l;
+    if (s != 0 && (zl > 0) != (s > 0)) {
+      continue;
+    }
+    // Derivative of sin(lat) along the line has the sign of
+    // dz*|p|^2 - z*(p.d), evaluated at the crossing
+    const Numeric pdl = pd + l;
+    const Numeric r2l = r2 + 2 * pd * l + l * l;
+    const Numeric dlat = dz * r2l - zl * pdl;
+    if ((upper && dlat > 0) || (!upper && dlat < 0)) {
+      l_cross = l;
+    }
+  }
+  return l_cross;
+}
+
+//! gridcell_3d_lon_crossing
+/*!
+    As gridcell_3d_lat_crossing, but for a face of constant longitude.
+
+    The face is a half-plane bounded by the polar axis, giving a linear
+    equation.
+
+    \author ARTS developers
+    \date   2020-06-02
+*/
+static Numeric gridcell_3d_lon_crossing(const Numeric& x,
+                                        const Numeric& y,
+                                        const Numeric& dx,
+                                        const Numeric& dy,
+                                        const Numeric& lon,
+                                        const bool& upper) {
+  const Numeric slon = sin(DEG2RAD * lon);
+  const Numeric clon = cos(DEG2RAD * lon);
+
+  // Normal of the plane, pointing towards increasing longitude
+  const Numeric dn = -slon * dx + clon * dy;
+  if ((upper && dn <= 0) || (!upper && dn >= 0)) {
+    return L_NOT_FOUND;
+  }
+
+  const Numeric l = (slon * x - clon * y) / dn;
+  if (l <= 0) {
+    return L_NOT_FOUND;
+  }
+
+  // The plane also holds the half-plane of lon+180
+  if (clon * (x + dx * l) + slon * (y + dy * l) <= 0) {
+    return L_NOT_FOUND;
+  }
+  return l;
+}
+
+//! do_gridcell_3d_analytic
+/*!
+    Works as do_gridcell_3d_byltest, but determines the end point of the
+    path step without a search along the path.
+
+    The crossings with the latitude and longitude faces are obtained
+    analytically. The pressure levels and the surface are bilinear in
+    latitude and longitude. Their crossings are bracketed using that the
+    distance to them is close to convex (lower level and surface) or
+    concave (upper level) along the path, and are then found by a regula
+    falsi (Illinois) search. Cases where this is not applicable
+    (zenith and nadir looking, north-south paths and cells at the poles)
+    and the rare cases where the result fails the checks of
+    do_gridcell_3d_byltest are handed over to that function.
+
+    \author ARTS developers
+    \date   2020-06-02
+*/
+void do_gridcell_3d_analytic(Vector& r_v,
+                             Vector& lat_v,
+                             Vector& lon_v,
+                             Vector& za_v,
+                             Vector& aa_v,
+                             Numeric& lstep,
+                             Index& endface,
+                             const Numeric& r_start0,
+                             const Numeric& lat_start0,
+                             const Numeric& lon_start0,
+                             const Numeric& za_start,
+                             const Numeric& aa_start,
+                             const Numeric& ppc,
+                             const Numeric& lmax,
+                             const Numeric& lat1,
+                             const Numeric& lat3,
+                             const Numeric& lon5,
+                             const Numeric& lon6,
+                             const Numeric& r15a,
+                             const Numeric& r35a,
+                             const Numeric& r36a,
+                             const Numeric& r16a,
+                             const Numeric& r15b,
+                             const Numeric& r35b,
+                             const Numeric& r36b,
+                             const Numeric& r16b,
+                             const Numeric& rsurface15,
+                             const Numeric& rsurface35,
+                             const Numeric& rsurface36,
+                             const Numeric& rsurface16) {
+  // Special cases, handled by the general function
+  if (za_start < ANGTOL || za_start > 180 - ANGTOL ||
+      abs(aa_start) < ANGTOL || abs(aa_start) > 180 - ANGTOL ||
+      abs(lat1) >= POLELAT || abs(lat3) >= POLELAT || lon6 - lon5 >= 360) {
+    do_gridcell_3d_byltest(r_v,
+                           lat_v,
+                           lon_v,
+                           za_v,
+                           aa_v,
+                           lstep,
+                           endface,
+                           r_start0,
+                           lat_start0,
+                           lon_start0,
+                           za_start,
+                           aa_start,
+                           -1,
+                           0,
+                           ppc,
+                           lmax,
+                           lat1,
+                           lat3,
+                           lon5,
+                           lon6,
+                           r15a,
+                           r35a,
+                           r36a,
+                           r16a,
+                           r15b,
+                           r35b,
+                           r36b,
+                           r16b,
+                           rsurface15,
+                           rsurface35,
+                           rsurface36,
+                           rsurface16);
+    return;
   }
+
+  // Shift start position inside the cell, as do_gridcell_3d_byltest
+  Numeric r_start = r_start0;
+  Numeric lat_start = min(max(lat_start0, lat1), lat3);
+  Numeric lon_start = min(max(lon_start0, lon5), lon6);
   //
-  r_v.resize(n + 1);
-  lat_v.resize(n + 1);
-  lon_v.resize(n + 1);
-  za_v.resize(n + 1);
-  aa_v.resize(n + 1);
+  const Numeric rlow0 = rsurf_at_latlon(
+      lat1, lat3, lon5, lon6, r15a, r35a, r36a, r16a, lat_start, lon_start);
+  const Numeric rupp0 = rsurf_at_latlon(
+      lat1, lat3, lon5, lon6, r15b, r35b, r36b, r16b, lat_start, lon_start);
+  r_start = min(max(r_start, rlow0), rupp0);
+
+  // Position and LOS in cartesian coordinates
+  Numeric x, y, z, dx, dy, dz;
+  poslos2cart(
+      x, y, z, dx, dy, dz, r_start, lat_start, lon_start, za_start, aa_start);
+
+  // Correction terms, as in do_gridcell_3d_byltest
+  Numeric r_corr, lat_corr, lon_corr;
+  cart2sph(r_corr,
+           lat_corr,
+           lon_corr,
+           x,
+           y,
+           z,
+           lat_start,
+           lon_start,
+           za_start,
+           aa_start);
+  r_corr -= r_start;
+  lat_corr -= lat_start;
+  lon_corr -= lon_start;
+
+  const bool do_surface =
+      rsurface15 + RTOL >= r15a || rsurface35 + RTOL >= r35a ||
+      rsurface36 + RTOL >= r36a || rsurface16 + RTOL >= r16a;
+
+  // Distance to a boundary at a length along the path, positive inside
+  // the cell. The boundaries are coded by their endface: 2 for the lower
+  // pressure level, 4 for the upper one and 7 for the surface.
+  auto boundary_distance = [&](const Numeric& l, const Index& face) {
+    Numeric r, lat, lon;
+    cart2sph(r,
+             lat,
+             lon,
+             x + dx * l,
+             y + dy * l,
+             z + dz * l,
+             lat_start,
+             lon_start,
+             za_start,
+             aa_start);
+    r -= r_corr;
+    lat -= lat_corr;
+    lon -= lon_corr;
+    resolve_lon(lon, lon5, lon6);
+
+    if (face == 2) {
+      return r - rsurf_at_latlon(
+                     lat1, lat3, lon5, lon6, r15a, r35a, r36a, r16a, lat, lon);
+    } else if (face == 4) {
+      return rsurf_at_latlon(
+                 lat1, lat3, lon5, lon6, r15b, r35b, r36b, r16b, lat, lon) -
+             r;
+    }
+    return r - rsurf_at_latlon(lat1,
+                               lat3,
+                               lon5,
+                               lon6,
+                               rsurface15,
+                               rsurface35,
+                               rsurface36,
+                               rsurface16,
+                               lat,
+                               lon);
+  };
+
+  // Exit through the latitude and longitude faces
   //
-  r_v[0] = r_start;
-  lat_v[0] = lat_start;
-  lon_v[0] = lon_start;
-  za_v[0] = za_start;
-  aa_v[0] = aa_start;
+  Numeric l_end = L_NOT_FOUND;
+  endface = 0;
+  {
+    const Numeric l1 =
+        gridcell_3d_lat_crossing(x, y, z, dx, dy, dz, lat1, false);
+    const Numeric l3 = gridcell_3d_lat_crossing(x, y, z, dx, dy, dz, lat3, true);
+    const Numeric l5 = gridcell_3d_lon_crossing(x, y, dx, dy, lon5, false);
+    const Numeric l6 = gridcell_3d_lon_crossing(x, y, dx, dy, lon6, true);
+    if (l1 < l_end) {
+      l_end = l1;
+      endface = 1;
+    }
+    if (l3 < l_end) {
+      l_end = l3;
+      endface = 3;
+    }
+    if (l5 < l_end) {
+      l_end = l5;
+      endface = 5;
+    }
+    if (l6 < l_end) {
+      l_end = l6;
+      endface = 6;
+    }
+  }
+
+  // Exit through the pressure levels or the surface, before l_end
   //
-  lstep = l_end / (Numeric)n;
-  Numeric l;
-  bool ready = true;
+  // Along the path the radius is convex in the length, while the
+  // boundaries are close to linear inside a grid cell. The distance to the
+  // upper level is then concave and can only be crossed once, if negative
+  // at l_end. The distance to the lower level and the surface is convex.
+  // If it is positive at l_end, the path can still dip below the boundary
+  // and come back. The minimum is then searched for (golden section) and
+  // a crossing is bracketed by the start and any point found below the
+  // boundary. The first crossing inside each bracket is found by regula
+  // falsi (Illinois).
   //
-  for (Index j = 1; j <= n; j++) {
-    l = lstep * (Numeric)j;
-    cart2poslos(r_v[j],
-                lat_v[j],
-                lon_v[j],
-                za_v[j],
-                aa_v[j],
-                x + dx * l,
-                y + dy * l,
-                z + dz * l,
-                dx,
-                dy,
-                dz,
-                ppc,
-                x,
-                y,
-                z,
-                lat_start,
-                lon_start,
-                za_start,
-                aa_start);
-
-    // Shall lon values be shifted (value 0 is already OK)?
-    resolve_lon(lon_v[j], lon5, lon6);
+  bool found = endface > 0;
+  if (found) {
+    ArrayOfIndex faces(1, 2);
+    faces.push_back(4);
+    if (do_surface) {
+      faces.push_back(7);
+    }
 
-    if (j < n) {
-      if (unsafe) {
-        // Check that r_v[j] is above lower pressure level and the
-        // surface. This can fail around tangent points. For p-levels
-        // with constant r this is easy to handle analytically, but the
-        // problem is tricky in the general case with a non-spherical
-        // geometry, and this crude solution is used instead. Not the
-        // most elegant solution, but it works! Added later the same
-        // check for upper level, after getting assert in that direction.
-        // The z_field was crazy, but still formerly correct.
-        rlow = rsurf_at_latlon(
-            lat1, lat3, lon5, lon6, r15a, r35a, r36a, r16a, lat_v[j], lon_v[j]);
-        if (do_surface) {
-          const Numeric r_surface = rsurf_at_latlon(lat1,
-                                                    lat3,
-                                                    lon5,
-                                                    lon6,
-                                                    rsurface15,
-                                                    rsurface35,
-                                                    rsurface36,
-                                                    rsurface16,
-                                                    lat_v[j],
-                                                    lon_v[j]);
-          const Numeric r_test = max(r_surface, rlow);
-          if (r_v[j] < r_test) {
-            ready = false;
-            break;
+    const Numeric l_face = l_end;
+    for (Index ib = 0; ib < faces.nelem(); ib++) {
+      const Index face = faces[ib];
+      Numeric la = 0, lb = l_face;
+      Numeric fa = max(boundary_distance(la, face), Numeric(0));
+      Numeric fb = boundary_distance(lb, face);
+
+      if (fb >= 0 && face != 4) {
+        // Nothing to search for if the distance increases from the start
+        // or decreases up to the end
+        const Numeric dl = min(Numeric(1), l_face / 4);
+        if (boundary_distance(dl, face) < fa &&
+            boundary_distance(l_face - dl, face) < fb) {
+          const Numeric g = (sqrt(Numeric(5)) - 1) / 2;
+          Numeric a = 0, b = l_face;
+          Numeric c = b - g * (b - a), d = a + g * (b - a);
+          Numeric fc = boundary_distance(c, face);
+          Numeric fd = boundary_distance(d, face);
+          for (Index it = 0;
+               it < 100 && b - a > LACC && fc >= -RTOL && fd >= -RTOL;
+               it++) {
+            if (fc < fd) {
+              b = d;
+              d = c;
+              fd = fc;
+              c = b - g * (b - a);
+              fc = boundary_distance(c, face);
+            } else {
+              a = c;
+              c = d;
+              fc = fd;
+              d = a + g * (b - a);
+              fd = boundary_distance(d, face);
+            }
+          }
+          if (fc < -RTOL) {
+            lb = c;
+            fb = fc;
+          } else if (fd < -RTOL) {
+            lb = d;
+            fb = fd;
           }
-        } else if (r_v[j] < rlow) {
-          ready = false;
-          break;
         }
+      }
 
-        rupp = rsurf_at_latlon(
-            lat1, lat3, lon5, lon6, r15b, r35b, r36b, r16b, lat_v[j], lon_v[j]);
-        if (r_v[j] > rupp) {
-          ready = false;
-          break;
-        }
+      if (fb >= 0) {
+        continue;
       }
-    } else  // j==n
-    {
-      if (unsafe) {
-        // Set end point to be consistent with found endface.
-        //
-        if (endface == 1) {
-          lat_v[n] = lat1;
-        } else if (endface == 2) {
-          r_v[n] = rsurf_at_latlon(lat1,
-                                   lat3,
-                                   lon5,
-                                   lon6,
-                                   r15a,
-                                   r35a,
-                                   r36a,
-                                   r16a,
-                                   lat_v[n],
-                                   lon_v[n]);
-        } else if (endface == 3) {
-          lat_v[n] = lat3;
-        } else if (endface == 4) {
-          r_v[n] = rsurf_at_latlon(lat1,
-                                   lat3,
-                                   lon5,
-                                   lon6,
-                                   r15b,
-                                   r35b,
-                                   r36b,
-                                   r16b,
-                                   lat_v[n],
-                                   lon_v[n]);
-        } else if (endface == 5) {
-          lon_v[n] = lon5;
-        } else if (endface == 6) {
-          lon_v[n] = lon6;
-        } else if (endface == 7) {
-          r_v[n] = rsurf_at_latlon(lat1,
-                                   lat3,
-                                   lon5,
-                                   lon6,
-                                   rsurface15,
-                                   rsurface35,
-                                   rsurface36,
-                                   rsurface16,
-                                   lat_v[n],
-                                   lon_v[n]);
+
+      Index side = 0;
+      for (Index it = 0; it < 100 && lb - la > LACC; it++) {
+        const Numeric lc = (la * fb - lb * fa) / (fb - fa);
+        const Numeric fc = boundary_distance(lc, face);
+        if (fc < 0) {
+          lb = lc;
+          fb = fc;
+          if (side == -1) {
+            fa /= 2;
+          }
+          side = -1;
+        } else {
+          la = lc;
+          fa = fc;
+          if (side == 1) {
+            fb /= 2;
+          }
+          side = 1;
+        }
+        if (abs(fc) < LACC) {
+          la = lb = lc;
         }
       }
+      if (lb < l_end) {
+        l_end = lb;
+        endface = face;
+      }
+    }
+
+    // The end point must be inside the cell, with the tolerance for radius
+    found = l_end > 0;
+    for (Index ib = 0; ib < faces.nelem() && found; ib++) {
+      found = boundary_distance(l_end, faces[ib]) > -RTOL;
     }
   }
 
-  if (!ready) {  // If an "outside" point found, restart with l as start search length
+  if (!found) {
+    do_gridcell_3d_byltest(r_v,
+                           lat_v,
+                           lon_v,
+                           za_v,
+                           aa_v,
+                           lstep,
+                           endface,
+                           r_start0,
+                           lat_start0,
+                           lon_start0,
+                           za_start,
+                           aa_start,
+                           -1,
+                           0,
+                           ppc,
+                           lmax,
+                           lat1,
+                           lat3,
+                           lon5,
+                           lon6,
+                           r15a,
+                           r35a,
+                           r36a,
+                           r16a,
+                           r15b,
+                           r35b,
+                           r36b,
+                           r16b,
+                           rsurface15,
+                           rsurface35,
+                           rsurface36,
+                           rsurface16);
+    return;
+  }
+
+  Numeric l;
+  const bool ready = gridcell_3d_path_points(r_v,
+                                             lat_v,
+                                             lon_v,
+                                             za_v,
+                                             aa_v,
+                                             lstep,
+                                             l,
+                                             endface,
+                                             l_end,
+                                             true,
+                                             do_surface,
+                                             x,
+                                             y,
+                                             z,
+                                             dx,
+                                             dy,
+                                             dz,
+                                             r_start,
+                                             lat_start,
+                                             lon_start,
+                                             za_start,
+                                             aa_start,
+                                             ppc,
+                                             lmax,
+                                             lat1,
+                                             lat3,
+                                             lon5,
+                                             lon6,
+                                             r15a,
+                                             r35a,
+                                             r36a,
+                                             r16a,
+                                             r15b,
+                                             r35b,
+                                             r36b,
+                                             r16b,
+                                             rsurface15,
+                                             rsurface35,
+                                             rsurface36,
+                                             rsurface16);
+
+  if (!ready) {
     do_gridcell_3d_byltest(r_v,
                            lat_v,
                            lon_v,
@@ -3619,7 +4245,7 @@ void do_gridcell_3d_byltest(Vector& r_v,
                            za_start,
                            aa_start,
                            l,
-                           icall + 1,
+                           1,
                            ppc,
                            lmax,
                            lat1,
@@ -3655,6 +4281,8 @@ void do_gridcell_3d_byltest(Vector& r_v,
    \param   refellipsoid      As the WSV with the same name.
    \param   z_surface         Surface altitudes.
    \param   lmax              Maximum allowed length between the path points.
+   \param   analytic          Flag to determine the end of the path step
+                              by do_gridcell_3d_analytic.
 
    \author Patrick Eriksson
    \date   2002-12-30
@@ -3665,7 +4293,8 @@ void ppath_step_geom_3d(Ppath& ppath,
                         ConstTensor3View z_field,
                         ConstVectorView refellipsoid,
                         ConstMatrixView z_surface,
-                        const Numeric& lmax) {
+                        const Numeric& lmax,
+                        const bool& analytic) {
   // Radius, zenith angle and latitude of start point.
   Numeric r_start, lat_start, lon_start, za_start, aa_start;
 
@@ -3724,38 +4353,71 @@ void ppath_step_geom_3d(Ppath& ppath,
   Numeric lstep;
   Index endface;
 
-  do_gridcell_3d_byltest(r_v,
-                         lat_v,
-                         lon_v,
-                         za_v,
-                         aa_v,
-                         lstep,
-                         endface,
-                         r_start,
-                         lat_start,
-                         lon_start,
-                         za_start,
-                         aa_start,
-                         -1,
-                         0,
-                         ppc,
-                         lmax,
-                         lat1,
-                         lat3,
-                         lon5,
-                         lon6,
-                         r15a,
-                         r35a,
-                         r36a,
-                         r16a,
-                         r15b,
-                         r35b,
-                         r36b,
-                         r16b,
-                         rsurface15,
-                         rsurface35,
-                         rsurface36,
-                         rsurface16);
+  if (analytic) {
+    do_gridcell_3d_analytic(r_v,
+                            lat_v,
+                            lon_v,
+                            za_v,
+                            aa_v,
+                            lstep,
+                            endface,
+                            r_start,
+                            lat_start,
+                            lon_start,
+                            za_start,
+                            aa_start,
+                            ppc,
+                            lmax,
+                            lat1,
+                            lat3,
+                            lon5,
+                            lon6,
+                            r15a,
+                            r35a,
+                            r36a,
+                            r16a,
+                            r15b,
+                            r35b,
+                            r36b,
+                            r16b,
+                            rsurface15,
+                            rsurface35,
+                            rsurface36,
+                            rsurface16);
+  } else {
+    do_gridcell_3d_byltest(r_v,
+                           lat_v,
+                           lon_v,
+                           za_v,
+                           aa_v,
+                           lstep,
+                           endface,
+                           r_start,
+                           lat_start,
+                           lon_start,
+                           za_start,
+                           aa_start,
+                           -1,
+                           0,
+                           ppc,
+                           lmax,
+                           lat1,
+                           lat3,
+                           lon5,
+                           lon6,
+                           r15a,
+                           r35a,
+                           r36a,
+                           r16a,
+                           r15b,
+                           r35b,
+                           r36b,
+                           r16b,
+                           rsurface15,
+                           rsurface35,
+                           rsurface36,
+                           rsurface16);
+  }
 
   // Fill *ppath*
   const Index np = r_v.nelem();
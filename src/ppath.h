@@ -196,7 +196,8 @@ void ppath_step_geom_3d(Ppath& ppath,
                         ConstTensor3View z_field,
                         ConstVectorView refellipsoid,
                         ConstMatrixView z_surface,
-                        const Numeric& lmax);
+                        const Numeric& lmax,
+                        const bool& analytic);
 
 void ppath_step_refr_1d(Workspace& ws,
                         Ppath& ppath,
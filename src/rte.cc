@@ -34,7 +34,9 @@
   ===========================================================================*/
 
 #include "rte.h"
+#include <atomic>
 #include <cmath>
+#include <memory>
 #include <stdexcept>
 #include "auto_md.h"
 #include "check_input.h"
@@ -56,6 +58,126 @@ extern const String SCATSPECIES_MAINTAG;
 extern const Numeric SPEED_OF_LIGHT;
 extern const Numeric TEMP_0_C;
 
+/*===========================================================================
+  === Reusable storage for radiative transfer along a propagation path
+  ===========================================================================*/
+
+//! Pool of RteScratch of this thread, one per nesting level of iy methods.
+static thread_local std::vector<std::unique_ptr<RteScratch>> rte_scratch_pool;
+static thread_local size_t rte_scratch_depth = 0;
+
+static std::atomic<Index> rte_scratch_uses{0};
+static std::atomic<Index> rte_scratch_grows{0};
+static std::atomic<Index> rte_scratch_max_depth{0};
+static std::atomic<Index> rte_scratch_max_np{0};
+static std::atomic<Index> rte_scratch_max_elements{0};
+
+static void atomic_max(std::atomic<Index>& a, const Index x) {
+  Index old = a.load(std::memory_order_relaxed);
+  while (old < x and
+         not a.compare_exchange_weak(old, x, std::memory_order_relaxed)) {
+  }
+}
+
+template <typename T>
+static void scratch_assign(Array<T>& a, const Index n, const T& x) {
+  a.resize(n);
+  for (auto& ai : a) ai = x;
+}
+
+template <typename T>
+static void scratch_assign(Array<Array<T>>& a,
+                           const Index n,
+                           const Index m,
+                           const T& x) {
+  a.resize(n);
+  for (auto& ai : a) scratch_assign(ai, m, x);
+}
+
+void RteScratch::set_init(Index nf, Index ns) {
+  if (nf != nf_init or ns != ns_init) {
+    rad_init = RadiationVector(nf, ns);
+    tra_init = TransmissionMatrix(nf, ns);
+    propmat_init = PropagationMatrix(nf, ns);
+    nf_init = nf;
+    ns_init = ns;
+  }
+}
+
+void RteScratch::update_size(Index np, Index& n, Index elements) {
+  n = elements;
+  const Index total = n_rt + n_propmat + n_tensors;
+  if (total > max_elements) {
+    max_elements = total;
+    rte_scratch_grows++;
+    atomic_max(rte_scratch_max_elements, total);
+  }
+  atomic_max(rte_scratch_max_np, np);
+}
+
+void RteScratch::resize(
+    Index np, Index nq, Index nf, Index ns, bool do_source) {
+  // Element-wise copies reuse the memory of the containers
+  set_init(nf, ns);
+  scratch_assign(lvl_rad, np, rad_init);
+  scratch_assign(dlvl_rad, np, nq, rad_init);
+  if (do_source) {
+    scratch_assign(src_rad, np, rad_init);
+    scratch_assign(dsrc_rad, np, nq, rad_init);
+  }
+  scratch_assign(lyr_tra, np, tra_init);
+  scratch_assign(dlyr_tra_above, np, nq, tra_init);
+  scratch_assign(dlyr_tra_below, np, nq, tra_init);
+  scratch_assign(tot_tra, np, tra_init);
+  tot_tra_path.resize(nf, ns, ns);
+  iy_trans_new.resize(nf, ns, ns);
+
+  update_size(np,
+              n_rt,
+              np * (1 + nq) * (do_source ? 2 : 1) * nf * ns +
+                  np * (2 + 2 * nq) * nf * ns * ns + 2 * nf * ns * ns);
+}
+
+void RteScratch::resize_propmat(Index np, Index nq, Index nf, Index ns) {
+  set_init(nf, ns);
+  scratch_assign(K, np, propmat_init);
+  scratch_assign(dK_dx, np, nq, propmat_init);
+  lte.resize(np);
+
+  update_size(np, n_propmat, np * (1 + nq) * nf * ns * ns);
+}
+
+void RteScratch::resize_tensors(Index np, Index nq, Index nf, Index ns) {
+  J.resize(np, nf, ns);
+  dJ_dx.resize(np, nq, nf, ns);
+  trans_partial.resize(np, nf, ns, ns);
+  dtrans_partial_dx_above.resize(np, nq, nf, ns, ns);
+  dtrans_partial_dx_below.resize(np, nq, nf, ns, ns);
+
+  update_size(np,
+              n_tensors,
+              np * (1 + nq) * nf * ns + np * (1 + 2 * nq) * nf * ns * ns);
+}
+
+RteScratchGuard::RteScratchGuard() {
+  if (rte_scratch_depth == rte_scratch_pool.size())
+    rte_scratch_pool.emplace_back(new RteScratch);
+  mscratch = rte_scratch_pool[rte_scratch_depth++].get();
+
+  rte_scratch_uses++;
+  atomic_max(rte_scratch_max_depth, Index(rte_scratch_depth));
+}
+
+RteScratchGuard::~RteScratchGuard() { rte_scratch_depth--; }
+
+RteScratchStatistics rte_scratch_statistics() {
+  return RteScratchStatistics{rte_scratch_uses.load(),
+                              rte_scratch_grows.load(),
+                              rte_scratch_max_depth.load(),
+                              rte_scratch_max_np.load(),
+                              rte_scratch_max_elements.load()};
+}
+
 /*===========================================================================
   === The functions in alphabetical order
   ===========================================================================*/
@@ -2280,6 +2402,134 @@ void get_stepwise_clearsky_propmat(
   }
 }
 
+//! get_stepwise_clearsky_propmat_from_field
+/*!
+ *  Gets the clearsky propagation matrix and NLTE contributions by
+ *  interpolating a precomputed propmat_clearsky_field
+ * 
+ *  Counterpart to get_stepwise_clearsky_propmat, where the absorption has
+ *  been calculated once for each atmospheric grid point (by
+ *  propmat_clearsky_fieldCalc) instead of once for each ppath point.
+ *  The field is linearly interpolated to the ppath point, species by
+ *  species. The only supported partial derivatives are absorption species
+ *  derivatives, that are set in the same (unadopted) manner as by
+ *  get_stepwise_clearsky_propmat.
+ * 
+ *  Kbuf and Sbuf are only work space. They are resized when needed, so
+ *  that the caller can keep them between calls.
+ * 
+ *  \param K                        Out: Level propagation matrix
+ *  \param S                        Out: NLTE source vector for level
+ *  \param lte                      Out: Index indicating if there is any NLTE source term
+ *  \param dK_dx                    Out: Unadopted propagation matrix derivatives of level
+ *  \param dS_dx                    Out: Unadopted NLTE source derivatives of level
+ *  \param Kbuf                     Work space for one propagation matrix
+ *  \param Sbuf                     Work space for one source vector
+ *  \param propmat_clearsky_field   As the WSV
+ *  \param nlte_source_field        As the WSV, empty if LTE
+ *  \param gp_p                     Pressure grid position of the ppath point
+ *  \param gp_lat                   Latitude grid position of the ppath point
+ *  \param gp_lon                   Longitude grid position of the ppath point
+ *  \param atmosphere_dim           As the WSV
+ *  \param jacobian_quantities      As the WSV
+ *  \param jacobian_species         Species index of each Jacobian quantity
+ *  \param jacobian_do              Flag for if any Jacobian is to be calculated
+ */
+void get_stepwise_clearsky_propmat_from_field(
+    PropagationMatrix& K,
+    StokesVector& S,
+    Index& lte,
+    ArrayOfPropagationMatrix& dK_dx,
+    ArrayOfStokesVector& dS_dx,
+    Matrix& Kbuf,
+    Vector& Sbuf,
+    ConstTensor7View propmat_clearsky_field,
+    ConstTensor6View nlte_source_field,
+    const GridPos& gp_p,
+    const GridPos& gp_lat,
+    const GridPos& gp_lon,
+    const Index& atmosphere_dim,
+    const ArrayOfRetrievalQuantity& jacobian_quantities,
+    const ArrayOfIndex& jacobian_species,
+    const bool& jacobian_do) {
+  const Index nq = jacobian_quantities.nelem();
+  const Index nspecies = propmat_clearsky_field.nlibraries();
+  const Index nf = propmat_clearsky_field.nvitrines();
+  const Index ns = propmat_clearsky_field.nshelves();
+
+  lte = nlte_source_field.empty() ? 1 : 0;
+
+  // Grid cell corners with non-zero interpolation weight
+  Index ncorners = 0;
+  Index ip[8], ilat[8], ilon[8];
+  Numeric w[8];
+  for (Index i = 0; i < 2; i++) {
+    const Numeric wp = gp_p.fd[1 - i];
+    if (wp == 0) continue;
+    for (Index j = 0; j < (atmosphere_dim > 1 ? 2 : 1); j++) {
+      const Numeric wlat = atmosphere_dim > 1 ? gp_lat.fd[1 - j] : 1;
+      if (wlat == 0) continue;
+      for (Index k = 0; k < (atmosphere_dim > 2 ? 2 : 1); k++) {
+        const Numeric wlon = atmosphere_dim > 2 ? gp_lon.fd[1 - k] : 1;
+        if (wlon == 0) continue;
+        ip[ncorners] = gp_p.idx + i;
+        ilat[ncorners] = atmosphere_dim > 1 ? gp_lat.idx + j : 0;
+        ilon[ncorners] = atmosphere_dim > 2 ? gp_lon.idx + k : 0;
+        w[ncorners] = wp * wlat * wlon;
+        ncorners++;
+      }
+    }
+  }
+
+  if (Kbuf.nrows() != ns || Kbuf.ncols() != ns) Kbuf.resize(ns, ns);
+  if (Sbuf.nelem() != ns) Sbuf.resize(ns);
+
+  K.SetZero();
+  S.SetZero();
+
+  if (jacobian_do)
+    for (Index iq = 0; iq < nq; iq++) {
+      dK_dx[iq].SetZero();
+      dS_dx[iq].SetZero();
+    }
+
+  for (Index is = 0; is < nspecies; is++) {
+    // As for species tag derivatives in get_stepwise_clearsky_propmat,
+    // the NLTE part is not known
+    if (jacobian_do && not lte)
+      for (Index iq = 0; iq < nq; iq++)
+        if (jacobian_species[iq] == is) {
+          ostringstream os;
+          os << "We do not yet support species"
+             << " tag and NLTE Jacobians.\n";
+          throw std::runtime_error(os.str());
+        }
+
+    for (Index iv = 0; iv < nf; iv++) {
+      Kbuf = 0;
+      for (Index c = 0; c < ncorners; c++)
+        for (Index is1 = 0; is1 < ns; is1++)
+          for (Index is2 = 0; is2 < ns; is2++)
+            Kbuf(is1, is2) += w[c] * propmat_clearsky_field(
+                                         is, iv, is1, is2, ip[c], ilat[c], ilon[c]);
+      K.AddAtPosition(Kbuf, iv);
+
+      if (jacobian_do)
+        for (Index iq = 0; iq < nq; iq++)
+          if (jacobian_species[iq] == is) dK_dx[iq].SetAtPosition(Kbuf, iv);
+
+      if (not lte) {
+        Sbuf = 0;
+        for (Index c = 0; c < ncorners; c++)
+          for (Index is1 = 0; is1 < ns; is1++)
+            Sbuf[is1] +=
+                w[c] * nlte_source_field(is, iv, is1, ip[c], ilat[c], ilon[c]);
+        S.GetData()(0, 0, iv, joker) += Sbuf;
+      }
+    }
+  }
+}
+
 //! adapt_stepwise_partial_derivatives
 /*!
  *  Adapts clearsky partial derivatives for the following fields:
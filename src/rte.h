@@ -47,6 +47,132 @@
 #include "optproperties.h"
 #include "ppath.h"
 
+/*===========================================================================
+  === Reusable storage for radiative transfer along a propagation path
+  ===========================================================================*/
+
+/** Per-path radiative transfer variables that can be reused between calls.
+
+    The containers keep their memory between calls of resize(), which
+    then only allocates memory if the sizes differ from the previous call
+    or if a container has to grow.
+*/
+class RteScratch {
+ public:
+  ArrayOfRadiationVector lvl_rad;
+  ArrayOfArrayOfRadiationVector dlvl_rad;
+  ArrayOfRadiationVector src_rad;
+  ArrayOfArrayOfRadiationVector dsrc_rad;
+  ArrayOfTransmissionMatrix lyr_tra;
+  ArrayOfArrayOfTransmissionMatrix dlyr_tra_above;
+  ArrayOfArrayOfTransmissionMatrix dlyr_tra_below;
+  ArrayOfTransmissionMatrix tot_tra;
+  Tensor3 tot_tra_path;
+  Tensor3 iy_trans_new;
+
+  /** Resize and initialize the containers.
+
+      Radiation vectors are set to zero and transmission matrices to the
+      identity matrix, as after construction. The tensors tot_tra_path
+      and iy_trans_new get the size (nf, ns, ns) but are not initialized.
+
+      @param[in] np Number of path points.
+      @param[in] nq Number of Jacobian quantities.
+      @param[in] nf Number of frequencies.
+      @param[in] ns Stokes dimension.
+      @param[in] do_source Also set up src_rad and dsrc_rad.
+  */
+  void resize(Index np, Index nq, Index nf, Index ns, bool do_source = true);
+
+  ArrayOfPropagationMatrix K;
+  ArrayOfArrayOfPropagationMatrix dK_dx;
+  ArrayOfIndex lte;
+
+  /** Resize and initialize the propagation matrices of each path point.
+
+      The matrices are set to zero, as after construction.
+
+      @param[in] np Number of path points.
+      @param[in] nq Number of Jacobian quantities.
+      @param[in] nf Number of frequencies.
+      @param[in] ns Stokes dimension.
+  */
+  void resize_propmat(Index np, Index nq, Index nf, Index ns);
+
+  Tensor3 J;
+  Tensor4 dJ_dx;
+  Tensor4 trans_partial;
+  Tensor5 dtrans_partial_dx_above;
+  Tensor5 dtrans_partial_dx_below;
+
+  /** Resize the tensors used by iyHybrid, without initializing them.
+
+      @param[in] np Number of path points.
+      @param[in] nq Number of Jacobian quantities.
+      @param[in] nf Number of frequencies.
+      @param[in] ns Stokes dimension.
+  */
+  void resize_tensors(Index np, Index nq, Index nf, Index ns);
+
+ private:
+  void set_init(Index nf, Index ns);
+
+  RadiationVector rad_init;
+  TransmissionMatrix tra_init;
+  PropagationMatrix propmat_init;
+  Index nf_init{-1};
+  Index ns_init{-1};
+
+  // Sets the current size of one group of containers and updates the
+  // usage statistics
+  void update_size(Index np, Index& n, Index elements);
+
+  // Number of Numerics in the containers set up by resize, resize_propmat
+  // and resize_tensors, and the largest sum of these
+  Index n_rt{0};
+  Index n_propmat{0};
+  Index n_tensors{0};
+  Index max_elements{0};
+};
+
+/** Grants exclusive use of an RteScratch of the calling thread.
+
+    Every thread has its own pool of RteScratch objects. The pool holds one
+    object per nesting level, since iy methods can call themselves through
+    the surface and cloudbox agendas. The object is returned to the pool
+    when the guard goes out of scope.
+*/
+class RteScratchGuard {
+ public:
+  RteScratchGuard();
+  ~RteScratchGuard();
+
+  RteScratchGuard(const RteScratchGuard&) = delete;
+  RteScratchGuard& operator=(const RteScratchGuard&) = delete;
+
+  RteScratch& get() { return *mscratch; }
+
+ private:
+  RteScratch* mscratch;
+};
+
+/** Usage statistics of the RteScratch pools of all threads. */
+struct RteScratchStatistics {
+  /** Number of times an RteScratch was used. */
+  Index uses;
+  /** Number of times the size of an RteScratch was increased. */
+  Index grows;
+  /** Largest number of simultaneously used RteScratch in one thread. */
+  Index max_depth;
+  /** Largest number of path points. */
+  Index max_np;
+  /** Largest number of Numerics held by one RteScratch (the high-water
+      mark of an RteScratch). */
+  Index max_elements;
+};
+
+RteScratchStatistics rte_scratch_statistics();
+
 /*===========================================================================
   === Functions in rte.cc
   ===========================================================================*/
@@ -288,6 +414,24 @@ void get_stepwise_clearsky_propmat(
     const ArrayOfIndex& jacobian_species,
     const bool& jacobian_do);
 
+void get_stepwise_clearsky_propmat_from_field(
+    PropagationMatrix& K,
+    StokesVector& S,
+    Index& lte,
+    ArrayOfPropagationMatrix& dK_dx,
+    ArrayOfStokesVector& dS_dx,
+    Matrix& Kbuf,
+    Vector& Sbuf,
+    ConstTensor7View propmat_clearsky_field,
+    ConstTensor6View nlte_source_field,
+    const GridPos& gp_p,
+    const GridPos& gp_lat,
+    const GridPos& gp_lon,
+    const Index& atmosphere_dim,
+    const ArrayOfRetrievalQuantity& jacobian_quantities,
+    const ArrayOfIndex& jacobian_species,
+    const bool& jacobian_do);
+
 void adapt_stepwise_partial_derivatives(
     ArrayOfPropagationMatrix& dK_dx,
     ArrayOfStokesVector& dS_dx,
@@ -0,0 +1,450 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   scat_database.cc
+
+  \brief  Memory-mapped single scattering database.
+
+  The file starts with a header:
+
+  - 8 bytes magic "ARTSSDB", zero terminated
+  - Index: format version
+  - Index: byte order mark, 0x0102030405060708 in native byte order
+  - Index: number of scattering species
+  - Index[]: number of scattering elements of each species
+  - Index[]: byte offset of each scattering element
+
+  followed by one record per scattering element:
+
+  - Index: ptype
+  - Index: length of the description, followed by the description,
+    padded with zeros to a multiple of 8 bytes
+  - Index[4]: size of f_grid, T_grid, za_grid and aa_grid
+  - Index[7]: size of pha_mat_data
+  - Index[5]: size of ext_mat_data
+  - Index[5]: size of abs_vec_data
+  - Numeric[]: f_grid, T_grid, za_grid and aa_grid
+  - Numeric[]: pha_mat_data, ext_mat_data and abs_vec_data, in row-major
+    order
+
+  All numbers are stored in the native format of the machine writing the
+  file. As frequency is the leading dimension of the optical properties,
+  the data of a single frequency are contiguous in the file and only these
+  pages are read when a slice is interpolated.
+*/
+
+#include "scat_database.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include "interpolation_poly.h"
+
+namespace {
+
+const char scat_database_magic[8] = "ARTSSDB";
+const Index scat_database_version = 1;
+const Index scat_database_bom = 0x0102030405060708;
+
+void write_index(std::ofstream& ofs, Index x) {
+  ofs.write(reinterpret_cast<const char*>(&x), sizeof(Index));
+}
+
+void write_numeric(std::ofstream& ofs, const Numeric* x, Index n) {
+  if (n > 0)
+    ofs.write(reinterpret_cast<const char*>(x),
+              std::streamsize(size_t(n) * sizeof(Numeric)));
+}
+
+void write_vector(std::ofstream& ofs, const Vector& x) {
+  for (Index i = 0; i < x.nelem(); i++) {
+    const Numeric xi = x[i];
+    write_numeric(ofs, &xi, 1);
+  }
+}
+
+//! Reads consecutive items from the mapped file, with bounds checking.
+class MapReader {
+ public:
+  MapReader(const void* map, size_t size, const String& filename)
+      : mmap(static_cast<const char*>(map)),
+        msize(size),
+        mpos(0),
+        mfilename(filename) {}
+
+  void seek(size_t pos) {
+    if (pos > msize || pos % sizeof(Numeric)) corrupt();
+    mpos = pos;
+  }
+
+  const char* take(size_t nbytes) {
+    if (nbytes > msize - mpos) corrupt();
+    const char* p = mmap + mpos;
+    mpos = std::min(msize, mpos + (nbytes + 7) / 8 * 8);
+    return p;
+  }
+
+  Index index() {
+    Index x;
+    std::memcpy(&x, take(sizeof(Index)), sizeof(Index));
+    if (x < 0) corrupt();
+    return x;
+  }
+
+  const Numeric* numeric(Index n) {
+    return reinterpret_cast<const Numeric*>(take(size_t(n) * sizeof(Numeric)));
+  }
+
+  void vector(Vector& x, Index n) {
+    const Numeric* p = numeric(n);
+    x.resize(n);
+    for (Index i = 0; i < n; i++) x[i] = p[i];
+  }
+
+  [[noreturn]] void corrupt() const {
+    ostringstream os;
+    os << "The scattering database file " << mfilename
+       << " is truncated or corrupt.";
+    throw runtime_error(os.str());
+  }
+
+ private:
+  const char* mmap;
+  size_t msize;
+  size_t mpos;
+  String mfilename;
+};
+
+Index product(const Index* dims, Index n) {
+  Index p = 1;
+  for (Index i = 0; i < n; i++) p *= dims[i];
+  return p;
+}
+
+Index nelem(const Tensor7& x) {
+  return x.nlibraries() * x.nvitrines() * x.nshelves() * x.nbooks() *
+         x.npages() * x.nrows() * x.ncols();
+}
+
+Index nelem(const Tensor5& x) {
+  return x.nshelves() * x.nbooks() * x.npages() * x.nrows() * x.ncols();
+}
+
+Index nbytes(const SingleScatteringData& ssd) {
+  return Index(sizeof(Numeric)) *
+         (nelem(ssd.pha_mat_data) + nelem(ssd.ext_mat_data) +
+          nelem(ssd.abs_vec_data));
+}
+
+//! Interpolate one of the data arrays of an element in frequency.
+/*!
+  \param out    Data for one frequency.
+  \param data   Data of all frequencies, frequency is the leading dimension.
+  \param dims   Size of data.
+  \param ndims  Number of dimensions of data.
+  \param gp     Frequency grid position.
+  \param itw    Interpolation weights.
+*/
+void interp_frequency(Numeric* out,
+                      const Numeric* data,
+                      const Index* dims,
+                      Index ndims,
+                      const GridPosPoly& gp,
+                      ConstVectorView itw) {
+  const Index n = product(dims + 1, ndims - 1);
+  if (dims[0] == 1) {
+    for (Index k = 0; k < n; k++) out[k] = data[k];
+    return;
+  }
+  for (Index k = 0; k < n; k++) out[k] = 0;
+  for (Index j = 0; j < gp.idx.nelem(); j++) {
+    const Numeric* src = data + gp.idx[j] * n;
+    const Numeric w = itw[j];
+    for (Index k = 0; k < n; k++) out[k] += src[k] * w;
+  }
+}
+
+}  // namespace
+
+void ScatteringDatabase::write(
+    const String& filename,
+    const ArrayOfIndex& n_elements,
+    const std::function<const SingleScatteringData&(Index, Index)>&
+        get_element) {
+  std::ofstream ofs(filename.c_str(), std::ios::binary | std::ios::trunc);
+  if (!ofs) {
+    ostringstream os;
+    os << "Cannot open scattering database file " << filename
+       << " for writing.";
+    throw runtime_error(os.str());
+  }
+
+  Index n_total = 0;
+  ofs.write(scat_database_magic, sizeof(scat_database_magic));
+  write_index(ofs, scat_database_version);
+  write_index(ofs, scat_database_bom);
+  write_index(ofs, n_elements.nelem());
+  for (Index i_ss = 0; i_ss < n_elements.nelem(); i_ss++) {
+    write_index(ofs, n_elements[i_ss]);
+    n_total += n_elements[i_ss];
+  }
+
+  // The offsets are filled in when the elements have been written
+  const std::streampos offsets_pos = ofs.tellp();
+  for (Index i = 0; i < n_total; i++) write_index(ofs, 0);
+
+  ArrayOfIndex offsets;
+  for (Index i_ss = 0; i_ss < n_elements.nelem(); i_ss++) {
+    for (Index i_se = 0; i_se < n_elements[i_ss]; i_se++) {
+      const SingleScatteringData& ssd = get_element(i_ss, i_se);
+      offsets.push_back(Index(ofs.tellp()));
+
+      const Index ndesc = Index(ssd.description.size());
+      write_index(ofs, Index(ssd.ptype));
+      write_index(ofs, ndesc);
+      const String padding(size_t((8 - ndesc % 8) % 8), '\0');
+      ofs.write(ssd.description.c_str(), ndesc);
+      ofs.write(padding.c_str(), Index(padding.size()));
+
+      write_index(ofs, ssd.f_grid.nelem());
+      write_index(ofs, ssd.T_grid.nelem());
+      write_index(ofs, ssd.za_grid.nelem());
+      write_index(ofs, ssd.aa_grid.nelem());
+
+      const Tensor7& pha = ssd.pha_mat_data;
+      const Tensor5& ext = ssd.ext_mat_data;
+      const Tensor5& abs = ssd.abs_vec_data;
+      write_index(ofs, pha.nlibraries());
+      write_index(ofs, pha.nvitrines());
+      write_index(ofs, pha.nshelves());
+      write_index(ofs, pha.nbooks());
+      write_index(ofs, pha.npages());
+      write_index(ofs, pha.nrows());
+      write_index(ofs, pha.ncols());
+      for (const Tensor5* t : {&ext, &abs}) {
+        write_index(ofs, t->nshelves());
+        write_index(ofs, t->nbooks());
+        write_index(ofs, t->npages());
+        write_index(ofs, t->nrows());
+        write_index(ofs, t->ncols());
+      }
+
+      write_vector(ofs, ssd.f_grid);
+      write_vector(ofs, ssd.T_grid);
+      write_vector(ofs, ssd.za_grid);
+      write_vector(ofs, ssd.aa_grid);
+
+      if (!pha.empty()) write_numeric(ofs, pha.get_c_array(), nelem(pha));
+      if (!ext.empty()) write_numeric(ofs, ext.get_c_array(), nelem(ext));
+      if (!abs.empty()) write_numeric(ofs, abs.get_c_array(), nelem(abs));
+    }
+  }
+
+  ofs.seekp(offsets_pos);
+  for (Index i = 0; i < n_total; i++) write_index(ofs, offsets[i]);
+
+  ofs.close();
+  if (!ofs) {
+    ostringstream os;
+    os << "Error writing scattering database file " << filename << ".";
+    throw runtime_error(os.str());
+  }
+}
+
+void ScatteringDatabase::open(const String& filename, Index cache_size) {
+  std::shared_ptr<Data> data = std::make_shared<Data>();
+  data->filename = filename;
+  data->cache_size = cache_size;
+
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    ostringstream os;
+    os << "Cannot open scattering database file " << filename << ": "
+       << std::strerror(errno);
+    throw runtime_error(os.str());
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    data->map_size = size_t(st.st_size);
+    data->map = mmap(nullptr, data->map_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data->map == MAP_FAILED) data->map = nullptr;
+  }
+  const int err = errno;
+  close(fd);
+  if (!data->map) {
+    ostringstream os;
+    os << "Cannot map scattering database file " << filename << ": "
+       << std::strerror(err);
+    throw runtime_error(os.str());
+  }
+
+  MapReader r(data->map, data->map_size, filename);
+  if (std::memcmp(r.take(sizeof(scat_database_magic)),
+                  scat_database_magic,
+                  sizeof(scat_database_magic))) {
+    ostringstream os;
+    os << "The file " << filename << " is not a scattering database.";
+    throw runtime_error(os.str());
+  }
+  if (r.index() != scat_database_version) {
+    ostringstream os;
+    os << "The scattering database file " << filename
+       << " has an unsupported format version.";
+    throw runtime_error(os.str());
+  }
+  if (r.index() != scat_database_bom) {
+    ostringstream os;
+    os << "The scattering database file " << filename
+       << " was written on a machine with a different byte order.";
+    throw runtime_error(os.str());
+  }
+
+  const Index n_ss = r.index();
+  ArrayOfIndex n_elements(n_ss);
+  data->elements.resize(n_ss);
+  for (Index i_ss = 0; i_ss < n_ss; i_ss++) {
+    n_elements[i_ss] = r.index();
+    data->elements[i_ss].resize(n_elements[i_ss]);
+  }
+  ArrayOfIndex offsets;
+  for (Index i_ss = 0; i_ss < n_ss; i_ss++)
+    for (Index i_se = 0; i_se < n_elements[i_ss]; i_se++)
+      offsets.push_back(r.index());
+
+  Index i = 0;
+  for (Index i_ss = 0; i_ss < n_ss; i_ss++) {
+    for (Index i_se = 0; i_se < n_elements[i_ss]; i_se++, i++) {
+      Element& e = data->elements[i_ss][i_se];
+      r.seek(size_t(offsets[i]));
+
+      e.ssd.ptype = PType(r.index());
+      const Index ndesc = r.index();
+      e.ssd.description.assign(r.take(size_t(ndesc)), size_t(ndesc));
+
+      Index ngrid[4];
+      for (Index j = 0; j < 4; j++) ngrid[j] = r.index();
+      for (Index j = 0; j < 7; j++) e.pha_mat_dims[j] = r.index();
+      for (Index j = 0; j < 5; j++) e.ext_mat_dims[j] = r.index();
+      for (Index j = 0; j < 5; j++) e.abs_vec_dims[j] = r.index();
+
+      r.vector(e.ssd.f_grid, ngrid[0]);
+      r.vector(e.ssd.T_grid, ngrid[1]);
+      r.vector(e.ssd.za_grid, ngrid[2]);
+      r.vector(e.ssd.aa_grid, ngrid[3]);
+
+      e.pha_mat = r.numeric(product(e.pha_mat_dims, 7));
+      e.ext_mat = r.numeric(product(e.ext_mat_dims, 5));
+      e.abs_vec = r.numeric(product(e.abs_vec_dims, 5));
+
+      // The interpolation assumes data for each frequency, or a single
+      // set of data used for all frequencies.
+      for (const Index nf :
+           {e.pha_mat_dims[0], e.ext_mat_dims[0], e.abs_vec_dims[0]}) {
+        if (nf != 1 && nf != ngrid[0]) {
+          ostringstream os;
+          os << "Scattering element " << i_se << " of species " << i_ss
+             << " in the scattering database file " << filename
+             << " has optical properties for " << nf
+             << " frequencies, but f_grid has " << ngrid[0] << " elements.";
+          throw runtime_error(os.str());
+        }
+      }
+    }
+  }
+
+  mdata = data;
+}
+
+std::shared_ptr<const SingleScatteringData> ScatteringDatabase::slice(
+    Index i_ss, Index i_se, Numeric f, Index interp_order) {
+  Data& d = *mdata;
+  const Key key(i_ss, i_se, f, interp_order);
+  {
+    std::lock_guard<std::mutex> lock(d.mutex);
+    auto it = d.cache.find(key);
+    if (it != d.cache.end()) {
+      d.hits++;
+      return it->second;
+    }
+    d.misses++;
+  }
+
+  // The interpolation is done outside the lock, so that several threads
+  // can read from the database at the same time.
+  const Element& e = d.elements[i_ss][i_se];
+  std::shared_ptr<SingleScatteringData> ssd =
+      std::make_shared<SingleScatteringData>();
+  ssd->ptype = e.ssd.ptype;
+  ssd->description = e.ssd.description;
+  ssd->f_grid.resize(1);
+  ssd->f_grid = f;
+  ssd->T_grid = e.ssd.T_grid;
+  ssd->za_grid = e.ssd.za_grid;
+  ssd->aa_grid = e.ssd.aa_grid;
+
+  GridPosPoly gp;
+  Vector itw;
+  if (e.ssd.f_grid.nelem() == 1) {
+    gp.idx.resize(1);
+    gp.idx[0] = 0;
+    itw.resize(1);
+    itw = 1;
+  } else {
+    gridpos_poly(gp, e.ssd.f_grid, f, interp_order);
+    itw.resize(gp.idx.nelem());
+    interpweights(itw, gp);
+  }
+
+  const Index* pd = e.pha_mat_dims;
+  const Index* ed = e.ext_mat_dims;
+  const Index* ad = e.abs_vec_dims;
+  ssd->pha_mat_data.resize(1, pd[1], pd[2], pd[3], pd[4], pd[5], pd[6]);
+  ssd->ext_mat_data.resize(1, ed[1], ed[2], ed[3], ed[4]);
+  ssd->abs_vec_data.resize(1, ad[1], ad[2], ad[3], ad[4]);
+  if (!ssd->pha_mat_data.empty())
+    interp_frequency(
+        ssd->pha_mat_data.get_c_array(), e.pha_mat, pd, 7, gp, itw);
+  if (!ssd->ext_mat_data.empty())
+    interp_frequency(
+        ssd->ext_mat_data.get_c_array(), e.ext_mat, ed, 5, gp, itw);
+  if (!ssd->abs_vec_data.empty())
+    interp_frequency(
+        ssd->abs_vec_data.get_c_array(), e.abs_vec, ad, 5, gp, itw);
+
+  const Index size = nbytes(*ssd);
+
+  std::lock_guard<std::mutex> lock(d.mutex);
+  if (size <= d.cache_size && !d.cache.count(key)) {
+    // Drop the oldest slices. Slices still in use stay valid, as they are
+    // shared with the caller.
+    while (d.cache_used + size > d.cache_size && !d.cache_order.empty()) {
+      auto it = d.cache.find(d.cache_order.front());
+      d.cache_used -= nbytes(*it->second);
+      d.cache.erase(it);
+      d.cache_order.pop_front();
+    }
+    d.cache[key] = ssd;
+    d.cache_order.push_back(key);
+    d.cache_used += size;
+  }
+  return ssd;
+}
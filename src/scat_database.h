@@ -0,0 +1,167 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   scat_database.h
+
+  \brief  Memory-mapped single scattering database.
+
+  A scattering database holds the single scattering data of several
+  scattering species in a binary file that is mapped into memory. Only the
+  grids are read when the file is opened. The optical properties of a
+  scattering element are interpolated to a frequency when they are first
+  requested, and the resulting slices are kept in a cache of limited size.
+
+  As for IybCache, copies of a ScatteringDatabase share the mapping and the
+  cache, and access to the cache is serialised.
+*/
+
+#ifndef scat_database_h
+#define scat_database_h
+
+#include <sys/mman.h>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <tuple>
+#include "optproperties.h"
+
+class ScatteringDatabase {
+ public:
+  ScatteringDatabase() : mdata(std::make_shared<Data>()) {}
+
+  //! Write a scattering database file.
+  /*!
+    The elements are fetched one at a time by get_element, so the complete
+    data never have to be in memory.
+
+    \param filename     Name of the database file.
+    \param n_elements   Number of scattering elements of each species.
+    \param get_element  Function returning element (i_ss, i_se).
+  */
+  static void write(
+      const String& filename,
+      const ArrayOfIndex& n_elements,
+      const std::function<const SingleScatteringData&(Index, Index)>&
+          get_element);
+
+  //! Open a database file.
+  /*!
+    Copies of this object made before are not affected.
+
+    \param filename    Name of the database file.
+    \param cache_size  Maximum size of the cache [bytes].
+  */
+  void open(const String& filename, Index cache_size);
+
+  //! Return true if a database file is open.
+  bool is_open() const { return mdata->map != nullptr; }
+
+  //! Name of the open database file.
+  const String& filename() const { return mdata->filename; }
+
+  //! Number of scattering species.
+  Index nspecies() const { return mdata->elements.nelem(); }
+
+  //! Number of scattering elements of species i_ss.
+  Index nelements(Index i_ss) const { return mdata->elements[i_ss].nelem(); }
+
+  //! Frequency grid of a scattering element.
+  const Vector& f_grid(Index i_ss, Index i_se) const {
+    return mdata->elements[i_ss][i_se].ssd.f_grid;
+  }
+
+  //! Optical properties of a scattering element at a single frequency.
+  /*!
+    The data are interpolated with polynomials of order interp_order, in
+    the same way as by *scat_dataCalc*. The grids of the element are
+    assumed to be checked by the caller.
+
+    \param i_ss          Scattering species index.
+    \param i_se          Scattering element index.
+    \param f             Frequency.
+    \param interp_order  Interpolation order.
+    \return              Data with a frequency grid of length 1.
+  */
+  std::shared_ptr<const SingleScatteringData> slice(Index i_ss,
+                                                    Index i_se,
+                                                    Numeric f,
+                                                    Index interp_order);
+
+  //! Number of slices served from the cache.
+  Index hits() const { return mdata->hits; }
+
+  //! Number of slices that had to be interpolated.
+  Index misses() const { return mdata->misses; }
+
+ private:
+  //! Location of the data of a scattering element in the mapping.
+  struct Element {
+    //! The element without the optical properties.
+    SingleScatteringData ssd;
+    Index pha_mat_dims[7];
+    Index ext_mat_dims[5];
+    Index abs_vec_dims[5];
+    const Numeric* pha_mat;
+    const Numeric* ext_mat;
+    const Numeric* abs_vec;
+  };
+
+  typedef std::tuple<Index, Index, Numeric, Index> Key;
+
+  struct Data {
+    Data()
+        : map(nullptr),
+          map_size(0),
+          cache_size(0),
+          cache_used(0),
+          hits(0),
+          misses(0) {}
+    ~Data() {
+      if (map) munmap(map, map_size);
+    }
+    std::mutex mutex;
+    String filename;
+    void* map;
+    size_t map_size;
+    Array<Array<Element>> elements;
+    std::map<Key, std::shared_ptr<const SingleScatteringData>> cache;
+    std::deque<Key> cache_order;
+    Index cache_size;
+    Index cache_used;
+    Index hits;
+    Index misses;
+  };
+
+  std::shared_ptr<Data> mdata;
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                const ScatteringDatabase& db) {
+  os << "ScatteringDatabase: ";
+  if (db.is_open())
+    os << db.filename() << ", " << db.hits() << " hits, " << db.misses()
+       << " misses";
+  else
+    os << "not open";
+  return os;
+}
+
+#endif /* scat_database_h */
@@ -35,6 +35,7 @@
 #include <list>
 #include <stdexcept>
 #include "arts.h"
+#include "arts_omp.h"
 #include "logic.h"
 #include "matpackI.h"
 #include "matpackII.h"
@@ -127,91 +128,104 @@ void antenna1d_matrix(Sparse& H,
   // Some size(s)
   const Index nfpol = n_f * n_pol;
 
-  // Resize H
-  H.resize(n_ant * nfpol, n_za * nfpol);
+  // Rows of H, set in parallel for the antenna beams
+  SparseRowBuilder hrows(n_ant * nfpol, n_za * nfpol);
 
-  // Storage vectors for response weights
-  Vector hrow(H.ncols(), 0.0);
-  Vector hza(n_za, 0.0);
-
-  // Antenna response to apply (possibly obtained by frequency interpolation)
-  Vector aresponse(n_ar_za, 0.0);
+  String fail_msg;
+  bool failed = false;
 
   // Antenna beam loop
+#pragma omp parallel for if (!arts_omp_in_parallel() && n_ant > 1)
   for (Index ia = 0; ia < n_ant; ia++) {
-    Vector shifted_aresponse_za_grid = aresponse_za_grid;
-    shifted_aresponse_za_grid += antenna_dza[ia];
-
-    // Order of loops assumes that the antenna response more often
-    // changes with frequency than for polarisation
-
-    // Frequency loop
-    for (Index f = 0; f < n_f; f++) {
-      // Polarisation loop
-      for (Index ip = 0; ip < n_pol; ip++) {
-        // Determine antenna pattern to apply
-        //
-        // Interpolation needed only if response has a frequency grid
-        //
-        Index new_antenna = 1;
-        //
-        if (n_ar_f == 1)  // No frequency variation
-        {
-          if (pol_step)  // Polarisation variation, update always needed
-          {
-            aresponse = antenna_response.data(ip, 0, joker, 0);
-          } else if (f == 0 && ip == 0)  // Set fully constant pattern
-          {
-            aresponse = antenna_response.data(0, 0, joker, 0);
-          } else  // The one set just above can be reused
+    if (failed) continue;
+    try {
+      // Storage vector for response weights
+      Vector hza(n_za, 0.0);
+
+      // Antenna response to apply (possibly obtained by frequency
+      // interpolation)
+      Vector aresponse(n_ar_za, 0.0);
+
+      Vector shifted_aresponse_za_grid = aresponse_za_grid;
+      shifted_aresponse_za_grid += antenna_dza[ia];
+
+      // Order of loops assumes that the antenna response more often
+      // changes with frequency than for polarisation
+
+      // Frequency loop
+      for (Index f = 0; f < n_f; f++) {
+        // Polarisation loop
+        for (Index ip = 0; ip < n_pol; ip++) {
+          // Determine antenna pattern to apply
+          //
+          // Interpolation needed only if response has a frequency grid
+          //
+          Index new_antenna = 1;
+          //
+          if (n_ar_f == 1)  // No frequency variation
           {
-            new_antenna = 0;
-          }
-        } else {
-          if (ip == 0 || pol_step)  // Interpolation required
-          {
-            // Interpolation (do this in "green way")
-            ArrayOfGridPos gp_f(1), gp_za(n_ar_za);
-            gridpos(gp_f, aresponse_f_grid, Vector(1, f_grid[f]));
-            gridpos(gp_za, aresponse_za_grid, aresponse_za_grid);
-            Tensor3 itw(1, n_ar_za, 4);
-            interpweights(itw, gp_f, gp_za);
-            Matrix aresponse_matrix(1, n_ar_za);
-            interp(aresponse_matrix,
-                   itw,
-                   antenna_response.data(ip, joker, joker, 0),
-                   gp_f,
-                   gp_za);
-            aresponse = aresponse_matrix(0, joker);
-          } else  // Reuse pattern for ip==0
-          {
-            new_antenna = 0;
+            if (pol_step)  // Polarisation variation, update always needed
+            {
+              aresponse = antenna_response.data(ip, 0, joker, 0);
+            } else if (f == 0 && ip == 0)  // Set fully constant pattern
+            {
+              aresponse = antenna_response.data(0, 0, joker, 0);
+            } else  // The one set just above can be reused
+            {
+              new_antenna = 0;
+            }
+          } else {
+            if (ip == 0 || pol_step)  // Interpolation required
+            {
+              // Interpolation (do this in "green way")
+              ArrayOfGridPos gp_f(1), gp_za(n_ar_za);
+              gridpos(gp_f, aresponse_f_grid, Vector(1, f_grid[f]));
+              gridpos(gp_za, aresponse_za_grid, aresponse_za_grid);
+              Tensor3 itw(1, n_ar_za, 4);
+              interpweights(itw, gp_f, gp_za);
+              Matrix aresponse_matrix(1, n_ar_za);
+              interp(aresponse_matrix,
+                     itw,
+                     antenna_response.data(ip, joker, joker, 0),
+                     gp_f,
+                     gp_za);
+              aresponse = aresponse_matrix(0, joker);
+            } else  // Reuse pattern for ip==0
+            {
+              new_antenna = 0;
+            }
           }
-        }
 
-        // Calculate response weights
-        if (new_antenna) {
-          integration_func_by_vecmult(
-              hza, aresponse, shifted_aresponse_za_grid, za_grid);
+          // Calculate response weights
+          if (new_antenna) {
+            integration_func_by_vecmult(
+                hza, aresponse, shifted_aresponse_za_grid, za_grid);
 
-          // Normalisation?
-          if (do_norm) {
-            hza /= hza.sum();
+            // Normalisation?
+            if (do_norm) {
+              hza /= hza.sum();
+            }
           }
-        }
 
-        // Put weights into H
-        //
-        const Index ii = f * n_pol + ip;
-        //
-        hrow[Range(ii, n_za, nfpol)] = hza;
-        //
-        H.insert_row(ia * nfpol + ii, hrow);
-        //
-        hrow = 0;
+          // Put weights into H
+          //
+          const Index ii = f * n_pol + ip;
+          //
+          hrows.set_row(ia * nfpol + ii, hza, ii, nfpol);
+        }
+      }
+    } catch (const std::exception& x) {
+#pragma omp critical(antenna1d_matrix_fail)
+      {
+        fail_msg = x.what();
+        failed = true;
       }
     }
   }
+
+  if (failed) throw runtime_error(fail_msg);
+
+  hrows.build(H);
 }
 
 //! antenna2d_basic
@@ -279,117 +293,130 @@ void antenna2d_basic(Sparse& H,
   // Some size(s)
   const Index nfpol = n_f * n_pol;
 
-  // Resize H
-  H.resize(n_ant * nfpol, n_dlos * nfpol);
+  // Rows of H, set in parallel for the antenna beams
+  SparseRowBuilder hrows(n_ant * nfpol, n_dlos * nfpol);
 
-  // Storage vectors for response weights
-  Vector hrow(H.ncols(), 0.0);
-  Vector hza(n_dlos, 0.0);
-
-  // Antenna response to apply (possibly obtained by frequency interpolation)
-  Matrix aresponse(n_ar_za, n_ar_aa, 0.0);
+  String fail_msg;
+  bool failed = false;
 
   // Antenna beam loop
+#pragma omp parallel for if (!arts_omp_in_parallel() && n_ant > 1)
   for (Index ia = 0; ia < n_ant; ia++) {
-    // Order of loops assumes that the antenna response more often
-    // changes with frequency than for polarisation
-
-    // Frequency loop
-    for (Index f = 0; f < n_f; f++) {
-      // Polarisation loop
-      for (Index ip = 0; ip < n_pol; ip++) {
-        // Determine antenna pattern to apply
-        //
-        // Interpolation needed only if response has a frequency grid
-        //
-        Index new_antenna = 1;
-        //
-        if (n_ar_f == 1)  // No frequency variation
-        {
-          if (pol_step)  // Polarisation variation, update always needed
+    if (failed) continue;
+    try {
+      // Storage vector for response weights
+      Vector hza(n_dlos, 0.0);
+
+      // Antenna response to apply (possibly obtained by frequency
+      // interpolation)
+      Matrix aresponse(n_ar_za, n_ar_aa, 0.0);
+
+      // Order of loops assumes that the antenna response more often
+      // changes with frequency than for polarisation
+
+      // Frequency loop
+      for (Index f = 0; f < n_f; f++) {
+        // Polarisation loop
+        for (Index ip = 0; ip < n_pol; ip++) {
+          // Determine antenna pattern to apply
+          //
+          // Interpolation needed only if response has a frequency grid
+          //
+          Index new_antenna = 1;
+          //
+          if (n_ar_f == 1)  // No frequency variation
           {
-            aresponse = antenna_response.data(ip, 0, joker, joker);
-          } else if (f == 0 && ip == 0)  // Set fully constant pattern
-          {
-            aresponse = antenna_response.data(0, 0, joker, joker);
-          } else  // The one set just above can be reused
-          {
-            new_antenna = 0;
-          }
-        } else {
-          if (ip == 0 || pol_step) {
-            // Interpolation (do this in "green way")
-            ArrayOfGridPos gp_f(1), gp_za(n_ar_za), gp_aa(n_ar_aa);
-            gridpos(gp_f, aresponse_f_grid, Vector(1, f_grid[f]));
-            gridpos(gp_za, aresponse_za_grid, aresponse_za_grid);
-            gridpos(gp_aa, aresponse_aa_grid, aresponse_aa_grid);
-            Tensor4 itw(1, n_ar_za, n_ar_aa, 8);
-            interpweights(itw, gp_f, gp_za, gp_aa);
-            Tensor3 aresponse_matrix(1, n_ar_za, n_ar_aa);
-            interp(aresponse_matrix,
-                   itw,
-                   antenna_response.data(ip, joker, joker, joker),
-                   gp_f,
-                   gp_za,
-                   gp_aa);
-            aresponse = aresponse_matrix(0, joker, joker);
-          } else  // Reuse pattern for ip==0
-          {
-            new_antenna = 0;
-          }
-        }
-
-        // Calculate response weights
-        if (new_antenna) {
-          for (Index l = 0; l < n_dlos; l++) {
-            const Numeric za = mblock_dlos(l, 0) - antenna_dlos(ia, 0);
-            Numeric aa = 0.0;
-            if (mblock_dlos.ncols() > 1) {
-              aa += mblock_dlos(l, 1);
+            if (pol_step)  // Polarisation variation, update always needed
+            {
+              aresponse = antenna_response.data(ip, 0, joker, joker);
+            } else if (f == 0 && ip == 0)  // Set fully constant pattern
+            {
+              aresponse = antenna_response.data(0, 0, joker, joker);
+            } else  // The one set just above can be reused
+            {
+              new_antenna = 0;
             }
-            if (antenna_dlos.ncols() > 1) {
-              aa -= antenna_dlos(ia, 1);
+          } else {
+            if (ip == 0 || pol_step) {
+              // Interpolation (do this in "green way")
+              ArrayOfGridPos gp_f(1), gp_za(n_ar_za), gp_aa(n_ar_aa);
+              gridpos(gp_f, aresponse_f_grid, Vector(1, f_grid[f]));
+              gridpos(gp_za, aresponse_za_grid, aresponse_za_grid);
+              gridpos(gp_aa, aresponse_aa_grid, aresponse_aa_grid);
+              Tensor4 itw(1, n_ar_za, n_ar_aa, 8);
+              interpweights(itw, gp_f, gp_za, gp_aa);
+              Tensor3 aresponse_matrix(1, n_ar_za, n_ar_aa);
+              interp(aresponse_matrix,
+                     itw,
+                     antenna_response.data(ip, joker, joker, joker),
+                     gp_f,
+                     gp_za,
+                     gp_aa);
+              aresponse = aresponse_matrix(0, joker, joker);
+            } else  // Reuse pattern for ip==0
+            {
+              new_antenna = 0;
             }
+          }
 
-            // The response is zero if mblock_dlos is outside of
-            // antennna pattern
-            if (za < aresponse_za_grid[0] ||
-                za > aresponse_za_grid[n_ar_za - 1] ||
-                aa < aresponse_aa_grid[0] ||
-                aa > aresponse_aa_grid[n_ar_aa - 1]) {
-              hza[l] = 0;
+          // Calculate response weights
+          if (new_antenna) {
+            for (Index l = 0; l < n_dlos; l++) {
+              const Numeric za = mblock_dlos(l, 0) - antenna_dlos(ia, 0);
+              Numeric aa = 0.0;
+              if (mblock_dlos.ncols() > 1) {
+                aa += mblock_dlos(l, 1);
+              }
+              if (antenna_dlos.ncols() > 1) {
+                aa -= antenna_dlos(ia, 1);
+              }
+
+              // The response is zero if mblock_dlos is outside of
+              // antennna pattern
+              if (za < aresponse_za_grid[0] ||
+                  za > aresponse_za_grid[n_ar_za - 1] ||
+                  aa < aresponse_aa_grid[0] ||
+                  aa > aresponse_aa_grid[n_ar_aa - 1]) {
+                hza[l] = 0;
+              }
+              // Otherwise we make an (blue) interpolation
+              else {
+                ArrayOfGridPos gp_za(1), gp_aa(1);
+                gridpos(gp_za, aresponse_za_grid, Vector(1, za));
+                gridpos(gp_aa, aresponse_aa_grid, Vector(1, aa));
+                Matrix itw(1, 4);
+                interpweights(itw, gp_za, gp_aa);
+                Vector value(1);
+                interp(value, itw, aresponse, gp_za, gp_aa);
+                hza[l] = value[0];
+              }
             }
-            // Otherwise we make an (blue) interpolation
-            else {
-              ArrayOfGridPos gp_za(1), gp_aa(1);
-              gridpos(gp_za, aresponse_za_grid, Vector(1, za));
-              gridpos(gp_aa, aresponse_aa_grid, Vector(1, aa));
-              Matrix itw(1, 4);
-              interpweights(itw, gp_za, gp_aa);
-              Vector value(1);
-              interp(value, itw, aresponse, gp_za, gp_aa);
-              hza[l] = value[0];
+
+            // Normalisation?
+            if (do_norm) {
+              hza /= hza.sum();
             }
           }
 
-          // Normalisation?
-          if (do_norm) {
-            hza /= hza.sum();
-          }
+          // Put weights into H
+          //
+          const Index ii = f * n_pol + ip;
+          //
+          hrows.set_row(ia * nfpol + ii, hza, ii, nfpol);
         }
-
-        // Put weights into H
-        //
-        const Index ii = f * n_pol + ip;
-        //
-        hrow[Range(ii, n_dlos, nfpol)] = hza;
-        //
-        H.insert_row(ia * nfpol + ii, hrow);
-        //
-        hrow = 0;
+      }
+    } catch (const std::exception& x) {
+#pragma omp critical(antenna2d_basic_fail)
+      {
+        fail_msg = x.what();
+        failed = true;
       }
     }
   }
+
+  if (failed) throw runtime_error(fail_msg);
+
+  hrows.build(H);
 }
 
 //! gaussian_response_autogrid
@@ -559,37 +586,53 @@ void mixer_matrix(Sparse& H,
     e++;
   }
 
-  // Resize H
-  H.resize(f_mixer.nelem() * n_pol * n_sp, f_grid.nelem() * n_pol * n_sp);
+  // Rows of H, set in parallel for the mixer frequencies
+  SparseRowBuilder hrows(f_mixer.nelem() * n_pol * n_sp,
+                         f_grid.nelem() * n_pol * n_sp);
 
   // Calculate the sensor summation vector and insert the values in the
   // final matrix taking number of polarisations and zenith angles into
   // account.
-  Vector row_temp(f_grid.nelem());
-  Vector row_final(f_grid.nelem() * n_pol * n_sp);
-  //
   Vector if_grid = f_grid;
   if_grid -= lo;
   //
+  String fail_msg;
+  bool failed = false;
+  //
+#pragma omp parallel for if (!arts_omp_in_parallel() && f_mixer.nelem() > 1)
   for (Index i = 0; i < f_mixer.nelem(); i++) {
-    summation_by_vecmult(
-        row_temp, filter.data, filter_grid, if_grid, f_mixer[i], -f_mixer[i]);
-
-    // Normalise if flag is set
-    if (do_norm) row_temp /= row_temp.sum();
-
-    // Loop over number of polarisations
-    for (Index p = 0; p < n_pol; p++) {
-      // Loop over number of zenith angles/antennas
-      for (Index a = 0; a < n_sp; a++) {
-        // Distribute elements of row_temp to row_final.
-        row_final = 0.0;
-        row_final[Range(
-            a * f_grid.nelem() * n_pol + p, f_grid.nelem(), n_pol)] = row_temp;
-        H.insert_row(a * f_mixer.nelem() * n_pol + p + i * n_pol, row_final);
+    if (failed) continue;
+    try {
+      Vector row_temp(f_grid.nelem());
+      summation_by_vecmult(
+          row_temp, filter.data, filter_grid, if_grid, f_mixer[i], -f_mixer[i]);
+
+      // Normalise if flag is set
+      if (do_norm) row_temp /= row_temp.sum();
+
+      // Loop over number of polarisations
+      for (Index p = 0; p < n_pol; p++) {
+        // Loop over number of zenith angles/antennas
+        for (Index a = 0; a < n_sp; a++) {
+          // Distribute elements of row_temp to the row of H
+          hrows.set_row(a * f_mixer.nelem() * n_pol + p + i * n_pol,
+                        row_temp,
+                        a * f_grid.nelem() * n_pol + p,
+                        n_pol);
+        }
+      }
+    } catch (const std::exception& x) {
+#pragma omp critical(mixer_matrix_fail)
+      {
+        fail_msg = x.what();
+        failed = true;
       }
     }
   }
+
+  if (failed) throw runtime_error(fail_msg);
+
+  hrows.build(H);
 }
 
 //! mueller_rotation
@@ -707,7 +750,7 @@ void met_mm_polarisation_hmatrix(Sparse& H,
     */
 
   // Complete H, for all channels
-  H = Sparse(nch, nch * stokes_dim);
+  SparseRowBuilder hrows(nch, nch * stokes_dim);
 
   for (Index i = 0; i < nch; i++) {
     /*
@@ -754,12 +797,12 @@ void met_mm_polarisation_hmatrix(Sparse& H,
     // No rotation, just plane polarisation response
     if (rot[i] == "none") {
       // Here we just need to fill the row H
-      Vector hrow(nch * stokes_dim, 0.0);
+      Vector hrow(stokes_dim);
       /* Old code, matching older version of stokes2pol:
           hrow[Range(i*stokes_dim,pv[ipv].nelem())] = pv[ipv];
           */
-      stokes2pol(hrow[Range(i * stokes_dim, stokes_dim)], stokes_dim, ipol, w);
-      H.insert_row(i, hrow);
+      stokes2pol(hrow, stokes_dim, ipol, w);
+      hrows.set_row(i, hrow, i * stokes_dim);
     }
 
     // Rotation + pol-response
@@ -803,14 +846,15 @@ void met_mm_polarisation_hmatrix(Sparse& H,
       mult(Hc, Hpol, Hrot);
 
       // Put Hc into H
-      Vector hrow(nch * stokes_dim, 0.0);
-      const Index i0 = i * stokes_dim;
+      Vector hrow(stokes_dim);
       for (Index s = 0; s < stokes_dim; s++) {
-        hrow[i0 + s] = Hc(0, s);
+        hrow[s] = Hc(0, s);
       }
-      H.insert_row(i, hrow);
+      hrows.set_row(i, hrow, i * stokes_dim);
     }
   }
+
+  hrows.build(H);
 }
 
 //! sensor_aux_vectors
@@ -902,51 +946,62 @@ void spectrometer_matrix(Sparse& H,
   // If response data extend outside sensor_f is checked in
   // integration_func_by_vecmult
 
-  // Reisze H
+  // Size of H
   //
   const Index nin_f = sensor_f.nelem();
   const Index nout_f = ch_f.nelem();
   const Index nin = n_sp * nin_f * n_pol;
   const Index nout = n_sp * nout_f * n_pol;
   //
-  H.resize(nout, nin);
+  SparseRowBuilder hrows(nout, nin);
 
-  // Calculate the sensor integration vector and put values in the temporary
-  // vector, then copy vector to the transfer matrix
-  //
-  Vector ch_response_f;
-  Vector weights(nin_f);
-  Vector weights_long(nin, 0.0);
+  String fail_msg;
+  bool failed = false;
+
+  // Calculate the sensor integration vector and put values in the rows
+  // of the transfer matrix. The channels are handled in parallel.
   //
+#pragma omp parallel for if (!arts_omp_in_parallel() && nout_f > 1)
   for (Index ifr = 0; ifr < nout_f; ifr++) {
-    const Index irp = ifr * freq_full;
-
-    //The spectrometer response is shifted for each centre frequency step
-    ch_response_f = ch_response[irp].get_numeric_grid(GFIELD1_F_GRID);
-    ch_response_f += ch_f[ifr];
-
-    // Call *integration_func_by_vecmult* and store it in the temp vector
-    integration_func_by_vecmult(
-        weights, ch_response[irp].data, ch_response_f, sensor_f);
-
-    // Normalise if flag is set
-    if (do_norm) weights /= weights.sum();
-
-    // Loop over polarisation and spectra (viewing directions)
-    // Weights change only with frequency
-    for (Index sp = 0; sp < n_sp; sp++) {
-      for (Index pol = 0; pol < n_pol; pol++) {
-        // Distribute the compact weight vector into weight_long
-        weights_long[Range(sp * nin_f * n_pol + pol, nin_f, n_pol)] = weights;
-
-        // Insert temp_long into H at the correct row
-        H.insert_row(sp * nout_f * n_pol + ifr * n_pol + pol, weights_long);
-
-        // Reset weight_long to zero.
-        weights_long = 0.0;
+    if (failed) continue;
+    try {
+      const Index irp = ifr * freq_full;
+      Vector weights(nin_f);
+
+      //The spectrometer response is shifted for each centre frequency step
+      Vector ch_response_f = ch_response[irp].get_numeric_grid(GFIELD1_F_GRID);
+      ch_response_f += ch_f[ifr];
+
+      // Call *integration_func_by_vecmult* and store it in the temp vector
+      integration_func_by_vecmult(
+          weights, ch_response[irp].data, ch_response_f, sensor_f);
+
+      // Normalise if flag is set
+      if (do_norm) weights /= weights.sum();
+
+      // Loop over polarisation and spectra (viewing directions)
+      // Weights change only with frequency
+      for (Index sp = 0; sp < n_sp; sp++) {
+        for (Index pol = 0; pol < n_pol; pol++) {
+          // Distribute the compact weight vector into the row of H
+          hrows.set_row(sp * nout_f * n_pol + ifr * n_pol + pol,
+                        weights,
+                        sp * nin_f * n_pol + pol,
+                        n_pol);
+        }
+      }
+    } catch (const std::exception& x) {
+#pragma omp critical(spectrometer_matrix_fail)
+      {
+        fail_msg = x.what();
+        failed = true;
       }
     }
   }
+
+  if (failed) throw runtime_error(fail_msg);
+
+  hrows.build(H);
 }
 
 //! stokes2pol
@@ -1308,6 +1363,105 @@ void find_effective_channel_boundaries(  // Output:
     out2 << "  " << fmin[i] << "               " << fmax[i] << "\n";
 }
 
+//! oss_select_frequencies
+/*!
+   Selects representative frequencies of a channel, following the
+   optimal spectral sampling (OSS) method.
+
+   The channel value of each training case is approximated as a weighted
+   sum of the monochromatic values at a few frequencies. Frequencies are
+   added one at a time (orthogonal matching pursuit), each time taking
+   the candidate that reduces the fitting error most. The weights are the
+   least squares solution over the training cases. The selection stops
+   when the RMS error is below max_error, when max_nfreq frequencies are
+   selected, or when no candidate reduces the error.
+
+   \param   f_index     Out: Indices of the selected frequencies.
+   \param   weights     Out: Weight of each selected frequency.
+   \param   y_train     Monochromatic values, dimension [frequency, case].
+   \param   target      Channel value of each training case.
+   \param   candidates  Indices of the frequencies to select from.
+   \param   max_error   Target RMS error.
+   \param   max_nfreq   Maximum number of frequencies to select.
+   \return              RMS fitting error over the training cases.
+
+   \author ARTS developers
+*/
+Numeric oss_select_frequencies(ArrayOfIndex& f_index,
+                               Vector& weights,
+                               ConstMatrixView y_train,
+                               ConstVectorView target,
+                               const ArrayOfIndex& candidates,
+                               const Numeric& max_error,
+                               const Index& max_nfreq) {
+  const Index ncases = y_train.ncols();
+  const Index nmax = min(max_nfreq, ncases);
+
+  // Orthonormal basis of the selected frequencies (rows of q), and the
+  // matching upper triangular matrix, y_train(f_index,joker) = r' * q
+  Matrix q(nmax, ncases);
+  Matrix r(nmax, nmax, 0);
+  Vector residual = target;
+  Vector v(ncases);
+  ArrayOfIndex used(candidates.nelem(), 0);
+
+  f_index.resize(0);
+  Numeric error = sqrt((residual * residual) / (Numeric)ncases);
+
+  while (error > max_error && f_index.nelem() < nmax) {
+    const Index k = f_index.nelem();
+
+    Index best = -1;
+    Numeric best_gain = 0;
+    for (Index c = 0; c < candidates.nelem(); c++) {
+      if (used[c]) continue;
+      v = y_train(candidates[c], joker);
+      const Numeric norm0 = v * v;
+      for (Index j = 0; j < k; j++) {
+        const Numeric qv = q(j, joker) * v;
+        for (Index i = 0; i < ncases; i++) v[i] -= qv * q(j, i);
+      }
+      const Numeric norm = v * v;
+      // Skip candidates that are (almost) linearly dependent on the
+      // frequencies already selected
+      if (!(norm > 1e-12 * norm0)) continue;
+      const Numeric vr = v * residual;
+      const Numeric gain = vr * vr / norm;
+      if (gain > best_gain) {
+        best = c;
+        best_gain = gain;
+      }
+    }
+    if (best < 0) break;
+
+    v = y_train(candidates[best], joker);
+    for (Index j = 0; j < k; j++) {
+      r(j, k) = q(j, joker) * v;
+      for (Index i = 0; i < ncases; i++) v[i] -= r(j, k) * q(j, i);
+    }
+    r(k, k) = sqrt(v * v);
+    v /= r(k, k);
+    q(k, joker) = v;
+    const Numeric vr = v * residual;
+    for (Index i = 0; i < ncases; i++) residual[i] -= vr * v[i];
+
+    used[best] = 1;
+    f_index.push_back(candidates[best]);
+    error = sqrt((residual * residual) / (Numeric)ncases);
+  }
+
+  // Weights by back substitution of r * weights = q * target
+  const Index n = f_index.nelem();
+  weights.resize(n);
+  for (Index i = n - 1; i >= 0; i--) {
+    Numeric x = q(i, joker) * target;
+    for (Index j = i + 1; j < n; j++) x -= r(i, j) * weights[j];
+    weights[i] = x / r(i, i);
+  }
+
+  return error;
+}
+
 /*===========================================================================
   === Core integration and sum functions:
   ===========================================================================*/
@@ -94,6 +94,14 @@ void met_mm_polarisation_hmatrix(Sparse& H,
                                  const Index stokes_dim,
                                  const String& iy_unit);
 
+Numeric oss_select_frequencies(ArrayOfIndex& f_index,
+                               Vector& weights,
+                               ConstMatrixView y_train,
+                               ConstVectorView target,
+                               const ArrayOfIndex& candidates,
+                               const Numeric& max_error,
+                               const Index& max_nfreq);
+
 void sensor_aux_vectors(Vector& sensor_response_f,
                         ArrayOfIndex& sensor_response_pol,
                         Matrix& sensor_response_dlos,
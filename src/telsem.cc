@@ -27,6 +27,7 @@
 #include "telsem.h"
 #include <cmath>
 #include <utility>
+#include "arts_omp.h"
 #include "check_input.h"
 #include "geodetic.h"
 
@@ -129,6 +130,12 @@ void TelsemAtlas::equare() {
   for (Index i = 1; i < maxlat; ++i) {
     firstcells[i] = firstcells[i - 1] + ncells[i];
   }
+
+  cellnum_offsets.resize(maxlat);
+  cellnum_offsets[0] = 0;
+  for (Index i = 1; i < maxlat; ++i) {
+    cellnum_offsets[i] = cellnum_offsets[i - 1] + ncells[i - 1];
+  }
 }
 
 void TelsemAtlas::telsem_calc_correspondence() {
@@ -159,16 +166,11 @@ Index TelsemAtlas::calc_cellnum(Numeric lat, Numeric lon) const {
     lat -= 0.125;
   }
 
-  Index cellnum = 0;
   Index ilat = static_cast<Index>((lat + 90.0) / dlat);
   Index ilon =
       static_cast<Index>(lon / (360.0 / static_cast<Numeric>(ncells[ilat]))) +
       1;
-  for (Index i = 0; i < ilat; ++i) {
-    cellnum += ncells[i];
-  }
-  cellnum += ilon;
-  return cellnum;
+  return cellnum_offsets[ilat] + ilon;
 }
 
 Index TelsemAtlas::calc_cellnum_nearest_neighbor(Numeric lat,
@@ -226,6 +228,34 @@ Index TelsemAtlas::calc_cellnum_nearest_neighbor(Numeric lat,
   }
 }
 
+Index TelsemAtlas::calc_cellnum_checked(Numeric lat,
+                                        Numeric lon,
+                                        Numeric d_max) const {
+  Index cellnumber = 0;
+  if (d_max <= 0.0) {
+    cellnumber = calc_cellnum(lat, lon);
+    if (!contains(cellnumber)) {
+      throw std::runtime_error(
+          "Given coordinates are not contained in "
+          " TELSEM atlas. To enable nearest neighbor"
+          "interpolation set *d_max* to a positive "
+          "value.");
+    }
+  } else {
+    cellnumber = calc_cellnum_nearest_neighbor(lat, lon);
+    Numeric lat_nn, lon_nn;
+    std::tie(lat_nn, lon_nn) = get_coordinates(cellnumber);
+    Numeric d = sphdist(lat, lon, lat_nn, lon_nn);
+    if (d > d_max) {
+      std::ostringstream out{};
+      out << "Distance of nearest neighbor exceeds provided limit (";
+      out << d << " > " << d_max << ").";
+      throw std::runtime_error(out.str());
+    }
+  }
+  return cellnumber;
+}
+
 std::pair<Numeric, Numeric> TelsemAtlas::get_coordinates(Index cellnum) const {
   Index index_lat_max = static_cast<Index>(180.0 / dlat);
   Index index_lat = -1;
@@ -295,8 +325,8 @@ std::pair<Numeric, Numeric> TelsemAtlas::emis_interp(
     Index class2,
     const ConstVectorView& ev,
     const ConstVectorView& eh) const {
-  Vector emiss_scal_h(3);
-  Vector emiss_scal_v(3);
+  std::array<Numeric, 3> emiss_scal_h;
+  std::array<Numeric, 3> emiss_scal_v;
 
   for (Index i = 0; i < 3; ++i) {
     Numeric e0 = a0_k0[i + (class1 - 1) * 3] +
@@ -343,6 +373,60 @@ std::pair<Numeric, Numeric> TelsemAtlas::emis_interp(
   return std::make_pair(emiss_v, emiss_h);
 }
 
+void TelsemAtlas::emis_interp_batch(Matrix& emis_vh,
+                                    const ConstVectorView& lat,
+                                    const ConstVectorView& lon,
+                                    const ConstVectorView& theta,
+                                    const ConstVectorView& freq,
+                                    Numeric d_max) const {
+  const Index n = lat.nelem();
+  if (lon.nelem() != n || theta.nelem() != n || freq.nelem() != n) {
+    throw std::runtime_error(
+        "The latitude, longitude, incidence angle and frequency inputs "
+        "must all have the same length.");
+  }
+
+  emis_vh.resize(n, 2);
+
+  bool failed = false;
+  String fail_msg;
+
+#pragma omp parallel if (!arts_omp_in_parallel() && n > 1)
+  {
+    // Thread-local buffers, re-used for all queries of this thread.
+    Vector ev(3), eh(3);
+
+#pragma omp for schedule(static)
+    for (Index i = 0; i < n; ++i) {
+      if (failed) continue;
+      try {
+        const Index cellnumber = calc_cellnum_checked(lat[i], lon[i], d_max);
+        const Index ind = correspondence[cellnumber];
+        ev[0] = emis(ind, 0);
+        ev[1] = emis(ind, 3);
+        ev[2] = emis(ind, 5);
+        eh[0] = emis(ind, 1);
+        eh[1] = emis(ind, 4);
+        eh[2] = emis(ind, 6);
+        std::tie(emis_vh(i, 0), emis_vh(i, 1)) = emis_interp(
+            theta[i], freq[i], classes1[ind], classes2[ind], ev, eh);
+      } catch (const std::exception& e) {
+        std::ostringstream os;
+        os << "Error at TELSEM query " << i << ": " << e.what();
+#pragma omp critical(TelsemAtlas_emis_interp_batch_fail)
+        {
+          failed = true;
+          fail_msg = os.str();
+        }
+      }
+    }
+  }
+
+  if (failed) {
+    throw std::runtime_error(fail_msg);
+  }
+}
+
 std::ostream& operator<<(std::ostream& os, const TelsemAtlas& ta) {
   os << ta.name << std::endl;
   return os;
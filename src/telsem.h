@@ -233,6 +233,21 @@ class TelsemAtlas {
      */
   Index calc_cellnum_nearest_neighbor(Numeric lat, Numeric lon) const;
 
+  /*! Compute the cellnumber to use for the given coordinates.
+     *
+     * If d_max is not positive, the cell containing the given coordinates
+     * is returned and a runtime error is thrown if it is not contained
+     * in the atlas. Otherwise the nearest neighbor contained in the atlas
+     * is returned, provided that its distance does not exceed d_max.
+     *
+     * @param[in] lat The latitude coordinate.
+     * @param[in] lon The longitude coordinate.
+     * @param[in] d_max The maximum allowed distance for nearest neighbor
+     *                  interpolation in meters.
+     * @return The cellnumber.
+     */
+  Index calc_cellnum_checked(Numeric lat, Numeric lon, Numeric d_max) const;
+
   /*! Compute corrdinates of a given cell.
      *
      * @param[in] cellnum The cell number for which to compute the coordinates.
@@ -279,6 +294,29 @@ class TelsemAtlas {
                                           const ConstVectorView &ev,
                                           const ConstVectorView &eh) const;
 
+  /*! Compute emissivities for a batch of queries.
+     *
+     * Evaluates the TELSEM model for n queries, each given by latitude,
+     * longitude, incidence angle and frequency. Cell lookup and
+     * interpolation of all queries is done in one OpenMP parallel pass
+     * without any per-query allocations.
+     *
+     * @param[out] emis_vh Matrix of size (n, 2) containing the vertical
+     *                     and horizontal emissivities.
+     * @param[in] lat The latitudes of the queries.
+     * @param[in] lon The longitudes of the queries, in [0, 360].
+     * @param[in] theta The incidence angles of the queries.
+     * @param[in] freq The frequencies of the queries in GHz (!!!)
+     * @param[in] d_max The maximum allowed distance for nearest neighbor
+     *                  interpolation, see calc_cellnum_checked(...).
+     */
+  void emis_interp_batch(Matrix &emis_vh,
+                         const ConstVectorView &lat,
+                         const ConstVectorView &lon,
+                         const ConstVectorView &theta,
+                         const ConstVectorView &freq,
+                         Numeric d_max) const;
+
   friend std::ostream &operator<<(std::ostream &os, const TelsemAtlas &ta);
   friend void xml_write_to_stream(ostream &,
                                   const TelsemAtlas &,
@@ -306,6 +344,8 @@ class TelsemAtlas {
   ArrayOfIndex ncells;
   // The first cell number of lat band.
   ArrayOfIndex firstcells;
+  // Number of cells in all lat bands south of a given lat band.
+  ArrayOfIndex cellnum_offsets;
   // Emissivities
   Matrix emis;
   // Emissivity uncertainties.
@@ -126,3 +126,77 @@ void tessem_prop_nn(VectorView& ny, const TessemNN& net, ConstVectorView nx) {
   for (Index i = 0; i < net.nb_outputs; i++)
     ny[i] = net.y_min[i] + (new_y[i] + 1.) / 2. * (net.y_max[i] - net.y_min[i]);
 }
+
+/*! Batched Tessem emissivity calculation
+
+  Same as tessem_prop_nn, but evaluates the network for several input
+  vectors at once. Each row of nx holds one input vector, with the same
+  layout as for tessem_prop_nn, and the corresponding row of ny receives
+  the network output.
+
+  The two layers are evaluated as matrix-matrix products and the
+  activation function is applied in one pass over the contiguous hidden
+  layer, which is much faster than calling tessem_prop_nn for each input
+  vector separately.
+
+  \param[out] ny  Calculated emissivities, size (n, nb_outputs).
+  \param[in] net  Neural network parameters.
+  \param[in] nx  Input data, size (n, nb_inputs).
+*/
+void tessem_prop_nn_batch(MatrixView ny,
+                          const TessemNN& net,
+                          ConstMatrixView nx) {
+  const Index n = nx.nrows();
+
+  if (nx.ncols() != net.nb_inputs) {
+    ostringstream os;
+    os << "Tessem NN requires " << net.nb_inputs
+       << " values, but input matrix has " << nx.ncols() << " columns.";
+    throw std::runtime_error(os.str());
+  }
+
+  if (ny.nrows() != n || ny.ncols() != net.nb_outputs) {
+    ostringstream os;
+    os << "Tessem NN generates " << net.nb_outputs << " values for " << n
+       << " inputs, but output matrix has size (" << ny.nrows() << ", "
+       << ny.ncols() << ").";
+    throw std::runtime_error(os.str());
+  }
+
+  if (!n) return;
+
+  // preprocessing
+  Vector scale(net.nb_inputs), offset(net.nb_inputs);
+  for (Index j = 0; j < net.nb_inputs; j++) {
+    scale[j] = 2. / (net.x_max[j] - net.x_min[j]);
+    offset[j] = -1. - net.x_min[j] * scale[j];
+  }
+  scale[0] *= 1e-9;
+  scale[4] *= 1e3;
+
+  Matrix new_x(n, net.nb_inputs);
+  for (Index k = 0; k < n; k++)
+    for (Index j = 0; j < net.nb_inputs; j++)
+      new_x(k, j) = nx(k, j) * scale[j] + offset[j];
+
+  // propagation, hidden layer
+  Matrix trans(n, net.nb_cache);
+  mult(trans, new_x, transpose(net.w1));
+
+  const Numeric* b1 = net.b1.get_c_array();
+  Numeric* t = trans.get_c_array();
+  for (Index k = 0; k < n; k++, t += net.nb_cache) {
+    for (Index i = 0; i < net.nb_cache; i++)
+      t[i] = 2. / (1. + exp(-2. * (t[i] + b1[i]))) - 1.;
+  }
+
+  // propagation, output layer
+  Matrix new_y(n, net.nb_outputs);
+  mult(new_y, trans, transpose(net.w2));
+
+  // postprocessing
+  for (Index k = 0; k < n; k++)
+    for (Index i = 0; i < net.nb_outputs; i++)
+      ny(k, i) = net.y_min[i] + (new_y(k, i) + net.b2[i] + 1.) / 2. *
+                                    (net.y_max[i] - net.y_min[i]);
+}
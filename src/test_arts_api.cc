@@ -0,0 +1,158 @@
+/* Copyright (C) 2020
+   ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   test_arts_api.cc
+  \author ARTS developers
+  \date   2020-06-12
+
+  \brief  Tests of views of external memory in the C API.
+*/
+
+#include <cstring>
+#include <iostream>
+
+#include "arts_api.h"
+
+//! Index of the group with the given name.
+long group_id(const char *name) {
+  for (unsigned long i = 0; i < get_number_of_groups(); ++i) {
+    if (strcmp(get_group_name(static_cast<int>(i)), name) == 0) return i;
+  }
+  return -1;
+}
+
+//! Index of the method with the given name.
+long method_id(const char *name) {
+  for (unsigned long i = 0; i < get_number_of_methods(); ++i) {
+    if (strcmp(get_method(i).name, name) == 0) return i;
+  }
+  return -1;
+}
+
+//! Report a failed check and count it.
+void check(bool ok, const char *what, int &n_failed) {
+  std::cout << "\t" << what << ": " << (ok ? "OK" : "FAILED") << std::endl;
+  if (!ok) ++n_failed;
+}
+
+/** Test that views are only used as input.
+ *
+ * A vector is bound to external memory. Reading it from a method must
+ * work, while methods and agendas writing to it must fail. This includes
+ * agendas that only write to it through the agendas they execute.
+ *
+ * @return The number of failed checks.
+ */
+int test_views() {
+  int n_failed = 0;
+  InteractiveWorkspace *ws = create_workspace();
+
+  const long vector_group = group_id("Vector");
+  const long numeric_group = group_id("Numeric");
+  const long index_group = group_id("Index");
+  const long agenda_group = group_id("Agenda");
+
+  const long view = add_variable(ws, vector_group, "view");
+  const long copy = add_variable(ws, vector_group, "copy");
+  const long value = add_variable(ws, numeric_group, "value");
+  const long start = add_variable(ws, index_group, "start");
+  const long stop = add_variable(ws, index_group, "stop");
+  const long forloop_agenda = lookup_workspace_variable("forloop_agenda");
+
+  Numeric data[3] = {1.0, 2.0, 3.0};
+  VariableValueStruct v{};
+  v.ptr = data;
+  v.initialized = true;
+  v.dimensions[0] = 3;
+  check(set_variable_view(ws, view, vector_group, v) == nullptr,
+        "Binding vector to external memory",
+        n_failed);
+
+  Numeric one = 1.0;
+  Index zero = 0;
+  v = VariableValueStruct{};
+  v.ptr = &one;
+  set_variable_value(ws, value, numeric_group, v);
+  v.ptr = &zero;
+  set_variable_value(ws, start, index_group, v);
+  set_variable_value(ws, stop, index_group, v);
+
+  // Reading the view.
+  const long add_scalar = method_id("VectorAddScalar");
+  long out[1] = {copy};
+  long in[2] = {view, value};
+  check(execute_workspace_method(ws, add_scalar, 1, out, 2, in) == nullptr,
+        "Method reading view",
+        n_failed);
+  VariableValueStruct r = get_variable_value(ws, copy, vector_group);
+  const Numeric *c = reinterpret_cast<const Numeric *>(r.ptr);
+  check(r.dimensions[0] == 3 && c[0] == 2.0 && c[2] == 4.0,
+        "Result of method reading view",
+        n_failed);
+
+  // Writing the view directly.
+  out[0] = view;
+  in[0] = copy;
+  check(execute_workspace_method(ws, add_scalar, 1, out, 2, in) != nullptr,
+        "Method writing view",
+        n_failed);
+
+  // Writing the view from forloop_agenda, executed by ForLoop.
+  Agenda *inner = create_agenda("forloop_agenda");
+  agenda_add_method(inner, add_scalar, 1, out, 2, in);
+  v.ptr = inner;
+  set_variable_value(ws, forloop_agenda, agenda_group, v);
+
+  const long for_loop = method_id("ForLoop");
+  long loop_in[4] = {forloop_agenda, start, stop, stop};
+  check(execute_workspace_method(ws, for_loop, 0, nullptr, 4, loop_in) !=
+            nullptr,
+        "Method executing agenda writing view",
+        n_failed);
+
+  Agenda *outer = create_agenda("outer");
+  agenda_add_method(outer, for_loop, 0, nullptr, 4, loop_in);
+  check(execute_agenda(ws, outer) != nullptr,
+        "Agenda executing agenda writing view",
+        n_failed);
+
+  // The external memory must be untouched.
+  check(data[0] == 1.0 && data[1] == 2.0 && data[2] == 3.0,
+        "External memory unchanged",
+        n_failed);
+
+  // After release, the variable can be written.
+  release_variable_view(ws, view);
+  check(execute_agenda(ws, outer) == nullptr,
+        "Agenda writing released view",
+        n_failed);
+
+  destroy_agenda(inner);
+  destroy_agenda(outer);
+  destroy_workspace(ws);
+  return n_failed;
+}
+
+int main() {
+  initialize();
+  std::cout << "Testing views of external memory:" << std::endl;
+  const int n_failed = test_views();
+  finalize();
+  return n_failed == 0 ? 0 : -1;
+}
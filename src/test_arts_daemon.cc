@@ -0,0 +1,262 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   test_arts_daemon.cc
+
+  \brief  Test of the arts execution daemon.
+
+  Starts arts in daemon mode, given by the path to the arts executable
+  as the only argument, and sends requests to it. See arts_daemon.h for
+  the protocol.
+*/
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static int connect_to(const std::string& path) {
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd >= 0 && connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0) return fd;
+  if (fd >= 0) close(fd);
+  return -1;
+}
+
+static bool write_bytes(int fd, const char* buf, size_t n) {
+  while (n) {
+    ssize_t r = send(fd, buf, n, MSG_NOSIGNAL);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    buf += r;
+    n -= static_cast<size_t>(r);
+  }
+  return true;
+}
+
+static bool read_bytes(int fd, char* buf, size_t n) {
+  while (n) {
+    ssize_t r = recv(fd, buf, n, 0);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    buf += r;
+    n -= static_cast<size_t>(r);
+  }
+  return true;
+}
+
+static bool write_integer(int fd, uint64_t i) {
+  return write_bytes(fd, reinterpret_cast<const char*>(&i), sizeof(i));
+}
+
+static bool write_string(int fd, const std::string& s) {
+  return write_integer(fd, s.size()) && write_bytes(fd, s.data(), s.size());
+}
+
+static bool read_integer(int fd, uint64_t& i) {
+  return read_bytes(fd, reinterpret_cast<char*>(&i), sizeof(i));
+}
+
+static bool read_string(int fd, std::string& s) {
+  uint64_t n;
+  if (!read_integer(fd, n) || n > (uint64_t(1) << 30)) return false;
+  s.assign(n, '\0');
+  return !n || read_bytes(fd, &s[0], n);
+}
+
+//! Send a request that modifies the Numeric value and returns it.
+/*!
+  \return true if the request succeeded and gave the expected value.
+*/
+static bool request_value(
+    const std::string& socket_path,
+    double expected,
+    const std::string& body = "NumericAdd(value, value, 1)") {
+  int fd = connect_to(socket_path);
+  if (fd < 0) return false;
+
+  bool ok = write_string(fd, body) &&
+            write_integer(fd, 0) && write_integer(fd, 1) &&
+            write_string(fd, "value");
+
+  uint64_t status = 1;
+  std::string xml, bin;
+  ok = ok && read_integer(fd, status) && status == 0 && read_string(fd, xml) &&
+       read_string(fd, bin);
+  close(fd);
+
+  double value = 0;
+  if (ok && bin.size() == sizeof(value))
+    memcpy(&value, bin.data(), sizeof(value));
+  return ok && value == expected;
+}
+
+static void check(bool ok, const char* what, int& n_failed) {
+  std::cout << "\t" << what << ": " << (ok ? "OK" : "FAILED") << std::endl;
+  if (!ok) ++n_failed;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: test_arts_daemon <path to arts>\n";
+    return 1;
+  }
+
+  const char* tmp = getenv("TMPDIR");
+  std::string dir =
+      std::string(tmp ? tmp : "/tmp") + "/test_arts_daemon_XXXXXX";
+  if (!mkdtemp(&dir[0])) {
+    std::cerr << "Cannot create temporary directory.\n";
+    return 1;
+  }
+  const std::string controlfile = dir + "/setup.arts";
+  const std::string socket_path = dir + "/socket";
+  {
+    std::ofstream cf(controlfile.c_str());
+    cf << "Arts2 {\nNumericCreate(value)\nNumericSet(value, 1.5)\n"
+       << "NumericSet(lat, 0)\nNumericSet(lon, 0)\nNumericSet(g0, 0.5)\n"
+       << "AgendaSet(g0_agenda) {\nIgnore(lat)\nIgnore(lon)\n"
+       << "NumericAdd(g0, value, 1)\n}\n}\n";
+  }
+
+  // A path that is not a socket must not be replaced.
+  const std::string file_path = dir + "/file";
+  {
+    std::ofstream f(file_path.c_str());
+    f << "data\n";
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    execl(argv[1],
+          argv[1],
+          "-r000",
+          "-u",
+          file_path.c_str(),
+          controlfile.c_str(),
+          (char*)NULL);
+    _exit(127);
+  }
+  int exit_status = -1;
+  waitpid(pid, &exit_status, 0);
+  struct stat st;
+  const bool file_kept =
+      lstat(file_path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+  unlink(file_path.c_str());
+
+  pid = fork();
+  if (pid == 0) {
+    execl(argv[1],
+          argv[1],
+          "-r000",
+          "-u",
+          socket_path.c_str(),
+          controlfile.c_str(),
+          (char*)NULL);
+    _exit(127);
+  }
+
+  // Wait for the daemon to listen.
+  int fd = -1;
+  for (int i = 0; i < 600 && fd < 0; i++) {
+    fd = connect_to(socket_path);
+    if (fd < 0) usleep(100000);
+  }
+  if (fd < 0) {
+    std::cerr << "Daemon did not start.\n";
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    return 1;
+  }
+  close(fd);
+
+  int n_failed = 0;
+  std::cout << "Testing arts daemon:" << std::endl;
+
+  check(WIFEXITED(exit_status) && WEXITSTATUS(exit_status) != 0 && file_kept,
+        "Path that is not a socket kept",
+        n_failed);
+
+  check(stat(socket_path.c_str(), &st) == 0 && (st.st_mode & 0777) == 0600,
+        "Socket only accessible by user",
+        n_failed);
+
+  check(request_value(socket_path, 2.5), "Request", n_failed);
+  check(request_value(socket_path, 2.5),
+        "Request sees setup workspace",
+        n_failed);
+
+  // Variables set inside agendas are restored as well.
+  check(request_value(
+            socket_path, 2.5, "AgendaExecute(g0_agenda)\nCopy(value, g0)"),
+        "Agenda request",
+        n_failed);
+  check(request_value(socket_path, 1.5, "NumericAdd(value, g0, 1)"),
+        "Agenda request sees setup workspace",
+        n_failed);
+
+  // A too long string closes the connection without a response.
+  fd = connect_to(socket_path);
+  uint64_t status;
+  check(fd >= 0 && write_integer(fd, uint64_t(1) << 40) &&
+            !read_integer(fd, status),
+        "Too long string rejected",
+        n_failed);
+  if (fd >= 0) close(fd);
+
+  // As does a too large number of variables.
+  fd = connect_to(socket_path);
+  check(fd >= 0 && write_string(fd, "Touch(value)") &&
+            write_integer(fd, uint64_t(1) << 40) && !read_integer(fd, status),
+        "Too many variables rejected",
+        n_failed);
+  if (fd >= 0) close(fd);
+
+  check(request_value(socket_path, 2.5),
+        "Request after rejected requests",
+        n_failed);
+
+  // An empty body shuts the daemon down.
+  fd = connect_to(socket_path);
+  if (fd >= 0) {
+    write_integer(fd, 0);
+    close(fd);
+  }
+  exit_status = -1;
+  waitpid(pid, &exit_status, 0);
+  check(WIFEXITED(exit_status) && WEXITSTATUS(exit_status) == 0,
+        "Shut down",
+        n_failed);
+
+  unlink(controlfile.c_str());
+  unlink(socket_path.c_str());
+  rmdir(dir.c_str());
+
+  return n_failed == 0 ? 0 : 1;
+}
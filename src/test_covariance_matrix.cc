@@ -309,6 +309,46 @@ Numeric test_inverse(Index n_tests) {
   return e;
 }
 
+/**
+ * Test inverse of a banded covariance matrix, which is factorized using a
+ * sparse Cholesky decomposition.
+ *
+ * @param  n_tests The number of tests to perform.
+ * @return The maximum error of the solution of a linear system multiplied
+ * by the covariance matrix with respect to the right-hand side.
+ */
+Numeric test_banded_inverse(Index n_tests) {
+  Numeric e = 0.0;
+  for (Index i = 0; i < n_tests; i++) {
+    Index n = 2000;
+    std::shared_ptr<Sparse> s = std::make_shared<Sparse>(n, n);
+    for (Index j = 0; j < n; j++) {
+      s->rw(j, j) = 2.0;
+      if (j + 1 < n) {
+        s->rw(j, j + 1) = -0.5;
+        s->rw(j + 1, j) = -0.5;
+      }
+    }
+    CovarianceMatrix covmat{};
+    covmat.add_correlation(
+        Block(Range(0, n), Range(0, n), std::make_pair(0, 0), s));
+    covmat.compute_inverse();
+
+    Vector v(n), w(n), v_ref(n);
+    random_fill_vector(v_ref, 10.0, false);
+    solve(w, covmat, v_ref);
+    mult(v, covmat, w);
+    e = std::max(e, get_maximum_error(v, v_ref, true));
+
+    Matrix B(n, 3), C(n, 3), B_ref(n, 3);
+    random_fill_matrix(B_ref, 10.0, false);
+    mult_inv(C, covmat, B_ref);
+    mult(B, covmat, C);
+    e = std::max(e, get_maximum_error(B, B_ref, true));
+  }
+  return e;
+}
+
 /**
  * Test addition of covariance matrices and inverse covariance matrices.
  *
@@ -396,6 +436,44 @@ Numeric test_io(Index n_tests) {
   return 0.0;
 }
 
+/**
+ * Test the inverse blocks of computed inverses.
+ *
+ * @param  n_tests The number of tests to perform
+ * @return The maximum error of the inverse assembled from the inverse blocks
+ * and of the inverse of a covariance matrix that has been stored to xml
+ * format and reread.
+ */
+Numeric test_inverse_blocks(Index n_tests) {
+  Numeric e(0.0);
+  for (Index i = 0; i < n_tests; i++) {
+    ArrayOfArrayOfIndex jis;
+    ArrayOfRetrievalQuantity rqs;
+    std::tie(rqs, jis) = setup_retrieval_1D();
+    CovarianceMatrix covmat_1(random_covariance_matrix(rqs, jis)), covmat_2{};
+    covmat_1.compute_inverse();
+
+    Index n = covmat_1.nrows();
+    Matrix A(covmat_1.get_inverse()), B(n, n);
+    B = 0.0;
+    for (const Block& b : covmat_1.get_inverse_blocks()) {
+      MatrixView Bview = B(b.get_row_range(), b.get_column_range());
+      Bview = b.get_dense();
+      Index bi, bj;
+      std::tie(bi, bj) = b.get_indices();
+      if (bi != bj) {
+        B(b.get_column_range(), b.get_row_range()) = transpose(b.get_dense());
+      }
+    }
+    e = std::max(e, get_maximum_error(A, B, true));
+
+    xml_write_to_file("test.xml", covmat_1, FILE_TYPE_ASCII, 0, Verbosity());
+    xml_read_from_file("test.xml", covmat_2, Verbosity());
+    e = std::max(e, get_maximum_error(A, covmat_2.get_inverse(), true));
+  }
+  return e;
+}
+
 template <typename MatrixType>
 void covmat_seSet(CovarianceMatrix& covmat,
                   const MatrixType& block,
@@ -622,6 +700,13 @@ int main() {
     return -1;
   }
 
+  e = test_banded_inverse(2);
+  std::cout << "\tBanded Inverse:          " << e << std::endl;
+  e_max = std::max(e, e_max);
+  if (e_max > 1e-5) {
+    return -1;
+  }
+
   e = test_io(10);
   std::cout << "\tXML IO:                  " << e << std::endl;
   e_max = std::max(e, e_max);
@@ -629,6 +714,13 @@ int main() {
     return -1;
   }
 
+  e = test_inverse_blocks(10);
+  std::cout << "\tInverse Blocks:          " << e << std::endl;
+  e_max = std::max(e, e_max);
+  if (e_max > 1e-5) {
+    return -1;
+  }
+
   e = test_invlib_wrapper(10);
   std::cout << "\tinvlib Wrapper:          " << e << std::endl;
   e_max = std::max(e, e_max);
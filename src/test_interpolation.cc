@@ -560,4 +560,55 @@ void test08() {
   }
 }
 
-int main() { test08(); }
+template <Index N>
+Numeric test09_max_diff(ConstVectorView og,
+                        ConstVectorView ng,
+                        ConstVectorView of) {
+  ArrayOfGridPosPoly gp(ng.nelem());
+  gridpos_poly(gp, og, ng, N);
+  Matrix itw(gp.nelem(), N + 1);
+  interpweights(itw, gp);
+  Vector nf(ng.nelem());
+  interp(nf, itw, of, gp);
+
+  Numeric max_diff = 0;
+  for (Index i = 0; i < ng.nelem(); ++i) {
+    FixedGridPosPoly<N> fgp;
+    gridpos_poly(fgp, og, ng[i]);
+    for (Index j = 0; j < N + 1; ++j)
+      if (fgp.idx[j] != gp[i].idx[j]) {
+        cout << "Index mismatch for order " << N << " at point " << i
+             << "\n";
+        return -1;
+      }
+    max_diff = max(max_diff, abs(interp(of, fgp) - nf[i]));
+    max_diff = max(
+        max_diff, abs(interp_poly_point(of, og, ng[i], N) - nf[i]));
+  }
+  return max_diff;
+}
+
+void test09() {
+  cout << "Fixed order polynomial interpolation, compared to GridPosPoly.\n";
+
+  Vector og(1, 5, +1);    // 1, 2, 3, 4, 5
+  Vector ng(0.5, 21, 0.25);  // 0.5, 0.75, ... 5.5
+  Vector of(og.nelem());
+  for (Index i = 0; i < og.nelem(); ++i) of[i] = sin(og[i]);
+
+  cout << "order 0: " << test09_max_diff<0>(og, ng, of) << "\n";
+  cout << "order 1: " << test09_max_diff<1>(og, ng, of) << "\n";
+  cout << "order 2: " << test09_max_diff<2>(og, ng, of) << "\n";
+  cout << "order 3: " << test09_max_diff<3>(og, ng, of) << "\n";
+
+  // Descending grid
+  Vector og_desc(5, 5, -1);  // 5, 4, 3, 2, 1
+  for (Index i = 0; i < og.nelem(); ++i) of[i] = sin(og_desc[i]);
+  cout << "order 3, descending grid: "
+       << test09_max_diff<3>(og_desc, ng, of) << "\n";
+}
+
+int main() {
+  test08();
+  test09();
+}
@@ -0,0 +1,235 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   test_ppath.cc
+  \author ARTS developers
+  \date   2020-06-02
+
+  \brief  Test of the analytic determination of 3D geometric path steps.
+
+  Paths are followed step by step, both with the analytic end point search
+  and the bisection search of ppath_step_geom_3d. The analytic path must
+  contain all step end points of the bisection, and may only add steps
+  ending at a pressure level. The
+  atmosphere has tilted pressure levels and a varying surface, and both a
+  spherical and an ellipsoidal planet are tested.
+*/
+
+#include <cmath>
+#include <iostream>
+#include "arts.h"
+#include "interpolation.h"
+#include "matpackIII.h"
+#include "messages.h"
+#include "ppath.h"
+
+extern const Numeric DEG2RAD;
+
+//! Follow a path from the sensor to its end.
+/*!
+  \param steps    End points of all steps, one row per step, holding
+                  radius, latitude, longitude and the fractional grid
+                  positions in pressure, latitude and longitude.
+  \return         False if the path left the lat/lon grids.
+*/
+bool follow_path(Matrix& steps,
+                 const Vector& p_grid,
+                 const Vector& lat_grid,
+                 const Vector& lon_grid,
+                 const Tensor3& z_field,
+                 const Vector& refellipsoid,
+                 const Matrix& z_surface,
+                 const Vector& rte_pos,
+                 const Vector& rte_los,
+                 const bool analytic) {
+  const Verbosity verbosity(0, 0, 0);
+  const Index imax_p = p_grid.nelem() - 1;
+  const Index imax_lat = lat_grid.nelem() - 1;
+  const Index imax_lon = lon_grid.nelem() - 1;
+
+  Ppath ppath;
+  ppath_start_stepping(ppath,
+                       3,
+                       p_grid,
+                       lat_grid,
+                       lon_grid,
+                       z_field,
+                       refellipsoid,
+                       z_surface,
+                       0,
+                       ArrayOfIndex(0),
+                       false,
+                       rte_pos,
+                       rte_los,
+                       verbosity);
+
+  Array<Vector> rows;
+  while (!ppath_what_background(ppath)) {
+    ppath_step_geom_3d(ppath,
+                       lat_grid,
+                       lon_grid,
+                       z_field,
+                       refellipsoid,
+                       z_surface,
+                       -1,
+                       analytic);
+    const Index n = ppath.np - 1;
+
+    Vector row(6);
+    row[0] = ppath.r[n];
+    row[1] = ppath.pos(n, 1);
+    row[2] = ppath.pos(n, 2);
+    row[3] = fractional_gp(ppath.gp_p[n]);
+    row[4] = fractional_gp(ppath.gp_lat[n]);
+    row[5] = fractional_gp(ppath.gp_lon[n]);
+    rows.push_back(row);
+
+    if (is_gridpos_at_index_i(ppath.gp_lat[n], 0) ||
+        is_gridpos_at_index_i(ppath.gp_lat[n], imax_lat) ||
+        is_gridpos_at_index_i(ppath.gp_lon[n], 0) ||
+        is_gridpos_at_index_i(ppath.gp_lon[n], imax_lon))
+      return false;
+    if (is_gridpos_at_index_i(ppath.gp_p[n], imax_p) ||
+        (abs(ppath.los(n, 0)) < 90 &&
+         is_gridpos_at_index_i(ppath.gp_p[n], imax_p, false)))
+      ppath_set_background(ppath, 1);
+    if (rows.nelem() > 10000) return false;
+  }
+
+  steps.resize(rows.nelem(), 6);
+  for (Index i = 0; i < rows.nelem(); i++) steps(i, joker) = rows[i];
+  return true;
+}
+
+//! Check if two step end points, as given by follow_path, agree.
+bool same_step(ConstVectorView a, ConstVectorView b) {
+  bool ok = abs(a[0] - b[0]) < 0.1 && abs(a[1] - b[1]) < 1e-5 &&
+            abs(a[2] - b[2]) < 1e-5;
+  for (Index j = 3; ok && j < 6; j++) ok = abs(a[j] - b[j]) < 1e-3;
+  return ok;
+}
+
+//! Compare analytic and bisection path steps for a set of geometries.
+/*!
+  \return The number of failed cases.
+*/
+Index test_analytic_steps(const Vector& refellipsoid) {
+  // Grids as in TestPpath3D.arts, with coarse cells in longitude
+  Vector p_grid(41), lat_grid(21), lon_grid(21);
+  for (Index i = 0; i < 41; i++) p_grid[i] = 1000e2 * pow(1e-5, (Numeric)i / 40);
+  for (Index i = 0; i < 21; i++) lat_grid[i] = 35 + (Numeric)i;
+  for (Index i = 0; i < 21; i++) lon_grid[i] = -40 + 4 * (Numeric)i;
+
+  // Tilted pressure levels and a varying surface
+  Tensor3 z_field(41, 21, 21);
+  Matrix z_surface(21, 21);
+  for (Index ilat = 0; ilat < 21; ilat++) {
+    for (Index ilon = 0; ilon < 21; ilon++) {
+      const Numeric lat = lat_grid[ilat], lon = lon_grid[ilon];
+      const Numeric tilt = 1 + 0.02 * sin(DEG2RAD * 20 * (lat - 45)) +
+                           0.01 * cos(DEG2RAD * 4 * lon);
+      for (Index ip = 0; ip < 41; ip++)
+        z_field(ip, ilat, ilon) = 2e3 * (Numeric)ip * tilt - 100;
+      z_surface(ilat, ilon) =
+          400 + 300 * sin(DEG2RAD * 45 * (lat - 35)) * cos(DEG2RAD * 9 * lon);
+    }
+  }
+
+  Index nfailed = 0, ncases = 0, nextra = 0;
+  Vector rte_pos(3), rte_los(2);
+  const Numeric sensor_z[] = {10e3, 40e3, 79e3};
+  const Numeric sensor_aa[] = {-171, -132.5, -90, -47, -3, 8, 61, 90, 134, 177};
+  for (const Numeric z : sensor_z) {
+    for (Numeric za = 60; za < 180; za += 1.7) {
+      for (const Numeric aa : sensor_aa) {
+        rte_pos[0] = z;
+        rte_pos[1] = 44.7;
+        rte_pos[2] = 1.3;
+        rte_los[0] = za;
+        rte_los[1] = aa;
+
+        Matrix bisection, analytic;
+        if (!follow_path(bisection,
+                         p_grid,
+                         lat_grid,
+                         lon_grid,
+                         z_field,
+                         refellipsoid,
+                         z_surface,
+                         rte_pos,
+                         rte_los,
+                         false))
+          continue;
+        follow_path(analytic,
+                    p_grid,
+                    lat_grid,
+                    lon_grid,
+                    z_field,
+                    refellipsoid,
+                    z_surface,
+                    rte_pos,
+                    rte_los,
+                    true);
+        ncases++;
+
+        // All bisection steps must be found in order. The bisection can
+        // miss a path dipping slightly below a tilted pressure level, so
+        // additional analytic steps are accepted if they end at a level.
+        Index ia = 0;
+        bool ok = true;
+        for (Index ib = 0; ok && ib < bisection.nrows(); ib++) {
+          for (; ia < analytic.nrows(); ia++) {
+            if (same_step(analytic(ia, joker), bisection(ib, joker))) break;
+            if (abs(analytic(ia, 3) - round(analytic(ia, 3))) > 1e-6) {
+              ok = false;
+              break;
+            }
+            nextra++;
+          }
+          ok = ok && ia < analytic.nrows();
+          ia++;
+        }
+        ok = ok && ia == analytic.nrows();
+        if (!ok) {
+          nfailed++;
+          cerr << "Mismatch for z=" << z << ", za=" << za << ", aa=" << aa
+               << ": " << bisection.nrows() << " steps by bisection, "
+               << analytic.nrows() << " steps analytic.\n";
+        }
+      }
+    }
+  }
+
+  cout << "\t" << ncases << " paths compared, " << nfailed << " failed, "
+       << nextra << " additional level crossings found analytically\n";
+  return nfailed;
+}
+
+int main() {
+  cout << "Testing analytic 3D path steps, sphere:\n";
+  Vector refellipsoid(2);
+  refellipsoid[0] = 6378137;
+  refellipsoid[1] = 0;
+  Index nfailed = test_analytic_steps(refellipsoid);
+
+  cout << "Testing analytic 3D path steps, WGS84:\n";
+  refellipsoid[1] = 0.0818191908426;
+  nfailed += test_analytic_steps(refellipsoid);
+
+  return nfailed == 0 ? 0 : 1;
+}
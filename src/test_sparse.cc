@@ -498,6 +498,73 @@ Numeric test_insert_row(Index ntests, bool verbose) {
   return err_max;
 }
 
+//! Test SparseRowBuilder.
+/*!
+
+  Performs ntests randomized tests of SparseRowBuilder. For each test, a
+  random vector is set with random offset and stride in each row of a
+  builder, and in a dense matrix. Returns the maximum error between the
+  built sparse matrix and the dense matrix, which should be 0.
+
+  \param ntests Number of test to perform.
+  \param verbose If verbose == true, the error for each test is printed
+  to stdout.
+
+  \return The maximum error between the sparse and dense matrix.
+*/
+Numeric test_row_builder(Index ntests, bool verbose) {
+  Numeric err_max = 0.0;
+
+  Vector v;
+  Matrix A, B;
+  Sparse A_sparse;
+
+  if (verbose) cout << endl << "Testing SparseRowBuilder:" << endl << endl;
+
+  for (Index i = 0; i < ntests; i++) {
+    Index m = (std::rand() % 10) + 1;
+    Index n = (std::rand() % 10) + 1;
+
+    SparseRowBuilder builder(m, n);
+    B.resize(m, n);
+    B = 0;
+
+    for (Index r = 0; r < m; r++) {
+      // Leave some rows empty
+      if (std::rand() % 4 == 0) continue;
+
+      const Index offset = std::rand() % n;
+      const Index stride = (std::rand() % 3) + 1;
+      v.resize((n - 1 - offset) / stride + 1);
+      random_fill_vector(v, 10, false);
+      if (v.nelem() > 1) v[std::rand() % v.nelem()] = 0;
+
+      builder.set_row(r, v, offset, stride);
+      B(r, Range(offset, v.nelem(), stride)) = v;
+    }
+
+    builder.build(A_sparse);
+    if ((A_sparse.nrows() != m) || (A_sparse.ncols() != n)) {
+      if (verbose) cout << "FAILED: Wrong size." << endl;
+      return 1.0;
+    }
+
+    A = A_sparse;
+
+    // Compare in both directions to also catch misplaced elements
+    Numeric err = max(get_maximum_error(A, B, true),
+                      get_maximum_error(B, A, true));
+    if (err > err_max) err_max = err;
+
+    if (verbose) {
+      cout << endl;
+      cout << "Maximum relative error: " << err << endl;
+    }
+  }
+
+  return err_max;
+}
+
 //! Test sparse identity matrix.
 /*!
 
@@ -1151,6 +1218,13 @@ int main() {
   else
     cout << "FAILED (Error: " << err << ")" << endl;
 
+  cout << "Testing row builder: ";
+  err = test_row_builder(1000, false);
+  if (err < 1e-11)
+    cout << "PASSED" << endl;
+  else
+    cout << "FAILED (Error: " << err << ")" << endl;
+
   cout << "Testing abs(...) and transpose(...): ";
   err = test_sparse_unary_operations(1000, 1000, 1000, false);
   if (err < 1e-11)
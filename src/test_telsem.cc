@@ -200,6 +200,67 @@ Numeric test_telsem_read(String atlas_file,
   return error;
 }
 
+/** Test batched evaluation of TELSEM emissivities
+ *
+ * Evaluates the emissivities on a lat/lon map using the batch interface
+ * and compares them to the results of the single-point interface.
+ *
+ * @param atlas_file The path to the atlas file.
+ * @param resolution The resolution to use for the lat/lon map.
+ * @param theta The incidence angle to which to interpolate the frequencies.
+ * @param frequencies The frequencies [GHz] (!!!) for which to interpolate the emissivities
+ */
+Numeric test_telsem_batch(std::string atlas_file,
+                          Numeric resolution,
+                          Numeric theta,
+                          Vector frequencies) {
+  TelsemAtlas atlas(atlas_file);
+
+  Index n_lat = static_cast<Index>(180.0 / resolution);
+  Index n_lon = static_cast<Index>(360.0 / resolution);
+  Index n_freqs = frequencies.nelem();
+
+  std::vector<Numeric> lats, lons;
+  for (Index i = 0; i < n_lat; ++i) {
+    for (Index j = 0; j < n_lon; ++j) {
+      Numeric lat = 0.125 + resolution / 2.0 - 90.0 +
+                    static_cast<Numeric>(i) * resolution;
+      Numeric lon =
+          0.125 + resolution / 2.0 + static_cast<Numeric>(j) * resolution;
+      if (atlas.contains(atlas.calc_cellnum(lat, lon))) {
+        lats.push_back(lat);
+        lons.push_back(lon);
+      }
+    }
+  }
+
+  Index n = static_cast<Index>(lats.size()) * n_freqs;
+  Vector lat(n), lon(n), thetas(n, theta), freqs(n);
+  for (Index i = 0; i < n; ++i) {
+    lat[i] = lats[i / n_freqs];
+    lon[i] = lons[i / n_freqs];
+    freqs[i] = frequencies[i % n_freqs];
+  }
+
+  Matrix emis;
+  atlas.emis_interp_batch(emis, lat, lon, thetas, freqs, -1.0);
+
+  Numeric error = 0.0;
+  for (Index i = 0; i < n; ++i) {
+    Index cellnumber = atlas.calc_cellnum(lat[i], lon[i]);
+    Numeric e_v, e_h;
+    std::tie(e_v, e_h) = atlas.emis_interp(theta,
+                                           freqs[i],
+                                           atlas.get_class1(cellnumber),
+                                           atlas.get_class2(cellnumber),
+                                           atlas.get_emis_v(cellnumber),
+                                           atlas.get_emis_h(cellnumber));
+    error = std::max(error, std::fabs(emis(i, 0) - e_v));
+    error = std::max(error, std::fabs(emis(i, 1) - e_h));
+  }
+  return error;
+}
+
 int main(int argc, const char** argv) {
   if (argc != 4) {
     std::cout
@@ -235,5 +296,11 @@ int main(int argc, const char** argv) {
       atlas_file, result_path, resolution, theta, frequencies);
   std::cout << "Maximum error interpolating emissivities: " << error
             << std::endl;
+
+  // Batched interpolation of emissivities.
+
+  error = test_telsem_batch(atlas_file, resolution, theta, frequencies);
+  std::cout << "Maximum error batch vs. single queries:   " << error
+            << std::endl;
   return 0;
 }
@@ -0,0 +1,92 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   test_tessem.cc
+  \author ARTS developers
+  \date   2020-06-28
+
+  \brief  Test of the batched evaluation of the TESSEM neural networks.
+
+  The batched forward pass is compared to the evaluation of one input
+  vector at a time by tessem_prop_nn, for both the H and the V network.
+  The path to the directory holding the network files is given as the
+  only argument.
+*/
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include "arts.h"
+#include "tessem.h"
+
+//! Compare tessem_prop_nn_batch with tessem_prop_nn.
+/*!
+  \param net_file  The network file.
+  \return          Maximum absolute difference of the emissivities.
+*/
+Numeric test_tessem_batch(const String& net_file) {
+  std::ifstream is(net_file.c_str());
+  if (!is) {
+    cerr << "Cannot open " << net_file << "\n";
+    return 1;
+  }
+  TessemNN net;
+  tessem_read_ascii(is, net);
+
+  // Frequency [Hz], incidence angle [deg], wind speed [m/s],
+  // temperature [K] and salinity [kg/kg], covering the range of the
+  // network
+  const Index n = 60;
+  Matrix nx(n, 5);
+  for (Index k = 0; k < n; k++) {
+    nx(k, 0) = 10e9 + 690e9 * std::fmod(0.37 * (Numeric)k, 1.);
+    nx(k, 1) = 65 * std::fmod(0.61 * (Numeric)k, 1.);
+    nx(k, 2) = 15 * std::fmod(0.23 * (Numeric)k, 1.);
+    nx(k, 3) = 271 + 35 * std::fmod(0.79 * (Numeric)k, 1.);
+    nx(k, 4) = 0.04 * std::fmod(0.43 * (Numeric)k, 1.);
+  }
+
+  Matrix ny(n, net.nb_outputs);
+  tessem_prop_nn_batch(ny, net, nx);
+
+  Numeric max_diff = 0;
+  Vector y(net.nb_outputs);
+  for (Index k = 0; k < n; k++) {
+    VectorView yv = y;
+    tessem_prop_nn(yv, net, nx(k, joker));
+    for (Index i = 0; i < net.nb_outputs; i++)
+      max_diff = std::max(max_diff, std::fabs(ny(k, i) - y[i]));
+  }
+
+  cout << "\t" << net_file << ": maximum difference " << max_diff << "\n";
+  return max_diff;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    cerr << "Usage: test_tessem <directory with TESSEM network files>\n";
+    return 1;
+  }
+  const String dir = argv[1];
+
+  cout << "Testing batched TESSEM networks:\n";
+  Numeric max_diff = test_tessem_batch(dir + "/tessem_sav_net_H.txt");
+  max_diff = std::max(max_diff, test_tessem_batch(dir + "/tessem_sav_net_V.txt"));
+
+  return max_diff < 1e-12 ? 0 : 1;
+}
@@ -24,14 +24,24 @@
 */
 
 #include "tmatrix.h"
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <iomanip>
 #include <stdexcept>
+#include "arts_omp.h"
 #include "complex.h"
 #include "math_funcs.h"
 #include "matpackI.h"
 #include "messages.h"
 #include "optproperties.h"
+#include "xml_io.h"
 
 void calc_phamat(Matrix& z,
                  const Index& nmax,
@@ -1293,6 +1303,366 @@ void calcSingleScatteringDataProperties(SingleScatteringData& ssd,
   }
 }
 
+//! Input and result of one job of calcSingleScatteringDataPropertiesBatch.
+struct TmatrixJob {
+  Index element;
+  Index f_index;
+  Index T_index;
+  String key;
+  String filename;
+  bool done;
+  SingleScatteringData ssd;
+};
+
+static const char TMATRIX_FAILED_MARK[] = "\n(failed)";
+
+//! Description of all input affecting the result of a job.
+static String tmatrix_job_key(const SingleScatteringData& ssd,
+                              const Numeric ref_index_real,
+                              const Numeric ref_index_imag,
+                              const Numeric equiv_radius,
+                              const Index np,
+                              const Numeric axial_ratio,
+                              const Numeric precision,
+                              const Index ndgs) {
+  std::ostringstream os;
+  os << std::setprecision(17);
+  os << "ARTS T-matrix job\n"
+     << "ptype: " << PTypeToString(ssd.ptype) << "\n"
+     << "np: " << np << "\n"
+     << "equiv_radius: " << equiv_radius << "\n"
+     << "axial_ratio: " << axial_ratio << "\n"
+     << "ref_index: " << ref_index_real << " " << ref_index_imag << "\n"
+     << "f: " << ssd.f_grid[0] << "\n"
+     << "T: " << ssd.T_grid[0] << "\n"
+     << "precision: " << precision << "\n"
+     << "ndgs: " << ndgs << "\n"
+     << "za_grid:";
+  for (Index i = 0; i < ssd.za_grid.nelem(); i++) os << " " << ssd.za_grid[i];
+  os << "\naa_grid:";
+  for (Index i = 0; i < ssd.aa_grid.nelem(); i++) os << " " << ssd.aa_grid[i];
+  return os.str();
+}
+
+//! Name of the file holding the result of a job.
+/*!
+  The name is given by the 64 bit FNV-1a hash of the job key.
+*/
+static String tmatrix_job_filename(const String& dir, const String& key) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < key.size(); i++) {
+    hash ^= (unsigned char)key[i];
+    hash *= 1099511628211ULL;
+  }
+  std::ostringstream os;
+  os << dir << "/tmatrix_" << std::hex << std::setw(16) << std::setfill('0')
+     << hash
+     << ".xml";
+  return os.str();
+}
+
+//! Read the result of a job from its file.
+/*!
+  \param job            The job.
+  \param accept_failed  Accept results of failed calculations.
+  \param verbosity      Verbosity.
+  \return               True if a valid result was found.
+*/
+static bool tmatrix_job_read(TmatrixJob& job,
+                             const bool accept_failed,
+                             const Verbosity& verbosity) {
+  if (access(job.filename.c_str(), R_OK)) return false;
+  try {
+    xml_read_from_file(job.filename, job.ssd, verbosity);
+  } catch (const std::runtime_error&) {
+    return false;
+  }
+  return job.ssd.description == job.key ||
+         (accept_failed &&
+          job.ssd.description == job.key + TMATRIX_FAILED_MARK);
+}
+
+//! Calculate a job and store the result in its file.
+static void tmatrix_job_calc(TmatrixJob& job,
+                             ConstMatrixView ref_index_real,
+                             ConstMatrixView ref_index_imag,
+                             const Numeric equiv_radius,
+                             const Index np,
+                             const Numeric axial_ratio,
+                             const Numeric precision,
+                             const Index ndgs,
+                             const Index robust,
+                             const Index quiet,
+                             const bool store,
+                             const Verbosity& verbosity) {
+  calcSingleScatteringDataProperties(
+      job.ssd,
+      ref_index_real(Range(job.f_index, 1), Range(job.T_index, 1)),
+      ref_index_imag(Range(job.f_index, 1), Range(job.T_index, 1)),
+      equiv_radius,
+      np,
+      axial_ratio,
+      precision,
+      ndgs,
+      robust,
+      quiet);
+
+  job.ssd.description = job.key;
+  if (std::isnan(job.ssd.ext_mat_data(0, 0, 0, 0, 0)))
+    job.ssd.description += TMATRIX_FAILED_MARK;
+
+  if (store) {
+    // Write to temporary files first, so that an interrupted calculation
+    // never leaves an incomplete result behind
+    std::ostringstream tmpname;
+    tmpname << job.filename << ".tmp" << getpid();
+    xml_write_to_file(tmpname.str(), job.ssd, FILE_TYPE_BINARY, 0, verbosity);
+    if (rename((tmpname.str() + ".bin").c_str(),
+               (job.filename + ".bin").c_str()) ||
+        rename(tmpname.str().c_str(), job.filename.c_str()))
+      throw std::runtime_error("Cannot store T-Matrix result in " +
+                               job.filename);
+  }
+  job.done = true;
+}
+
+// Documentation in header file.
+void calcSingleScatteringDataPropertiesBatch(
+    ArrayOfSingleScatteringData& ssd,
+    const ArrayOfMatrix& ref_index_real,
+    const ArrayOfMatrix& ref_index_imag,
+    ConstVectorView equiv_radius,
+    const Index np,
+    ConstVectorView axial_ratio,
+    const Numeric precision,
+    const Index ndgs,
+    const Index robust,
+    const Index quiet,
+    const String& cache_dir,
+    const Index nprocesses,
+    const Verbosity& verbosity) {
+  CREATE_OUT2;
+
+  const Index nelem = ssd.nelem();
+  if (ref_index_real.nelem() != nelem || ref_index_imag.nelem() != nelem ||
+      equiv_radius.nelem() != nelem || axial_ratio.nelem() != nelem)
+    throw std::runtime_error(
+        "All inputs of calcSingleScatteringDataPropertiesBatch must have "
+        "one element for each scattering element.");
+
+  // Set up the jobs
+  Array<TmatrixJob> jobs;
+  for (Index ie = 0; ie < nelem; ie++) {
+    const Index nf = ssd[ie].f_grid.nelem();
+    const Index nT = ssd[ie].T_grid.nelem();
+    if (ref_index_real[ie].nrows() != nf || ref_index_real[ie].ncols() != nT ||
+        ref_index_imag[ie].nrows() != nf || ref_index_imag[ie].ncols() != nT)
+      throw std::runtime_error(
+          "Size of refractive index must match ssd.f_grid and ssd.T_grid.");
+
+    for (Index f_index = 0; f_index < nf; f_index++)
+      for (Index T_index = 0; T_index < nT; T_index++) {
+        jobs.push_back(TmatrixJob());
+        TmatrixJob& job = jobs.back();
+        job.element = ie;
+        job.f_index = f_index;
+        job.T_index = T_index;
+        job.done = false;
+        job.ssd.ptype = ssd[ie].ptype;
+        job.ssd.f_grid = Vector(1, ssd[ie].f_grid[f_index]);
+        job.ssd.T_grid = Vector(1, ssd[ie].T_grid[T_index]);
+        job.ssd.za_grid = ssd[ie].za_grid;
+        job.ssd.aa_grid = ssd[ie].aa_grid;
+        job.key = tmatrix_job_key(job.ssd,
+                                  ref_index_real[ie](f_index, T_index),
+                                  ref_index_imag[ie](f_index, T_index),
+                                  equiv_radius[ie],
+                                  np,
+                                  axial_ratio[ie],
+                                  precision,
+                                  ndgs);
+      }
+  }
+
+  if (cache_dir.nelem() && mkdir(cache_dir.c_str(), 0777) && errno != EEXIST)
+    throw std::runtime_error("Cannot create cache directory " + cache_dir);
+
+  // Results already in the cache
+  ArrayOfIndex todo;
+  for (Index i = 0; i < jobs.nelem(); i++) {
+    if (cache_dir.nelem()) {
+      jobs[i].filename = tmatrix_job_filename(cache_dir, jobs[i].key);
+      if (tmatrix_job_read(jobs[i], false, verbosity)) {
+        jobs[i].done = true;
+        continue;
+      }
+    }
+    todo.push_back(i);
+  }
+
+  out2 << "  T-Matrix calculations: " << jobs.nelem() << " in total, "
+       << jobs.nelem() - todo.nelem() << " found in cache.\n";
+
+  Index nworkers = nprocesses > 0 ? nprocesses : arts_omp_get_max_threads();
+  if (nworkers > todo.nelem()) nworkers = todo.nelem();
+  if (arts_omp_in_parallel()) nworkers = 1;
+
+  if (nworkers <= 1) {
+    for (Index i = 0; i < todo.nelem(); i++) {
+      TmatrixJob& job = jobs[todo[i]];
+      tmatrix_job_calc(job,
+                       ref_index_real[job.element],
+                       ref_index_imag[job.element],
+                       equiv_radius[job.element],
+                       np,
+                       axial_ratio[job.element],
+                       precision,
+                       ndgs,
+                       robust,
+                       quiet,
+                       cache_dir.nelem() > 0,
+                       verbosity);
+    }
+  } else {
+    // The results of the worker processes are passed on through files.
+    // Without a cache, a temporary directory is used.
+    String workdir = cache_dir;
+    if (!workdir.nelem()) {
+      const char* tmp = getenv("TMPDIR");
+      workdir = String(tmp ? tmp : "/tmp") + "/arts_tmatrix_XXXXXX";
+      if (!mkdtemp(&workdir[0]))
+        throw std::runtime_error("Cannot create temporary directory " +
+                                 workdir);
+      for (Index i = 0; i < todo.nelem(); i++)
+        jobs[todo[i]].filename =
+            tmatrix_job_filename(workdir, jobs[todo[i]].key);
+    }
+
+    out2 << "  Starting " << nworkers << " T-Matrix worker processes.\n";
+
+    // Only the calling thread exists in the worker processes. The writer
+    // thread of the asynchronous output could hold locks at the time of
+    // the fork, which would then never be released in the workers.
+    // Asynchronous output is therefore stopped for the rest of the run.
+    async_log_stop();
+    std::cout.flush();
+    std::cerr.flush();
+
+    // Each worker reports errors through a pipe
+    ArrayOfIndex pids;
+    ArrayOfIndex fds;
+    String fail_msg;
+    for (Index w = 0; w < nworkers; w++) {
+      int fd[2];
+      pid_t pid = -1;
+      if (!pipe(fd)) {
+        pid = fork();
+        if (pid < 0) {
+          close(fd[0]);
+          close(fd[1]);
+        }
+      }
+      if (pid < 0) {
+        fail_msg = "Cannot start T-Matrix worker process.";
+        break;
+      }
+      if (pid == 0) {
+        close(fd[0]);
+        int status = 0;
+        try {
+          for (Index i = w; i < todo.nelem(); i += nworkers) {
+            TmatrixJob& job = jobs[todo[i]];
+            tmatrix_job_calc(job,
+                             ref_index_real[job.element],
+                             ref_index_imag[job.element],
+                             equiv_radius[job.element],
+                             np,
+                             axial_ratio[job.element],
+                             precision,
+                             ndgs,
+                             robust,
+                             quiet,
+                             true,
+                             verbosity);
+          }
+        } catch (const std::exception& e) {
+          status = 1;
+          if (write(fd[1], e.what(), strlen(e.what())) < 0) status = 2;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        close(fd[1]);
+        _exit(status);
+      }
+      close(fd[1]);
+      pids.push_back(pid);
+      fds.push_back(fd[0]);
+    }
+
+    for (Index w = 0; w < pids.nelem(); w++) {
+      String msg;
+      char buffer[1024];
+      ssize_t n;
+      while ((n = read(int(fds[w]), buffer, sizeof(buffer))) > 0)
+        msg.append(buffer, size_t(n));
+      close(int(fds[w]));
+
+      int status = 0;
+      waitpid(pid_t(pids[w]), &status, 0);
+      if (!fail_msg.nelem() &&
+          (!WIFEXITED(status) || WEXITSTATUS(status) != 0))
+        fail_msg = msg.nelem() ? msg
+                               : String("A T-Matrix worker process failed.");
+    }
+
+    if (!fail_msg.nelem())
+      for (Index i = 0; i < todo.nelem(); i++)
+        if (!tmatrix_job_read(jobs[todo[i]], true, verbosity)) {
+          fail_msg = "Result of T-Matrix worker process is missing: " +
+                     jobs[todo[i]].filename;
+          break;
+        }
+
+    if (!cache_dir.nelem()) {
+      for (Index i = 0; i < todo.nelem(); i++) {
+        unlink(jobs[todo[i]].filename.c_str());
+        unlink((jobs[todo[i]].filename + ".bin").c_str());
+      }
+      rmdir(workdir.c_str());
+    }
+
+    if (fail_msg.nelem()) throw std::runtime_error(fail_msg);
+  }
+
+  // Join the results of all frequencies and temperatures
+  for (Index i = 0; i < jobs.nelem(); i++) {
+    const TmatrixJob& job = jobs[i];
+    SingleScatteringData& s = ssd[job.element];
+    const Index nf = s.f_grid.nelem();
+    const Index nT = s.T_grid.nelem();
+    if (job.f_index == 0 && job.T_index == 0) {
+      const Tensor7& p = job.ssd.pha_mat_data;
+      const Tensor5& e = job.ssd.ext_mat_data;
+      const Tensor5& a = job.ssd.abs_vec_data;
+      s.pha_mat_data.resize(nf,
+                            nT,
+                            p.nshelves(),
+                            p.nbooks(),
+                            p.npages(),
+                            p.nrows(),
+                            p.ncols());
+      s.ext_mat_data.resize(nf, nT, e.npages(), e.nrows(), e.ncols());
+      s.abs_vec_data.resize(nf, nT, a.npages(), a.nrows(), a.ncols());
+    }
+    s.pha_mat_data(job.f_index, job.T_index, joker, joker, joker, joker, joker) =
+        job.ssd.pha_mat_data(0, 0, joker, joker, joker, joker, joker);
+    s.ext_mat_data(job.f_index, job.T_index, joker, joker, joker) =
+        job.ssd.ext_mat_data(0, 0, joker, joker, joker);
+    s.abs_vec_data(job.f_index, job.T_index, joker, joker, joker) =
+        job.ssd.abs_vec_data(0, 0, joker, joker, joker);
+  }
+}
+
 // Documentation in header file.
 void tmatrix_ampld_test(const Verbosity& verbosity) {
   CREATE_OUT0;
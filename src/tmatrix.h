@@ -62,6 +62,57 @@ void calcSingleScatteringDataProperties(SingleScatteringData& ssd,
                                         const Index robust = 0,
                                         const Index quiet = 1);
 
+/** Calculate SingleScatteringData properties for several scattering elements.
+
+ Gives the same result as calling calcSingleScatteringDataProperties for each
+ element of ssd. The calculations are split into one job for each element,
+ frequency and temperature. As the T-Matrix code is not reentrant, the jobs
+ are distributed over worker processes.
+
+ If cache_dir is set, the result of each job is stored in that directory.
+ The files are named after a hash of all input affecting the result (shape,
+ size, aspect ratio, refractive index, frequency, temperature, angular grids
+ and precision settings). Jobs with a stored result are not calculated again,
+ so only new grid points are calculated when a calculation is repeated with
+ extended grids. Results of failed calculations (robust = 1) are not reused.
+ The directory is created if it does not exist.
+
+ \param[in,out] ssd         As for calcSingleScatteringDataProperties, one
+                            element for each scattering element.
+ \param[in] ref_index_real  Real parts of refractive index, one matrix for
+                            each scattering element, see
+                            calcSingleScatteringDataProperties.
+ \param[in] ref_index_imag  Imaginary parts of refractive index.
+ \param[in] equiv_radius    Equivalent volume radius [micrometer] of each
+                            scattering element.
+ \param[in] np              Particle type (-1 for spheroid, -2 for cylinder)
+ \param[in] axial_ratio     Axial ratio of each scattering element.
+ \param[in] precision       Accuracy of the computations
+ \param[in] ndgs            See calcSingleScatteringDataProperties.
+ \param[in] robust          Continue if individual calculations fail.
+ \param[in] quiet           Suppress output of the T-Matrix code.
+ \param[in] cache_dir       Directory for stored results, or empty.
+ \param[in] nprocesses      Maximum number of worker processes.
+ \param[in] verbosity       Verbosity.
+
+ uthor Patrick Eriksson
+ \date   2020-06-30
+ */
+void calcSingleScatteringDataPropertiesBatch(
+    ArrayOfSingleScatteringData& ssd,
+    const ArrayOfMatrix& ref_index_real,
+    const ArrayOfMatrix& ref_index_imag,
+    ConstVectorView equiv_radius,
+    const Index np,
+    ConstVectorView axial_ratio,
+    const Numeric precision,
+    const Index ndgs,
+    const Index robust,
+    const Index quiet,
+    const String& cache_dir,
+    const Index nprocesses,
+    const Verbosity& verbosity);
+
 /** T-Matrix validation test.
 
  Executes the standard test included with the double precision T-Matrix code
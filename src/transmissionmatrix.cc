@@ -1522,6 +1522,15 @@ ArrayOfTransmissionMatrix cumulative_transmission(
       TransmissionMatrix(
           n ? T[0].Frequencies() : 0,
           n ? T[0].StokesDim() : 1));  // Initialize as identity matrix
+  cumulative_transmission(PiT, T, type);
+  return PiT;  // Note how the output is such that forward transmission is from -1 to 0
+}
+
+void cumulative_transmission(ArrayOfTransmissionMatrix& PiT,
+                             const ArrayOfTransmissionMatrix& T,
+                             const CumulativeTransmission type) {
+  const Index n = T.nelem();
+  assert(PiT.nelem() == n);
   switch (type) {
     case CumulativeTransmission::Forward:
       for (Index i = 1; i < n; i++) PiT[i].mul(PiT[i - 1], T[i]);
@@ -1536,7 +1545,6 @@ ArrayOfTransmissionMatrix cumulative_transmission(
               T[j], PiT[i]);  // Fixme:  Should be possible to speed up...
       break;
   }
-  return PiT;  // Note how the output is such that forward transmission is from -1 to 0
 }
 
 // TEST CODE BEGIN
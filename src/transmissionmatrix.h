@@ -73,6 +73,14 @@ class TransmissionMatrix {
 
   operator Tensor3() const {
     Tensor3 T(Frequencies(), stokes_dim, stokes_dim);
+    to_tensor3(T);
+    return T;
+  }
+
+  /** Copy the matrices to T, of size (nf, stokes_dim, stokes_dim). */
+  void to_tensor3(Tensor3View T) const {
+    assert(T.npages() == Frequencies() and T.nrows() == stokes_dim and
+           T.ncols() == stokes_dim);
     for (size_t i = 0; i < T4.size(); i++)
       for (size_t j = 0; j < 4; j++)
         for (size_t k = 0; k < 4; k++) T(i, j, k) = T4[i](j, k);
@@ -83,7 +91,6 @@ class TransmissionMatrix {
       for (size_t j = 0; j < 2; j++)
         for (size_t k = 0; k < 2; k++) T(i, j, k) = T2[i](j, k);
     for (size_t i = 0; i < T1.size(); i++) T(i, 0, 0) = T1[i](0, 0);
-    return T;
   }
 
   const Eigen::Matrix4d& Mat4(size_t i) const { return T4[i]; }
@@ -574,6 +581,15 @@ ArrayOfTransmissionMatrix cumulative_transmission(
     const ArrayOfTransmissionMatrix& T,
     const CumulativeTransmission type) /*[[expects: T.nelem()>0]]*/;
 
+/** Cumulative transmission, written to existing storage.
+
+    Same as the version returning the result, but the memory of PiT is
+    reused. PiT must have the size of T and hold identity matrices.
+*/
+void cumulative_transmission(ArrayOfTransmissionMatrix& PiT,
+                             const ArrayOfTransmissionMatrix& T,
+                             const CumulativeTransmission type);
+
 void set_backscatter_radiation_vector(
     ArrayOfRadiationVector& I,
     ArrayOfArrayOfRadiationVector& dI,
@@ -1438,6 +1438,23 @@ void Workspace::define_wsv_data() {
                 DESCRIPTION("Agenda executing the DOIT convergence test.\n"),
                 GROUP("Agenda")));
 
+  wsv_data.push_back(WsvRecord(
+      NAME("doit_geometry_cache"),
+      DESCRIPTION(
+          "Storage of the propagation path steps of 3D DOIT sweeps.\n"
+          "\n"
+          "The path steps and the atmospheric quantities along them do not\n"
+          "change between the iterations, and normally neither between the\n"
+          "frequencies. They are calculated by the first call of\n"
+          "*doit_i_fieldUpdateSeq3D* and stored together with a key\n"
+          "describing the atmospheric state and the grids. Later calls, for\n"
+          "all frequencies handled by *doit_mono_agenda*, use the stored\n"
+          "steps if the key matches. The variable is initialised by\n"
+          "*DoitInit*.\n"
+          "\n"
+          "Usage:      Set by *DoitInit*, used by *doit_i_fieldUpdateSeq3D*.\n"),
+      GROUP("DoitGeometryCache")));
+
   wsv_data.push_back(WsvRecord(
       NAME("doit_i_field"),
       DESCRIPTION(
@@ -1933,6 +1950,21 @@ void Workspace::define_wsv_data() {
           "            mblock_dlos_grid, and nf is length of f_grid.\n"),
       GROUP("Vector")));
 
+  wsv_data.push_back(WsvRecord(
+      NAME("iyb_cache"),
+      DESCRIPTION(
+          "Storage of monochromatic pencil beam data between calls of\n"
+          "*yCalcCached*.\n"
+          "\n"
+          "Holds *iyb*, its analytical Jacobian and auxiliary data for all\n"
+          "measurement blocks, together with a key describing the state they\n"
+          "were calculated for. The data are kept from one call of\n"
+          "*inversion_iterate_agenda* to the next, if the variable is\n"
+          "initialised (e.g. by *Touch*) before *OEM* is called.\n"
+          "\n"
+          "Usage:      Used by *yCalcCached*.\n"),
+      GROUP("IybCache")));
+
   wsv_data.push_back(WsvRecord(
       NAME("iy_agenda_call1"),
       DESCRIPTION(
@@ -3091,6 +3123,20 @@ void Workspace::define_wsv_data() {
           "       (*cloudbox_limits*[5] - *cloudbox_limits*[4]) +1 ] \n"),
       GROUP("Tensor4")));
 
+  wsv_data.push_back(WsvRecord(
+      NAME("pnd_field_cache"),
+      DESCRIPTION(
+          "Storage of *pnd_field* and *dpnd_field_dx* between calls of\n"
+          "*pnd_fieldCalcFromParticleBulkPropsCached*.\n"
+          "\n"
+          "Holds the fields together with a key describing the state they\n"
+          "were calculated for. The data are kept from one call of\n"
+          "*inversion_iterate_agenda* to the next, if the variable is\n"
+          "initialised (e.g. by *Touch*) before *OEM* is called.\n"
+          "\n"
+          "Usage:      Used by *pnd_fieldCalcFromParticleBulkPropsCached*.\n"),
+      GROUP("PndFieldCache")));
+
   wsv_data.push_back(WsvRecord(
       NAME("pnd_size_grid"),
       DESCRIPTION(
@@ -3896,6 +3942,24 @@ void Workspace::define_wsv_data() {
           "derive it from *scat_data_raw*."),
       GROUP("ArrayOfArrayOfSingleScatteringData")));
 
+  wsv_data.push_back(WsvRecord(
+      NAME("scat_database"),
+      DESCRIPTION(
+          "Memory-mapped single scattering database.\n"
+          "\n"
+          "An alternative to *scat_data_raw* for large sets of scattering\n"
+          "data. The database file is written by *ScatteringDatabaseWrite* or\n"
+          "*ScatteringDatabaseWriteFromFiles* and opened by\n"
+          "*scat_databaseOpen*. Only the grids are read when the file is\n"
+          "opened. The optical properties of a scattering element are\n"
+          "interpolated to a frequency when first requested, and kept in a\n"
+          "cache of limited size. Copies of the variable share the file\n"
+          "mapping and the cache.\n"
+          "\n"
+          "Usage: Set by *scat_databaseOpen*, used by *scat_dataFromDatabase*\n"
+          "and *scat_data_monoFromDatabase*.\n"),
+      GROUP("ScatteringDatabase")));
+
   wsv_data.push_back(WsvRecord(
       NAME("scat_data_checked"),
       DESCRIPTION(
@@ -212,6 +212,8 @@ void xml_write_to_stream(ostream& os_xml,
   ArtsXMLTag covmat_tag(verbosity);
   ArtsXMLTag close_tag(verbosity);
 
+  covmat.store_inverse();
+
   covmat_tag.set_name("CovarianceMatrix");
   covmat_tag.add_attribute(
       "n_blocks", covmat.correlations_.size() + covmat.inverses_.size());
@@ -301,6 +303,9 @@ void xml_read_from_stream(istream& is_xml,
   tag.read_from_stream(is_xml);
   tag.check_name("GasAbsLookup");
 
+  // Start from an empty table, to reset any compression of a previous table.
+  gal = GasAbsLookup();
+
   xml_read_from_stream(is_xml, gal.species, pbifs, verbosity);
   xml_read_from_stream(is_xml, gal.nonlinear_species, pbifs, verbosity);
   xml_read_from_stream(is_xml, gal.f_grid, pbifs, verbosity);
@@ -350,8 +355,16 @@ void xml_write_to_stream(ostream& os_xml,
                       pbofs,
                       "NonlinearSpeciesVmrPerturbations",
                       verbosity);
-  xml_write_to_stream(
-      os_xml, gal.xsec, pbofs, "AbsorptionCrossSections", verbosity);
+  // Compressed tables are written in uncompressed form.
+  if (gal.IsCompressed()) {
+    Tensor4 xsec;
+    gal.GetXsec(xsec);
+    xml_write_to_stream(
+        os_xml, xsec, pbofs, "AbsorptionCrossSections", verbosity);
+  } else {
+    xml_write_to_stream(
+        os_xml, gal.xsec, pbofs, "AbsorptionCrossSections", verbosity);
+  }
 
   close_tag.set_name("/GasAbsLookup");
   close_tag.write_to_stream(os_xml);
@@ -1929,6 +1942,7 @@ void xml_read_from_stream(istream& is_xml,
   xml_read_from_stream(is_xml, ta.classes1, pbifs, verbosity);
   xml_read_from_stream(is_xml, ta.classes2, pbifs, verbosity);
   xml_read_from_stream(is_xml, ta.cellnums, pbifs, verbosity);
+  ta.equare();
   ta.telsem_calc_correspondence();
   tag.read_from_stream(is_xml);
   tag.check_name("/TelsemAtlas");
@@ -2119,6 +2133,23 @@ void xml_write_to_stream(ostream&,
   throw runtime_error("Method not implemented!");
 }
 
+//=== IybCache ================================================
+
+void xml_read_from_stream(istream&,
+                          IybCache&,
+                          bifstream* /* pbifs */,
+                          const Verbosity&) {
+  throw runtime_error("Method not implemented!");
+}
+
+void xml_write_to_stream(ostream&,
+                         const IybCache&,
+                         bofstream* /* pbofs */,
+                         const String& /* name */,
+                         const Verbosity&) {
+  throw runtime_error("Method not implemented!");
+}
+
 //=== MCAntenna ================================================
 
 void xml_read_from_stream(istream&,
@@ -2136,6 +2167,57 @@ void xml_write_to_stream(ostream&,
   throw runtime_error("Method not implemented!");
 }
 
+//=== DoitGeometryCache ========================================
+
+void xml_read_from_stream(istream&,
+                          DoitGeometryCache&,
+                          bifstream* /* pbifs */,
+                          const Verbosity&) {
+  throw runtime_error("Method not implemented!");
+}
+
+void xml_write_to_stream(ostream&,
+                         const DoitGeometryCache&,
+                         bofstream* /* pbofs */,
+                         const String& /* name */,
+                         const Verbosity&) {
+  throw runtime_error("Method not implemented!");
+}
+
+//=== PndFieldCache ============================================
+
+void xml_read_from_stream(istream&,
+                          PndFieldCache&,
+                          bifstream* /* pbifs */,
+                          const Verbosity&) {
+  throw runtime_error("Method not implemented!");
+}
+
+void xml_write_to_stream(ostream&,
+                         const PndFieldCache&,
+                         bofstream* /* pbofs */,
+                         const String& /* name */,
+                         const Verbosity&) {
+  throw runtime_error("Method not implemented!");
+}
+
+//=== ScatteringDatabase =======================================
+
+void xml_read_from_stream(istream&,
+                          ScatteringDatabase&,
+                          bifstream* /* pbifs */,
+                          const Verbosity&) {
+  throw runtime_error("Method not implemented!");
+}
+
+void xml_write_to_stream(ostream&,
+                         const ScatteringDatabase&,
+                         bofstream* /* pbofs */,
+                         const String& /* name */,
+                         const Verbosity&) {
+  throw runtime_error("Method not implemented!");
+}
+
 //=== TessemNN ================================================
 
 void xml_read_from_stream(istream&,
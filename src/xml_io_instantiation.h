@@ -68,6 +68,7 @@ TMPL_XML_READ_WRITE(RadiationVector)
 TMPL_XML_READ_WRITE(Agenda)
 TMPL_XML_READ_WRITE(CIARecord)
 TMPL_XML_READ_WRITE(CovarianceMatrix)
+TMPL_XML_READ_WRITE(DoitGeometryCache)
 TMPL_XML_READ_WRITE(GriddedField1)
 TMPL_XML_READ_WRITE(GriddedField2)
 TMPL_XML_READ_WRITE(GriddedField3)
@@ -77,11 +78,14 @@ TMPL_XML_READ_WRITE(GriddedField6)
 TMPL_XML_READ_WRITE(GasAbsLookup)
 TMPL_XML_READ_WRITE(GridPos)
 TMPL_XML_READ_WRITE(IsotopologueRecord)
+TMPL_XML_READ_WRITE(IybCache)
 TMPL_XML_READ_WRITE(MCAntenna)
+TMPL_XML_READ_WRITE(PndFieldCache)
 TMPL_XML_READ_WRITE(Ppath)
 TMPL_XML_READ_WRITE(QuantumIdentifier)
 TMPL_XML_READ_WRITE(QuantumNumbers)
 TMPL_XML_READ_WRITE(RetrievalQuantity)
+TMPL_XML_READ_WRITE(ScatteringDatabase)
 TMPL_XML_READ_WRITE(ScatteringMetaData)
 TMPL_XML_READ_WRITE(SLIData2)
 TMPL_XML_READ_WRITE(SingleScatteringData)
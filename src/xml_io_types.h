@@ -40,9 +40,11 @@
 #include "bofstream.h"
 #include "cia.h"
 #include "covariance_matrix.h"
+#include "doit_geometry_cache.h"
 #include "gas_abs_lookup.h"
 #include "gridded_fields.h"
 #include "hitran_xsec.h"
+#include "iyb_cache.h"
 #include "jacobian.h"
 #include "m_general.h"
 #include "matpackII.h"
@@ -51,7 +53,9 @@
 #include "mc_interp.h"
 #include "messages.h"
 #include "optproperties.h"
+#include "pnd_field_cache.h"
 #include "ppath.h"
+#include "scat_database.h"
 #include "propagationmatrix.h"
 #include "telsem.h"
 #include "tessem.h"
@@ -92,6 +96,7 @@ TMPL_XML_READ_WRITE_STREAM(Vector)
 TMPL_XML_READ_WRITE_STREAM(Agenda)
 TMPL_XML_READ_WRITE_STREAM(CIARecord)
 TMPL_XML_READ_WRITE_STREAM(CovarianceMatrix)
+TMPL_XML_READ_WRITE_STREAM(DoitGeometryCache)
 TMPL_XML_READ_WRITE_STREAM(GriddedField1)
 TMPL_XML_READ_WRITE_STREAM(GriddedField2)
 TMPL_XML_READ_WRITE_STREAM(GriddedField3)
@@ -101,11 +106,14 @@ TMPL_XML_READ_WRITE_STREAM(GriddedField6)
 TMPL_XML_READ_WRITE_STREAM(GasAbsLookup)
 TMPL_XML_READ_WRITE_STREAM(GridPos)
 TMPL_XML_READ_WRITE_STREAM(IsotopologueRecord)
+TMPL_XML_READ_WRITE_STREAM(IybCache)
 TMPL_XML_READ_WRITE_STREAM(MCAntenna)
+TMPL_XML_READ_WRITE_STREAM(PndFieldCache)
 TMPL_XML_READ_WRITE_STREAM(Ppath)
 TMPL_XML_READ_WRITE_STREAM(QuantumIdentifier)
 TMPL_XML_READ_WRITE_STREAM(QuantumNumbers)
 TMPL_XML_READ_WRITE_STREAM(RetrievalQuantity)
+TMPL_XML_READ_WRITE_STREAM(ScatteringDatabase)
 TMPL_XML_READ_WRITE_STREAM(ScatteringMetaData)
 TMPL_XML_READ_WRITE_STREAM(SLIData2)
 TMPL_XML_READ_WRITE_STREAM(SingleScatteringData)
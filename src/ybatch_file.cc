@@ -0,0 +1,325 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   ybatch_file.cc
+
+  \brief  Append-only files holding the results of batch calculations.
+
+  See ybatch_file.h for a description of the file format.
+*/
+
+#include "ybatch_file.h"
+#include <unistd.h>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+static const char YBATCH_FILE_MAGIC[] = "ARTSYBF1";
+static const size_t YBATCH_FILE_MAGIC_LEN = 8;
+static const Index YBATCH_RECORD_TAG = 0x59424154434852;
+
+static void ybatch_file_append(vector<char>& buffer,
+                               const void* data,
+                               size_t n) {
+  const char* c = static_cast<const char*>(data);
+  buffer.insert(buffer.end(), c, c + n);
+}
+
+static void ybatch_file_append(vector<char>& buffer, Index i) {
+  ybatch_file_append(buffer, &i, sizeof(Index));
+}
+
+static void ybatch_file_append(vector<char>& buffer, ConstVectorView v) {
+  ybatch_file_append(buffer, v.nelem());
+  for (Index i = 0; i < v.nelem(); i++) {
+    const Numeric x = v[i];
+    ybatch_file_append(buffer, &x, sizeof(Numeric));
+  }
+}
+
+//! Sequential reading of a record payload with bounds checking.
+class YbatchRecordReader {
+ public:
+  YbatchRecordReader(const vector<char>& buffer, const String& filename)
+      : mbuffer(buffer), mfilename(filename), mpos(0) {}
+
+  Index index() {
+    Index i;
+    read(&i, sizeof(Index));
+    if (i < 0) corrupt();
+    return i;
+  }
+
+  void numerics(VectorView v) {
+    for (Index i = 0; i < v.nelem(); i++) read(&v[i], sizeof(Numeric));
+  }
+
+ private:
+  void read(void* data, size_t n) {
+    if (mpos + n > mbuffer.size()) corrupt();
+    memcpy(data, &mbuffer[mpos], n);
+    mpos += n;
+  }
+
+  void corrupt() const {
+    throw runtime_error("Corrupt record in ybatch file: " + mfilename);
+  }
+
+  const std::vector<char>& mbuffer;
+  const String& mfilename;
+  size_t mpos;
+};
+
+//! Locate the complete records of a file.
+/*!
+  \param is        The open file.
+  \param filename  Name of the file, for error messages.
+  \param key       Out: The setup key of the file.
+  \param records   Out: Start of the record of each job.
+  \return          End of the last complete record.
+*/
+static streamoff ybatch_file_scan(istream& is,
+                                  const String& filename,
+                                  String& key,
+                                  map<Index, streamoff>& records) {
+  char magic[YBATCH_FILE_MAGIC_LEN];
+  Index byte_order = 0;
+  is.read(magic, YBATCH_FILE_MAGIC_LEN);
+  is.read(reinterpret_cast<char*>(&byte_order), sizeof(Index));
+  if (!is || memcmp(magic, YBATCH_FILE_MAGIC, YBATCH_FILE_MAGIC_LEN))
+    throw runtime_error("Not a ybatch file: " + filename);
+  if (byte_order != 1)
+    throw runtime_error("The ybatch file " + filename +
+                        " was written with a different byte order.");
+
+  Index key_size = -1;
+  is.read(reinterpret_cast<char*>(&key_size), sizeof(Index));
+  if (!is || key_size < 0)
+    throw runtime_error("Not a ybatch file: " + filename);
+  key.resize(size_t(key_size));
+  if (key_size > 0) is.read(&key[0], streamsize(key_size));
+  if (!is) throw runtime_error("Not a ybatch file: " + filename);
+
+  streamoff end = is.tellg();
+  while (true) {
+    Index head[3];
+    Index tail;
+    if (!is.read(reinterpret_cast<char*>(head), sizeof(head)) ||
+        head[0] != YBATCH_RECORD_TAG || head[2] < 0)
+      break;
+    is.seekg(head[2], ios::cur);
+    if (!is.read(reinterpret_cast<char*>(&tail), sizeof(Index)) ||
+        tail != head[1])
+      break;
+    records[head[1]] = end;
+    end = is.tellg();
+  }
+  is.clear();
+
+  return end;
+}
+
+YbatchFileWriter::YbatchFileWriter(const String& filename,
+                                   const String& key,
+                                   Index queue_size)
+    : mfilename(filename),
+      mqueue_size(queue_size > 0 ? size_t(queue_size) : 1),
+      mclosing(false) {
+  streamoff end = 0;
+  {
+    ifstream is(filename.c_str(), ios::binary);
+    if (is) {
+      is.seekg(0, ios::end);
+      const streamoff size = is.tellg();
+      is.seekg(0);
+      if (size > 0) {
+        String file_key;
+        end = ybatch_file_scan(is, filename, file_key, mdone);
+        if (file_key != key) {
+          ostringstream os;
+          os << "The file " << filename << "\n"
+             << "belongs to a batch calculation with a different "
+             << "*ybatch_start*,\n*ybatch_n* or *ybatch_calc_agenda*.\n"
+             << "Remove it or use another file name.";
+          throw runtime_error(os.str());
+        }
+        if (end < size && truncate(filename.c_str(), off_t(end)))
+          throw runtime_error(
+              "Cannot remove incomplete record at the end of " + filename);
+      }
+    }
+  }
+
+  mfile.open(filename.c_str(), ios::binary | ios::app);
+  if (!mfile) throw runtime_error("Cannot open output file: " + filename);
+
+  if (end == 0) {
+    const Index byte_order = 1;
+    const Index key_size = Index(key.size());
+    mfile.write(YBATCH_FILE_MAGIC, YBATCH_FILE_MAGIC_LEN);
+    mfile.write(reinterpret_cast<const char*>(&byte_order), sizeof(Index));
+    mfile.write(reinterpret_cast<const char*>(&key_size), sizeof(Index));
+    mfile.write(key.data(), streamsize(key_size));
+    mfile.flush();
+    if (!mfile) throw runtime_error("Error writing to file: " + filename);
+  }
+
+  mthread = thread(&YbatchFileWriter::write_loop, this);
+}
+
+YbatchFileWriter::~YbatchFileWriter() {
+  try {
+    finish();
+  } catch (...) {
+  }
+}
+
+void YbatchFileWriter::push(Index job,
+                            Vector& y,
+                            ArrayOfVector& y_aux,
+                            Matrix& jacobian) {
+  unique_lock<mutex> lock(mmutex);
+  mnot_full.wait(lock,
+                 [this] { return mqueue.size() < mqueue_size || merror; });
+  if (merror) rethrow_exception(merror);
+
+  mqueue.push_back(Job());
+  Job& j = mqueue.back();
+  j.index = job;
+  j.y = std::move(y);
+  j.y_aux = std::move(y_aux);
+  j.jacobian = std::move(jacobian);
+
+  mnot_empty.notify_one();
+}
+
+void YbatchFileWriter::finish() {
+  {
+    lock_guard<mutex> lock(mmutex);
+    mclosing = true;
+  }
+  mnot_empty.notify_all();
+  if (mthread.joinable()) mthread.join();
+  if (mfile.is_open()) mfile.close();
+  if (merror) rethrow_exception(merror);
+}
+
+void YbatchFileWriter::write_loop() {
+  std::vector<char> buffer;
+
+  while (true) {
+    Job job;
+    {
+      unique_lock<mutex> lock(mmutex);
+      mnot_empty.wait(lock, [this] { return !mqueue.empty() || mclosing; });
+      if (mqueue.empty()) return;
+      job = std::move(mqueue.front());
+      mqueue.pop_front();
+    }
+    mnot_full.notify_one();
+
+    try {
+      // Header, the payload size is filled in below
+      buffer.clear();
+      ybatch_file_append(buffer, YBATCH_RECORD_TAG);
+      ybatch_file_append(buffer, job.index);
+      ybatch_file_append(buffer, Index(0));
+      const size_t payload_start = buffer.size();
+
+      ybatch_file_append(buffer, job.y);
+      ybatch_file_append(buffer, job.y_aux.nelem());
+      for (Index i = 0; i < job.y_aux.nelem(); i++)
+        ybatch_file_append(buffer, job.y_aux[i]);
+      ybatch_file_append(buffer, job.jacobian.nrows());
+      ybatch_file_append(buffer, job.jacobian.ncols());
+      for (Index r = 0; r < job.jacobian.nrows(); r++)
+        for (Index c = 0; c < job.jacobian.ncols(); c++) {
+          const Numeric x = job.jacobian(r, c);
+          ybatch_file_append(buffer, &x, sizeof(Numeric));
+        }
+
+      const Index payload_size = Index(buffer.size() - payload_start);
+      memcpy(&buffer[payload_start - sizeof(Index)],
+             &payload_size,
+             sizeof(Index));
+      ybatch_file_append(buffer, job.index);
+
+      mfile.write(&buffer[0], streamsize(buffer.size()));
+      mfile.flush();
+      if (!mfile) throw runtime_error("Error writing to file: " + mfilename);
+    } catch (...) {
+      lock_guard<mutex> lock(mmutex);
+      merror = current_exception();
+      mqueue.clear();
+      mnot_full.notify_all();
+      return;
+    }
+  }
+}
+
+void ybatch_file_read(ArrayOfVector& ybatch,
+                      ArrayOfArrayOfVector& ybatch_aux,
+                      ArrayOfMatrix& ybatch_jacobians,
+                      const String& filename,
+                      const Index& ybatch_start,
+                      const Index& ybatch_n) {
+  ifstream is(filename.c_str(), ios::binary);
+  if (!is) throw runtime_error("Cannot open input file: " + filename);
+
+  String key;
+  map<Index, streamoff> records;
+  ybatch_file_scan(is, filename, key, records);
+
+  ybatch.resize(ybatch_n);
+  ybatch_aux.resize(ybatch_n);
+  ybatch_jacobians.resize(ybatch_n);
+
+  std::vector<char> buffer;
+  for (Index i = 0; i < ybatch_n; i++) {
+    ybatch[i].resize(0);
+    ybatch_aux[i].resize(0);
+    ybatch_jacobians[i].resize(0, 0);
+
+    const map<Index, streamoff>::const_iterator it =
+        records.find(ybatch_start + i);
+    if (it == records.end()) continue;
+
+    Index head[3];
+    is.seekg(it->second);
+    is.read(reinterpret_cast<char*>(head), sizeof(head));
+    buffer.resize(size_t(head[2]));
+    if (head[2] > 0) is.read(&buffer[0], streamsize(head[2]));
+    if (!is) throw runtime_error("Error reading from file: " + filename);
+
+    YbatchRecordReader record(buffer, filename);
+    ybatch[i].resize(record.index());
+    record.numerics(ybatch[i]);
+    ybatch_aux[i].resize(record.index());
+    for (Index j = 0; j < ybatch_aux[i].nelem(); j++) {
+      ybatch_aux[i][j].resize(record.index());
+      record.numerics(ybatch_aux[i][j]);
+    }
+    const Index nrows = record.index();
+    const Index ncols = record.index();
+    ybatch_jacobians[i].resize(nrows, ncols);
+    for (Index r = 0; r < nrows; r++) record.numerics(ybatch_jacobians[i](r, joker));
+  }
+}
@@ -0,0 +1,146 @@
+/* Copyright (C) 2020 The ARTS developers
+
+   This program is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the
+   Free Software Foundation; either version 2, or (at your option) any
+   later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+   USA. */
+
+/*!
+  \file   ybatch_file.h
+
+  \brief  Append-only files holding the results of batch calculations.
+
+  The file is written by *ybatchCalcToFile* and read by *ybatchReadFile*.
+  All integers are signed 64 bit and all floating point numbers are
+  Numeric, both in native byte order. The file starts with the 8
+  characters "ARTSYBF1" followed by the integer 1, which is used to detect
+  files written with a different byte order. The header ends with the
+  setup key, an integer n followed by n characters. It describes the
+  calculation the file belongs to, and a file is only continued by a
+  calculation with the same key. Then follows one record per completed
+  job:
+
+  - Integer: The record tag 0x59424154434852 ("YBATCHR").
+  - Integer: The job index, i.e. the value of *ybatch_index*.
+  - Integer: The size of the payload in bytes.
+  - The payload:
+    - Integer ny followed by the ny elements of *y*.
+    - Integer naux followed by naux times an integer n and n values, the
+      elements of *y_aux*.
+    - Integers nrows and ncols followed by *jacobian* in row-major order.
+  - Integer: The job index again. A record is complete only if this
+    matches the index at the start of the record.
+
+  The records are in the order the jobs were completed, the job index is
+  what identifies them. An incomplete record at the end of the file, left
+  by an interrupted calculation, is removed when the file is opened for
+  writing again.
+*/
+
+#ifndef ybatch_file_h
+#define ybatch_file_h
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "array.h"
+#include "matpackI.h"
+#include "mystring.h"
+
+//! Writes results of batch jobs to a file from a separate thread.
+/*!
+  The results are passed to the writer thread through a queue of limited
+  length, so the memory needed is independent of the number of jobs.
+*/
+class YbatchFileWriter {
+ public:
+  //! Open the file for appending, or create it if it does not exist.
+  /*!
+    Throws if an existing file has a different setup key.
+
+    \param filename    Name of the file.
+    \param key         Setup key of the calculation.
+    \param queue_size  Maximum number of results waiting to be written.
+  */
+  YbatchFileWriter(const String& filename,
+                   const String& key,
+                   Index queue_size);
+
+  ~YbatchFileWriter();
+
+  //! Check if the file already holds the result of a job.
+  bool contains(Index job) const { return mdone.count(job) > 0; }
+
+  //! Number of jobs found in the file when it was opened.
+  Index ndone() const { return (Index)mdone.size(); }
+
+  //! Queue the result of a job for writing.
+  /*!
+    Blocks while the queue is full. Throws if the writer thread has
+    failed.
+  */
+  void push(Index job, Vector& y, ArrayOfVector& y_aux, Matrix& jacobian);
+
+  //! Write all queued results and close the file.
+  /*!
+    Rethrows any error of the writer thread.
+  */
+  void finish();
+
+ private:
+  struct Job {
+    Index index;
+    Vector y;
+    ArrayOfVector y_aux;
+    Matrix jacobian;
+  };
+
+  void write_loop();
+
+  String mfilename;
+  std::ofstream mfile;
+  std::map<Index, std::streamoff> mdone;
+  std::deque<Job> mqueue;
+  size_t mqueue_size;
+  bool mclosing;
+  std::exception_ptr merror;
+  std::mutex mmutex;
+  std::condition_variable mnot_empty;
+  std::condition_variable mnot_full;
+  std::thread mthread;
+};
+
+//! Read batch results from a file written by YbatchFileWriter.
+/*!
+  Job ybatch_start + i is stored at position i of the output arrays. Jobs
+  missing in the file are left empty.
+
+  \param ybatch            Out: The measurement vectors.
+  \param ybatch_aux        Out: The auxiliary data.
+  \param ybatch_jacobians  Out: The Jacobians.
+  \param filename          Name of the file.
+  \param ybatch_start      Index of the first job to read.
+  \param ybatch_n          Number of jobs to read.
+*/
+void ybatch_file_read(ArrayOfVector& ybatch,
+                      ArrayOfArrayOfVector& ybatch_aux,
+                      ArrayOfMatrix& ybatch_jacobians,
+                      const String& filename,
+                      const Index& ybatch_start,
+                      const Index& ybatch_n);
+
+#endif /* ybatch_file_h */